@@ -0,0 +1,65 @@
+// *******************************************************
+//
+// dblBuf.c
+//
+// Lock-free double-buffered exchange of a fixed size
+// record from one writer to any readers. See dblBuf.h.
+//
+// Group 1
+// Created on: 17/10/2026
+//
+// *******************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "spscBuf.h"
+#include "dblBuf.h"
+
+// *******************************************************
+// initDblBuf: Initialise the exchange over two copies of
+// size bytes each, with initial in both.
+void
+initDblBuf (dblBuf_t *buffer, void *storage, uint32_t size, const void *initial)
+{
+	buffer->copy[0] = (uint8_t *) storage;
+	buffer->copy[1] = (uint8_t *) storage + size;
+	buffer->size = size;
+	memcpy(buffer->copy[0], initial, size);
+	memcpy(buffer->copy[1], initial, size);
+	buffer->seq = 0;
+}
+
+// *******************************************************
+// writeDblBuf: Writer side. The record must be in memory
+// before the new seq is, or a reader could copy it part
+// written.
+void
+writeDblBuf (dblBuf_t *buffer, const void *src)
+{
+	uint32_t seq = buffer->seq;
+
+	memcpy(buffer->copy[(seq + 1) & 1], src, buffer->size);
+	SPSC_BARRIER();
+	buffer->seq = seq + 1;
+}
+
+// *******************************************************
+// readDblBuf: Reader side. The copy is intact if the writer
+// published nothing while it was taken: anything it wrote
+// meanwhile went into the other copy. Once it publishes,
+// it starts on this one.
+uint32_t
+readDblBuf (dblBuf_t *buffer, void *dest)
+{
+	uint32_t seq;
+
+	do {
+		seq = buffer->seq;
+		SPSC_BARRIER();
+		memcpy(dest, buffer->copy[seq & 1], buffer->size);
+		SPSC_BARRIER();
+	} while (buffer->seq != seq);
+
+	return seq;
+}
@@ -0,0 +1,68 @@
+#ifndef DBLBUF_H_
+#define DBLBUF_H_
+
+// *******************************************************
+//
+// dblBuf.h
+//
+// Lock-free double-buffered exchange of a fixed size record
+// (e.g. set points, or telemetry) from one writer to any
+// number of readers, at any interrupt priorities. Neither
+// side disables interrupts or calls FreeRTOS, so it can be
+// used from an interrupt above
+// configMAX_SYSCALL_INTERRUPT_PRIORITY, which a critical
+// section does not hold off.
+//
+// The writer copies each record into the copy not last
+// published, then publishes it by advancing seq. The newest
+// record is always copy[seq & 1], and is never written
+// until the one after it has been published, so a reader
+// can take it whatever state the writer was interrupted
+// in. A reader checks seq has not moved on while it copied,
+// in which case the writer may have started on the copy it
+// was reading, and it reads again. A reader the writer
+// cannot interrupt (e.g. an interrupt reading what a task
+// writes) therefore never retries, and one that the writer
+// can (a task reading what an interrupt writes) only does
+// if a record is published while it copies.
+//
+// Storage for the two copies is supplied by the caller
+// (normally a static array of two records) rather than
+// allocated.
+//
+// Group 1
+// Created on: 17/10/2026
+//
+// *******************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+// *******************************************************
+// Buffer structure
+typedef struct {
+	uint8_t *copy[2];			// The two copies, supplied by the caller
+	uint32_t size;				// Bytes in a record
+	volatile uint32_t seq;		// Records published, only changed by the writer
+} dblBuf_t;
+
+// *******************************************************
+// initDblBuf: Initialise the exchange over two copies of
+// size bytes each in storage, and publish initial as the
+// first record. Must be called before either side starts.
+void
+initDblBuf (dblBuf_t *buffer, void *storage, uint32_t size, const void *initial);
+
+// *******************************************************
+// writeDblBuf: Writer side. Publish the record at src. Only
+// one writer at a time.
+void
+writeDblBuf (dblBuf_t *buffer, const void *src);
+
+// *******************************************************
+// readDblBuf: Reader side. Copy the newest record to dest.
+// Returns its sequence number, which changes each time a
+// new record is published.
+uint32_t
+readDblBuf (dblBuf_t *buffer, void *dest);
+
+#endif /*DBLBUF_H_*/
@@ -0,0 +1,248 @@
+// *******************************************************
+//
+// filter.c
+//
+// FIR, biquad and running median filters, and a pipeline
+// to chain them. See filter.h.
+//
+// Group 1
+// Created on: 17/10/2026
+//
+// *******************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "filter.h"
+
+// *******************************************************
+// Dual 16 x 16 bit multiply-accumulate: the low halves of a
+// and b multiplied, plus the high halves multiplied, plus
+// acc. One SMLAD instruction on the Cortex-M4, plain C on
+// the host.
+#if defined(__TI_ARM__)
+#define FIR_SMLAD(a, b, acc)	_smlad((a), (b), (acc))
+#elif defined(__GNUC__) && defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#define FIR_SMLAD(a, b, acc)	((int32_t) __smlad((a), (b), (acc)))
+#else
+#define FIR_SMLAD(a, b, acc)	((acc) + (int16_t) (a) * (int16_t) (b) \
+		+ (int16_t) ((uint32_t) (a) >> 16) * (int16_t) ((uint32_t) (b) >> 16))
+#endif
+
+// *******************************************************
+// loadPair: Two consecutive int16_t as one 32 bit word. The
+// Cortex-M4 allows unaligned word loads, so this compiles
+// to a single LDR.
+static inline uint32_t
+loadPair (const int16_t *pair)
+{
+	uint32_t word;
+
+	memcpy(&word, pair, sizeof(word));
+	return word;
+}
+
+// *******************************************************
+// roundFloat: Nearest integer, halves away from zero.
+static inline int32_t
+roundFloat (float value)
+{
+	return (int32_t) (value + ((value >= 0.0f) ? 0.5f : -0.5f));
+}
+
+// *******************************************************
+// initFirFilter: Initialise a FIR filter of taps coefficients.
+void
+initFirFilter (firFilter_t *fir, const int16_t *coeffs, int16_t *history, uint32_t taps)
+{
+	fir->coeffs = coeffs;
+	fir->history = history;
+	fir->taps = taps;
+	fir->index = 0;
+	fir->primed = false;
+}
+
+// *******************************************************
+// stepFirFilter: The window is stored twice, one copy after
+// the other, and written from the end towards the start.
+// The last taps samples, newest first, are then always the
+// contiguous run from history[index], so the taps can be
+// taken in pairs with no wrap check. Both the window and the
+// coefficients are newest first, so sample and coefficient
+// pairs line up for SMLAD.
+int32_t
+stepFirFilter (void *filter, int32_t sample)
+{
+	firFilter_t *fir = (firFilter_t *) filter;
+	const int16_t *window;
+	int16_t input;
+	int32_t acc = 0;
+	uint32_t taps = fir->taps;
+	uint32_t k;
+
+	if (sample > INT16_MAX)
+		input = INT16_MAX;
+	else if (sample < INT16_MIN)
+		input = INT16_MIN;
+	else
+		input = (int16_t) sample;
+
+	if (!fir->primed) {
+		for (k = 0; k < 2 * taps; k++)
+			fir->history[k] = input;  // As if input had always been applied
+		fir->primed = true;
+	}
+
+	if (fir->index == 0)
+		fir->index = taps;
+	fir->index--;
+	fir->history[fir->index] = input;
+	fir->history[fir->index + taps] = input;
+
+	window = &fir->history[fir->index];
+	for (k = 0; k + 1 < taps; k += 2)
+		acc = FIR_SMLAD(loadPair(&window[k]), loadPair(&fir->coeffs[k]), acc);
+	if (taps & 1)
+		acc += window[taps - 1] * fir->coeffs[taps - 1];
+
+	return (acc + (1 << (FIR_FRAC_BITS - 1))) >> FIR_FRAC_BITS;
+}
+
+// *******************************************************
+// initBiquadFilter: Initialise a cascade of biquad sections.
+void
+initBiquadFilter (biquadFilter_t *biquad, const biquadCoeffs_t *coeffs, float *state, uint32_t sections)
+{
+	biquad->coeffs = coeffs;
+	biquad->state = state;
+	biquad->sections = sections;
+	biquad->primed = false;
+}
+
+// *******************************************************
+// stepBiquadFilter: Direct form II transposed, two state
+// values per section. On the first sample each section is
+// set to its steady state for that input (output = DC gain
+// times input), so there is no start up transient.
+int32_t
+stepBiquadFilter (void *filter, int32_t sample)
+{
+	biquadFilter_t *biquad = (biquadFilter_t *) filter;
+	const biquadCoeffs_t *c;
+	float *s = biquad->state;
+	float x = (float) sample;
+	float y;
+	uint32_t i;
+
+	if (!biquad->primed) {
+		for (i = 0, c = biquad->coeffs; i < biquad->sections; i++, c++) {
+			y = x * (c->b0 + c->b1 + c->b2) / (1.0f + c->a1 + c->a2);
+			s[2 * i] = y - c->b0 * x;
+			s[2 * i + 1] = c->b2 * x - c->a2 * y;
+			x = y;
+		}
+		x = (float) sample;
+		biquad->primed = true;
+	}
+
+	for (i = 0, c = biquad->coeffs; i < biquad->sections; i++, c++, s += 2) {
+		y = c->b0 * x + s[0];
+		s[0] = c->b1 * x - c->a1 * y + s[1];
+		s[1] = c->b2 * x - c->a2 * y;
+		x = y;
+	}
+
+	return roundFloat(x);
+}
+
+// *******************************************************
+// initMedianFilter: Initialise a running median over size
+// samples.
+void
+initMedianFilter (medianFilter_t *median, int32_t *history, int32_t *sorted, uint32_t size)
+{
+	median->history = history;
+	median->sorted = sorted;
+	median->size = size;
+	median->index = 0;
+	median->primed = false;
+}
+
+// *******************************************************
+// stepMedianFilter: The new sample takes the place of the
+// oldest one in the sorted copy, then moves up or down past
+// the values it should not be in front of. Costs at most
+// size compares and moves, with no full sort.
+int32_t
+stepMedianFilter (void *filter, int32_t sample)
+{
+	medianFilter_t *median = (medianFilter_t *) filter;
+	int32_t *sorted = median->sorted;
+	uint32_t size = median->size;
+	int32_t oldest;
+	uint32_t i;
+
+	if (!median->primed) {
+		for (i = 0; i < size; i++) {
+			median->history[i] = sample;
+			sorted[i] = sample;
+		}
+		median->primed = true;
+		return sample;
+	}
+
+	oldest = median->history[median->index];
+	median->history[median->index] = sample;
+	if (++median->index == size)
+		median->index = 0;
+
+	for (i = 0; sorted[i] != oldest; i++)
+		;  // oldest is always held, so this stops within size
+
+	if (sample > oldest) {
+		for (; i + 1 < size && sorted[i + 1] < sample; i++)
+			sorted[i] = sorted[i + 1];
+	} else {
+		for (; i > 0 && sorted[i - 1] > sample; i--)
+			sorted[i] = sorted[i - 1];
+	}
+	sorted[i] = sample;
+
+	return sorted[size / 2];
+}
+
+// *******************************************************
+// initFilterChain: Initialise an empty pipeline.
+void
+initFilterChain (filterChain_t *chain)
+{
+	chain->stages = 0;
+}
+
+// *******************************************************
+// addFilterChain: Append a stage to the pipeline.
+bool
+addFilterChain (filterChain_t *chain, filterStep_t step, void *filter)
+{
+	if (chain->stages == FILTER_MAX_STAGES)
+		return false;
+
+	chain->step[chain->stages] = step;
+	chain->filter[chain->stages] = filter;
+	chain->stages++;
+	return true;
+}
+
+// *******************************************************
+// stepFilterChain: Pass one sample through every stage.
+int32_t
+stepFilterChain (filterChain_t *chain, int32_t sample)
+{
+	uint32_t i;
+
+	for (i = 0; i < chain->stages; i++)
+		sample = chain->step[i](chain->filter[i], sample);
+
+	return sample;
+}
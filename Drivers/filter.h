@@ -0,0 +1,146 @@
+#ifndef FILTER_H_
+#define FILTER_H_
+
+// *******************************************************
+//
+// filter.h
+//
+// Digital filters for integer sample streams (e.g. ADC
+// counts), which can be chained into a pipeline at run time:
+//
+//   FIR     Q15 coefficients, 16 bit samples. Two taps per
+//           SMLAD dual multiply-accumulate on the Cortex-M4.
+//   biquad  Cascade of second order IIR sections, direct
+//           form II transposed in single precision (FPU).
+//   median  Running median, for rejecting single sample
+//           spikes before the linear stages.
+//
+// Every filter settles on its first sample (as if that
+// value had always been applied), so a pipeline does not
+// ramp up from zero at start up.
+//
+// Coefficients and state are supplied by the caller
+// (normally static arrays) rather than allocated.
+//
+// Group 1
+// Created on: 17/10/2026
+//
+// *******************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FILTER_MAX_STAGES	4	// Stages in a filterChain_t
+#define FIR_FRAC_BITS		15	// FIR coefficients are Q15, 32768 is a gain of 1
+
+// *******************************************************
+// Step function of a pipeline stage: filter one sample and
+// return the output. Every filter below provides one, and
+// any other function of this form can be added to a chain.
+typedef int32_t (*filterStep_t)(void *filter, int32_t sample);
+
+// *******************************************************
+// FIR structure
+typedef struct {
+	const int16_t *coeffs;	// taps Q15 coefficients, coeffs[k] multiplies the sample k steps old
+	int16_t *history;		// 2 * taps entries of caller storage, the window is kept twice over
+	uint32_t taps;
+	uint32_t index;			// Newest sample, history[index] and history[index + taps]
+	bool primed;
+} firFilter_t;
+
+// *******************************************************
+// Biquad section coefficients,
+// y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+typedef struct {
+	float b0, b1, b2, a1, a2;
+} biquadCoeffs_t;
+
+// *******************************************************
+// Biquad cascade structure
+typedef struct {
+	const biquadCoeffs_t *coeffs;	// One set per section
+	float *state;			// 2 * sections entries of caller storage
+	uint32_t sections;
+	bool primed;
+} biquadFilter_t;
+
+// *******************************************************
+// Median structure
+typedef struct {
+	int32_t *history;		// size entries of caller storage, in arrival order
+	int32_t *sorted;		// size entries of caller storage, the same values in order
+	uint32_t size;
+	uint32_t index;			// Oldest entry of history
+	bool primed;
+} medianFilter_t;
+
+// *******************************************************
+// Pipeline structure
+typedef struct {
+	filterStep_t step[FILTER_MAX_STAGES];
+	void *filter[FILTER_MAX_STAGES];
+	uint32_t stages;
+} filterChain_t;
+
+// *******************************************************
+// initFirFilter: Initialise a FIR filter of taps coefficients
+// over 2 * taps entries of history. The sum of the absolute
+// coefficients times the largest input must stay below
+// 2^31 / 2^15 (e.g. up to 16.0 in total at 12 bit full scale)
+// or the accumulator overflows. Inputs are saturated to 16 bits.
+void
+initFirFilter (firFilter_t *fir, const int16_t *coeffs, int16_t *history, uint32_t taps);
+
+// *******************************************************
+// stepFirFilter: Filter one sample through a firFilter_t.
+// Returns the output rounded to the nearest integer.
+int32_t
+stepFirFilter (void *fir, int32_t sample);
+
+// *******************************************************
+// initBiquadFilter: Initialise a cascade of sections biquads
+// over 2 * sections entries of state.
+void
+initBiquadFilter (biquadFilter_t *biquad, const biquadCoeffs_t *coeffs, float *state, uint32_t sections);
+
+// *******************************************************
+// stepBiquadFilter: Filter one sample through every section
+// of a biquadFilter_t. Returns the output rounded to the
+// nearest integer, the sections themselves are not rounded.
+int32_t
+stepBiquadFilter (void *biquad, int32_t sample);
+
+// *******************************************************
+// initMedianFilter: Initialise a running median over size
+// samples, with size entries each of history and sorted
+// storage. Use an odd size, an even one returns the upper
+// of the two middle values.
+void
+initMedianFilter (medianFilter_t *median, int32_t *history, int32_t *sorted, uint32_t size);
+
+// *******************************************************
+// stepMedianFilter: Add one sample to a medianFilter_t.
+// Returns the median of the last size samples.
+int32_t
+stepMedianFilter (void *median, int32_t sample);
+
+// *******************************************************
+// initFilterChain: Initialise an empty pipeline, which
+// passes samples straight through.
+void
+initFilterChain (filterChain_t *chain);
+
+// *******************************************************
+// addFilterChain: Append a stage, filter with its step
+// function, to the end of the pipeline. Returns false if
+// the pipeline already has FILTER_MAX_STAGES stages.
+bool
+addFilterChain (filterChain_t *chain, filterStep_t step, void *filter);
+
+// *******************************************************
+// stepFilterChain: Pass one sample through every stage in
+// order. Returns the output of the last stage.
+int32_t
+stepFilterChain (filterChain_t *chain, int32_t sample);
+
+#endif /*FILTER_H_*/
@@ -0,0 +1,88 @@
+// *******************************************************
+//
+// pingPongBuf.c
+//
+// Hand-off of two alternating DMA half-buffers from the
+// completion interrupt to one task. See pingPongBuf.h.
+//
+// Group 1
+// Created on: 17/10/2026
+//
+// *******************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "spscBuf.h"
+#include "pingPongBuf.h"
+
+// *******************************************************
+// initPingPongBuf: Initialise the hand-off over two halves
+// of halfSize entries each.
+void
+initPingPongBuf (pingPongBuf_t *buffer, volatile uint16_t *ping,
+		volatile uint16_t *pong, uint32_t halfSize)
+{
+	buffer->half[0] = ping;
+	buffer->half[1] = pong;
+	buffer->halfSize = halfSize;
+	buffer->completed = 0;
+	buffer->consumed = 0;
+	buffer->overruns = 0;
+}
+
+// *******************************************************
+// nextPingPongBuf: Producer side. Halves complete strictly
+// alternately, starting with ping.
+uint32_t
+nextPingPongBuf (pingPongBuf_t *buffer)
+{
+	return buffer->completed & 1;
+}
+
+// *******************************************************
+// completePingPongBuf: Producer side. The DMA has already
+// written the half, the barrier keeps the new ticket from
+// being seen before that data.
+uint32_t
+completePingPongBuf (pingPongBuf_t *buffer)
+{
+	uint32_t completed = buffer->completed;
+
+	SPSC_BARRIER();
+	buffer->completed = completed + 1;
+	return completed & 1;
+}
+
+// *******************************************************
+// acquirePingPongBuf: Consumer side. Ticket t was written to
+// half (t - 1) & 1.
+const volatile uint16_t *
+acquirePingPongBuf (pingPongBuf_t *buffer, uint32_t *ticket)
+{
+	uint32_t completed = buffer->completed;
+
+	if (completed == buffer->consumed)
+		return NULL;
+
+	buffer->overruns += completed - buffer->consumed - 1;
+	buffer->consumed = completed;
+	*ticket = completed;
+
+	SPSC_BARRIER();  // Read the ticket before the data it covers
+	return buffer->half[(completed - 1) & 1];
+}
+
+// *******************************************************
+// checkPingPongBuf: Consumer side. The re-armed half of
+// ticket t still has its full transfer count until the DMA
+// moves back into it, which can be before ticket t + 1 is
+// published. A full count with no newer ticket means the
+// DMA has not touched it (a count reloaded by a later
+// re-arm always comes with a newer ticket).
+bool
+checkPingPongBuf (pingPongBuf_t *buffer, uint32_t ticket, uint32_t remaining)
+{
+	SPSC_BARRIER();  // Finish reading the data and the count before the ticket
+	return (remaining == buffer->halfSize) && (buffer->completed == ticket);
+}
@@ -0,0 +1,85 @@
+#ifndef PINGPONGBUF_H_
+#define PINGPONGBUF_H_
+
+// *******************************************************
+//
+// pingPongBuf.h
+//
+// Hand-off of two alternating half-buffers filled by a DMA
+// channel in ping-pong mode (e.g. ADC0 sequence 0 into
+// uDMA), from the DMA completion interrupt to one task.
+//
+// The DMA fills ping, then pong, then ping again, and so
+// on. Every completed half is numbered: the first ping is
+// ticket 1, the first pong ticket 2, and so on. The
+// interrupt publishes each ticket in order with
+// completePingPongBuf(). The task takes the newest one with
+// acquirePingPongBuf(), reads the half, then confirms with
+// checkPingPongBuf() that the DMA did not start refilling
+// it while it was being read.
+//
+// Once the interrupt has re-armed a half and published its
+// ticket, the DMA moves back into it as soon as the other
+// half completes, which is before the interrupt for that
+// completion can publish the next ticket. A newer ticket
+// alone cannot show a refill in that window, so the check
+// also takes what the hardware has left to transfer into
+// the half.
+//
+// Group 1
+// Created on: 17/10/2026
+//
+// *******************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+// *******************************************************
+// Buffer structure
+typedef struct {
+	volatile uint16_t *half[2];	// Ping and pong storage, supplied by the caller
+	uint32_t halfSize;			// Entries in each half
+	volatile uint32_t completed;	// Halves filled, only changed by the producer
+	uint32_t consumed;			// Last ticket acquired, only changed by the consumer
+	uint32_t overruns;			// Halves completed but never acquired
+} pingPongBuf_t;
+
+// *******************************************************
+// initPingPongBuf: Initialise the hand-off over two halves
+// of halfSize entries each. Must be called before the DMA is
+// started.
+void
+initPingPongBuf (pingPongBuf_t *buffer, volatile uint16_t *ping,
+		volatile uint16_t *pong, uint32_t halfSize);
+
+// *******************************************************
+// nextPingPongBuf: Producer side. Return the half the DMA is
+// expected to complete next, 0 for ping and 1 for pong.
+uint32_t
+nextPingPongBuf (pingPongBuf_t *buffer);
+
+// *******************************************************
+// completePingPongBuf: Producer side. Publish the half
+// returned by nextPingPongBuf() as filled. Returns that half.
+uint32_t
+completePingPongBuf (pingPongBuf_t *buffer);
+
+// *******************************************************
+// acquirePingPongBuf: Consumer side. Return the newest filled
+// half and set *ticket to its number, or return NULL if no
+// half has completed since the last call. Older halves that
+// were never acquired are counted in overruns.
+const volatile uint16_t *
+acquirePingPongBuf (pingPongBuf_t *buffer, uint32_t *ticket);
+
+// *******************************************************
+// checkPingPongBuf: Consumer side. Return true if the half
+// acquired with ticket has not been refilled since, so what
+// was read from it is one complete block. remaining is the
+// number of transfers the DMA still has to make into that
+// half (ticket t is in half (t - 1) & 1), read from its
+// control structure after the data, e.g. with
+// uDMAChannelSizeGet().
+bool
+checkPingPongBuf (pingPongBuf_t *buffer, uint32_t ticket, uint32_t remaining);
+
+#endif /*PINGPONGBUF_H_*/
@@ -0,0 +1,174 @@
+// *******************************************************
+//
+// rotorPWM.c
+//
+// PWM drive of the main and tail rotor motors, a single
+// compare register write per duty. See rotorPWM.h.
+//
+// Group 1
+// Created on: 17/10/2026
+//
+// *******************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_pwm.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/pwm.h"
+#include "driverlib/sysctl.h"
+#include "rotorPWM.h"
+
+// *******************************************************
+// Rotor structure
+typedef struct {
+	uint32_t base;				// PWM module
+	uint32_t outBit;			// PWM_OUT_n_BIT of the output
+	uint32_t compare;			// Address of the compare register that sets the output
+	uint32_t load;				// Generator load, half the period as it counts up and down
+	uint32_t min;				// Duty limits, fractions of ROTOR_DUTY_ONE
+	uint32_t max;
+	volatile bool on;			// A duty other than 0 was set last
+} rotor_t;
+
+// *******************************************************
+// Globals to module
+// *******************************************************
+static rotor_t rotors[NUM_ROTORS];
+static volatile bool killed;
+
+// *******************************************************
+// initRotor: Start one generator, counting up and down so
+// the pulse is centred in the period, with its output off.
+static void
+initRotor (uint8_t rotor, uint32_t pwmPeriph, uint32_t gpioPeriph, uint32_t gpioBase, uint32_t gpioConfig,
+		uint8_t gpioPin, uint32_t base, uint32_t gen, uint32_t out, uint32_t outBit)
+{
+	rotor_t *r = &rotors[rotor];
+
+	SysCtlPeripheralEnable(pwmPeriph);
+	SysCtlPeripheralEnable(gpioPeriph);
+	while (!SysCtlPeripheralReady(pwmPeriph));
+	while (!SysCtlPeripheralReady(gpioPeriph));
+
+	GPIOPinConfigure(gpioConfig);
+	GPIOPinTypePWM(gpioBase, gpioPin);
+
+	PWMGenConfigure(base, gen, PWM_GEN_MODE_UP_DOWN | PWM_GEN_MODE_NO_SYNC);
+	PWMGenPeriodSet(base, gen, SysCtlClockGet() / ROTOR_PWM_DIVIDER / ROTOR_PWM_HZ);
+	PWMOutputState(base, outBit, false);
+
+	r->base = base;
+	r->outBit = outBit;
+	r->compare = base + gen + ((out & 1) ? PWM_O_X_CMPB : PWM_O_X_CMPA);	// Odd outputs are set by B
+	r->load = HWREG(base + gen + PWM_O_X_LOAD);		// As PWMGenPeriodSet() worked it out
+	r->min = ROTOR_DUTY_MIN;
+	r->max = ROTOR_DUTY_MAX;
+	r->on = false;
+	HWREG(r->compare) = r->load;	// No pulse until a duty is set
+
+	PWMGenEnable(base, gen);
+}
+
+// *******************************************************
+// initRotorPWM: Both generators share the PWM clock
+// divider. Killed first, so no duty set meanwhile can turn
+// an output on.
+void
+initRotorPWM (void)
+{
+	SysCtlPWMClockSet(ROTOR_PWM_DIVIDER_CODE);
+	killed = true;
+
+	initRotor(ROTOR_MAIN, ROTOR_MAIN_PWM_PERIPH, ROTOR_MAIN_GPIO_PERIPH, ROTOR_MAIN_GPIO_BASE,
+			ROTOR_MAIN_GPIO_CONFIG, ROTOR_MAIN_GPIO_PIN, ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_GEN,
+			ROTOR_MAIN_PWM_OUTNUM, ROTOR_MAIN_PWM_OUTBIT);
+	initRotor(ROTOR_TAIL, ROTOR_TAIL_PWM_PERIPH, ROTOR_TAIL_GPIO_PERIPH, ROTOR_TAIL_GPIO_BASE,
+			ROTOR_TAIL_GPIO_CONFIG, ROTOR_TAIL_GPIO_PIN, ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_GEN,
+			ROTOR_TAIL_PWM_OUTNUM, ROTOR_TAIL_PWM_OUTBIT);
+}
+
+// *******************************************************
+// setRotorDuty: The output is high from the compare on the
+// way up to it on the way down, load - compare counts each
+// side of the top of a 2 * load count period. The load is
+// 16 bits, so load * duty fits in 32.
+void
+setRotorDuty (uint8_t rotor, uint32_t duty)
+{
+	rotor_t *r = &rotors[rotor];
+
+	if (duty == 0)
+	{
+		// Off before on is cleared, so a setRotorDuty() that interrupts this turns it back on after
+		PWMOutputState(r->base, r->outBit, false);
+		r->on = false;
+		return;
+	}
+
+	if (duty < r->min)
+		duty = r->min;
+	else if (duty > r->max)
+		duty = r->max;
+	HWREG(r->compare) = r->load - ((r->load * duty + (ROTOR_DUTY_ONE >> 1)) >> ROTOR_DUTY_BITS);
+
+	if (!r->on)
+	{
+		r->on = true;
+		if (!killed)
+		{
+			PWMOutputState(r->base, r->outBit, true);
+			if (killed)
+				PWMOutputState(r->base, r->outBit, false);	// Killed while it was turned on
+		}
+	}
+}
+
+// *******************************************************
+// setRotorLimits: Clamped to what setRotorDuty() can set.
+void
+setRotorLimits (uint8_t rotor, uint32_t min, uint32_t max)
+{
+	rotors[rotor].min = (min < 1) ? 1 : min;
+	rotors[rotor].max = (max > ROTOR_DUTY_ONE) ? ROTOR_DUTY_ONE : max;
+}
+
+// *******************************************************
+// killRotors: The flag goes first, so a setRotorDuty() that
+// interrupts this does not turn an output back on.
+void
+killRotors (void)
+{
+	uint8_t i;
+
+	killed = true;
+	for (i = 0; i < NUM_ROTORS; i++)
+	{
+		PWMOutputState(rotors[i].base, rotors[i].outBit, false);
+	}
+}
+
+// *******************************************************
+// armRotors: Only the outputs with a duty set come back on.
+void
+armRotors (void)
+{
+	uint8_t i;
+
+	killed = false;
+	for (i = 0; i < NUM_ROTORS; i++)
+	{
+		if (rotors[i].on)
+			PWMOutputState(rotors[i].base, rotors[i].outBit, true);
+	}
+}
+
+// *******************************************************
+// getRotorsKilled
+bool
+getRotorsKilled (void)
+{
+	return killed;
+}
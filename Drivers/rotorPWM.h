@@ -0,0 +1,115 @@
+#ifndef ROTORPWM_H_
+#define ROTORPWM_H_
+
+// *******************************************************
+//
+// rotorPWM.h
+//
+// PWM drive of the HeliRig's two motors: the main rotor on
+// M0PWM7 (PC5, J4-05) and the tail rotor on M1PWM5 (PF1),
+// both at ROTOR_PWM_HZ.
+//
+// initRotorPWM() works out each generator's load once, so
+// setting a duty is a multiply and a shift into the
+// output's compare register, a single write with no divide
+// and no driverlib call. It can be called from any task or
+// interrupt, including one above
+// configMAX_SYSCALL_INTERRUPT_PRIORITY. The generators take
+// a new compare up when they next count to 0, so a pulse is
+// never cut short.
+//
+// Duties are fixed point fractions of ROTOR_DUTY_ONE (so a
+// Q16.16 fraction as it is), held to each rotor's limits.
+// A duty of 0 turns the output off instead.
+//
+// killRotors() is the kill switch: both outputs are turned
+// off, and kept off whatever duties are set, until
+// armRotors(). initRotorPWM() leaves them killed, so the
+// motors only turn once something arms them on purpose.
+//
+// Group 1
+// Created on: 17/10/2026
+//
+// *******************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+// *******************************************************
+// Constants
+// *******************************************************
+enum rotorNames {ROTOR_MAIN = 0, ROTOR_TAIL, NUM_ROTORS};
+
+#define ROTOR_PWM_HZ            250
+#define ROTOR_PWM_DIVIDER_CODE  SYSCTL_PWMDIV_4
+#define ROTOR_PWM_DIVIDER       4		// The generators count at the system clock / 4, 20 MHz at 80 MHz
+
+#define ROTOR_DUTY_BITS         16
+#define ROTOR_DUTY_ONE          (1U << ROTOR_DUTY_BITS)		// A duty of 100%
+#define ROTOR_DUTY(x)           ((uint32_t) ((x) * ROTOR_DUTY_ONE + 0.5))	// Of a constant fraction
+#define ROTOR_DUTY_MIN          ROTOR_DUTY(0.02)	// Limits set by initRotorPWM()
+#define ROTOR_DUTY_MAX          ROTOR_DUTY(0.98)
+
+// Main rotor: M0PWM7, PC5 (gen 3)
+#define ROTOR_MAIN_PWM_BASE     PWM0_BASE
+#define ROTOR_MAIN_PWM_GEN      PWM_GEN_3
+#define ROTOR_MAIN_PWM_OUTNUM   PWM_OUT_7
+#define ROTOR_MAIN_PWM_OUTBIT   PWM_OUT_7_BIT
+#define ROTOR_MAIN_PWM_PERIPH   SYSCTL_PERIPH_PWM0
+#define ROTOR_MAIN_GPIO_PERIPH  SYSCTL_PERIPH_GPIOC
+#define ROTOR_MAIN_GPIO_BASE    GPIO_PORTC_BASE
+#define ROTOR_MAIN_GPIO_CONFIG  GPIO_PC5_M0PWM7
+#define ROTOR_MAIN_GPIO_PIN     GPIO_PIN_5
+// Tail rotor: M1PWM5, PF1 (gen 2)
+#define ROTOR_TAIL_PWM_BASE     PWM1_BASE
+#define ROTOR_TAIL_PWM_GEN      PWM_GEN_2
+#define ROTOR_TAIL_PWM_OUTNUM   PWM_OUT_5
+#define ROTOR_TAIL_PWM_OUTBIT   PWM_OUT_5_BIT
+#define ROTOR_TAIL_PWM_PERIPH   SYSCTL_PERIPH_PWM1
+#define ROTOR_TAIL_GPIO_PERIPH  SYSCTL_PERIPH_GPIOF
+#define ROTOR_TAIL_GPIO_BASE    GPIO_PORTF_BASE
+#define ROTOR_TAIL_GPIO_CONFIG  GPIO_PF1_M1PWM5
+#define ROTOR_TAIL_GPIO_PIN     GPIO_PIN_1
+
+// *******************************************************
+// initRotorPWM: Start both generators at ROTOR_PWM_HZ with
+// the outputs off, killed until armRotors(), and limited
+// to ROTOR_DUTY_MIN to ROTOR_DUTY_MAX. The system clock
+// must be set first.
+void
+initRotorPWM (void);
+
+// *******************************************************
+// setRotorDuty: Set the duty of rotor (ROTOR_MAIN or
+// ROTOR_TAIL), a fraction of ROTOR_DUTY_ONE, held to its
+// limits. 0 turns the output off, any other duty turns it
+// on unless the rotors are killed.
+void
+setRotorDuty (uint8_t rotor, uint32_t duty);
+
+// *******************************************************
+// setRotorLimits: Hold the duties of rotor to min to max,
+// fractions of ROTOR_DUTY_ONE, min at least 1 and max at
+// most ROTOR_DUTY_ONE. Takes effect at the next
+// setRotorDuty(), set them before the rotor is driven.
+void
+setRotorLimits (uint8_t rotor, uint32_t min, uint32_t max);
+
+// *******************************************************
+// killRotors: Turn both outputs off until armRotors().
+// Safe under interrupt.
+void
+killRotors (void);
+
+// *******************************************************
+// armRotors: Turn back on the outputs killRotors() turned
+// off, at the duties last set.
+void
+armRotors (void);
+
+// *******************************************************
+// getRotorsKilled: Returns true from killRotors() until
+// armRotors().
+bool
+getRotorsKilled (void);
+
+#endif /*ROTORPWM_H_*/
@@ -0,0 +1,142 @@
+// *******************************************************
+//
+// spscBuf.c
+//
+// Lock-free single-producer/single-consumer circular buffer
+// of uint32_t values. See spscBuf.h.
+//
+// Group 1
+// Created on: 17/10/2026
+//
+// *******************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "spscBuf.h"
+
+// *******************************************************
+// initSpscBuf: Initialise the buffer over size entries of
+// storage. Returns false (and leaves the buffer unusable) if
+// size is not a power of two.
+bool
+initSpscBuf (spscBuf_t *buffer, volatile uint32_t *storage, uint32_t size)
+{
+	uint32_t i;
+
+	buffer->windex = 0;
+	buffer->rindex = 0;
+	buffer->sum = 0;
+	buffer->overruns = 0;
+	buffer->mask = 0;
+	buffer->data = storage;
+
+	if (size == 0 || (size & (size - 1)) != 0)
+		return false;
+
+	for (i = 0; i < size; i++)
+		storage[i] = 0;  // The running sum relies on unwritten slots being 0
+	buffer->mask = size - 1;
+	return true;
+}
+
+// *******************************************************
+// writeSpscBuf: Producer side. The entry and the sum must be
+// in memory before the new windex is, or the consumer could
+// read a stale slot or sum. The sum swaps the oldest entry
+// for the new one, which stays exact through uint32_t wrap.
+void
+writeSpscBuf (spscBuf_t *buffer, uint32_t entry)
+{
+	uint32_t windex = buffer->windex;
+	uint32_t slot = windex & buffer->mask;
+
+	buffer->sum = buffer->sum - buffer->data[slot] + entry;
+	buffer->data[slot] = entry;
+	SPSC_BARRIER();
+	buffer->windex = windex + 1;
+}
+
+// *******************************************************
+// readSpscBuf: Consumer side. Copy the oldest unread entry
+// to *entry and advance rindex. If the producer has lapped
+// the reader, the overwritten entries are skipped and
+// counted in overruns.
+bool
+readSpscBuf (spscBuf_t *buffer, uint32_t *entry)
+{
+	uint32_t rindex = buffer->rindex;
+	uint32_t windex;
+	uint32_t size = buffer->mask + 1;
+
+	do {
+		windex = buffer->windex;
+		if (windex == rindex)
+			return false;
+
+		if (windex - rindex > size) {
+			buffer->overruns += windex - rindex - size;
+			rindex = windex - size;
+		}
+
+		SPSC_BARRIER();  // Read windex before the slot it covers
+		*entry = buffer->data[rindex & buffer->mask];
+		SPSC_BARRIER();
+
+		// Retry if the producer overwrote the slot while it was read
+	} while (buffer->windex - rindex > size);
+
+	buffer->rindex = rindex + 1;
+	return true;
+}
+
+// *******************************************************
+// snapshotSpscBuf: Consumer side. Copy the count most recent
+// entries, oldest first, into dest without consuming them.
+// The copy is retried if the producer wrote over any of the
+// copied slots before it finished.
+uint32_t
+snapshotSpscBuf (spscBuf_t *buffer, uint32_t *dest, uint32_t count)
+{
+	uint32_t size = buffer->mask + 1;
+	uint32_t start, end, i;
+
+	if (count > size)
+		count = size;
+
+	do {
+		end = buffer->windex;
+		if (count > end)
+			count = end;  // Fewer entries written than requested
+		start = end - count;
+
+		SPSC_BARRIER();
+		for (i = 0; i < count; i++)
+			dest[i] = buffer->data[(start + i) & buffer->mask];
+		SPSC_BARRIER();
+
+		// Slot start was safe until the producer reached start + size
+	} while (buffer->windex - start > size);
+
+	return count;
+}
+
+// *******************************************************
+// sumSpscBuf: Consumer side. The sum is read between two reads
+// of windex; if the producer ran in between, the pair is
+// inconsistent and is read again.
+uint32_t
+sumSpscBuf (spscBuf_t *buffer, uint32_t *count)
+{
+	uint32_t size = buffer->mask + 1;
+	uint32_t windex, sum;
+
+	do {
+		windex = buffer->windex;
+		SPSC_BARRIER();
+		sum = buffer->sum;
+		SPSC_BARRIER();
+	} while (buffer->windex != windex);
+
+	*count = (windex < size) ? windex : size;
+	return sum;
+}
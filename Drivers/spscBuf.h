@@ -0,0 +1,99 @@
+#ifndef SPSCBUF_H_
+#define SPSCBUF_H_
+
+// *******************************************************
+//
+// spscBuf.h
+//
+// Lock-free single-producer/single-consumer circular buffer
+// of uint32_t values, for passing samples from one ISR to one
+// task without disabling interrupts.
+//
+// The producer (e.g. ADCIntHandler) only writes windex and the
+// consumer only writes rindex. Both indices run freely and are
+// masked into the buffer, so the size must be a power of two
+// and there is no modulo or wrap branch on either side.
+//
+// The producer never blocks: once the buffer is full it
+// overwrites the oldest entry. readSpscBuf() skips entries
+// that were overwritten before they could be read, and
+// snapshotSpscBuf() retries if the producer laps it while
+// copying.
+//
+// The producer also keeps a running sum of the entries held,
+// so sumSpscBuf() gives the window mean in constant time
+// whatever the buffer size.
+//
+// Storage is supplied by the caller (normally a static array)
+// rather than allocated.
+//
+// Group 1
+// Created on: 17/10/2026
+//
+// *******************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+// *******************************************************
+// Memory barrier between the data and index accesses. The
+// Cortex-M4 is single core, so this only has to stop the
+// compiler and the write buffer reordering them. On the host
+// an acquire/release fence is enough (no store-load ordering
+// is needed), and costs nothing on x86.
+#if defined(__TI_ARM__)
+#define SPSC_BARRIER()  __asm(" dmb")
+#elif defined(__GNUC__) && defined(__arm__)
+#define SPSC_BARRIER()  __asm volatile ("dmb" ::: "memory")
+#else
+#define SPSC_BARRIER()  __atomic_thread_fence(__ATOMIC_ACQ_REL)
+#endif
+
+// *******************************************************
+// Buffer structure
+typedef struct {
+	uint32_t mask;				// Number of entries in buffer - 1
+	volatile uint32_t windex;	// Entries written, only changed by the producer
+	volatile uint32_t rindex;	// Entries read, only changed by the consumer
+	volatile uint32_t sum;		// Sum of the entries held, only changed by the producer
+	uint32_t overruns;			// Entries lost before readSpscBuf() reached them
+	volatile uint32_t *data;	// Caller supplied storage
+} spscBuf_t;
+
+// *******************************************************
+// initSpscBuf: Initialise the buffer over size entries of
+// storage. Returns false (and leaves the buffer unusable) if
+// size is not a power of two. Must be called before the
+// producer is started.
+bool
+initSpscBuf (spscBuf_t *buffer, volatile uint32_t *storage, uint32_t size);
+
+// *******************************************************
+// writeSpscBuf: Producer side. Insert entry at windex, update
+// the running sum and publish both by advancing windex.
+void
+writeSpscBuf (spscBuf_t *buffer, uint32_t entry);
+
+// *******************************************************
+// readSpscBuf: Consumer side. Copy the oldest unread entry
+// to *entry and advance rindex. Returns false if there is
+// nothing new to read.
+bool
+readSpscBuf (spscBuf_t *buffer, uint32_t *entry);
+
+// *******************************************************
+// snapshotSpscBuf: Consumer side. Copy the count most recent
+// entries, oldest first, into dest without consuming them.
+// Returns the number copied, which is less than count until
+// the producer has written that many entries.
+uint32_t
+snapshotSpscBuf (spscBuf_t *buffer, uint32_t *dest, uint32_t count);
+
+// *******************************************************
+// sumSpscBuf: Consumer side. Return the sum of the most recent
+// entries held, which is all size entries once the buffer has
+// filled, and set *count to how many that is. Costs the same
+// at any buffer size. Does not consume any entries.
+uint32_t
+sumSpscBuf (spscBuf_t *buffer, uint32_t *count);
+
+#endif /*SPSCBUF_H_*/
@@ -27,6 +27,8 @@
 
 #define configUSE_TICK_HOOK 0
 
+#define configCHECK_FOR_STACK_OVERFLOW 2 // Checks the end of the stack on every switch out, calls vApplicationStackOverflowHook() (main.c)
+
 #define INCLUDE_vTaskPrioritySet 0
 
 #define INCLUDE_uxTaskPriorityGet 0
@@ -35,7 +37,7 @@
 
 #define INCLUDE_vTaskSuspend 1
 
-#define INCLUDE_vTaskDelayUntil 0
+#define INCLUDE_vTaskDelayUntil 1
 
 #define INCLUDE_vTaskDelay 1
 
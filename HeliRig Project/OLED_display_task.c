@@ -54,13 +54,15 @@ OLEDDisplayTask (void *pvParameters)
     {
         if (xQueueReceive(Queue, (void *)&OLEDMessage, portMAX_DELAY) == pdTRUE) { // Check if something is available on the queue
 
-            IntMasterDisable();  // Disable all interrupts to protect OLEDStringDraw();
+            // Hold off the tasks and the interrupts that use FreeRTOS to protect OLEDStringDraw(),
+            // but not the control interrupt (CONTROL_IN_ISR), which is above them and never draws
+            taskENTER_CRITICAL();
 
             if (OLEDMessage.charLine != 0) {
                 OLEDStringDraw (OLEDMessage.strBuf, OLEDMessage.charPos, OLEDMessage.charLine); // Draw to OLED display
             }
 
-            IntMasterEnable();  // Re-enable interrupts
+            taskEXIT_CRITICAL();
         }
     }
 }
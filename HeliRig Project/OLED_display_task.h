@@ -19,7 +19,9 @@
  *******************************************************/
 
 
+#ifndef TASK_STACK_DEPTH  // The host simulation needs larger stacks (Simulation/FreeRTOSConfig.h)
 #define TASK_STACK_DEPTH    32
+#endif
 #define TASK_PRIORITY       4
 
 #define OLED_QUEUE_LENGTH 5
@@ -1,99 +1,271 @@
 /*******************************************************
- * PI_controller.h
+ * PI_controller.c
  *
- * Produces PI feedback control based on the present value (pv) and set point (sp)
+ * Produces PID feedback control based on the present value (pv) and set point (sp)
  *
  *  Created on: 12/08/2021
  *      Author: Group 1
  *******************************************************/
 
-#include <stdio.h>
-#include <math.h>
-
-#include "FreeRTOS.h"
-#include "task.h"
-#include "queue.h"
-#include "semphr.h"
+#include <stdint.h>
+#include <stdbool.h>
 
+#include "heli_math.h"
 #include "PI_controller.h"
 
 
 /*******************************************************
- * Function: pid_calc
+ * Function: clampPID
+ *
+ * returns: value restricted to the controller's min/max
+ *******************************************************/
+static num_t
+clampPID (const PIDController *pid, num_t value)
+{
+    if (value > pid->max)
+    {
+        return pid->max;
+    }
+    if (value < pid->min)
+    {
+        return pid->min;
+    }
+    return value;
+}
+
+
+/*******************************************************
+ * Function: updateWindupGain
+ *
+ * Works out the back calculation gain for the present
+ * gains, dt / (ki * tt), once rather than every step
+ *******************************************************/
+static void
+updateWindupGain (PIDController *pid)
+{
+    num_t tt = pid->tt;
+
+    if (tt == 0 && pid->ki != 0)
+    {
+        tt = numDiv(pid->kp, pid->ki);  // Integral time
+    }
+    pid->aw = (pid->ki != 0 && tt != 0) ? numDiv(pid->dt, numMul(pid->ki, tt)) : 0;
+}
+
+
+/*******************************************************
+ * Function: stepPID
  *
- * Creates the feedback term by calculating proportional and integral error
+ * Creates the feedback term by calculating proportional, integral and derivative error
+ * Call once every dt
  *
- * set point: the desired position
+ * pid: the controller
+ * setpoint: the desired position
  * pv: the present value being measured
  *
- * returns: combined proportional and integral feedback value
+ * returns: combined feedback value, clamped to min and max
  *******************************************************/
-double
-pid_calc (double setpoint, double pv)
+num_t
+stepPID (PIDController *pid, num_t setpoint, num_t pv)
 {
-  double error = setpoint - pv;  // Calculate error
+  num_t error = setpoint - pv;  // Calculate error
 
-  double Pout = PID_var.kp * error;  // Proportional term
+  num_t Pout = numMul(pid->kp, error);  // Proportional term
 
-  PID_var.integral += error * PID_var.dt;
-  double Iout = PID_var.ki * PID_var.integral;  // Integral term
+  // Derivative term, on the measurement so a set point step does not kick the output
+  num_t Dout = 0;
+  if (pid->primed)
+    {
+      Dout = numMul(pid->kd_dt, pid->pre_pv - pv);
+    }
+  pid->pre_pv = pv;  // Save present value for the next derivative
+  pid->primed = true;
+  pid->pre_error = error;
+
+  if (pid->manual)
+    {
+      // Track the manual output, so the controller takes over from it without a bump
+      if (pid->ki != 0)
+        {
+          pid->integral = numDiv(pid->output - Pout - Dout - pid->ff, pid->ki);
+        }
+      return pid->output;
+    }
 
+  num_t pre_integral = pid->integral;
+  pid->integral += numMul(error, pid->dt);
+  num_t Iout = numMul(pid->ki, pid->integral);  // Integral term
 
-  double output = Pout + Iout;  // Calculate total output
+  num_t output = Pout + Iout + Dout + pid->ff;  // Calculate total output
 
   /*************************
    * Restrict to max/min
    *    Clamping output to min or max so output does not saturate
    *************************/
-  if (output > PID_var.max)
+  num_t clamped = clampPID(pid, output);
+
+  /*************************
+   * Anti-windup
+   *    Stop the integral growing while the output is clamped
+   *************************/
+  if (clamped != output)
     {
-      output = PID_var.max;
+      if (pid->windup == PID_WINDUP_CONDITIONAL)
+        {
+          if ((output > pid->max && error > 0) || (output < pid->min && error < 0))
+            {
+              pid->integral = pre_integral;  // Integrating would only push it further out
+            }
+        }
+      else if (pid->windup == PID_WINDUP_BACK_CALC)
+        {
+          pid->integral += numMul(pid->aw, clamped - output);
+        }
     }
-  else if (output < PID_var.min)
+
+  pid->output = clamped;
+
+  return clamped;
+}
+
+
+/*******************************************************
+ * Function: setPIDWindup
+ *
+ * Selects the anti-windup strategy
+ *
+ * pid: the controller
+ * windup: PID_WINDUP_ strategy
+ * tt: tracking time for PID_WINDUP_BACK_CALC, 0 for the
+ *     integral time kp / ki
+ *******************************************************/
+void
+setPIDWindup (PIDController *pid, uint8_t windup, num_t tt)
+{
+    pid->windup = windup;
+    pid->tt = tt;
+    updateWindupGain(pid);
+}
+
+
+/*******************************************************
+ * Function: setPIDGains
+ *
+ * Changes the gains between steps without a bump
+ *
+ * pid: the controller
+ * kp: proportional gain
+ * ki: integral gain
+ * kd: derivative gain
+ *******************************************************/
+void
+setPIDGains (PIDController *pid, num_t kp, num_t ki, num_t kd)
+{
+    // Keep kp * e + ki * integral as it was at the last error
+    if (ki != 0)
     {
-      output = PID_var.min;
+        pid->integral = numDiv(numMul(pid->ki, pid->integral) + numMul(pid->kp - kp, pid->pre_error), ki);
     }
 
-  PID_var.pre_error = error;  // Save error to previous error
+    pid->kp = kp;
+    pid->ki = ki;
+    pid->kd = kd;
+    pid->kd_dt = numDiv(kd, pid->dt);
+    updateWindupGain(pid);
+}
+
+
+/*******************************************************
+ * Function: setPIDFeedForward
+ *
+ * Sets a term added to the output before it is clamped
+ *
+ * pid: the controller
+ * ff: feed-forward, in the units of the output
+ *******************************************************/
+void
+setPIDFeedForward (PIDController *pid, num_t ff)
+{
+    pid->ff = ff;
+}
+
 
-  return output;
+/*******************************************************
+ * Function: setPIDManual
+ *
+ * Holds the output at a value set by the caller
+ *
+ * pid: the controller
+ * output: output to hold, clamped to min and max
+ *******************************************************/
+void
+setPIDManual (PIDController *pid, num_t output)
+{
+    pid->output = clampPID(pid, output);
+    pid->manual = true;
 }
 
 
 /*******************************************************
- * Function: PIDinit
+ * Function: setPIDAuto
  *
- * Creates the FreeRTOS task PID_CALCULATE
+ * Hands the output back to the controller
  *
+ * pid: the controller
+ *******************************************************/
+void
+setPIDAuto (PIDController *pid)
+{
+    pid->manual = false;
+}
+
+
+/*******************************************************
+ * Function: resetPID
+ *
+ * Clears the integral and derivative history, keeping
+ * the gains, limits and mode
+ *
+ * pid: the controller
+ *******************************************************/
+void
+resetPID (PIDController *pid)
+{
+    pid->integral = 0;
+    pid->pre_pv = 0;
+    pid->pre_error = 0;
+    pid->primed = false;
+}
+
+
+/*******************************************************
+ * Function: initPID
+ *
+ * Sets the gains and limits of a controller and resets it
+ *
+ * pid: the controller
  * dt: time step
  * max: maximum feedback value
  * min: minimum feedback value
  * kp: proportional gain
  * ki: integral gain
- *
- * returns: 0 on successful creation of PID_CALCULATE
- *          1 on failed attempt
+ * kd: derivative gain, 0 for a PI controller
  *******************************************************/
-uint32_t
-PIDinit (double dt, double max, double min, double kp, double ki)
+void
+initPID (PIDController *pid, num_t dt, num_t max, num_t min, num_t kp, num_t ki, num_t kd)
 {
-
     //Initialise values in struct
-    PID_var.kp = kp;
-    PID_var.ki = ki;
-    PID_var.dt = dt;
-    PID_var.max = max;
-    PID_var.min = min;
-    PID_var.pre_error = 0;
-    PID_var.integral = 0;
-
-    //Create PID task
-    if(xTaskCreate(pid_calc, "PID_CALCULATE", PIDSTACK, NULL, 1, NULL) != pdTRUE)
-    {
-        return(1);  // Fail (Must not have had enough memory to create the task)
-    }
+    pid->kp = kp;
+    pid->ki = ki;
+    pid->kd = kd;
+    pid->kd_dt = numDiv(kd, dt);
+    pid->dt = dt;
+    pid->max = max;
+    pid->min = min;
+    pid->output = 0;
+    pid->ff = 0;
+    pid->manual = false;
 
-    return(0);  // Success
+    setPIDWindup(pid, PID_WINDUP_DEFAULT, 0);
+    resetPID(pid);
 }
-
-
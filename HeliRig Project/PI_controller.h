@@ -4,66 +4,205 @@
 /*******************************************************
  * PI_controller.h
  *
- * Produces PI feedback control based on the present value (pv) and set point (sp)
+ * Produces PID feedback control based on the present value (pv) and set point (sp)
+ *
+ * Every loop (height, yaw) keeps its own PIDController and
+ * steps it from its own task, so the functions hold no
+ * state of their own and any number of controllers run
+ * independently. A controller is only ever used by one
+ * task, so needs no locking.
+ *
+ * The derivative is taken on the measurement rather than
+ * the error, so a set point step does not kick the output.
+ *
+ * While the output is clamped the integral is kept from
+ * winding up (PID_WINDUP_), so it does not have to unwind
+ * through a long overshoot at take off or after a large
+ * set point jump. Gain changes (setPIDGains) and handing
+ * the output over to and back from manual (setPIDManual,
+ * setPIDAuto) rebase the integral so the output does not
+ * jump.
+ *
+ * A feed-forward (setPIDFeedForward), e.g. the duty a set
+ * point profile's rate and acceleration need, is added in
+ * before the clamp, so the integral only has to make up
+ * what the model gets wrong, and anti-windup still sees
+ * the whole output.
  *
  *  Created on: 12/08/2021
  *      Author: Group 1
  *******************************************************/
 
+#include <stdbool.h>
+
+#include "heli_math.h"
+
 
 /*******************************************************
  * Constants
  *******************************************************/
-#define PIDSTACK 64
+// Anti-windup strategies
+#define PID_WINDUP_NONE         0  // Integrates through saturation
+#define PID_WINDUP_CONDITIONAL  1  // Holds the integral while clamped, if the error would push the output further out
+#define PID_WINDUP_BACK_CALC    2  // Feeds the output clamped off back into the integral, over the tracking time
+
+#ifndef PID_WINDUP_DEFAULT
+#define PID_WINDUP_DEFAULT      PID_WINDUP_BACK_CALC  // Set by initPID()
+#endif
 
-struct PID_Struct
+#if PID_WINDUP_DEFAULT != PID_WINDUP_NONE && PID_WINDUP_DEFAULT != PID_WINDUP_CONDITIONAL \
+    && PID_WINDUP_DEFAULT != PID_WINDUP_BACK_CALC
+#error "PID_WINDUP_DEFAULT must be one of the PID_WINDUP_ strategies"
+#endif
+
+
+// Terms are num_t (heli_math.h), float or Q16.16 fixed point
+typedef struct PID_Struct
 {
     //Gain Values
-    double kp;
-    double ki;
+    num_t kp;
+    num_t ki;
+    num_t kd;
+    num_t kd_dt;  // kd / dt, worked out once by initPID() (a fixed point divide is a library call)
 
     //Set values
-    double dt;
-    double max;
-    double min;
+    num_t dt;  // Time step, the period stepPID() is called at
+    num_t max;
+    num_t min;
+
+    //Anti-windup
+    uint8_t windup;  // PID_WINDUP_ strategy
+    num_t tt;  // Back calculation tracking time, 0 for the integral time kp / ki
+    num_t aw;  // Integral correction per unit of output clamped off, dt / (ki * tt)
+
+    //Feed-forward
+    num_t ff;  // Added to the output before it is clamped, set by setPIDFeedForward()
 
     //Variables
-    double pre_error;
-    double integral;
+    num_t integral;  // Sum of error * dt
+    num_t pre_pv;  // Present value at the last step, for the derivative
+    num_t pre_error;  // Error at the last step, for rebasing the integral on a gain change
+    num_t output;  // Last output, or the manual output
+    bool primed;  // pre_pv is valid
+    bool manual;  // Output set by setPIDManual(), the integral tracks it
+} PIDController;
 
-} PID_var;
+
+/*******************************************************
+ * Function: initPID
+ *
+ * Sets the gains and limits of a controller and resets it
+ *
+ * pid: the controller
+ * dt: time step
+ * max: maximum feedback value
+ * min: minimum feedback value
+ * kp: proportional gain
+ * ki: integral gain
+ * kd: derivative gain, 0 for a PI controller
+ *******************************************************/
+void
+initPID(PIDController *pid, num_t dt, num_t max, num_t min, num_t kp, num_t ki, num_t kd);
 
 
 /*******************************************************
- * Function: pid_calc
+ * Function: stepPID
  *
- * Creates the feedback term by calculating proportional and integral error
+ * Creates the feedback term by calculating proportional, integral and derivative error
+ * Call once every dt
  *
- * set point: the desired position
+ * pid: the controller
+ * setpoint: the desired position
  * pv: the present value being measured
  *
- * returns: combined proportional and integral feedback value
+ * returns: combined feedback value, clamped to min and max
  *******************************************************/
-extern double
-calculate(double setpoint, double pv);
+num_t
+stepPID(PIDController *pid, num_t setpoint, num_t pv);
 
 
 /*******************************************************
- * Function: PIDinit
+ * Function: setPIDWindup
  *
- * Creates the FreeRTOS task PID_CALCULATE
+ * Selects the anti-windup strategy, initPID() sets
+ * PID_WINDUP_DEFAULT with the integral time
  *
- * dt: time step
- * max: maximum feedback value
- * min: minimum feedback value
+ * pid: the controller
+ * windup: PID_WINDUP_ strategy
+ * tt: tracking time for PID_WINDUP_BACK_CALC, 0 for the
+ *     integral time kp / ki. Shorter unwinds harder.
+ *******************************************************/
+void
+setPIDWindup(PIDController *pid, uint8_t windup, num_t tt);
+
+
+/*******************************************************
+ * Function: setPIDGains
+ *
+ * Changes the gains between steps without a bump: the
+ * integral is rebased so the proportional and integral
+ * terms still add up to the same at the last error
+ *
+ * pid: the controller
  * kp: proportional gain
  * ki: integral gain
+ * kd: derivative gain
+ *******************************************************/
+void
+setPIDGains(PIDController *pid, num_t kp, num_t ki, num_t kd);
+
+
+/*******************************************************
+ * Function: setPIDFeedForward
+ *
+ * Sets a term added to the output from the next step on,
+ * before it is clamped. It stays until changed, initPID()
+ * sets 0.
+ *
+ * pid: the controller
+ * ff: feed-forward, in the units of the output
+ *******************************************************/
+void
+setPIDFeedForward(PIDController *pid, num_t ff);
+
+
+/*******************************************************
+ * Function: setPIDManual
+ *
+ * Holds the output at a value set by the caller (e.g.
+ * while finding the yaw reference, or landing). stepPID()
+ * returns it, and keeps the integral tracking it so that
+ * setPIDAuto() carries on from it without a bump.
+ *
+ * pid: the controller
+ * output: output to hold, clamped to min and max
+ *******************************************************/
+void
+setPIDManual(PIDController *pid, num_t output);
+
+
+/*******************************************************
+ * Function: setPIDAuto
+ *
+ * Hands the output back to the controller
+ *
+ * pid: the controller
+ *******************************************************/
+void
+setPIDAuto(PIDController *pid);
+
+
+/*******************************************************
+ * Function: resetPID
+ *
+ * Clears the integral and derivative history, keeping
+ * the gains, limits and mode, e.g. on landing or after
+ * the loop has been open
  *
- * returns: 0 on successful creation of PID_CALCULATE
- *          1 on failed attempt
+ * pid: the controller
  *******************************************************/
-extern void
-PIDinit(double dt, double max, double min, double kp, double ki);
+void
+resetPID(PIDController *pid);
 
 
 #endif /* _PID_H_ */
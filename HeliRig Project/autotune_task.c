@@ -0,0 +1,136 @@
+/*******************************************************
+ * autotune_task.c
+ *
+ * A FreeRTOS task that tunes the height and yaw loops
+ * once, streaming the identification data over the UART
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "buttons4.h"
+#include "heli_math.h"
+#include "relay_tune.h"
+#include "control_task.h"
+#include "autotune_task.h"
+
+
+/*******************************************************
+ * Function: tuneLoop
+ *
+ * Tunes one loop, streaming its set point, measurement
+ * and duty while the relay drives it, then the result
+ *
+ * axis: CONTROL_TUNE_HEIGHT or CONTROL_TUNE_YAW
+ * name: the loop, for the streamed lines
+ *******************************************************/
+static void
+tuneLoop (uint8_t axis, const char *name)
+{
+    TickType_t lastWake;
+    ControlOutput output;
+    ControlTune tune;
+    uint8_t runs;
+    uint32_t lastCycle = 0;
+    bool streamed = false;  // lastCycle is valid
+
+    getControlTune(&tune);
+    runs = tune.runs;
+    startControlTune(axis);
+
+    lastWake = xTaskGetTickCount();
+    do
+    {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(AUTOTUNE_STREAM_MS));
+        getControlOutput(&output);
+        getControlTune(&tune);
+
+        // Each cycle once, only while the relay drives the loop
+        if (output.tuning == axis && (!streamed || output.cycle != lastCycle))
+        {
+            if (axis == CONTROL_TUNE_HEIGHT)
+            {
+                printRelayTuneSample(name, output.cycle, output.heightSetpoint, output.height, output.mainDuty);
+            }
+            else
+            {
+                printRelayTuneSample(name, output.cycle, output.yawSetpoint, output.yaw, output.tailDuty);
+            }
+            lastCycle = output.cycle;
+            streamed = true;
+        }
+    } while (tune.runs == runs || tune.result.state == RELAY_TUNE_RUNNING);  // Until the loop has taken our tune up, and finished it
+
+    printRelayTuneResult(name, &tune.result);
+}
+
+
+/*******************************************************
+ * Function: autotuneTask
+ *
+ * Arms the rotors on a press of AUTOTUNE_ARM_BUTTON,
+ * hovers, then tunes the height and then the yaw loop,
+ * streaming each over the UART. Deletes itself when done.
+ *
+ * pvParameters: NULL
+ *******************************************************/
+void
+autotuneTask (void *pvParameters)
+{
+    ControlOutput output;
+
+    (void) pvParameters;
+
+    // Nothing turns until the operator arms it
+    do
+    {
+        vTaskDelay(pdMS_TO_TICKS(AUTOTUNE_STREAM_MS));
+        updateButtons();
+    } while (checkButton(AUTOTUNE_ARM_BUTTON) != PUSHED);
+    armControl(true);
+
+    // Both loops must be running, the height calibrated and the yaw reference found
+    do
+    {
+        vTaskDelay(pdMS_TO_TICKS(AUTOTUNE_STREAM_MS));
+        getControlOutput(&output);
+    } while (!output.heightAuto || !output.yawAuto);
+
+    setControlTarget(AUTOTUNE_HEIGHT, output.yawTarget);
+    vTaskDelay(pdMS_TO_TICKS(AUTOTUNE_SETTLE_MS));
+    tuneLoop(CONTROL_TUNE_HEIGHT, "height");
+
+    vTaskDelay(pdMS_TO_TICKS(AUTOTUNE_SETTLE_MS));
+    tuneLoop(CONTROL_TUNE_YAW, "yaw");
+
+    vTaskDelete(NULL);
+}
+
+
+/*******************************************************
+ * Function: initAutotuneTask
+ *
+ * Initialises the buttons and creates the FreeRTOS task
+ * autotuneTask
+ *
+ * returns: 0 on successful creation of autotuneTask
+ *          1 on failed attempt
+ *******************************************************/
+uint8_t
+initAutotuneTask (void)
+{
+    initButtons();
+
+    if (pdTRUE != xTaskCreate(autotuneTask, "Autotune", AUTOTUNE_STACK_DEPTH, NULL, AUTOTUNE_TASK_PRIORITY, NULL))
+    {
+        return(1);  // Fail (Must not have had enough memory to create the task)
+    }
+    return(0);  // Success
+}
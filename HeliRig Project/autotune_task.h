@@ -0,0 +1,77 @@
+#ifndef __AUTOTUNE_TASK_H__
+#define __AUTOTUNE_TASK_H__
+
+/*******************************************************
+ * autotune_task.c
+ *
+ * A FreeRTOS task that tunes the height and yaw loops
+ * once, after take off: once AUTOTUNE_ARM_BUTTON is
+ * pressed it arms the rotors (armControl()), then it
+ * hovers the rig at
+ * AUTOTUNE_HEIGHT, then hands each loop in turn to a relay
+ * experiment (startControlTune(), relay_tune.h). Both
+ * loops keep the gains found.
+ *
+ * While a loop is tuning, its set point, measurement and
+ * duty are streamed over the UART console every
+ * AUTOTUNE_STREAM_MS, then the Ku, Tu and gains found
+ * (printRelayTuneSample(), printRelayTuneResult()), for
+ * logging on the PC.
+ *
+ * It is the only task that uses UARTprintf(), and runs
+ * below the others, so the streaming only takes spare
+ * time. The loops do not wait for it.
+ *
+ * Built in with CONTROL_AUTOTUNE=1, initUART() must have
+ * been called.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#ifndef CONTROL_AUTOTUNE
+#define CONTROL_AUTOTUNE        0  // 1: tune both loops after take off, streaming over the UART
+#endif
+
+#ifndef AUTOTUNE_STACK_DEPTH  // UARTprintf() needs more than TASK_STACK_DEPTH
+#define AUTOTUNE_STACK_DEPTH    128
+#endif
+#define AUTOTUNE_TASK_PRIORITY  1  // Below the other tasks, it only streams
+
+#define AUTOTUNE_HEIGHT         50  // % height the loops are tuned at
+#define AUTOTUNE_SETTLE_MS      5000  // Hovered for before each tune, the settling requirement
+#define AUTOTUNE_STREAM_MS      10  // Samples streamed every 10 ms (100 Hz), and the buttons polled until armed
+#define AUTOTUNE_ARM_BUTTON     UP  // buttons4.h, pressed to arm the rotors, nothing turns until then
+
+
+/*******************************************************
+ * Function: autotuneTask
+ *
+ * Arms the rotors on a press of AUTOTUNE_ARM_BUTTON,
+ * hovers, then tunes the height and then the yaw loop,
+ * streaming each over the UART. Deletes itself when done.
+ *
+ * pvParameters: NULL
+ *******************************************************/
+void
+autotuneTask (void *pvParameters);
+
+
+/*******************************************************
+ * Function: initAutotuneTask
+ *
+ * Initialises the buttons and creates the FreeRTOS task
+ * autotuneTask
+ *
+ * returns: 0 on successful creation of autotuneTask
+ *          1 on failed attempt
+ *******************************************************/
+uint8_t
+initAutotuneTask (void);
+
+
+#endif /* __AUTOTUNE_TASK_H__ */
@@ -0,0 +1,729 @@
+/*******************************************************
+ * control_task.c
+ *
+ * A FreeRTOS task (or with CONTROL_IN_ISR, a timer
+ * interrupt) that runs the height and yaw PID loops at a
+ * fixed rate (CONTROL_RATE_HZ), timing each release
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_ints.h"
+
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/interrupt.h"
+
+#include "dblBuf.h"
+#include "rotorPWM.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "heli_math.h"
+#include "PI_controller.h"
+#include "trajectory.h"
+#include "relay_tune.h"
+#include "gain_schedule.h"
+#include "get_height_task.h"
+#include "get_yaw_task.h"
+#include "control_task.h"
+
+
+// Set points, handed to the loop through g_targetBuf
+typedef struct Control_Target
+{
+    int32_t height;
+    int32_t yaw;
+} ControlTarget;
+
+// Everything the loop publishes each cycle through g_telemetryBuf
+typedef struct Control_Telemetry
+{
+    ControlOutput output;
+    ControlStats stats;  // Times in release timer counts, getControlStats() converts them
+    ControlTune tune;
+} ControlTelemetry;
+
+// Gain schedules, at CONTROL_HEIGHT_SCHED_ and CONTROL_YAW_SCHED_ spacing
+static const GainPoint g_heightGains[] = {
+    { CONTROL_HEIGHT_KP, CONTROL_HEIGHT_KI },  // 0%
+    { CONTROL_HEIGHT_KP, CONTROL_HEIGHT_KI },  // 25%
+    { CONTROL_HEIGHT_KP, CONTROL_HEIGHT_KI },  // 50%
+    { CONTROL_HEIGHT_KP, CONTROL_HEIGHT_KI },  // 75%
+    { CONTROL_HEIGHT_KP, CONTROL_HEIGHT_KI },  // 100%
+};
+static const GainPoint g_yawGains[] = {
+    { CONTROL_YAW_KP, CONTROL_YAW_KI },  // 0.2 main duty
+    { CONTROL_YAW_KP, CONTROL_YAW_KI },  // 0.35
+    { CONTROL_YAW_KP, CONTROL_YAW_KI },  // 0.5
+    { CONTROL_YAW_KP, CONTROL_YAW_KI },  // 0.65
+    { CONTROL_YAW_KP, CONTROL_YAW_KI },  // 0.8
+};
+
+
+// Only used by the loop (controlTask, or controlIntHandler)
+static PIDController g_heightPID;
+static PIDController g_yawPID;
+static Trajectory g_heightProfile;
+static Trajectory g_yawProfile;
+static GainSchedule g_heightSchedule;
+static GainSchedule g_yawSchedule;
+static num_t g_mainThrust;  // Estimate of the main rotor's thrust, the main duty through its motor lag
+static YawPosition g_position;
+static YawVelocity g_velocity;
+static RelayTune g_tune;
+static uint8_t g_tuneAxis;  // CONTROL_TUNE_ loop g_tune is driving
+static ControlTelemetry g_telemetry;  // Built up each cycle, then published
+static uint32_t g_cyclesRun;  // Since start up, resetControlStats() does not clear it
+static uint32_t g_findCycles;  // Cycles armed without the yaw reference, up to the find timeout
+static uint32_t g_periodCounts;  // Release timer counts in one period
+static uint32_t g_countsPerUs;
+
+// Exchanged between the loop and the tasks, neither side waits for the other
+static dblBuf_t g_targetBuf;  // Written by setControlTarget(), read by the loop
+static ControlTarget g_targetCopies[2];
+static dblBuf_t g_telemetryBuf;  // Written by the loop, read by getControlOutput() and getControlStats()
+static ControlTelemetry g_telemetryCopies[2];
+static volatile bool g_statsReset;  // Set by resetControlStats(), cleared by the loop once it has
+static volatile uint8_t g_tuneRequest;  // Set by startControlTune(), cleared by the loop once it has started it
+static volatile uint8_t g_armRequest;  // Set by armControl(), cleared by the loop once it has armed or killed the rotors
+
+
+/*******************************************************
+ * Function: initControlTimer
+ *
+ * Initialises the timer the releases are timestamped on
+ * With CONTROL_IN_ISR, starts it releasing
+ * controlIntHandler every period
+ *******************************************************/
+void
+initControlTimer (void)
+{
+    SysCtlPeripheralEnable(CONTROL_TIMER_PERIPH);
+    while (!SysCtlPeripheralReady(CONTROL_TIMER_PERIPH));
+    TimerConfigure(CONTROL_TIMER_BASE, TIMER_CFG_PERIODIC);
+
+    // The tick is from the same clock, so a period is a whole number of counts
+    g_periodCounts = SysCtlClockGet() / CONTROL_RATE_HZ;
+    g_countsPerUs = SysCtlClockGet() / 1000000;
+
+#if CONTROL_IN_ISR
+    // Times out every period, which is the release
+    TimerLoadSet(CONTROL_TIMER_BASE, TIMER_A, g_periodCounts - 1);
+    TimerIntRegister(CONTROL_TIMER_BASE, TIMER_A, controlIntHandler);
+    IntPrioritySet(CONTROL_TIMER_INT, CONTROL_INT_PRIORITY);
+    TimerIntEnable(CONTROL_TIMER_BASE, TIMER_TIMA_TIMEOUT);
+#else
+    // Free running, no interrupt
+    TimerLoadSet(CONTROL_TIMER_BASE, TIMER_A, 0xFFFFFFFF);
+#endif
+    TimerEnable(CONTROL_TIMER_BASE, TIMER_A);
+}
+
+
+/*******************************************************
+ * Function: countsToNs
+ *
+ * returns: release timer counts in ns
+ *******************************************************/
+static uint64_t
+countsToNs (uint64_t counts)
+{
+    return counts * 1000 / g_countsPerUs;
+}
+
+
+/*******************************************************
+ * Function: setControlTarget
+ *
+ * Sets the set points, taken up at the next release
+ *
+ * height: % height
+ * yaw: degrees from the reference, not wrapped, clamped to
+ *      CONTROL_YAW_LIMIT either way
+ *******************************************************/
+void
+setControlTarget (int32_t height, int32_t yaw)
+{
+    ControlTarget target = { height, yaw };
+
+    if (target.yaw > CONTROL_YAW_LIMIT)
+    {
+        target.yaw = CONTROL_YAW_LIMIT;
+    }
+    else if (target.yaw < -CONTROL_YAW_LIMIT)
+    {
+        target.yaw = -CONTROL_YAW_LIMIT;
+    }
+
+    taskENTER_CRITICAL();  // One writer at a time, this does not hold off the loop in CONTROL_IN_ISR
+    writeDblBuf(&g_targetBuf, &target);
+    taskEXIT_CRITICAL();
+}
+
+
+/*******************************************************
+ * Function: getControlOutput
+ *
+ * Copies out the set points, measurements and duties of
+ * the last cycle
+ *******************************************************/
+void
+getControlOutput (ControlOutput *output)
+{
+    ControlTelemetry telemetry;
+
+    (void) readDblBuf(&g_telemetryBuf, &telemetry);
+    *output = telemetry.output;
+}
+
+
+/*******************************************************
+ * Function: getControlStats
+ *
+ * Copies out the release timing
+ *******************************************************/
+void
+getControlStats (ControlStats *stats)
+{
+    ControlTelemetry telemetry;
+
+    (void) readDblBuf(&g_telemetryBuf, &telemetry);
+    *stats = telemetry.stats;
+    stats->jitterLast = countsToNs(telemetry.stats.jitterLast);
+    stats->jitterMax = countsToNs(telemetry.stats.jitterMax);
+    stats->jitterSum = countsToNs(telemetry.stats.jitterSum);
+    stats->execLast = countsToNs(telemetry.stats.execLast);
+    stats->execMax = countsToNs(telemetry.stats.execMax);
+}
+
+
+/*******************************************************
+ * Function: resetControlStats
+ *
+ * Clears the release timing, at the next cycle
+ *******************************************************/
+void
+resetControlStats (void)
+{
+    g_statsReset = true;
+}
+
+
+/*******************************************************
+ * Function: armControl
+ *
+ * Arms or kills the rotors, at the next cycle
+ *******************************************************/
+void
+armControl (bool armed)
+{
+    g_armRequest = armed ? CONTROL_ARM_ON : CONTROL_ARM_OFF;
+}
+
+
+/*******************************************************
+ * Function: startControlTune
+ *
+ * Hands a loop to a relay experiment, at the next cycle
+ *
+ * axis: CONTROL_TUNE_HEIGHT or CONTROL_TUNE_YAW
+ *******************************************************/
+void
+startControlTune (uint8_t axis)
+{
+    g_tuneRequest = axis;
+}
+
+
+/*******************************************************
+ * Function: getControlTune
+ *
+ * Copies out the last autotune
+ *******************************************************/
+void
+getControlTune (ControlTune *tune)
+{
+    ControlTelemetry telemetry;
+
+    (void) readDblBuf(&g_telemetryBuf, &telemetry);
+    *tune = telemetry.tune;
+}
+
+
+/*******************************************************
+ * Function: startTune
+ *
+ * Starts the relay on a loop, about the point on its
+ * profile and the duty that held it, if it is running
+ * and no other is tuning
+ *
+ * axis: CONTROL_TUNE_ loop
+ *******************************************************/
+static void
+startTune (uint8_t axis, const ControlOutput *output)
+{
+    ControlTune *tune = &g_telemetry.tune;
+    const uint32_t timeout = CONTROL_TUNE_TIMEOUT_S * CONTROL_RATE_HZ;
+
+    tune->axis = axis;
+    tune->runs++;
+    if (g_tuneAxis == CONTROL_TUNE_NONE && axis == CONTROL_TUNE_HEIGHT && output->heightAuto && !output->landed)
+    {
+        initRelayTune(&g_tune, g_heightPID.dt, g_heightProfile.position, g_heightPID.output, CONTROL_HEIGHT_TUNE_STEP,
+                      CONTROL_HEIGHT_TUNE_BAND, CONTROL_DUTY_MAX, CONTROL_DUTY_MIN, timeout);
+    }
+    else if (g_tuneAxis == CONTROL_TUNE_NONE && axis == CONTROL_TUNE_YAW && output->yawAuto && !output->landed)
+    {
+        initRelayTune(&g_tune, g_yawPID.dt, g_yawProfile.position, g_yawPID.output, CONTROL_YAW_TUNE_STEP,
+                      CONTROL_YAW_TUNE_BAND, CONTROL_DUTY_MAX, CONTROL_DUTY_MIN, timeout);
+    }
+    else
+    {
+        tune->result.state = RELAY_TUNE_FAILED;
+        return;
+    }
+    g_tuneAxis = axis;
+    tune->result = g_tune.result;
+}
+
+
+/*******************************************************
+ * Function: scheduleGains
+ *
+ * Looks up a loop's gains, changing them (without a
+ * bump) only if they have
+ *
+ * x: the schedule's variable
+ *******************************************************/
+static void
+scheduleGains (PIDController *pid, const GainSchedule *schedule, num_t x)
+{
+    GainPoint gains;
+
+    lookupGainSchedule(schedule, x, &gains);
+    if (gains.kp != pid->kp || gains.ki != pid->ki)
+    {
+        setPIDGains(pid, gains.kp, gains.ki, 0);
+    }
+}
+
+
+/*******************************************************
+ * Function: stepTune
+ *
+ * Steps the relay in place of a loop's PI, holding its
+ * profile on the set point. The PI tracks the relay, so
+ * it takes back over without a bump once it finishes,
+ * with its schedule fitted to the gains found.
+ *
+ * at: the schedule's variable where the loop was tuned
+ *
+ * returns: the duty
+ *******************************************************/
+static num_t
+stepTune (PIDController *pid, Trajectory *profile, GainSchedule *schedule, num_t at, num_t pv)
+{
+    GainPoint gains;
+
+    num_t duty = stepRelayTune(&g_tune, pv);
+
+    resetTrajectory(profile, g_tune.setpoint);
+    setPIDManual(pid, duty);
+    (void) stepPID(pid, g_tune.setpoint, pv);
+
+    if (g_tune.result.state != RELAY_TUNE_RUNNING)
+    {
+        if (g_tune.result.state == RELAY_TUNE_DONE)
+        {
+            gains.kp = g_tune.result.kp;
+            gains.ki = g_tune.result.ki;
+            fitGainSchedule(schedule, at, &gains);
+            scheduleGains(pid, schedule, at);
+        }
+        setPIDAuto(pid);
+        g_telemetry.tune.result = g_tune.result;
+        g_tuneAxis = CONTROL_TUNE_NONE;
+    }
+    return duty;
+}
+
+
+/*******************************************************
+ * Function: feedForward
+ *
+ * returns: the duty a profile's present rate,
+ *          acceleration and jerk need
+ *******************************************************/
+static num_t
+feedForward (const Trajectory *profile, num_t rateGain, num_t accelGain, num_t jerkGain)
+{
+    return numMul(rateGain, profile->velocity) + numMul(accelGain, profile->accel) + numMul(jerkGain, profile->jerk);
+}
+
+
+/*******************************************************
+ * Function: mainFeedForward
+ *
+ * returns: the tail duty that holds off the main rotor's
+ *          torque, 0 on the ground where it has none
+ *******************************************************/
+static num_t
+mainFeedForward (const ControlOutput *output)
+{
+    // Off once the thrust lifts it, before the height reads a whole %
+    if (!output->heightAuto || (output->height <= 0 && g_mainThrust < CONTROL_HEIGHT_FF_HOVER))
+    {
+        return 0;
+    }
+    // The tail motor lags less than the main, so lead the thrust estimate by the difference
+    return numMul(CONTROL_YAW_FF_MAIN, g_mainThrust + numMul(CONTROL_YAW_FF_LEAD, output->mainDuty - g_mainThrust));
+}
+
+
+/*******************************************************
+ * Function: controlStep
+ *
+ * Reads the height and yaw, and steps both loops. Calls
+ * no FreeRTOS function, so it can run in controlIntHandler.
+ *******************************************************/
+static void
+controlStep (void)
+{
+    ControlOutput *output = &g_telemetry.output;
+    ControlTarget target;
+    int32_t height;
+    int64_t count;
+    num_t shift;
+
+    // Sense first, so every sample is taken the same time into its period
+    updateYawPosition(&g_position);
+    output->yawRate = numMul(numFromInt(updateYawVelocity(&g_velocity)), YAW_DEG_PER_COUNT);
+    if (g_position.rebase != 0)
+    {
+        // The yaw moved over to count from the reference, move what it is followed against with it so the error
+        // does not step. The profile then takes it to the set point, which is from the reference, within its limits.
+        shift = numMul(numFromInt(g_position.rebase), YAW_DEG_PER_COUNT);
+        shiftTrajectory(&g_yawProfile, shift);
+        if (g_tuneAxis == CONTROL_TUNE_YAW)
+        {
+            shiftRelayTune(&g_tune, shift);
+        }
+    }
+#if CONTROL_IN_ISR
+    output->heightAuto = getHeightFromISR(&height);
+#else
+    output->heightAuto = getHeight(&height);
+#endif
+
+    (void) readDblBuf(&g_targetBuf, &target);
+    output->heightTarget = target.height;
+    output->yawTarget = target.yaw;
+    if (output->heightAuto)
+    {
+        output->height = numFromInt(height);
+    }
+
+    // The loop is the only one that drives the rotors, so it arms and kills them too
+    if (g_armRequest != CONTROL_ARM_NONE)
+    {
+        if (g_armRequest == CONTROL_ARM_ON)
+        {
+            armRotors();
+        }
+        else
+        {
+            killRotors();
+        }
+        g_armRequest = CONTROL_ARM_NONE;
+    }
+    output->armed = !getRotorsKilled();
+
+#if YAW_FIND_REF
+    // Once armed, the tail is held at a fixed duty until the reference is found (or the loop gives up), then taken
+    // over without a bump
+    output->yawAuto = getYawRefFound() || g_findCycles >= YAW_FIND_REF_TIMEOUT_MS * CONTROL_RATE_HZ / 1000;
+#else
+    output->yawAuto = true;
+#endif
+
+    // Both motors off until armed and calibrated, and again once back on the ground with nothing asked of the height
+    output->landed = !output->armed || !output->heightAuto
+                     || (target.height <= 0 && height <= 0 && g_heightProfile.position <= 0
+                         && isTrajectoryDone(&g_heightProfile));
+    if (output->landed && g_tuneAxis != CONTROL_TUNE_NONE)
+    {
+        // Killed part way through, the loop gets its PI back for the next take off
+        setPIDAuto(g_tuneAxis == CONTROL_TUNE_HEIGHT ? &g_heightPID : &g_yawPID);
+        g_telemetry.tune.result.state = RELAY_TUNE_FAILED;
+        g_tuneAxis = CONTROL_TUNE_NONE;
+    }
+
+    if (g_tuneRequest != CONTROL_TUNE_NONE)
+    {
+        startTune(g_tuneRequest, output);
+        g_tuneRequest = CONTROL_TUNE_NONE;
+    }
+
+    if (output->landed)
+    {
+        // Off, and a clean start to take off from
+        resetPID(&g_heightPID);
+        resetTrajectory(&g_heightProfile, 0);
+        output->heightSetpoint = 0;
+        output->mainDuty = 0;
+    }
+    else if (g_tuneAxis == CONTROL_TUNE_HEIGHT)
+    {
+        output->heightSetpoint = g_tune.setpoint;
+        output->mainDuty = stepTune(&g_heightPID, &g_heightProfile, &g_heightSchedule, g_tune.setpoint, output->height);
+    }
+    else
+    {
+        output->heightSetpoint = stepTrajectory(&g_heightProfile, numFromInt(target.height));
+        scheduleGains(&g_heightPID, &g_heightSchedule, output->heightSetpoint);
+        setPIDFeedForward(&g_heightPID, CONTROL_HEIGHT_FF_HOVER + feedForward(&g_heightProfile, CONTROL_HEIGHT_FF_RATE,
+                                                                              CONTROL_HEIGHT_FF_ACCEL, CONTROL_HEIGHT_FF_JERK));
+        output->mainDuty = stepPID(&g_heightPID, output->heightSetpoint, output->height);
+    }
+    g_mainThrust += numMul(CONTROL_MAIN_LAG, output->mainDuty - g_mainThrust);
+
+    // Clamped like the set point, the count itself would overflow num_t past about 90 turns
+    count = g_position.count;
+    if (count > CONTROL_YAW_LIMIT_COUNTS)
+    {
+        count = CONTROL_YAW_LIMIT_COUNTS;
+    }
+    else if (count < -CONTROL_YAW_LIMIT_COUNTS)
+    {
+        count = -CONTROL_YAW_LIMIT_COUNTS;
+    }
+    output->yaw = numMul(numFromInt((int32_t) count), YAW_DEG_PER_COUNT);
+    if (g_tuneAxis == CONTROL_TUNE_YAW)
+    {
+        output->yawSetpoint = g_tune.setpoint;
+        output->tailDuty = stepTune(&g_yawPID, &g_yawProfile, &g_yawSchedule, g_mainThrust, output->yaw);
+    }
+    else if (output->landed && (output->yawAuto || !output->armed))
+    {
+        // Off, the profile starts from wherever the yaw is at take off
+        resetPID(&g_yawPID);
+        resetTrajectory(&g_yawProfile, output->yaw);
+        output->yawSetpoint = output->yaw;
+        output->tailDuty = 0;
+    }
+    else
+    {
+        if (output->yawAuto)
+        {
+            setPIDAuto(&g_yawPID);
+            scheduleGains(&g_yawPID, &g_yawSchedule, g_mainThrust);
+            output->yawSetpoint = stepTrajectory(&g_yawProfile, numFromInt(target.yaw));
+        }
+        else
+        {
+            setPIDManual(&g_yawPID, CONTROL_YAW_FIND_DUTY);
+            resetTrajectory(&g_yawProfile, output->yaw);  // The profile starts from wherever the loop takes over
+            output->yawSetpoint = output->yaw;
+            g_findCycles++;
+        }
+        setPIDFeedForward(&g_yawPID, feedForward(&g_yawProfile, CONTROL_YAW_FF_RATE, CONTROL_YAW_FF_ACCEL,
+                                                 CONTROL_YAW_FF_JERK)
+                                     + mainFeedForward(output));
+        output->tailDuty = stepPID(&g_yawPID, output->yawSetpoint, output->yaw);
+    }
+
+    setRotorDuty(ROTOR_MAIN, (uint32_t) numToScaled(output->mainDuty, ROTOR_DUTY_ONE));
+    setRotorDuty(ROTOR_TAIL, (uint32_t) numToScaled(output->tailDuty, ROTOR_DUTY_ONE));
+
+    output->tuning = g_tuneAxis;
+    output->cycle = g_cyclesRun;
+    g_cyclesRun++;
+}
+
+
+/*******************************************************
+ * Function: recordCycle
+ *
+ * Adds a cycle to the stats and publishes them with the
+ * outputs
+ *
+ * late: release timer counts the release was late by
+ * exec: release timer counts from release to the end
+ * overrun: the cycle finished after the next release was due
+ *******************************************************/
+static void
+recordCycle (uint32_t late, uint32_t exec, bool overrun)
+{
+    static const ControlStats cleared;
+    ControlStats *stats = &g_telemetry.stats;
+
+    if (g_statsReset)
+    {
+        *stats = cleared;
+        g_statsReset = false;
+    }
+
+    stats->cycles++;
+    if (overrun)
+    {
+        stats->overruns++;  // The next release runs late
+    }
+    stats->jitterLast = late;
+    if (late > stats->jitterMax)
+    {
+        stats->jitterMax = late;
+    }
+    stats->jitterSum += late;
+    stats->execLast = exec;
+    if (exec > stats->execMax)
+    {
+        stats->execMax = exec;
+    }
+
+    writeDblBuf(&g_telemetryBuf, &g_telemetry);
+}
+
+
+#if CONTROL_IN_ISR
+/*******************************************************
+ * Function: controlIntHandler
+ *
+ * Runs when the control timer times out, once every
+ * period, and steps both loops
+ *
+ * The timer reloaded at the timeout, so how far it has
+ * counted down since is how late the interrupt ran, to
+ * the clock cycle.
+ *******************************************************/
+void
+controlIntHandler (void)
+{
+    uint32_t release = TimerValueGet(CONTROL_TIMER_BASE, TIMER_A);  // First, before anything else takes time
+    uint32_t finish;
+    bool overrun;
+
+    TimerIntClear(CONTROL_TIMER_BASE, TIMER_TIMA_TIMEOUT);
+
+    controlStep();
+
+    finish = TimerValueGet(CONTROL_TIMER_BASE, TIMER_A);
+    overrun = (TimerIntStatus(CONTROL_TIMER_BASE, false) & TIMER_TIMA_TIMEOUT) != 0;  // Timed out again meanwhile, and reloaded
+
+    recordCycle(g_periodCounts - 1 - release, release - finish + (overrun ? g_periodCounts : 0), overrun);
+}
+#else
+/*******************************************************
+ * Function: controlTask
+ *
+ * Every CONTROL_PERIOD_TICKS, reads the height and yaw,
+ * steps both loops and records the release timing
+ *
+ * A release is late by however long the tick interrupt
+ * and anything above this task held it up. The timer has
+ * no fixed relation to the tick, so each release is
+ * measured against the earliest one seen, moved on a
+ * period at a time, which is the nearest estimate of the
+ * tick itself.
+ *
+ * pvParameters: NULL
+ *******************************************************/
+void
+controlTask (void *pvParameters)
+{
+    TickType_t lastWake = xTaskGetTickCount();
+
+    uint32_t release;  // Timer counts at this release, counting up
+    uint32_t due = 0;  // Timer counts this release was due at
+    bool timed = false;  // due is valid
+    uint32_t late;
+    uint32_t finish;
+
+    (void) pvParameters;
+
+    while (1)
+    {
+        // Released every period from the last, however long the cycle took
+        vTaskDelayUntil(&lastWake, CONTROL_PERIOD_TICKS);
+        release = ~TimerValueGet(CONTROL_TIMER_BASE, TIMER_A);  // The timer counts down
+
+        controlStep();
+
+        // Lateness of the release
+        due = due + g_periodCounts;
+        late = release - due;
+        if (!timed || (int32_t) late < 0)
+        {
+            due = release;  // The earliest release yet
+            late = 0;
+            timed = true;
+        }
+
+        finish = ~TimerValueGet(CONTROL_TIMER_BASE, TIMER_A);
+        recordCycle(late, finish - release, finish - due >= g_periodCounts);
+    }
+}
+#endif
+
+
+/*******************************************************
+ * Function: initControlTask
+ *
+ * Creates the FreeRTOS task controlTask, or with
+ * CONTROL_IN_ISR starts the control interrupt
+ *      Initialises the release timer and both loops
+ *
+ * returns: 0 on successful creation of controlTask
+ *          1 on failed attempt
+ *******************************************************/
+uint8_t
+initControlTask (void)
+{
+    static const ControlTelemetry none;
+    const ControlTarget landed = { 0, 0 };
+    const num_t dt = numDiv(numFromInt(1), numFromInt(CONTROL_RATE_HZ));
+
+    // Everything the loop uses, before it can first run
+    initPID(&g_heightPID, dt, CONTROL_DUTY_MAX, CONTROL_DUTY_MIN, CONTROL_HEIGHT_KP, CONTROL_HEIGHT_KI, 0);
+    setPIDWindup(&g_heightPID, PID_WINDUP_BACK_CALC, CONTROL_HEIGHT_TT);
+    initPID(&g_yawPID, dt, CONTROL_DUTY_MAX, CONTROL_DUTY_MIN, CONTROL_YAW_KP, CONTROL_YAW_KI, 0);
+    setPIDWindup(&g_yawPID, PID_WINDUP_BACK_CALC, CONTROL_YAW_TT);
+    initTrajectory(&g_heightProfile, dt, CONTROL_HEIGHT_RATE, CONTROL_HEIGHT_ACCEL, CONTROL_HEIGHT_JERK, 0);
+    initTrajectory(&g_yawProfile, dt, CONTROL_YAW_RATE, CONTROL_YAW_ACCEL, CONTROL_YAW_JERK, 0);
+    initGainSchedule(&g_heightSchedule, g_heightGains, sizeof(g_heightGains) / sizeof(g_heightGains[0]),
+                     CONTROL_HEIGHT_SCHED_START, CONTROL_HEIGHT_SCHED_STEP);
+    initGainSchedule(&g_yawSchedule, g_yawGains, sizeof(g_yawGains) / sizeof(g_yawGains[0]), CONTROL_YAW_SCHED_START,
+                     CONTROL_YAW_SCHED_STEP);
+    g_mainThrust = 0;
+    initYawPosition(&g_position);
+    initYawVelocity(&g_velocity);
+    g_telemetry = none;
+    g_cyclesRun = 0;
+    g_findCycles = 0;
+    g_statsReset = false;
+    g_tuneAxis = CONTROL_TUNE_NONE;
+    g_tuneRequest = CONTROL_TUNE_NONE;
+    g_armRequest = CONTROL_ARM_NONE;
+    initDblBuf(&g_targetBuf, g_targetCopies, sizeof(ControlTarget), &landed);
+    initDblBuf(&g_telemetryBuf, g_telemetryCopies, sizeof(ControlTelemetry), &none);
+
+    initControlTimer();  // With CONTROL_IN_ISR, the loop runs from the first timeout
+
+#if !CONTROL_IN_ISR
+    // Create controlTask
+    if (pdTRUE != xTaskCreate(controlTask, "Control", CONTROL_STACK_DEPTH, NULL, CONTROL_TASK_PRIORITY, NULL))
+    {
+        return(1);  // Fail (Must not have had enough memory to create the task)
+    }
+#endif
+    return(0);  // Success
+}
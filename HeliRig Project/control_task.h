@@ -0,0 +1,346 @@
+#ifndef __CONTROL_TASK_H__
+#define __CONTROL_TASK_H__
+
+/*******************************************************
+ * control_task.c
+ *
+ * A FreeRTOS task that runs the height and yaw PID loops
+ * at a fixed rate, released by vTaskDelayUntil() so the
+ * period does not stretch by the time each cycle takes.
+ *
+ * Sensing is phase aligned: the height and yaw are read
+ * first thing after each release, so every sample is the
+ * same time into its period and the loop sees a constant
+ * delay rather than one that wanders with the other tasks.
+ *
+ * Each release is timestamped on a free running timer
+ * (TIMER3), and its lateness (jitter) and any cycle that
+ * runs into the next release (overrun) are kept in a
+ * ControlStats, see getControlStats().
+ *
+ * With CONTROL_IN_ISR the loops run in the TIMER3
+ * interrupt instead (controlIntHandler), which is then
+ * periodic at CONTROL_RATE_HZ. It is above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY, so neither the
+ * scheduler nor a critical section holds it up, and the
+ * release jitter is only the interrupt latency. It must
+ * then not call FreeRTOS at all.
+ *
+ * Each cycle's duties go straight out to the motors
+ * (rotorPWM.h), a compare register write each, either way.
+ * Nothing else writes them: while getYawTask waits for the
+ * yaw reference, the loop holds the tail that turns the
+ * helicopter onto it.
+ *
+ * The rotors start disarmed, and both motors are off
+ * (duty 0) until armControl() arms them on an explicit
+ * action, and the height is calibrated. They go off again
+ * once it is back on the ground with a height set point
+ * of 0, and the loops take off from a clean start.
+ *
+ * A change of set point is not stepped into the loops,
+ * they follow a rate, acceleration and jerk limited
+ * profile to it (trajectory.h), so they do not saturate
+ * the motors and overshoot. The duty the profile's rate,
+ * acceleration and jerk need (and the hover duty) is fed
+ * forward, so the PI only corrects what the model misses
+ * and the loops keep up with the profile.
+ *
+ * The tail must also hold off the main rotor's torque, so
+ * the tail duty that does so is fed forward from the main
+ * duty, through the difference between the two motors'
+ * lags, and a change of height no longer knocks the yaw
+ * off. The PI gains of each loop are scheduled, looked up
+ * every cycle from a table (gain_schedule.h), by height
+ * for the height loop and by main duty for the yaw loop.
+ *
+ * startControlTune() hands a loop to a relay experiment
+ * (relay_tune.h) in place of its PI, which finds the
+ * loop's ultimate gain and period, and the loop takes back
+ * over with the PI gains found from them. The result is
+ * published with the outputs, see getControlTune().
+ *
+ * Either way, the set points go to the loops and the
+ * outputs and stats come back through lock-free double
+ * buffers (dblBuf.h), so neither side ever waits for the
+ * other.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#ifndef TASK_STACK_DEPTH  // The host simulation needs larger stacks (Simulation/FreeRTOSConfig.h)
+#define TASK_STACK_DEPTH    32
+#endif
+#ifndef CONTROL_STACK_DEPTH  // The FPU context (about 50 words) and controlStep()'s float calls need more than TASK_STACK_DEPTH
+#define CONTROL_STACK_DEPTH     256  // About twice the deepest use, check with uxTaskGetStackHighWaterMark()
+#endif
+#define CONTROL_TASK_PRIORITY   5  // Above the sensing and display tasks, so only interrupts delay a release
+
+#ifndef CONTROL_RATE_HZ
+#define CONTROL_RATE_HZ         200  // Control cycles per second
+#endif
+#define CONTROL_PERIOD_TICKS    (configTICK_RATE_HZ / CONTROL_RATE_HZ)
+
+#if CONTROL_RATE_HZ < 1 || configTICK_RATE_HZ % CONTROL_RATE_HZ != 0
+#error "CONTROL_RATE_HZ must divide configTICK_RATE_HZ, releases fall on ticks"
+#endif
+
+// Release timestamps, a 32 bit timer at the system clock: free running, or with
+// CONTROL_IN_ISR periodic, its timeout interrupt releasing each cycle
+#define CONTROL_TIMER_BASE      TIMER3_BASE
+#define CONTROL_TIMER_PERIPH    SYSCTL_PERIPH_TIMER3
+#define CONTROL_TIMER_INT       INT_TIMER3A
+
+#ifndef CONTROL_IN_ISR
+#define CONTROL_IN_ISR          0  // 1: run the loops in controlIntHandler, 0: in controlTask
+#endif
+#define CONTROL_INT_PRIORITY    (0 << 5)  // Above configMAX_SYSCALL_INTERRUPT_PRIORITY, may not call FreeRTOS
+
+// Loops, output is duty as a fraction, gains as in Testing/gainSweep.c
+#define CONTROL_DUTY_MIN        NUM_CONST(0.02)
+#define CONTROL_DUTY_MAX        NUM_CONST(0.98)
+#define CONTROL_HEIGHT_KP       NUM_CONST(0.04)  // Per % height
+#define CONTROL_HEIGHT_KI       NUM_CONST(0.01)
+#define CONTROL_HEIGHT_TT       NUM_CONST(0.0)  // Back calculation tracking time, the integral time (Testing/windupTest.c)
+#define CONTROL_YAW_KP          NUM_CONST(0.008)  // Per degree
+#define CONTROL_YAW_KI          NUM_CONST(0.002)
+#define CONTROL_YAW_TT          NUM_CONST(1.0)
+#define CONTROL_YAW_FIND_DUTY   NUM_CONST(YAW_FIND_REF_DUTY / 100.0)  // Tail held at while finding the reference
+#define CONTROL_YAW_LIMIT       14400  // Degrees (40 turns) the yaw and its set point are clamped to either way, so the
+                                       // error between them stays inside Q16.16's range (heli_math.h)
+#define CONTROL_YAW_LIMIT_COUNTS ((int64_t) CONTROL_YAW_LIMIT * YAW_COUNTS_PER_REV / 360)
+
+// Set point profiles (trajectory.h), what the loops can follow without saturating, see Testing/trajectoryTest.c
+#define CONTROL_HEIGHT_RATE     NUM_CONST(20.0)  // % per s
+#define CONTROL_HEIGHT_ACCEL    NUM_CONST(40.0)  // % per s^2
+#define CONTROL_HEIGHT_JERK     NUM_CONST(200.0)  // % per s^3
+#define CONTROL_YAW_RATE        NUM_CONST(60.0)  // Degrees per s
+#define CONTROL_YAW_ACCEL       NUM_CONST(120.0)
+#define CONTROL_YAW_JERK        NUM_CONST(600.0)
+
+// Feed-forward from the profiles, duty per unit of rate, acceleration and jerk, from the rig's model
+// (Simulation/heli_plant.c): lift, damping, and the motor lag for the acceleration and jerk
+#define CONTROL_HEIGHT_FF_HOVER NUM_CONST(0.45)  // Main duty that holds the height
+#define CONTROL_HEIGHT_FF_RATE  NUM_CONST(0.0135)  // Per % per s
+#define CONTROL_HEIGHT_FF_ACCEL NUM_CONST(0.0036)
+#define CONTROL_HEIGHT_FF_JERK  NUM_CONST(0.000225)
+#define CONTROL_YAW_FF_RATE     NUM_CONST(0.0067)  // Per degree per s
+#define CONTROL_YAW_FF_ACCEL    NUM_CONST(0.00144)
+#define CONTROL_YAW_FF_JERK     NUM_CONST(0.0000556)
+
+// Feed-forward of the main rotor's torque to the tail, once off the ground. The tail thrust that balances it,
+// led by the tail motor's lag and lagged by the main motor's, on an estimate of the main thrust
+#define CONTROL_YAW_FF_MAIN     NUM_CONST(0.778)  // Tail duty per main duty, coupling over tail gain (700 / 900)
+#define CONTROL_MAIN_TAU_S      0.1  // Main motor lag, s
+#define CONTROL_TAIL_TAU_S      0.05  // Tail motor lag, s
+#define CONTROL_YAW_FF_LEAD     NUM_CONST(CONTROL_TAIL_TAU_S / CONTROL_MAIN_TAU_S)
+#define CONTROL_MAIN_LAG        NUM_CONST(1.0 / (CONTROL_MAIN_TAU_S * CONTROL_RATE_HZ))  // dt / tau, per cycle
+
+// Gain schedules (gain_schedule.h), kp and ki at evenly spaced points, tables in control_task.c. Flat at
+// the gains above, the model is linear, until the rig is tuned at each point (autotune_task.h)
+#define CONTROL_HEIGHT_SCHED_START NUM_CONST(0.0)  // By the height set point, %
+#define CONTROL_HEIGHT_SCHED_STEP  NUM_CONST(25.0)
+#define CONTROL_YAW_SCHED_START NUM_CONST(0.2)  // By the main thrust estimate, duty
+#define CONTROL_YAW_SCHED_STEP  NUM_CONST(0.15)
+
+// Autotune (relay_tune.h), the relay about the duty that held the set point, see Testing/relayTuneTest.c
+#define CONTROL_TUNE_NONE       0  // Loops
+#define CONTROL_TUNE_HEIGHT     1
+#define CONTROL_TUNE_YAW        2
+#define CONTROL_HEIGHT_TUNE_STEP NUM_CONST(0.3)  // Relay amplitude, duty
+#define CONTROL_HEIGHT_TUNE_BAND NUM_CONST(1.0)  // Hysteresis, %, a count of getHeight()
+#define CONTROL_YAW_TUNE_STEP   NUM_CONST(0.3)
+#define CONTROL_YAW_TUNE_BAND   NUM_CONST(0.4)  // Degrees, half a count, the next count over switches it
+#define CONTROL_TUNE_TIMEOUT_S  30  // Gives up, and the loop takes back over with the gains it had
+
+// armControl() requests, taken up by the loop
+#define CONTROL_ARM_NONE        0
+#define CONTROL_ARM_ON          1
+#define CONTROL_ARM_OFF         2
+
+
+/*******************************************************
+ * Types
+ *******************************************************/
+// Release timing of the control cycles, see getControlStats()
+typedef struct Control_Stats
+{
+    uint32_t cycles;  // Cycles run
+    uint32_t overruns;  // Cycles that finished after the next release was due
+    uint32_t jitterLast;  // Lateness of the last release, in ns
+    uint32_t jitterMax;  // Greatest lateness of any release, in ns
+    uint64_t jitterSum;  // Sum of the lateness of every release, in ns, for the mean
+    uint32_t execLast;  // Time from release to the end of the last cycle, in ns
+    uint32_t execMax;  // Longest cycle, in ns
+} ControlStats;
+
+
+// Set points and the last outputs of the loops, see getControlOutput()
+typedef struct Control_Output
+{
+    int32_t heightTarget;  // % height
+    int32_t yawTarget;  // Degrees from the reference, not wrapped
+    num_t heightSetpoint;  // Point on the profile to heightTarget the loop followed, %
+    num_t yawSetpoint;  // ... and to yawTarget, degrees
+    num_t height;  // Measured at the last release, % (0 until calibrated)
+    num_t yaw;  // Measured at the last release, degrees from the reference
+    num_t yawRate;  // Measured at the last release, degrees per second from the edge timing
+    num_t mainDuty;  // Fraction, CONTROL_DUTY_MIN to CONTROL_DUTY_MAX, or 0 for off
+    num_t tailDuty;
+    bool armed;  // armControl() has armed the rotors, both are off until then
+    bool landed;  // Both motors are off: disarmed, not yet calibrated, or on the ground with a height set point of 0
+    bool heightAuto;  // The height is calibrated, the loop is held landed until then
+    bool yawAuto;  // The yaw loop can run, once armed the tail is held at CONTROL_YAW_FIND_DUTY until the reference is found
+    uint8_t tuning;  // CONTROL_TUNE_ loop the relay is driving, CONTROL_TUNE_NONE normally
+    uint32_t cycle;  // Cycles run since start up, to tell one cycle's outputs from the next
+} ControlOutput;
+
+
+// The last autotune, see getControlTune()
+typedef struct Control_Tune
+{
+    uint8_t axis;  // CONTROL_TUNE_ loop tuned
+    uint8_t runs;  // Tunes asked for, so a caller can tell its own result from the last
+    RelayTuneResult result;  // RELAY_TUNE_RUNNING until it finishes
+} ControlTune;
+
+
+/*******************************************************
+ * Function: initControlTimer
+ *
+ * Initialises the timer the releases are timestamped on
+ * With CONTROL_IN_ISR, starts it releasing
+ * controlIntHandler every period
+ *******************************************************/
+void
+initControlTimer (void);
+
+
+/*******************************************************
+ * Function: setControlTarget
+ *
+ * Sets the set points, taken up at the next release.
+ * Call from tasks only.
+ *
+ * height: % height
+ * yaw: degrees from the reference, not wrapped (360 is
+ *      one turn on from 0)
+ *******************************************************/
+void
+setControlTarget (int32_t height, int32_t yaw);
+
+
+/*******************************************************
+ * Function: getControlOutput
+ *
+ * Copies out the set points, measurements and duties of
+ * the last cycle
+ *******************************************************/
+void
+getControlOutput (ControlOutput *output);
+
+
+/*******************************************************
+ * Function: getControlStats
+ *
+ * Copies out the release timing, e.g. for telemetry.
+ * Can be called at any time from any task.
+ *******************************************************/
+void
+getControlStats (ControlStats *stats);
+
+
+/*******************************************************
+ * Function: resetControlStats
+ *
+ * Clears the release timing, e.g. after a change in load
+ * to measure from. The loop clears it at its next cycle.
+ *******************************************************/
+void
+resetControlStats (void);
+
+
+/*******************************************************
+ * Function: armControl
+ *
+ * Arms the rotors, or with armed false kills them, at the
+ * next cycle. They start disarmed, so nothing turns until
+ * this is called on an explicit action (a button press or
+ * a command). Killed in flight, the helicopter drops.
+ * Call from tasks only.
+ *******************************************************/
+void
+armControl (bool armed);
+
+
+/*******************************************************
+ * Function: startControlTune
+ *
+ * Hands a loop to a relay experiment at the next cycle,
+ * about its present set point. The loop must be running
+ * (heightAuto, yawAuto, not landed) and steady, the other
+ * loop holds as normal. Once finished, the loop takes back
+ * over without a bump, with its gain schedule scaled to
+ * the gains found, or as it was if it failed. It fails if
+ * the rotors are killed part way through. Call from tasks
+ * only.
+ *
+ * axis: CONTROL_TUNE_HEIGHT or CONTROL_TUNE_YAW
+ *******************************************************/
+void
+startControlTune (uint8_t axis);
+
+
+/*******************************************************
+ * Function: getControlTune
+ *
+ * Copies out the last autotune. It fails straight away if
+ * the loop was not running, or one was already tuning.
+ *******************************************************/
+void
+getControlTune (ControlTune *tune);
+
+
+/*******************************************************
+ * Function: controlTask
+ *
+ * Every CONTROL_PERIOD_TICKS, reads the height and yaw,
+ * steps both loops and records the release timing
+ *
+ * pvParameters: NULL
+ *******************************************************/
+void
+controlTask (void *pvParameters);
+
+
+/*******************************************************
+ * Function: controlIntHandler
+ *
+ * CONTROL_IN_ISR: runs when the control timer times out,
+ * once every period, and steps both loops as controlTask
+ * would
+ *******************************************************/
+void
+controlIntHandler (void);
+
+
+/*******************************************************
+ * Function: initControlTask
+ *
+ * Creates the FreeRTOS task controlTask, or with
+ * CONTROL_IN_ISR starts the control interrupt
+ *      Initialises the release timer and both loops
+ *
+ * returns: 0 on successful creation of controlTask
+ *          1 on failed attempt
+ *******************************************************/
+uint8_t
+initControlTask (void);
+
+
+#endif /* __CONTROL_TASK_H__ */
@@ -0,0 +1,212 @@
+#ifndef _DISCRETE_CONTROLLER_H_
+#define _DISCRETE_CONTROLLER_H_
+
+/*******************************************************
+ * discrete_controller.h
+ *
+ * Controllers discretised at compile time: a continuous
+ * PI, PID (with its derivative filtered) or lead-lag, and
+ * the sample period, go in to a macro, and fixed
+ * difference equation coefficients come out, worked out
+ * by the compiler in double precision (the Tustin, or
+ * bilinear, transform, s = 2 / dt (z - 1) / (z + 1)):
+ *
+ *     static const DiscreteCoeffs heightPI =
+ *         DISCRETE_PI(0.04, 0.01, 1.0 / CONTROL_RATE_HZ, 0.98, 0.02);
+ *
+ * A step is then only the multiply-adds of
+ *     y = b0 e + b1 e1 + b2 e2 - a1 y1 - a2 y2
+ * on the error now and the errors and outputs one and two
+ * steps back, no dt and no divide, against stepPID()'s
+ * separate terms. The gains cannot change at run time,
+ * and there is no feed-forward, manual mode or choice of
+ * anti-windup: the output is clamped, and the clamped
+ * output fed back, so an integrator stops at the limit as
+ * the incremental (velocity) form does. For loops that
+ * need those, see PI_controller.h.
+ *
+ * A first order specification (PI, lead-lag) is kept as a
+ * first order section (b2 = a2 = 0), so no pole at z = -1
+ * is left to cancel. A PID's derivative filter time tf
+ * must be more than 0, a pure derivative has no
+ * discrete form.
+ *
+ * In fixed point (HELI_MATH_FIXED) the coefficients are
+ * Q8.24 (DISCRETE_COEF_BITS), as ki dt is too small for
+ * Q16.16, and each step is summed in 64 bits (a
+ * multiply-accumulate, SMLAL, on the Cortex-M4). What is
+ * rounded off the output is carried into the next step,
+ * so an integrator sees every last bit of a small error.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+
+#include "heli_math.h"
+
+
+/*******************************************************
+ * Coefficients
+ *******************************************************/
+#if HELI_MATH_TYPE == HELI_MATH_FIXED
+typedef int32_t dcoef_t;  // Q8.24, -128 to 128
+#define DISCRETE_COEF_BITS  24
+#define DISCRETE_COEF(x)    ((dcoef_t) ((x) * 16777216.0 + (((x) >= 0) ? 0.5 : -0.5)))
+#else
+typedef float dcoef_t;
+#define DISCRETE_COEF(x)    ((dcoef_t) (x))
+#endif
+
+// Tustin transform of (n1 s + n0) / (d1 s + d0), and of (n2 s^2 + n1 s + n0) / (d2 s^2 + d1 s + d0),
+// normalised so a0 is 1. DISCRETE_K is 2 / dt.
+#define DISCRETE_K(dt)      (2.0 / (dt))
+#define DISCRETE_A0_1(d1, d0, dt)           ((d1) * DISCRETE_K(dt) + (d0))
+#define DISCRETE_A0_2(d2, d1, d0, dt)       ((d2) * DISCRETE_K(dt) * DISCRETE_K(dt) + (d1) * DISCRETE_K(dt) + (d0))
+
+#define DISCRETE_FIRST_ORDER(n1, n0, d1, d0, dt, max, min) \
+    { \
+        DISCRETE_COEF(((n1) * DISCRETE_K(dt) + (n0)) / DISCRETE_A0_1(d1, d0, dt)), \
+        DISCRETE_COEF(((n0) - (n1) * DISCRETE_K(dt)) / DISCRETE_A0_1(d1, d0, dt)), \
+        DISCRETE_COEF(0.0), \
+        DISCRETE_COEF(((d0) - (d1) * DISCRETE_K(dt)) / DISCRETE_A0_1(d1, d0, dt)), \
+        DISCRETE_COEF(0.0), \
+        NUM_CONST(max), NUM_CONST(min) \
+    }
+
+#define DISCRETE_SECOND_ORDER(n2, n1, n0, d2, d1, d0, dt, max, min) \
+    { \
+        DISCRETE_COEF(((n2) * DISCRETE_K(dt) * DISCRETE_K(dt) + (n1) * DISCRETE_K(dt) + (n0)) \
+                      / DISCRETE_A0_2(d2, d1, d0, dt)), \
+        DISCRETE_COEF(2.0 * ((n0) - (n2) * DISCRETE_K(dt) * DISCRETE_K(dt)) / DISCRETE_A0_2(d2, d1, d0, dt)), \
+        DISCRETE_COEF(((n2) * DISCRETE_K(dt) * DISCRETE_K(dt) - (n1) * DISCRETE_K(dt) + (n0)) \
+                      / DISCRETE_A0_2(d2, d1, d0, dt)), \
+        DISCRETE_COEF(2.0 * ((d0) - (d2) * DISCRETE_K(dt) * DISCRETE_K(dt)) / DISCRETE_A0_2(d2, d1, d0, dt)), \
+        DISCRETE_COEF(((d2) * DISCRETE_K(dt) * DISCRETE_K(dt) - (d1) * DISCRETE_K(dt) + (d0)) \
+                      / DISCRETE_A0_2(d2, d1, d0, dt)), \
+        NUM_CONST(max), NUM_CONST(min) \
+    }
+
+// kp + ki / s
+#define DISCRETE_PI(kp, ki, dt, max, min) \
+    DISCRETE_FIRST_ORDER((kp), (ki), 1.0, 0.0, (dt), (max), (min))
+
+// kp + ki / s + kd s / (tf s + 1)
+#define DISCRETE_PID(kp, ki, kd, tf, dt, max, min) \
+    DISCRETE_SECOND_ORDER((kp) * (tf) + (kd), (kp) + (ki) * (tf), (ki), (tf), 1.0, 0.0, (dt), (max), (min))
+
+// k (s / wz + 1) / (s / wp + 1), a lead for wz < wp, a lag for wz > wp, rad/s
+#define DISCRETE_LEAD_LAG(k, wz, wp, dt, max, min) \
+    DISCRETE_FIRST_ORDER((k) / (wz), (k), 1.0 / (wp), 1.0, (dt), (max), (min))
+
+
+// Difference equation coefficients, from one of the macros above
+typedef struct Discrete_Coeffs_Struct
+{
+    dcoef_t b0;  // On the error now
+    dcoef_t b1;  // ... one step back
+    dcoef_t b2;  // ... two steps back
+    dcoef_t a1;  // On the output one step back, negated
+    dcoef_t a2;  // ... two steps back
+    num_t max;
+    num_t min;
+} DiscreteCoeffs;
+
+
+// A controller stepping a set of coefficients, num_t (heli_math.h)
+typedef struct Discrete_Controller_Struct
+{
+    const DiscreteCoeffs *coeffs;
+    num_t e1;  // Errors one and two steps back
+    num_t e2;
+    num_t y1;  // Outputs one and two steps back, as clamped
+    num_t y2;
+#if HELI_MATH_TYPE == HELI_MATH_FIXED
+    int32_t residue;  // Rounded off the last output, in Q.40, under one LSB of it
+#endif
+} DiscreteController;
+
+
+/*******************************************************
+ * Function: resetDiscrete
+ *
+ * Clears the history, to an output of 0
+ *******************************************************/
+static inline void
+resetDiscrete (DiscreteController *ctrl)
+{
+    ctrl->e1 = 0;
+    ctrl->e2 = 0;
+    ctrl->y1 = 0;
+    ctrl->y2 = 0;
+#if HELI_MATH_TYPE == HELI_MATH_FIXED
+    ctrl->residue = 0;
+#endif
+}
+
+
+/*******************************************************
+ * Function: initDiscrete
+ *
+ * Sets up a controller, at rest
+ *
+ * ctrl: the controller
+ * coeffs: from DISCRETE_PI, DISCRETE_PID ..., kept, not
+ *         copied
+ *******************************************************/
+static inline void
+initDiscrete (DiscreteController *ctrl, const DiscreteCoeffs *coeffs)
+{
+    ctrl->coeffs = coeffs;
+    resetDiscrete(ctrl);
+}
+
+
+/*******************************************************
+ * Function: stepDiscrete
+ *
+ * Steps the controller once, call once every dt it was
+ * discretised for
+ *
+ * setpoint: value to control to
+ * pv: present value
+ *
+ * returns: the output, restricted to min/max
+ *******************************************************/
+static inline num_t
+stepDiscrete (DiscreteController *ctrl, num_t setpoint, num_t pv)
+{
+    const DiscreteCoeffs *k = ctrl->coeffs;
+    num_t error = setpoint - pv;
+    num_t output;
+
+#if HELI_MATH_TYPE == HELI_MATH_FIXED
+    // Q8.24 times Q16.16 is Q.40, shifted back to Q16.16 with the remainder carried
+    int64_t sum = ctrl->residue;
+
+    sum += (int64_t) k->b0 * error + (int64_t) k->b1 * ctrl->e1 + (int64_t) k->b2 * ctrl->e2;
+    sum -= (int64_t) k->a1 * ctrl->y1 + (int64_t) k->a2 * ctrl->y2;
+    output = (num_t) (sum >> DISCRETE_COEF_BITS);  // Arithmetic shift rounds down
+    ctrl->residue = (int32_t) (sum - ((int64_t) output << DISCRETE_COEF_BITS));
+#else
+    output = k->b0 * error + k->b1 * ctrl->e1 + k->b2 * ctrl->e2 - k->a1 * ctrl->y1 - k->a2 * ctrl->y2;
+#endif
+
+    if (output > k->max || output < k->min)
+    {
+        output = (output > k->max) ? k->max : k->min;
+#if HELI_MATH_TYPE == HELI_MATH_FIXED
+        ctrl->residue = 0;
+#endif
+    }
+
+    ctrl->e2 = ctrl->e1;
+    ctrl->e1 = error;
+    ctrl->y2 = ctrl->y1;
+    ctrl->y1 = output;
+    return output;
+}
+
+
+#endif /* _DISCRETE_CONTROLLER_H_ */
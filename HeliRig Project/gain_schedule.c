@@ -0,0 +1,120 @@
+/*******************************************************
+ * gain_schedule.c
+ *
+ * PI gains interpolated from a table against a
+ * scheduling variable. See gain_schedule.h.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+
+#include "heli_math.h"
+#include "gain_schedule.h"
+
+
+/*******************************************************
+ * Function: initGainSchedule
+ *
+ * Sets up a schedule, copying its table
+ *
+ * schedule: the schedule
+ * points: gains at start, start + step, start + 2 step ...
+ * count: points in the table, 1 to GAIN_SCHEDULE_POINTS
+ * start: scheduling variable at the first point
+ * step: spacing of the points, more than 0
+ *******************************************************/
+void
+initGainSchedule (GainSchedule *schedule, const GainPoint *points, uint8_t count, num_t start, num_t step)
+{
+    uint8_t i;
+
+    if (count > GAIN_SCHEDULE_POINTS)
+    {
+        count = GAIN_SCHEDULE_POINTS;
+    }
+
+    schedule->start = start;
+    schedule->inv_step = numDiv(NUM_ONE, step);  // The only divide, lookups multiply
+    schedule->count = count;
+    for (i = 0; i < count; i++)
+    {
+        schedule->points[i] = points[i];
+    }
+}
+
+
+/*******************************************************
+ * Function: lookupGainSchedule
+ *
+ * Interpolates the gains at a value of the scheduling
+ * variable, in constant time
+ *
+ * schedule: the schedule
+ * x: scheduling variable, held to the ends of the table
+ * gains: filled with the gains at x
+ *******************************************************/
+void
+lookupGainSchedule (const GainSchedule *schedule, num_t x, GainPoint *gains)
+{
+    num_t position = numMul(x - schedule->start, schedule->inv_step);  // In points from the first
+    const GainPoint *below;
+    const GainPoint *above;
+    num_t fraction;
+    int32_t i;
+
+    if (position <= 0)
+    {
+        *gains = schedule->points[0];
+        return;
+    }
+    if (position >= numFromInt(schedule->count - 1))
+    {
+        *gains = schedule->points[schedule->count - 1];
+        return;
+    }
+
+    i = numFloor(position);
+    fraction = position - numFromInt(i);
+    below = &schedule->points[i];
+    above = &schedule->points[i + 1];
+    gains->kp = below->kp + numMul(fraction, above->kp - below->kp);
+    gains->ki = below->ki + numMul(fraction, above->ki - below->ki);
+}
+
+
+/*******************************************************
+ * Function: fitGainSchedule
+ *
+ * Scales the kp and ki of every point so the table gives
+ * these gains at x
+ *
+ * schedule: the schedule
+ * x: scheduling variable the gains were found at
+ * gains: the gains found
+ *******************************************************/
+void
+fitGainSchedule (GainSchedule *schedule, num_t x, const GainPoint *gains)
+{
+    GainPoint at;
+    num_t kpScale = NUM_ONE;
+    num_t kiScale = NUM_ONE;
+    uint8_t i;
+
+    lookupGainSchedule(schedule, x, &at);
+    if (at.kp != 0)
+    {
+        kpScale = numDiv(gains->kp, at.kp);
+    }
+    if (at.ki != 0)
+    {
+        kiScale = numDiv(gains->ki, at.ki);
+    }
+
+    for (i = 0; i < schedule->count; i++)
+    {
+        schedule->points[i].kp = numMul(schedule->points[i].kp, kpScale);
+        schedule->points[i].ki = numMul(schedule->points[i].ki, kiScale);
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef _GAIN_SCHEDULE_H_
+#define _GAIN_SCHEDULE_H_
+
+/*******************************************************
+ * gain_schedule.h
+ *
+ * PI gains that change with where the rig is flying: a
+ * table of kp and ki at evenly spaced values of a
+ * scheduling variable (e.g. the height, or the main duty),
+ * linearly interpolated in between, and held at the end
+ * points outside them.
+ *
+ * The points are evenly spaced so a lookup works out
+ * which two it falls between with one multiply, and takes
+ * the same time wherever it is in the table, with no
+ * search or divide. Like PIDController, a GainSchedule
+ * holds all its own state, so the loop that owns it can
+ * look up every cycle, in a task or the control interrupt.
+ *
+ * fitGainSchedule() scales a whole table so it gives the
+ * gains found at one point, e.g. by relay_tune.h, keeping
+ * the shape across the others.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+
+#include "heli_math.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define GAIN_SCHEDULE_POINTS    8  // Most points a table can have
+
+
+// Gains at one point, num_t (heli_math.h)
+typedef struct Gain_Point_Struct
+{
+    num_t kp;
+    num_t ki;
+} GainPoint;
+
+
+// A table of gains against a scheduling variable
+typedef struct Gain_Schedule_Struct
+{
+    //Set values
+    num_t start;  // Scheduling variable at the first point
+    num_t inv_step;  // 1 / spacing of the points, worked out once by initGainSchedule()
+    uint8_t count;  // Points in use
+    GainPoint points[GAIN_SCHEDULE_POINTS];
+} GainSchedule;
+
+
+/*******************************************************
+ * Function: initGainSchedule
+ *
+ * Sets up a schedule, copying its table
+ *
+ * schedule: the schedule
+ * points: gains at start, start + step, start + 2 step ...
+ * count: points in the table, 1 to GAIN_SCHEDULE_POINTS
+ * start: scheduling variable at the first point
+ * step: spacing of the points, more than 0
+ *******************************************************/
+void
+initGainSchedule (GainSchedule *schedule, const GainPoint *points, uint8_t count, num_t start, num_t step);
+
+
+/*******************************************************
+ * Function: lookupGainSchedule
+ *
+ * Interpolates the gains at a value of the scheduling
+ * variable, in constant time
+ *
+ * schedule: the schedule
+ * x: scheduling variable, held to the ends of the table
+ * gains: filled with the gains at x
+ *******************************************************/
+void
+lookupGainSchedule (const GainSchedule *schedule, num_t x, GainPoint *gains);
+
+
+/*******************************************************
+ * Function: fitGainSchedule
+ *
+ * Scales the kp and ki of every point so the table gives
+ * these gains at x. A gain that looks up as 0 at x is
+ * left as it was.
+ *
+ * schedule: the schedule
+ * x: scheduling variable the gains were found at
+ * gains: the gains found
+ *******************************************************/
+void
+fitGainSchedule (GainSchedule *schedule, num_t x, const GainPoint *gains);
+
+
+#endif /* _GAIN_SCHEDULE_H_ */
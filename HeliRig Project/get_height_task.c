@@ -1,8 +1,13 @@
 /*******************************************************
  * get_height_task.c
  *
- * A FreeRTOS task that uses a timer (TIMER1) interrupt the trigger the ADC,
- * saving the contents to a circular buffer
+ * A FreeRTOS task that works out the height from the ADC.
+ * TIMER1 triggers the ADC in hardware, with no timer
+ * interrupt. Each block of conversions is written by the
+ * ADC interrupt into a lock-free single producer, single
+ * consumer buffer (spscBuf.h), or with ADC_USE_UDMA moved
+ * by the uDMA into ping-pong halves (pingPongBuf.h), and
+ * the task averages (or with HEIGHT_FILTER, filters) them.
  *
  *  Created on: 12/08/2021
  *      Author: Group 1
@@ -15,6 +20,7 @@
 #include "inc/hw_memmap.h"
 #include "inc/hw_types.h"
 #include "inc/hw_ints.h"
+#include "inc/hw_adc.h"
 
 #include "driverlib/adc.h"
 #include "driverlib/pwm.h"
@@ -28,7 +34,9 @@
 
 #include "utils/ustdlib.h"
 
-#include "circBufT.h"
+#include "spscBuf.h"
+#include "pingPongBuf.h"
+#include "filter.h"
 
 #include "FreeRTOS.h"
 #include "task.h"
@@ -37,9 +45,66 @@
 #include "get_height_task.h"
 #include "helirig_structs.c"
 
-
-// From what I can tell this needs to be global as it is being accessed by the ADC Interrupt Handler
-static circBuf_t g_inBuffer;  // Buffer of size BUF_SIZE integers (sample values)
+#if ADC_USE_UDMA
+#include "driverlib/udma.h"
+#endif
+
+
+// Written by the ADC Interrupt Handler, read by getHeightTask
+static spscBuf_t g_inBuffer;  // Buffer of size BUF_SIZE integers (sample values)
+static volatile uint32_t g_inBufferData[BUF_SIZE];
+static uint32_t g_notifyCounts;  // Block mean getHeightTask was last notified at, only used by the ADC Interrupt Handler
+static TaskHandle_t g_heightTask;  // Notified by the ADC Interrupt Handler
+
+// Written by getHeightTask once the calibration window has passed, read by any task
+static HeightCalibration g_heightCal = {
+    HEIGHT_LANDED_NOMINAL, HEIGHT_FULL_SCALE_COUNTS, HEIGHT_CAL_SCALE, false, false
+};
+static volatile bool g_heightCalDone;  // Set once g_heightCal is written, for getHeightFromISR()
+
+#if HEIGHT_FILTER || ADC_USE_UDMA
+// Written by getHeightTask, read by getHeight()
+static volatile uint32_t g_heightADC;  // Newest filtered value or block mean
+#endif
+
+#if HEIGHT_FILTER
+// Height filter pipeline, only used by getHeightTask
+static filterChain_t g_heightFilter;
+static medianFilter_t g_heightMedian;
+static int32_t g_heightMedianHistory[HEIGHT_MEDIAN_SIZE];
+static int32_t g_heightMedianSorted[HEIGHT_MEDIAN_SIZE];
+static firFilter_t g_heightFir;
+static int16_t g_heightFirHistory[2 * HEIGHT_FIR_TAPS];
+static biquadFilter_t g_heightBiquad;
+static float g_heightBiquadState[2 * HEIGHT_BIQUAD_SECTIONS];
+
+// Hamming windowed sinc low-pass, 50 Hz cutoff at SAMPLE_RATE_HZ, Q15 (sums to 32768)
+static const int16_t g_heightFirCoeffs[HEIGHT_FIR_TAPS] = {
+      85,  105,  151,  227,  335,  475,  643,  836, 1045, 1262, 1475, 1675, 1850, 1990, 2089, 2141,
+    2141, 2089, 1990, 1850, 1675, 1475, 1262, 1045,  836,  643,  475,  335,  227,  151,  105,   85
+};
+
+// 2nd order Butterworth low-pass, 20 Hz cutoff at SAMPLE_RATE_HZ (bilinear transform)
+static const biquadCoeffs_t g_heightBiquadCoeffs[HEIGHT_BIQUAD_SECTIONS] = {
+    { 5.820761342e-04f, 1.164152268e-03f, 5.820761342e-04f, -1.930606427e+00f, 9.329347318e-01f }
+};
+#endif
+
+#if ADC_USE_UDMA
+// Filled by the uDMA, handed to getHeightTask by the ADC Interrupt Handler
+static pingPongBuf_t g_dmaBuffer;
+static volatile uint16_t g_dmaPing[ADC_DMA_HALF_SIZE];
+static volatile uint16_t g_dmaPong[ADC_DMA_HALF_SIZE];
+static const uint32_t g_dmaSelect[2] = { UDMA_PRI_SELECT, UDMA_ALT_SELECT };  // Control structure of each half
+
+// The uDMA control table must be 1024 byte aligned
+#if defined(__TI_ARM__)
+#pragma DATA_ALIGN(g_dmaControlTable, 1024)
+static tDMAControlTable g_dmaControlTable[64];
+#else
+static tDMAControlTable g_dmaControlTable[64] __attribute__ ((aligned(1024)));
+#endif
+#endif
 
 
 /*******************************************************
@@ -50,34 +115,113 @@ static circBuf_t g_inBuffer;  // Buffer of size BUF_SIZE integers (sample values
 void
 initADC (void)
 {
+    uint32_t step;
+
     // Enable ADC0 peripheral
     SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
     while (!SysCtlPeripheralReady(SYSCTL_PERIPH_ADC0));  // busy-wait until ADC0's bus clock is ready
 
-    // Configure the ADC to process a single sample (sequence 3) when the processor triggers
-    ADCSequenceConfigure(ADC0_BASE, 3, ADC_TRIGGER_PROCESSOR, 0);
+#if ADC_HW_OVERSAMPLE > 1
+    // Average ADC_HW_OVERSAMPLE conversions into every step
+    ADCHardwareOversampleConfigure(ADC0_BASE, ADC_HW_OVERSAMPLE);
+#endif
 
-    // Configure ADC Sequence 3
-    //      Sample channel 9 (ADC_CTL_CH9) for ADC from emulator height output.
-    //      Set the interrupt flag to be set after the data sample has been processed (ADC_CTL_IE).
-    //      End of sequence (ADC_CTL_END)
-    ADCSequenceStepConfigure(ADC0_BASE, 3, 0, ADC_CTL_CH0 | ADC_CTL_IE | ADC_CTL_END);
+    // Configure the ADC to process a block of ADC_STEPS_PER_TRIGGER samples each time TIMER1 times out
+    ADCSequenceConfigure(ADC0_BASE, ADC_SEQUENCE, ADC_TRIGGER_TIMER, 0);
+
+    // Configure the sequence steps
+    //      Sample channel 0 (ADC_CTL_CH0) for ADC from emulator height output on every step.
+    //      On the last step, set the interrupt flag once the block has been processed (ADC_CTL_IE)
+    //      and end the sequence (ADC_CTL_END)
+    for (step = 0; step < ADC_STEPS_PER_TRIGGER - 1; step++) {
+        ADCSequenceStepConfigure(ADC0_BASE, ADC_SEQUENCE, step, ADC_CTL_CH0);
+    }
+    ADCSequenceStepConfigure(ADC0_BASE, ADC_SEQUENCE, step, ADC_CTL_CH0 | ADC_CTL_IE | ADC_CTL_END);
 
-    // Enable ADC sequence 3
-    ADCSequenceEnable(ADC0_BASE, 3);
+    // Enable the ADC sequence
+    ADCSequenceEnable(ADC0_BASE, ADC_SEQUENCE);
 
+    // The handler notifies getHeightTask, so must run at a priority that may call FreeRTOS
+    IntPrioritySet(INT_ADC0SS0 + ADC_SEQUENCE, ADC_INT_PRIORITY);
+
+#if ADC_USE_UDMA
+    // Request the uDMA for the results, and interrupt only when it has filled a half-buffer
+    ADCSequenceDMAEnable(ADC0_BASE, ADC_SEQUENCE);
+    ADCIntRegister(ADC0_BASE, ADC_SEQUENCE, ADCIntHandler);
+    ADCIntEnableEx(ADC0_BASE, ADC_INT_DMA_SS0);
+#else
     // Register the interrupt handler
-    ADCIntRegister(ADC0_BASE, 3, ADCIntHandler);
+    ADCIntRegister(ADC0_BASE, ADC_SEQUENCE, ADCIntHandler);
 
     // Enable the ADC for interrupts
-    ADCIntEnable(ADC0_BASE, 3);
+    ADCIntEnable(ADC0_BASE, ADC_SEQUENCE);
+#endif
+}
+
+
+#if ADC_USE_UDMA
+/*******************************************************
+ * Function: initDMA
+ *
+ * Initialises the uDMA to move ADC sequence 0 results
+ * into the ping-pong half-buffers
+ *******************************************************/
+void
+initDMA (void)
+{
+    uint32_t half;
+
+    // Enable uDMA peripheral
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA));  // busy-wait until the uDMA's bus clock is ready
+
+    uDMAEnable();
+    uDMAControlBaseSet(g_dmaControlTable);
+
+    // Channel 14 serves ADC0 sequence 0, start from the primary (ping) control structure
+    uDMAChannelAssign(UDMA_CH14_ADC0_0);
+    uDMAChannelAttributeDisable(UDMA_CHANNEL_ADC0, UDMA_ATTR_ALTSELECT | UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+    uDMAChannelAttributeEnable(UDMA_CHANNEL_ADC0, UDMA_ATTR_USEBURST);
+
+    // 16 bit results from the FIFO into consecutive samples of each half
+    for (half = 0; half < 2; half++) {
+        uDMAChannelControlSet(UDMA_CHANNEL_ADC0 | g_dmaSelect[half], UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_1);
+        uDMATransferSet(UDMA_CHANNEL_ADC0 | g_dmaSelect[half], UDMA_MODE_PINGPONG, (void *) (ADC0_BASE + ADC_O_SSFIFO0),
+                        (void *) g_dmaBuffer.half[half], ADC_DMA_HALF_SIZE);
+    }
+
+    uDMAChannelEnable(UDMA_CHANNEL_ADC0);
+}
+#endif
+
+
+#if HEIGHT_FILTER
+/*******************************************************
+ * Function: initHeightFilter
+ *
+ * Builds the height filter pipeline (median, FIR, biquad)
+ *******************************************************/
+void
+initHeightFilter (void)
+{
+    initMedianFilter(&g_heightMedian, g_heightMedianHistory, g_heightMedianSorted, HEIGHT_MEDIAN_SIZE);
+    initFirFilter(&g_heightFir, g_heightFirCoeffs, g_heightFirHistory, HEIGHT_FIR_TAPS);
+    initBiquadFilter(&g_heightBiquad, g_heightBiquadCoeffs, g_heightBiquadState, HEIGHT_BIQUAD_SECTIONS);
+
+    // Spikes are removed first, so the linear stages never see them
+    initFilterChain(&g_heightFilter);
+    addFilterChain(&g_heightFilter, stepMedianFilter, &g_heightMedian);
+    addFilterChain(&g_heightFilter, stepFirFilter, &g_heightFir);
+    addFilterChain(&g_heightFilter, stepBiquadFilter, &g_heightBiquad);
 }
+#endif
 
 
 /*******************************************************
  * Function: initTimer
  *
- * Initialises a timer interrupt used to poll the ADC
+ * Initialises a periodic timer that triggers the ADC in
+ * hardware, so each sample costs only the ADC interrupt
  *******************************************************/
 void
 initTimer(void)
@@ -89,14 +233,11 @@ initTimer(void)
     // Configure the timer as periodic
     TimerConfigure(TIMER1_BASE, TIMER_CFG_PERIODIC);
 
-    // Set the frequency as SAMPLE_RATE_HZ
-    TimerLoadSet(TIMER1_BASE, TIMER_A, SysCtlClockGet() / SAMPLE_RATE_HZ);
+    // Set the frequency as ADC_TRIGGER_RATE_HZ, one block of samples per timeout (it counts the load value down to 0)
+    TimerLoadSet(TIMER1_BASE, TIMER_A, SysCtlClockGet() / ADC_TRIGGER_RATE_HZ - 1);
 
-    // Register the timerInterrupt handler
-    TimerIntRegister(TIMER1_BASE, TIMER_A, timerIntHandler);
-
-    // Enable the periodic timer interrupt
-    TimerIntEnable(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+    // Start the ADC sequence on every timeout, no timer interrupt is needed
+    TimerControlTrigger(TIMER1_BASE, TIMER_A, true);
 
     // Enable the timer
     TimerEnable(TIMER1_BASE, TIMER_A);
@@ -104,50 +245,211 @@ initTimer(void)
 
 
 /*******************************************************
- * Function: timerIntHandler
+ * Function: ADCIntHandler
  *
- * Periodic timer interrupt used to trigger the ADC
- * interrupt handler.
- * (There is a more efficient way to do this by triggering
- * the ACD interrupt handler directly in TimerIntRegister())
+ * Runs when a TIMER1 triggered block of conversions completes and writes it,
+ * or its mean (ADC_BLOCK_AVERAGE), to a circular buffer
+ * Notifies getHeightTask when the block mean moves HEIGHT_NOTIFY_COUNTS
  *******************************************************/
 void
-timerIntHandler(void)
+ADCIntHandler(void)
 {
-    // Trigger the ADC interrupt handler
-    ADCProcessorTrigger(ADC0_BASE, 3);
+#if ADC_USE_UDMA
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    uint32_t half;
+
+    // Clear the Interrupt
+    ADCIntClearEx(ADC0_BASE, ADC_INT_DMA_SS0);
+
+    // Re-arm every half the uDMA has finished with, in the order they were filled, and pass it to the task
+    half = nextPingPongBuf(&g_dmaBuffer);
+    while (uDMAChannelModeGet(UDMA_CHANNEL_ADC0 | g_dmaSelect[half]) == UDMA_MODE_STOP) {
+        uDMATransferSet(UDMA_CHANNEL_ADC0 | g_dmaSelect[half], UDMA_MODE_PINGPONG, (void *) (ADC0_BASE + ADC_O_SSFIFO0),
+                        (void *) g_dmaBuffer.half[half], ADC_DMA_HALF_SIZE);
+        completePingPongBuf(&g_dmaBuffer);
+        if (g_heightTask != NULL) {
+            vTaskNotifyGiveFromISR(g_heightTask, &higherPriorityTaskWoken);
+        }
+        half = nextPingPongBuf(&g_dmaBuffer);
+    }
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+#else
+    // Initialise variables
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    uint32_t ulValues[ADC_MAX_STEPS];  // Sized for a full FIFO, in case a block was missed
+    uint32_t sum = 0;
+    uint32_t mean;
+    int32_t count;
+    int32_t i;
+
+    // Read the block of data from the ADC FIFO
+    count = ADCSequenceDataGet(ADC0_BASE, ADC_SEQUENCE, ulValues);
+    for (i = 0; i < count; i++) {
+        sum = sum + ulValues[i];
+    }
+
+#if ADC_BLOCK_AVERAGE
+    // Write the mean of the block to the circular buffer
+    if (count > 0) {
+        writeSpscBuf(&g_inBuffer, (sum + count / 2) / count);
+    }
+#else
+    // Write every ADC sample to the circular buffer
+    for (i = 0; i < count; i++) {
+        writeSpscBuf(&g_inBuffer, ulValues[i]);
+    }
+#endif
+
+    // Wake getHeightTask if the reading has moved HEIGHT_NOTIFY_COUNTS since it was last woken
+    if (count > 0 && g_heightTask != NULL) {
+        mean = (sum + count / 2) / count;
+        if (mean >= g_notifyCounts + HEIGHT_NOTIFY_COUNTS || mean + HEIGHT_NOTIFY_COUNTS <= g_notifyCounts) {
+            g_notifyCounts = mean;
+            xTaskNotifyFromISR(g_heightTask, HEIGHT_EVENT_MOVED, eSetBits, &higherPriorityTaskWoken);
+        }
+    }
+
+    // Clear the Interrupt
+    ADCIntClear(ADC0_BASE, ADC_SEQUENCE);
 
-    //
-    TimerIntClear(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+#endif
 }
 
+
 /*******************************************************
- * Function: ADCIntHandler
+ * Function: heightFromADC
+ *
+ * Maps an ADC reading to height with the calibration
  *
- * Triggered by the timer interrupt and writes the output to a circular buffer
+ * returns: height in %, rounded to the nearest %
+ *******************************************************/
+int32_t
+heightFromADC (uint32_t counts)
+{
+    // The sensor voltage falls as the height rises, so the height is the drop from landed
+    return ((int32_t) (g_heightCal.landed - counts) * g_heightCal.scale + (1 << (HEIGHT_CAL_SHIFT - 1))) >> HEIGHT_CAL_SHIFT;
+}
+
+
+/*******************************************************
+ * Function: finishHeightCalibration
+ *
+ * Sets the landed reading from the calibration window
+ *
+ * landed: mean ADC reading over the window
+ *******************************************************/
+static void
+finishHeightCalibration (uint32_t landed)
+{
+    taskENTER_CRITICAL();  // getHeightCalibration() must not see the fields part written
+    if (landed + HEIGHT_CAL_TOLERANCE < HEIGHT_LANDED_NOMINAL || landed > HEIGHT_LANDED_NOMINAL + HEIGHT_CAL_TOLERANCE) {
+        g_heightCal.fallback = true;  // Not landed, or the sensor is not connected
+    } else {
+        g_heightCal.landed = landed;
+    }
+    g_heightCal.complete = true;
+    taskEXIT_CRITICAL();
+    g_heightCalDone = true;  // Only now, an interrupt above the critical section could have seen it part written
+}
+
+
+/*******************************************************
+ * Function: getHeightCalibration
+ *
+ * Copies out the height calibration, for telemetry and display
  *******************************************************/
 void
-ADCIntHandler(void)
+getHeightCalibration (HeightCalibration *calibration)
+{
+    taskENTER_CRITICAL();
+    *calibration = g_heightCal;
+    taskEXIT_CRITICAL();
+}
+
+
+/*******************************************************
+ * Function: latestHeightADC
+ *
+ * returns: the mean of the newest BUF_SIZE samples (with
+ *          HEIGHT_FILTER or ADC_USE_UDMA, the newest value
+ *          getHeightTask worked out). Lock-free, so safe
+ *          from any interrupt.
+ *******************************************************/
+static uint32_t
+latestHeightADC (void)
 {
-    // Initialise variable
-    uint32_t ulValue;
+#if HEIGHT_FILTER || ADC_USE_UDMA
+    return g_heightADC;
+#else
+    uint32_t count;
+    uint32_t sum = sumSpscBuf(&g_inBuffer, &count);  // Never empty once calibrated
+
+    return (2 * sum + count) / 2 / count;
+#endif
+}
 
-    // Read data from ACD and store in variable
-    ADCSequenceDataGet(ADC0_BASE, 3, &ulValue);
 
-    // Write ADC data to circular buffer
-    writeCircBuf(&g_inBuffer, ulValue);
+/*******************************************************
+ * Function: getHeight
+ *
+ * Reads the height for a controller: the mean of the
+ * newest BUF_SIZE samples at the moment of the call, so
+ * the caller decides when it is sampled (with HEIGHT_FILTER
+ * or ADC_USE_UDMA, the newest value getHeightTask worked out)
+ *
+ * height: set to the height in %
+ *
+ * returns: false until the calibration is complete
+ *******************************************************/
+bool
+getHeight (int32_t *height)
+{
+    bool complete;
 
-    // Clear the Interrupt
-    ADCIntClear(ADC0_BASE, 3);
+    taskENTER_CRITICAL();
+    complete = g_heightCal.complete;
+    taskEXIT_CRITICAL();
+    if (!complete) {
+        return false;
+    }
+
+    *height = heightFromADC(latestHeightADC());
+    return true;
+}
+
+
+/*******************************************************
+ * Function: getHeightFromISR
+ *
+ * As getHeight(), without a critical section, for an
+ * interrupt above configMAX_SYSCALL_INTERRUPT_PRIORITY
+ *
+ * height: set to the height in %
+ *
+ * returns: false until the calibration is complete
+ *******************************************************/
+bool
+getHeightFromISR (int32_t *height)
+{
+    if (!g_heightCalDone) {
+        return false;
+    }
+
+    *height = heightFromADC(latestHeightADC());
+    return true;
 }
 
 
 /*******************************************************
  * Function: GetHeightTask
  *
- * Reads the circular buffer and averages the values to get current height
- * Writes the current height to the FreeRTOS Queue OLEDQueue
+ * Reads the circular buffer and averages the values (or with HEIGHT_FILTER,
+ * filters every sample) to get current height
+ * Calibrates the landed reading for the first HEIGHT_CAL_MS
+ * Writes the current height to the FreeRTOS Queue OLEDQueue when it changes
+ * (at most every HEIGHT_PUBLISH_MIN_MS), or when it has not for HEIGHT_MAX_STALE_MS
  *
  * pvParameters: NULL
  *******************************************************/
@@ -159,15 +461,37 @@ getHeightTask (void *pvParameters)
     // Cast the queue pointer in pvParameters back into a Queue type
     xQueueHandle Queue = *((xQueueHandle *) pvParameters);
 
-    // Used for averaging the ADC Buffer
-    uint16_t i;
-    int32_t sum;
+    // Used for averaging (or filtering) the ADC Buffer
+#if HEIGHT_FILTER
+    int32_t filtered = 0;
+#else
+    uint32_t sum;
+#endif
+#if !(ADC_USE_UDMA && HEIGHT_FILTER)
+    uint32_t count;
+#endif
+#if ADC_USE_UDMA
+    const volatile uint16_t *block;
+    uint32_t ticket;
+    uint32_t i;
+#elif HEIGHT_FILTER
+    uint32_t sample;
+#endif
 
     // Used for mapping average ADC value to altitude (linear)
     uint32_t x;
-    uint32_t y;
-    uint16_t b = 242;
-    double m = -0.081;
+    int32_t y;
+
+    // Used for calibrating the landed ADC value
+    uint32_t calPasses = 0;
+    uint32_t calSum = 0;
+    bool calibrating;
+
+    // Used for sending only changes
+    int32_t sent = INT32_MIN;  // Height last sent, none yet
+    TickType_t sentTick = 0;
+    bool send;
+    bool moving = false;  // The last height sent was a change
 
     // Used for sending a message to the OLED display task
     OLEDMessage Message;
@@ -175,28 +499,102 @@ getHeightTask (void *pvParameters)
 
     while(1){
 
-        // Average the ADC values stored in the circular buffer
+#if ADC_USE_UDMA
+        // Wait for the uDMA to fill a half-buffer, then average (or filter) the whole block
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        block = acquirePingPongBuf(&g_dmaBuffer, &ticket);
+        if (block == NULL) {
+            continue;  // Already handled with an earlier notification
+        }
+#if HEIGHT_FILTER
+        for (i = 0; i < ADC_DMA_HALF_SIZE; i++) {
+            filtered = stepFilterChain(&g_heightFilter, block[i]);
+        }
+#else
         sum = 0;
-        for (i = 0; i < BUF_SIZE; i++) {
-            sum = sum + readCircBuf (&g_inBuffer);
+        for (i = 0; i < ADC_DMA_HALF_SIZE; i++) {
+            sum = sum + block[i];
         }
-        x = (2 * sum + BUF_SIZE) / 2 / BUF_SIZE; // Averaged Value
-
-        // Adjust average ADC value into altitude reading
-        y = (m*x) + b; // Mapped value
+        count = ADC_DMA_HALF_SIZE;
+#endif
+        if (!checkPingPongBuf(&g_dmaBuffer, ticket, uDMAChannelSizeGet(UDMA_CHANNEL_ADC0 | g_dmaSelect[(ticket - 1) & 1]))) {
+            continue;  // The uDMA started refilling it while it was being read (the filter then took some newer samples)
+        }
+#elif HEIGHT_FILTER
+        // Filter every sample written since the last pass, the newest output is the height
+        count = 0;
+        while (readSpscBuf(&g_inBuffer, &sample)) {
+            filtered = stepFilterChain(&g_heightFilter, sample);
+            count++;
+        }
+        if (count == 0) {
+            vTaskDelay(ADC_DISPLAY_RATE / portTICK_RATE_MS);  // No samples yet
+            continue;
+        }
+#else
+        // Average the ADC values in the circular buffer, using the sum kept by the ADC interrupt
+        sum = sumSpscBuf(&g_inBuffer, &count);
+        if (count == 0) {
+            vTaskDelay(ADC_DISPLAY_RATE / portTICK_RATE_MS);  // No samples yet
+            continue;
+        }
+#endif
+#if HEIGHT_FILTER
+        x = filtered; // Filtered Value
+#else
+        x = (2 * sum + count) / 2 / count; // Averaged Value
+#endif
+#if HEIGHT_FILTER || ADC_USE_UDMA
+        g_heightADC = x;  // For getHeight()
+#endif
 
         // Store a message into the OLEDMessage string buffer.
         Message.charLine = 1;
         Message.charPos = 0;
-        usnprintf(Message.strBuf, sizeof(Message.strBuf), "Height (/): %d ", y);
+
+        calibrating = calPasses < HEIGHT_CAL_PASSES;
+        if (calibrating) {
+            // Still calibrating, average the landed value
+            calSum = calSum + x;
+            calPasses++;
+            if (calPasses == HEIGHT_CAL_PASSES) {
+                finishHeightCalibration((calSum + HEIGHT_CAL_PASSES / 2) / HEIGHT_CAL_PASSES);
+            }
+            usnprintf(Message.strBuf, sizeof(Message.strBuf), "Height (/): cal ");
+            send = true;
+        } else {
+            // Adjust average ADC value into altitude reading
+            y = heightFromADC(x); // Mapped value
+            usnprintf(Message.strBuf, sizeof(Message.strBuf), "Height (/): %d ", y);
+
+            // Only send it on if it changed, or has not been sent for HEIGHT_MAX_STALE_MS
+            moving = (y != sent);
+            send = moving || xTaskGetTickCount() - sentTick >= HEIGHT_MAX_STALE_MS / portTICK_RATE_MS;
+            if (send) {
+                sent = y;
+                sentTick = xTaskGetTickCount();
+            }
+        }
 
         // Send the Message to the OLEDQueue
-        if (pdTRUE != xQueueSend(Queue, (void*)&Message, 10)) {  // Check if the message can be sent to the LEDQueue, wait 10 ticks
+        if (send && pdTRUE != xQueueSend(Queue, (void*)&Message, 10)) {  // Check if the message can be sent to the LEDQueue, wait 10 ticks
             while(1);  // Can't sent to Queue
         }
 
-        // Delay the task
-        vTaskDelay(ADC_DISPLAY_RATE / portTICK_RATE_MS);
+#if !ADC_USE_UDMA
+        if (calibrating) {
+            // Calibrate over exactly HEIGHT_CAL_PASSES periods
+            vTaskDelay(ADC_DISPLAY_RATE / portTICK_RATE_MS);
+            continue;
+        }
+        if (send) {
+            vTaskDelay(HEIGHT_PUBLISH_MIN_MS / portTICK_RATE_MS);  // Movement meanwhile is still notified
+        }
+
+        // Wait for the ADC interrupt to report movement, or to look again
+        xTaskNotifyWait(0, 0xFFFFFFFF, NULL,
+                        (HEIGHT_FILTER || moving ? ADC_DISPLAY_RATE : HEIGHT_MAX_STALE_MS) / portTICK_RATE_MS);
+#endif
     }
 }
 
@@ -205,7 +603,7 @@ getHeightTask (void *pvParameters)
  * Function: initGetHeightTask
  *
  * Creates the FreeRTOS task GetHeightTask
- *      Initialises the ADC, a timer, and a circular buffer
+ *      Initialises the ADC, a timer, a circular buffer and the height filter
  *
  * returns: 0 on successful creation of GetHeightTask
  *          1 on failed attempt
@@ -213,12 +611,20 @@ getHeightTask (void *pvParameters)
 uint8_t
 initGetHeightTask(xQueueHandle* OLEDQueue)
 {
+    initSpscBuf(&g_inBuffer, g_inBufferData, BUF_SIZE);  // Initialise the circular buffer before the ADC can write to it
+    g_notifyCounts = 0;
+#if HEIGHT_FILTER
+    initHeightFilter();  // Initialise the filter pipeline
+#endif
+#if ADC_USE_UDMA
+    initPingPongBuf(&g_dmaBuffer, g_dmaPing, g_dmaPong, ADC_DMA_HALF_SIZE);  // Initialise the half-buffers before the uDMA can write to them
+    initDMA();  // Initialise the uDMA
+#endif
     initADC();  // Initialise the ADC
-    initTimer();  // Initialise interrupt timer
-    initCircBuf(&g_inBuffer, BUF_SIZE);  // Initialise the circular buffer
+    initTimer();  // Initialise the ADC trigger timer
 
     //Create getHeightTask task
-    if (pdTRUE != xTaskCreate(getHeightTask, "Get Height Data", TASK_STACK_DEPTH, (void *) OLEDQueue, TASK_PRIORITY, NULL))
+    if (pdTRUE != xTaskCreate(getHeightTask, "Get Height Data", HEIGHT_STACK_DEPTH, (void *) OLEDQueue, TASK_PRIORITY, &g_heightTask))
     {
         return(1);  // Fail (Must not have had enough memory to create the task)
     }
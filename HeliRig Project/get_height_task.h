@@ -4,8 +4,13 @@
 /*******************************************************
  * get_height_task.c
  *
- * A FreeRTOS task that uses a timer (TIMER1) interrupt the trigger the ADC,
- * saving the contents to a circular buffer
+ * A FreeRTOS task that works out the height from the ADC.
+ * TIMER1 triggers the ADC in hardware, with no timer
+ * interrupt. Each block of conversions is written by the
+ * ADC interrupt into a lock-free single producer, single
+ * consumer buffer (spscBuf.h), or with ADC_USE_UDMA moved
+ * by the uDMA into ping-pong halves (pingPongBuf.h), and
+ * the task averages (or with HEIGHT_FILTER, filters) them.
  *
  *  Created on: 12/08/2021
  *      Author: Group 1
@@ -15,12 +20,143 @@
 /*******************************************************
  * Constants
  *******************************************************/
+#ifndef TASK_STACK_DEPTH  // The host simulation needs larger stacks (Simulation/FreeRTOSConfig.h)
 #define TASK_STACK_DEPTH    32
+#endif
 #define TASK_PRIORITY       4
 
-#define BUF_SIZE 4
-#define ADC_DISPLAY_RATE    25  // in ms
-#define SAMPLE_RATE_HZ      10
+#define ADC_DISPLAY_RATE    25  // in ms, period the height is averaged over and looked at while it changes
+#define SAMPLE_RATE_HZ      2560  // Conversions per second
+#define SAMPLES_PER_DISPLAY (SAMPLE_RATE_HZ * ADC_DISPLAY_RATE / 1000)  // 64, samples in one ADC_DISPLAY_RATE period
+
+// Height filtering
+//      By default the height is the mean of the last BUF_SIZE samples (a moving average).
+//      With HEIGHT_FILTER every sample instead goes through a pipeline of filters (filter.h),
+//      set up in initHeightFilter(): a 5 sample median for spikes, a 32 tap FIR low-pass
+//      (50 Hz) and a 2nd order Butterworth biquad low-pass (20 Hz). The coefficients are
+//      designed for SAMPLE_RATE_HZ, so the filter needs every sample (not ADC_BLOCK_AVERAGE).
+#ifndef HEIGHT_FILTER
+#define HEIGHT_FILTER       0
+#endif
+#define HEIGHT_MEDIAN_SIZE      5
+#define HEIGHT_FIR_TAPS         32
+#define HEIGHT_BIQUAD_SECTIONS  1
+
+#if HEIGHT_FILTER
+#define BUF_SIZE 128  // Must be a power of two (spscBuf), holds two ADC_DISPLAY_RATE periods so no samples are lost between passes
+#else
+#define BUF_SIZE 64  // Must be a power of two (spscBuf), averaging costs the same at any size, one ADC_DISPLAY_RATE period
+#endif
+
+#ifndef HEIGHT_STACK_DEPTH
+#if HEIGHT_FILTER
+#define HEIGHT_STACK_DEPTH  128  // The float biquad adds the FPU context (about 50 words) and stepFilterChain()'s calls
+#else
+#define HEIGHT_STACK_DEPTH  TASK_STACK_DEPTH
+#endif
+#endif
+
+// ADC capture
+//      ADC_SEQUENCE 3 converts one step per trigger. Sequence 0 converts a block of up to 8 steps
+//      back to back per trigger, with one interrupt for the block. The ADC also averages
+//      ADC_HW_OVERSAMPLE conversions into each step (1 for off, or 2 to 64 in powers of two).
+//      With ADC_BLOCK_AVERAGE the interrupt writes the block mean to the buffer, otherwise every step,
+//      so BUF_SIZE then spans ADC_STEPS_PER_TRIGGER times as long.
+#ifndef ADC_SEQUENCE  // Each can be overridden from the build options (see Testing/adcTriggerTest.c)
+#define ADC_SEQUENCE            0  // 0 (8 step FIFO) or 3 (1 step FIFO)
+#endif
+#ifndef ADC_STEPS_PER_TRIGGER
+#define ADC_STEPS_PER_TRIGGER   8
+#endif
+#ifndef ADC_HW_OVERSAMPLE
+#define ADC_HW_OVERSAMPLE       1
+#endif
+#ifndef ADC_BLOCK_AVERAGE
+#define ADC_BLOCK_AVERAGE       0
+#endif
+#define ADC_MAX_STEPS           8  // Sequence 0 FIFO depth
+#define ADC_TRIGGER_RATE_HZ     (SAMPLE_RATE_HZ / ADC_STEPS_PER_TRIGGER)  // TIMER1 rate, and ADC interrupt rate
+
+#if (ADC_SEQUENCE == 3 && ADC_STEPS_PER_TRIGGER != 1) || (ADC_SEQUENCE == 0 && ADC_STEPS_PER_TRIGGER > ADC_MAX_STEPS) \
+    || (ADC_SEQUENCE != 0 && ADC_SEQUENCE != 3) || ADC_STEPS_PER_TRIGGER < 1
+#error "ADC_STEPS_PER_TRIGGER must be 1 for sequence 3, or 1 to 8 for sequence 0"
+#endif
+#if SAMPLE_RATE_HZ % ADC_STEPS_PER_TRIGGER != 0
+#error "SAMPLE_RATE_HZ must be a multiple of ADC_STEPS_PER_TRIGGER"
+#endif
+#if HEIGHT_FILTER && ADC_BLOCK_AVERAGE
+#error "HEIGHT_FILTER needs every sample, set ADC_BLOCK_AVERAGE 0"
+#endif
+
+// uDMA capture
+//      With ADC_USE_UDMA the uDMA moves sequence 0 results straight into two alternating
+//      half-buffers (ping-pong), and the ADC interrupt only runs when a half is full.
+//      getHeightTask is woken once per half and averages the whole block.
+//      The uDMA is not simulated, so the host simulation only builds with this off.
+#ifndef ADC_USE_UDMA
+#define ADC_USE_UDMA            0
+#endif
+#define ADC_DMA_HALF_SIZE       SAMPLES_PER_DISPLAY  // Samples per half-buffer, one ADC_DISPLAY_RATE period
+#define ADC_INT_PRIORITY        (2 << 5)  // Must not be above configMAX_SYSCALL_INTERRUPT_PRIORITY, the ISR calls FreeRTOS
+
+#if ADC_USE_UDMA && (ADC_SEQUENCE != 0 || ADC_BLOCK_AVERAGE)
+#error "ADC_USE_UDMA needs ADC_SEQUENCE 0 and ADC_BLOCK_AVERAGE 0"
+#endif
+
+// Publishing
+//      getHeightTask does not poll. ADCIntHandler notifies it (xTaskNotifyFromISR) when the
+//      mean of a block has moved HEIGHT_NOTIFY_COUNTS since it last did, and it sends the height
+//      on when it changes, at most every HEIGHT_PUBLISH_MIN_MS. The average trails a step by up to
+//      ADC_DISPLAY_RATE, so while the height is changing it also looks again every ADC_DISPLAY_RATE.
+//      With nothing happening it still sends the height every HEIGHT_MAX_STALE_MS. The filter
+//      pipeline needs every sample before the buffer fills, so with HEIGHT_FILTER it always looks
+//      every ADC_DISPLAY_RATE, and only the sending is cut. With ADC_USE_UDMA it is woken per
+//      half-buffer as before.
+#define HEIGHT_NOTIFY_COUNTS    12  // ADC counts, about 1% height
+#define HEIGHT_PUBLISH_MIN_MS   20  // Least time between heights sent, limits the OLED traffic
+#define HEIGHT_MAX_STALE_MS     500  // Most time between heights sent
+#define HEIGHT_EVENT_MOVED      (1 << 0)  // getHeightTask notification bit
+
+#if HEIGHT_FILTER && (HEIGHT_PUBLISH_MIN_MS + ADC_DISPLAY_RATE) * SAMPLE_RATE_HZ > BUF_SIZE * 1000
+#error "HEIGHT_FILTER: BUF_SIZE must hold the samples between passes"
+#endif
+
+// Height calibration
+//      For the first HEIGHT_CAL_MS getHeightTask averages the reading with the helicopter
+//      landed, which becomes 0% height. 100% is HEIGHT_FULL_SCALE_MV below it, the voltage
+//      drop of the height sensor over its full range. After that each reading is turned into
+//      a height with one multiply and shift (heightFromADC()). A landed reading more than
+//      HEIGHT_CAL_TOLERANCE from HEIGHT_LANDED_NOMINAL is not trusted, and the nominal is used.
+#ifndef HEIGHT_CAL_MS
+#define HEIGHT_CAL_MS           500  // in ms, a multiple of ADC_DISPLAY_RATE
+#endif
+#define HEIGHT_CAL_PASSES       (HEIGHT_CAL_MS / ADC_DISPLAY_RATE)
+#define HEIGHT_FULL_SCALE_MV    1000  // Height sensor drop from 0% to 100%
+#define ADC_VREF_MV             3300
+#define ADC_COUNTS              4096  // 12 bit, one count is ADC_VREF_MV / ADC_COUNTS
+#define HEIGHT_LANDED_NOMINAL   2988  // ADC counts at 0% height on a typical rig
+#define HEIGHT_CAL_TOLERANCE    400  // ADC counts either side of HEIGHT_LANDED_NOMINAL
+#define HEIGHT_CAL_SHIFT        16  // Fraction bits of HeightCalibration.scale
+#define HEIGHT_FULL_SCALE_COUNTS ((HEIGHT_FULL_SCALE_MV * ADC_COUNTS + ADC_VREF_MV / 2) / ADC_VREF_MV)  // 1241
+#define HEIGHT_CAL_SCALE        (((100 << HEIGHT_CAL_SHIFT) + HEIGHT_FULL_SCALE_COUNTS / 2) / HEIGHT_FULL_SCALE_COUNTS)
+
+#if HEIGHT_CAL_PASSES < 1
+#error "HEIGHT_CAL_MS must be at least ADC_DISPLAY_RATE"
+#endif
+
+
+/*******************************************************
+ * Types
+ *******************************************************/
+// Result of the height calibration, see getHeightCalibration()
+typedef struct Height_Calibration
+{
+    uint32_t landed;  // ADC counts at 0% height
+    uint32_t fullScale;  // ADC counts from 0% to 100% height
+    int32_t scale;  // Height (%) per count below landed, with HEIGHT_CAL_SHIFT fraction bits
+    bool complete;  // The calibration window has passed, until then the nominal values are used
+    bool fallback;  // The landed reading was out of range and HEIGHT_LANDED_NOMINAL is used
+} HeightCalibration;
 
 /*******************************************************
  * Function: initADC
@@ -30,41 +166,112 @@
 void initADC (void);
 
 
+#if ADC_USE_UDMA
 /*******************************************************
- * Function: initTimer
+ * Function: initDMA
  *
- * Initialises a timer interrupt used to poll the ADC
+ * Initialises the uDMA to move ADC sequence 0 results
+ * into the ping-pong half-buffers
  *******************************************************/
 void
-initTimer(void);
+initDMA (void);
+#endif
 
 
+#if HEIGHT_FILTER
 /*******************************************************
- * Function: timerIntHandler
+ * Function: initHeightFilter
  *
- * Periodic timer interrupt used to trigger the ADC
- * interrupt handler.
- * (There is a more efficient way to do this by triggering
- * the ACD interrupt handler directly in TimerIntRegister())
+ * Builds the height filter pipeline (median, FIR, biquad)
  *******************************************************/
 void
-timerIntHandler(void);
+initHeightFilter (void);
+#endif
+
+
+/*******************************************************
+ * Function: initTimer
+ *
+ * Initialises a periodic timer that triggers the ADC in
+ * hardware, so each sample costs only the ADC interrupt
+ *******************************************************/
+void
+initTimer(void);
 
 
 /*******************************************************
  * Function: ADCIntHandler
  *
- * Triggered by the timer interrupt and writes the output to a circular buffer
+ * Runs when a TIMER1 triggered block of conversions completes and writes it,
+ * or its mean (ADC_BLOCK_AVERAGE), to a circular buffer
+ * Notifies getHeightTask when the block mean moves HEIGHT_NOTIFY_COUNTS
+ * With ADC_USE_UDMA, runs when the uDMA fills a half-buffer, re-arms it and
+ * wakes getHeightTask
  *******************************************************/
 void
 ADCIntHandler(void);
 
 
+/*******************************************************
+ * Function: heightFromADC
+ *
+ * Maps an ADC reading to height with the calibration
+ *
+ * returns: height in %, rounded to the nearest %
+ *******************************************************/
+int32_t
+heightFromADC (uint32_t counts);
+
+
+/*******************************************************
+ * Function: getHeightCalibration
+ *
+ * Copies out the height calibration, for telemetry and display
+ *******************************************************/
+void
+getHeightCalibration (HeightCalibration *calibration);
+
+
+/*******************************************************
+ * Function: getHeight
+ *
+ * Reads the height for a controller: the mean of the
+ * newest BUF_SIZE samples at the moment of the call, so
+ * the caller decides when it is sampled (with HEIGHT_FILTER
+ * or ADC_USE_UDMA, the newest value getHeightTask worked out)
+ *
+ * height: set to the height in %
+ *
+ * returns: false until the calibration is complete
+ *******************************************************/
+bool
+getHeight (int32_t *height);
+
+
+/*******************************************************
+ * Function: getHeightFromISR
+ *
+ * As getHeight(), without a critical section, for an
+ * interrupt above configMAX_SYSCALL_INTERRUPT_PRIORITY
+ * (CONTROL_IN_ISR)
+ *
+ * height: set to the height in %
+ *
+ * returns: false until the calibration is complete
+ *******************************************************/
+bool
+getHeightFromISR (int32_t *height);
+
+
 /*******************************************************
  * Function: GetHeightTask
  *
- * Reads the circular buffer and averages the values to get current height
+ * Reads the circular buffer (or with ADC_USE_UDMA, each filled half-buffer)
+ * and averages the values (or with HEIGHT_FILTER, filters every sample)
+ * to get current height
+ * Calibrates the landed reading for the first HEIGHT_CAL_MS
  * Writes the current height to the FreeRTOS Queue OLEDQueue
+ * when it changes, or has not for HEIGHT_MAX_STALE_MS
  *
  * pvParameters: NULL
  *******************************************************/
@@ -76,7 +283,7 @@ getHeightTask (void *pvParameters);
  * Function: initGetHeightTask
  *
  * Creates the FreeRTOS task GetHeightTask
- *      Initialises the ADC, a timer, and a circular buffer
+ *      Initialises the ADC, a timer, a circular buffer and the height filter
  *
  * returns: 0 on successful creation of GetHeightTask
  *          1 on failed attempt
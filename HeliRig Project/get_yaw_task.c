@@ -13,8 +13,14 @@
 #include <stdbool.h>
 #include "inc/hw_memmap.h"
 #include "inc/hw_types.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_gpio.h"
+#include "inc/hw_qei.h"
 #include "driverlib/gpio.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/qei.h"
 #include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
 #include "driverlib/interrupt.h"
 #include "driverlib/debug.h"
 #include "utils/ustdlib.h"
@@ -24,43 +30,368 @@
 #include "task.h"
 #include "queue.h"
 
+#include "heli_math.h"
 #include "get_yaw_task.h"
+#include "relay_tune.h"
+#include "control_task.h"
 #include "helirig_structs.c"
 
-static volatile QuadType QuadData; // Used by an interrupt so needs to be global
+// Used by an interrupt so need to be global. Only the interrupt writes the count, tasks
+// take a snapshot of it and follow it with a YawPosition.
+static volatile uint32_t g_quadIllegal;  // Transitions where A and B both changed (an edge was missed)
+static volatile uint32_t g_refCount;  // Quadrature count at the reference, valid once g_refFound is set
+static volatile bool g_refFound;  // Set once by yawRefIntHandler (or initYawRef), after g_refCount
+static uint32_t g_notifyCount;  // Count getYawTask was last notified at, only used by the interrupts
+static TaskHandle_t g_yawTask;  // Notified by the interrupts
+#if !YAW_USE_QEI
+static volatile uint32_t g_quadCount;  // Quadrature count, one per A/B edge, wraps at 2^32
+static uint32_t g_quadState;  // A/B at the last interrupt, only used by quadIntHandler
 
+// Edge record for the velocity estimate, written by quadIntHandler. Readers do not mask
+// the interrupt, so an edge is never held up by one. They instead retry until g_edgeSeq
+// is unchanged (and even) across their copy, up to YAW_SNAPSHOT_TRIES times.
+static volatile uint32_t g_edgeSeq;  // Odd while quadIntHandler is writing the record
+static volatile uint32_t g_edgeTime[YAW_EDGE_HISTORY];  // Timer ticks at each edge, counting up
+static volatile uint32_t g_edgeIndex;  // Edges timed, g_edgeTime[(g_edgeIndex - 1) % YAW_EDGE_HISTORY] is the newest
+static volatile uint32_t g_edgeRun;  // Edges in a row in the same direction, at most YAW_EDGE_HISTORY
+static volatile int32_t g_edgeDir;  // Direction of the last edge, +1 or -1
+static uint32_t g_timerHz;  // Rate of the edge timer
+static volatile int32_t g_quadVelocity;  // Last returned by getQuadVelocity
+
+// A copy of the edge record, taken by quadEdgeSnapshot
+typedef struct Quad_Edges
+{
+    uint32_t count;  // g_quadCount at the newest edge
+    uint32_t time[YAW_PERIOD_EDGES + 1];  // Newest edge first
+    uint32_t run;
+    int32_t dir;
+} QuadEdges;
+
+// Change in count for each transition, indexed by (previous AB << 2) | current AB,
+// where AB is the Port B read (A in bit 0, B in bit 1). B leading A counts up.
+// No change, and illegal transitions (both pins changed), count 0.
+static const int8_t g_quadTable[16] = {
+//  to AB: 00  01  10  11       from AB:
+            0, -1, +1,  0,  //  00
+           +1,  0,  0, -1,  //  01
+           -1,  0,  0, +1,  //  10
+            0, +1, -1,  0   //  11
+};
+#endif
+
+/*******************************************************
+ * Function: notifyMoved
+ *
+ * Notifies getYawTask if the count has moved
+ * YAW_NOTIFY_COUNTS either way since it was last notified.
+ * Only called from the interrupts, which share a priority.
+ *
+ * count: the quadrature count now
+ *******************************************************/
+static void
+notifyMoved (uint32_t count, BaseType_t *higherPriorityTaskWoken)
+{
+    int32_t moved = (int32_t) (count - g_notifyCount);
+
+    if (g_yawTask != NULL && (moved >= YAW_NOTIFY_COUNTS || moved <= -YAW_NOTIFY_COUNTS)) {
+        g_notifyCount = count;
+        xTaskNotifyFromISR(g_yawTask, YAW_EVENT_MOVED, eSetBits, higherPriorityTaskWoken);
+    }
+}
+
+#if !YAW_USE_QEI
 /*******************************************************
  * Function: quadIntHandler
  *
  * Initialises the GPIO interrupt handler
+ *      Decodes each A/B edge from one read of Port B
+ *      and the transition table
+ *      Notifies getYawTask every YAW_NOTIFY_COUNTS
  *******************************************************/
  
 void
 quadIntHandler(void)
 {
-    // Set Quadrature data
-    QuadData.A = (GPIOPinRead (GPIO_PORTB_BASE, GPIO_PIN_0) == GPIO_PIN_0);
-    QuadData.B = (GPIOPinRead (GPIO_PORTB_BASE, GPIO_PIN_1) == GPIO_PIN_1);
-    QuadData.L = (QuadData.A^QuadData.Bp);
-    QuadData.R = (QuadData.B^QuadData.Ap);
-    QuadData.sum = QuadData.sum - QuadData.L + QuadData.R;
-    QuadData.Ap = QuadData.A;
-    QuadData.Bp = QuadData.B;
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    uint32_t state;
+    uint32_t index;
+    uint32_t time;
+    int32_t step;
+
+    // Clear interrupts first, so an edge during the read below raises it again
+    GPIOIntClear(GPIO_PORTB_BASE, GPIO_INT_PIN_0 | GPIO_INT_PIN_1);
+
+    // Read A and B together, and the time as close to the edge as possible
+    state = GPIOPinRead(GPIO_PORTB_BASE, QUAD_PINS);
+    time = ~TimerValueGet(YAW_TIMER_BASE, TIMER_A);  // The timer counts down
+
+    // Look up the transition
+    index = (g_quadState << 2) | state;
+    g_quadState = state;
+    step = g_quadTable[index];
+
+    if (step != 0) {
+        g_edgeSeq = g_edgeSeq + 1;
+        g_quadCount = g_quadCount + step;
+        g_edgeTime[g_edgeIndex % YAW_EDGE_HISTORY] = time;
+        g_edgeIndex = g_edgeIndex + 1;
+        if (step != g_edgeDir) {
+            g_edgeRun = 1;
+            g_edgeDir = step;
+        } else if (g_edgeRun < YAW_EDGE_HISTORY) {
+            g_edgeRun = g_edgeRun + 1;
+        }
+        g_edgeSeq = g_edgeSeq + 1;
+
+        notifyMoved(g_quadCount, &higherPriorityTaskWoken);
+    }
+    g_quadIllegal = g_quadIllegal + ((QUAD_ILLEGAL_MASK >> index) & 1);
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+
+/*******************************************************
+ * Function: quadEdgeSnapshot
+ *
+ * Copies the edge record written by quadIntHandler,
+ * again if an edge arrived during the copy. A caller above
+ * YAW_INT_PRIORITY that preempted quadIntHandler part way
+ * through would see g_edgeSeq odd on every try, as the
+ * handler cannot finish until the caller returns.
+ *
+ * returns: true if the copy is whole, false after
+ *          YAW_SNAPSHOT_TRIES torn copies
+ *******************************************************/
+static bool
+quadEdgeSnapshot (QuadEdges *edges)
+{
+    uint32_t seq;
+    uint32_t newest;
+    uint32_t k;
+    uint32_t tries;
+
+    for (tries = 0; tries < YAW_SNAPSHOT_TRIES; tries++) {
+        seq = g_edgeSeq;
+        edges->count = g_quadCount;
+        newest = g_edgeIndex - 1;
+        for (k = 0; k <= YAW_PERIOD_EDGES; k++)
+            edges->time[k] = g_edgeTime[(newest - k) % YAW_EDGE_HISTORY];
+        edges->run = g_edgeRun;
+        edges->dir = g_edgeDir;
+        if (!(seq & 1) && seq == g_edgeSeq)
+            return true;
+    }
+    return false;
+}
+
+
+/*******************************************************
+ * Function: periodVelocity
+ *
+ * Velocity from the time between the newest edges, up to
+ * YAW_PERIOD_EDGES of them (one A/B cycle, which cancels
+ * out uneven spacing between A and B). Edges from before
+ * the last change of direction are not used. If it is
+ * longer since the newest edge than the period measured,
+ * the yaw has slowed down, and is taken as one edge over
+ * that time instead.
+ *
+ * returns: counts per second, rounded, 0 below YAW_VEL_MIN
+ *******************************************************/
+static int32_t
+periodVelocity (const QuadEdges *edges, uint32_t now)
+{
+    uint32_t intervals;
+    uint32_t span;
+    uint32_t since = now - edges->time[0];
+    uint32_t speed;
+
+    intervals = (edges->run > YAW_PERIOD_EDGES) ? YAW_PERIOD_EDGES : edges->run - (edges->run > 0);
+    if (intervals == 0 || since >= g_timerHz / YAW_VEL_MIN)
+        return 0;
+
+    span = edges->time[0] - edges->time[intervals];
+    if (span == 0)
+        span = 1;
+
+    if ((uint64_t) since * intervals > span)
+        speed = (g_timerHz + since / 2) / since;
+    else
+        speed = (uint32_t) (((uint64_t) intervals * g_timerHz + span / 2) / span);
+
+    if (speed < YAW_VEL_MIN)
+        return 0;
+    return (edges->dir < 0) ? -(int32_t) speed : (int32_t) speed;
+}
+
+
+/*******************************************************
+ * Function: getQuadCount
+ *
+ * returns: the quadrature count, wrapping at 2^32
+ *******************************************************/
+int32_t
+getQuadCount (void)
+{
+    return (int32_t) g_quadCount;
+}
 
-    // Clear interrupts
-    GPIOIntClear(GPIO_PORTB_BASE, GPIO_INT_PIN_0);
-    GPIOIntClear(GPIO_PORTB_BASE, GPIO_INT_PIN_1);
+
+/*******************************************************
+ * Function: getQuadVelocity
+ *
+ * returns: the yaw rate in counts per second, from the
+ *          period of the newest edges
+ *******************************************************/
+int32_t
+getQuadVelocity (void)
+{
+    QuadEdges edges;
+
+    if (quadEdgeSnapshot(&edges))
+        g_quadVelocity = periodVelocity(&edges, ~TimerValueGet(YAW_TIMER_BASE, TIMER_A));
+    return g_quadVelocity;
+}
+#else
+/*******************************************************
+ * Function: qeiIntHandler
+ *
+ * QEI backend interrupt handler, run at the end of each
+ * velocity period and on a phase error (A and B changed
+ * together). There is no interrupt per edge, so movement
+ * is checked for QEI_VEL_HZ times a second.
+ *******************************************************/
+void
+qeiIntHandler (void)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    uint32_t status = QEIIntStatus(QEI_BASE, true);
+
+    QEIIntClear(QEI_BASE, status);
+    if (status & QEI_INTERROR) {
+        g_quadIllegal = g_quadIllegal + 1;
+    }
+    if (status & QEI_INTTIMER) {
+        notifyMoved(HWREG(QEI_BASE + QEI_O_POS), &higherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+
+/*******************************************************
+ * Function: getQuadCount
+ *
+ * returns: the quadrature count, wrapping at 2^32
+ *******************************************************/
+int32_t
+getQuadCount (void)
+{
+    return (int32_t) HWREG(QEI_BASE + QEI_O_POS);
+}
+
+
+/*******************************************************
+ * Function: getQuadVelocity
+ *
+ * returns: the yaw rate in counts per second, over the
+ *          last QEI velocity period
+ *******************************************************/
+int32_t
+getQuadVelocity (void)
+{
+    int32_t velocity = (int32_t) HWREG(QEI_BASE + QEI_O_SPEED) * QEI_VEL_HZ;
+
+    return (HWREG(QEI_BASE + QEI_O_STAT) & QEI_STAT_DIRECTION) ? -velocity : velocity;
+}
+#endif
+
+
+/*******************************************************
+ * Function: yawRefIntHandler
+ *
+ * Port C interrupt handler, run on the falling edge of
+ * the reference signal. The pin falls at the near side of
+ * the reference slot turning forwards, and at the far
+ * side turning backwards, so only a forwards pass latches
+ * the count. The interrupt is then turned off, and
+ * getYawTask notified.
+ *
+ * Runs at the same priority as quadIntHandler, so the
+ * count cannot change part way through.
+ *******************************************************/
+void
+yawRefIntHandler (void)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    bool forwards;
+
+    GPIOIntClear(YAW_REF_BASE, YAW_REF_INT_PIN);
+
+#if YAW_USE_QEI
+    forwards = !(HWREG(QEI_BASE + QEI_O_STAT) & QEI_STAT_DIRECTION);
+#else
+    forwards = (g_edgeDir >= 0);  // 0 before the first edge, standing still
+#endif
+
+    if (forwards && !g_refFound) {
+        g_refCount = (uint32_t) getQuadCount();
+        g_refFound = true;
+        GPIOIntDisable(YAW_REF_BASE, YAW_REF_INT_PIN);
+        if (g_yawTask != NULL) {
+            xTaskNotifyFromISR(g_yawTask, YAW_EVENT_REF, eSetBits, &higherPriorityTaskWoken);
+        }
+    }
+
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+
+/*******************************************************
+ * Function: getYawRefFound
+ *
+ * returns: true once the reference has been latched
+ *******************************************************/
+bool
+getYawRefFound (void)
+{
+    return g_refFound;
+}
+
+
+/*******************************************************
+ * Function: getQuadIllegal
+ *
+ * returns: the number of illegal transitions (missed edges)
+ *          since start up
+ *******************************************************/
+uint32_t
+getQuadIllegal (void)
+{
+    return g_quadIllegal;
 }
 
+#if !YAW_USE_QEI
 /*******************************************************
  * Function: initGPIOInt
  *
- * Initialises the GPIO Pins for interrupt
+ * Initialises the GPIO Pins for interrupt, and the
+ * timer the edges are timed with. The decoder starts
+ * from the pins' state once port B is clocked
  *******************************************************/
  
 void
 initGPIOInt (void)
 {
+    // Free running timer to timestamp the edges, no interrupt
+    SysCtlPeripheralEnable(YAW_TIMER_PERIPH);
+    while (!SysCtlPeripheralReady(YAW_TIMER_PERIPH));
+    TimerConfigure(YAW_TIMER_BASE, TIMER_CFG_PERIODIC);
+    TimerLoadSet(YAW_TIMER_BASE, TIMER_A, 0xFFFFFFFF);
+    TimerEnable(YAW_TIMER_BASE, TIMER_A);
+    g_timerHz = SysCtlClockGet();
+
     // Port B must be enabled for configuration and use.
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB);
     while (!SysCtlPeripheralReady(SYSCTL_PERIPH_GPIOB));  // busy-wait until GPIOB's bus clock is ready
@@ -69,8 +400,12 @@ initGPIOInt (void)
     GPIOPinTypeGPIOInput (GPIO_PORTB_BASE, GPIO_PIN_0);
     GPIOPinTypeGPIOInput (GPIO_PORTB_BASE, GPIO_PIN_1);
 
-    // Register the quadIntHandler to interrupts on port B
+    // Decode from the pins as they are now, read once the port is clocked
+    g_quadState = GPIOPinRead(GPIO_PORTB_BASE, QUAD_PINS);
+
+    // Register the quadIntHandler to interrupts on port B, at a priority that may notify getYawTask
     GPIOIntRegister(GPIO_PORTB_BASE, quadIntHandler);
+    IntPrioritySet(INT_GPIOB, YAW_INT_PRIORITY);
 
     // Set the interrupt to trigger on both rising and falling edge
     GPIOIntTypeSet(GPIO_PORTB_BASE, GPIO_INT_PIN_0, GPIO_BOTH_EDGES);
@@ -81,6 +416,269 @@ initGPIOInt (void)
     GPIOIntEnable(GPIO_PORTB_BASE, GPIO_INT_PIN_1);
 
 }
+#else
+/*******************************************************
+ * Function: initQEI
+ *
+ * Initialises QEI0 to count A/B edges and measure
+ * velocity, for the YAW_USE_QEI backend
+ *******************************************************/
+
+void
+initQEI (void)
+{
+    SysCtlPeripheralEnable(QEI_PERIPH);
+    SysCtlPeripheralEnable(QEI_GPIO_PERIPH);
+    while (!SysCtlPeripheralReady(QEI_PERIPH));
+    while (!SysCtlPeripheralReady(QEI_GPIO_PERIPH));
+
+    // PD7 is locked at reset (NMI), unlock it to change its function
+    HWREG(QEI_GPIO_BASE + GPIO_O_LOCK) = GPIO_LOCK_KEY;
+    HWREG(QEI_GPIO_BASE + GPIO_O_CR) |= QEI_GPIO_PINS;
+    HWREG(QEI_GPIO_BASE + GPIO_O_LOCK) = 0;
+
+    GPIOPinConfigure(QEI_PHA_PIN);
+    GPIOPinConfigure(QEI_PHB_PIN);
+    GPIOPinTypeQEI(QEI_GPIO_BASE, QEI_GPIO_PINS);
+
+    // Count every edge of A and B over the full 32 bits, as quadIntHandler does.
+    // Swapped so that B leading A counts up, also as quadIntHandler does.
+    QEIDisable(QEI_BASE);
+    QEIConfigure(QEI_BASE, QEI_CONFIG_CAPTURE_A_B | QEI_CONFIG_NO_RESET | QEI_CONFIG_QUADRATURE | QEI_CONFIG_SWAP,
+                 0xFFFFFFFF);
+    QEIPositionSet(QEI_BASE, 0);
+
+    QEIVelocityConfigure(QEI_BASE, QEI_VELDIV_1, SysCtlClockGet() / QEI_VEL_HZ);
+    QEIVelocityEnable(QEI_BASE);
+
+    // Counting needs no CPU at all, only phase errors and the end of each velocity period interrupt
+    QEIIntRegister(QEI_BASE, qeiIntHandler);
+    IntPrioritySet(INT_QEI0, YAW_INT_PRIORITY);
+    QEIIntClear(QEI_BASE, QEI_INTERROR | QEI_INTDIR | QEI_INTTIMER | QEI_INTINDEX);
+    QEIIntEnable(QEI_BASE, QEI_INTERROR | QEI_INTTIMER);
+
+    QEIEnable(QEI_BASE);
+}
+#endif
+
+/*******************************************************
+ * Function: initYawRef
+ *
+ * Initialises the reference input and its interrupt.
+ * Latches the reference straight away if the helicopter
+ * is already over it, as no edge will come.
+ *******************************************************/
+
+void
+initYawRef (void)
+{
+    SysCtlPeripheralEnable(YAW_REF_PERIPH);
+    while (!SysCtlPeripheralReady(YAW_REF_PERIPH));
+
+    GPIOPinTypeGPIOInput(YAW_REF_BASE, YAW_REF_PIN);
+    GPIOPadConfigSet(YAW_REF_BASE, YAW_REF_PIN, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);  // Not found if unplugged
+
+    g_refFound = false;
+    GPIOIntRegister(YAW_REF_BASE, yawRefIntHandler);
+    IntPrioritySet(INT_GPIOC, YAW_INT_PRIORITY);
+    GPIOIntTypeSet(YAW_REF_BASE, YAW_REF_PIN, GPIO_FALLING_EDGE);
+    GPIOIntClear(YAW_REF_BASE, YAW_REF_INT_PIN);
+
+    if (GPIOPinRead(YAW_REF_BASE, YAW_REF_PIN) == 0) {
+        g_refCount = (uint32_t) getQuadCount();
+        g_refFound = true;
+    } else {
+        GPIOIntEnable(YAW_REF_BASE, YAW_REF_INT_PIN);
+    }
+}
+
+#if YAW_FIND_REF
+/*******************************************************
+ * Function: findYawReference
+ *
+ * Waits for the control loop to take the yaw over, showing
+ * so on the OLED. Once armed, the loop turns the helicopter
+ * forwards on the tail rotor until the reference is found,
+ * in under one revolution, or until it gives up after
+ * YAW_FIND_REF_TIMEOUT_MS of turning. It is the only one
+ * that drives the rotors, and keeps the time itself.
+ *
+ * returns: true if the reference was found
+ *******************************************************/
+
+static bool
+findYawReference (xQueueHandle OLEDQueue)
+{
+    OLEDMessage OLEDMessage;
+    ControlOutput output;
+
+    if (getYawRefFound())
+    {
+        return(true);
+    }
+
+    OLEDMessage.charLine = 2;
+    OLEDMessage.charPos = 0;
+    usnprintf(OLEDMessage.strBuf, sizeof(OLEDMessage.strBuf), "Finding ref...  ");
+    if (xQueueSend(OLEDQueue, (void *)&OLEDMessage, 10) != pdPASS)
+    {
+        while(1); // Could not send to Queue
+    }
+
+    do
+    {
+        vTaskDelay(YAW_FIND_REF_POLL_MS / portTICK_RATE_MS);
+        getControlOutput(&output);
+    } while (!output.yawAuto);
+
+    return getYawRefFound();
+}
+#endif
+
+/*******************************************************
+ * Function: initYawPosition
+ *
+ * Starts following the quadrature count from where it
+ * is now: from the reference if it has been found,
+ * otherwise as absolute position 0
+ *******************************************************/
+
+void
+initYawPosition (YawPosition *position)
+{
+    position->snapshot = (uint32_t) getQuadCount();
+    position->referenced = g_refFound;
+    position->count = position->referenced ? (int32_t) (position->snapshot - g_refCount) : 0;
+    position->rebase = 0;
+}
+
+/*******************************************************
+ * Function: updateYawPosition
+ *
+ * Adds the counts since the last update to the absolute
+ * position. The count is only read, never written, so no
+ * edge the interrupt adds meanwhile is lost. The first
+ * update after the reference is found moves the position
+ * over to count from it, which is a jump of however far
+ * the power on heading was from the reference. That jump
+ * is left in rebase for the one update, so a reader
+ * already steering by the count (the control loop, on the
+ * timeout or if it passes the reference in flight) can
+ * shift its set points by it in the same step.
+ *
+ * returns: the change in count since the last update
+ *******************************************************/
+
+int32_t
+updateYawPosition (YawPosition *position)
+{
+    uint32_t snapshot = (uint32_t) getQuadCount();
+    int32_t change = (int32_t) (snapshot - position->snapshot);  // Modulo 2^32, so right across the wrap
+
+    position->snapshot = snapshot;
+    position->rebase = 0;
+    if (!position->referenced && g_refFound) {
+        int32_t count = (int32_t) (snapshot - g_refCount);  // Less than 2^31 counts from it in practice
+
+        position->rebase = (int32_t) (count - (position->count + change));
+        position->count = count;
+        position->referenced = true;
+    } else {
+        position->count += change;
+    }
+    return change;
+}
+
+/*******************************************************
+ * Function: yawCountInRev
+ *
+ * returns: the position within the current revolution,
+ *          0 to YAW_COUNTS_PER_REV - 1
+ *******************************************************/
+
+int32_t
+yawCountInRev (const YawPosition *position)
+{
+    int32_t count = (int32_t) (position->count % YAW_COUNTS_PER_REV);
+
+    return (count < 0) ? count + YAW_COUNTS_PER_REV : count;
+}
+
+/*******************************************************
+ * Function: yawRevolutions
+ *
+ * returns: the number of whole revolutions from the start
+ *          position, rounded down (-1 just below it)
+ *******************************************************/
+
+int32_t
+yawRevolutions (const YawPosition *position)
+{
+    return (int32_t) ((position->count - yawCountInRev(position)) / YAW_COUNTS_PER_REV);
+}
+
+/*******************************************************
+ * Function: initYawVelocity
+ *
+ * Starts a velocity estimate from the edges so far, or
+ * from the count now if an edge is being recorded
+ *******************************************************/
+
+void
+initYawVelocity (YawVelocity *velocity)
+{
+#if !YAW_USE_QEI
+    QuadEdges edges;
+
+    if (quadEdgeSnapshot(&edges)) {
+        velocity->edgeCount = edges.count;
+        velocity->edgeTime = edges.time[0];
+    } else {
+        velocity->edgeCount = g_quadCount;
+        velocity->edgeTime = ~TimerValueGet(YAW_TIMER_BASE, TIMER_A);
+    }
+#endif
+    velocity->counts = 0;
+}
+
+/*******************************************************
+ * Function: updateYawVelocity
+ *
+ * Estimates the velocity now. When at least
+ * YAW_COUNT_EDGES edges have arrived since the last
+ * update, from their number over the time between the
+ * newest edges then and now (count based). Otherwise from
+ * the period of the newest edges (period based). The QEI
+ * backend gives the QEI's own count based measurement.
+ *
+ * returns: the velocity in counts per second
+ *******************************************************/
+
+int32_t
+updateYawVelocity (YawVelocity *velocity)
+{
+#if YAW_USE_QEI
+    velocity->counts = getQuadVelocity();
+#else
+    QuadEdges edges;
+    int32_t change;
+    uint32_t span;
+
+    if (!quadEdgeSnapshot(&edges))
+        return velocity->counts;  // Preempted quadIntHandler mid edge, the next update covers this one too
+    change = (int32_t) (edges.count - velocity->edgeCount);
+    span = edges.time[0] - velocity->edgeTime;
+
+    if ((change >= YAW_COUNT_EDGES || change <= -YAW_COUNT_EDGES) && span > 0)
+        velocity->counts = (int32_t) ((int64_t) change * g_timerHz / span);
+    else
+        velocity->counts = periodVelocity(&edges, ~TimerValueGet(YAW_TIMER_BASE, TIMER_A));
+
+    velocity->edgeCount = edges.count;
+    velocity->edgeTime = edges.time[0];
+#endif
+    return velocity->counts;
+}
 
 /*******************************************************
  * Function: getYawTask
@@ -88,6 +686,8 @@ initGPIOInt (void)
  * Processes the change in the quadrature and converts it
  * into change in degrees
  * Writes the current angle to the FreeRTOS Queue OLEDQueue
+ * when it changes (at most every YAW_PUBLISH_MIN_MS), or
+ * when it has not for YAW_MAX_STALE_MS
  *******************************************************/
 
 void getYawTask (void *pvParameters)
@@ -96,35 +696,49 @@ void getYawTask (void *pvParameters)
     xQueueHandle OLEDQueue = *((xQueueHandle *)pvParameters);
 
     int32_t angle;
+    int32_t sent = -1;  // Angle last sent, none yet
+    TickType_t sentTick = 0;
+    YawPosition position;
     // used for sending a message to the OLED display function
     OLEDMessage OLEDMessage;
     OLEDMessage.charLine = 2;
     OLEDMessage.charPos = 0;
 
+#if YAW_FIND_REF
+    // Carries on from the power on heading if not found, the reference is still latched if passed later
+    findYawReference(OLEDQueue);
+#endif
+
+    initYawPosition(&position);
+
     while (1)
     {
-        // Map quadrature to angle and apply limits
-        angle = (int32_t)((long) QuadData.sum * 0.8);
-        if (angle > 359){
-            angle = 0;
-            QuadData.sum = -1;
-        }
-        if (angle < 0){
-            angle = 359;
-            QuadData.sum = 449;
-        }
+        // Follow the count, the interrupt side keeps ownership of it
+        updateYawPosition(&position);
 
-        // store message for OLED display
-        usnprintf(OLEDMessage.strBuf, sizeof(OLEDMessage.strBuf), "Angle (deg): %d     ", angle);
+        // Map the position within the revolution to angle
+        angle = numToInt(numMul(numFromInt(yawCountInRev(&position)), YAW_DEG_PER_COUNT));
 
-        // Send to OLED queue
-        if (xQueueSend(OLEDQueue, (void *)&OLEDMessage, 10) != pdPASS)
+        // Send it on if it changed, or has not been sent for YAW_MAX_STALE_MS
+        if (angle != sent || xTaskGetTickCount() - sentTick >= YAW_MAX_STALE_MS / portTICK_RATE_MS)
         {
-            while(1); // Could not send to Queue
+            // store message for OLED display
+            usnprintf(OLEDMessage.strBuf, sizeof(OLEDMessage.strBuf), "Angle (deg): %d     ", angle);
+
+            // Send to OLED queue
+            if (xQueueSend(OLEDQueue, (void *)&OLEDMessage, 10) != pdPASS)
+            {
+                while(1); // Could not send to Queue
+            }
+            sent = angle;
+            sentTick = xTaskGetTickCount();
+
+            // Movement meanwhile is still notified, and picked up straight after
+            vTaskDelay(YAW_PUBLISH_MIN_MS / portTICK_RATE_MS);
         }
 
-        // Delay
-        vTaskDelay(YAW_TASK_HZ / portTICK_RATE_MS);
+        // Wait for the interrupts to report movement or the reference, or for the angle to go stale
+        xTaskNotifyWait(0, 0xFFFFFFFF, NULL, YAW_MAX_STALE_MS / portTICK_RATE_MS);
     }
 }
 
@@ -133,7 +747,8 @@ void getYawTask (void *pvParameters)
  * Function: initGetYawTask
  *
  * Creates the FreeRTOS task GetYawTask
- * Initialises the GPOI interrupt pins
+ * Initialises the GPOI interrupt pins and the reference
+ * input
  *
  * returns: 0 on successful creation of GetYawTask
  *          1 on failed attempt
@@ -142,15 +757,25 @@ void getYawTask (void *pvParameters)
 uint8_t
 initGetYawTask(xQueueHandle* OLEDQueue)
 {
+    g_quadIllegal = 0;
+    g_notifyCount = 0;
+
+#if YAW_USE_QEI
+    initQEI(); // Count in QEI0 from 0
+#else
+    // Preset quad data, initGPIOInt() reads the pins' starting state
+    g_quadCount = 0;
+    g_edgeIndex = 0;
+    g_edgeRun = 0;
+    g_edgeDir = 0;
+
     initGPIOInt(); // Initialise GPIO interrupts
+#endif
 
-    // Preset quad data
-    QuadData.Ap = 0;
-    QuadData.Bp = 0;
-    QuadData.sum = 1;
+    initYawRef(); // Once the count is running
 
     // Create getYawTask
-    if (pdTRUE != xTaskCreate(getYawTask, "Get Yaw Data", TASK_STACK_DEPTH, (void *) OLEDQueue, TASK_PRIORITY, NULL))
+    if (pdTRUE != xTaskCreate(getYawTask, "Get Yaw Data", TASK_STACK_DEPTH, (void *) OLEDQueue, TASK_PRIORITY, &g_yawTask))
     {
         return(1);               // Oh no! Must not have had enough memory to create the task.
     }
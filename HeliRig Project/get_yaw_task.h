@@ -8,6 +8,30 @@
  * to trigger the Quadrature decoding, and process the
  * yaw (angular position) data of the HeliRig
  *
+ * With YAW_USE_QEI set the QEI0 peripheral counts the
+ * edges instead, and position and velocity are read from
+ * its registers. There is no interrupt per edge. PB0/PB1
+ * have no QEI function, so this needs the encoder A/B
+ * wired to PD6 (PhA0) and PD7 (PhB0). PD7 is the Orbit
+ * OLED D/C line, which must then be moved as well, so the
+ * GPIO backend stays the default.
+ *
+ * The reference signal (PC4, low over the reference slot)
+ * gives the absolute heading. Its first falling edge while
+ * turning forwards latches the count there, and from then
+ * on every YawPosition counts from the reference instead
+ * of from power on. With YAW_FIND_REF set, the control loop
+ * first turns the helicopter on the tail rotor until it is
+ * found once armed, and getYawTask waits for the loop to
+ * take over.
+ *
+ * getYawTask does not poll. The interrupts notify it
+ * (xTaskNotifyFromISR) when the count has moved
+ * YAW_NOTIFY_COUNTS since they last did, or the reference
+ * is found, and it sends the angle on when it changes, at
+ * most every YAW_PUBLISH_MIN_MS. With nothing happening it
+ * still sends it every YAW_MAX_STALE_MS.
+ *
  *  Created on: 12/08/2021
  *      Author: Group 1
  *******************************************************/
@@ -16,37 +40,264 @@
  * Constants
  *******************************************************/
 
+#ifndef TASK_STACK_DEPTH  // The host simulation needs larger stacks (Simulation/FreeRTOSConfig.h)
 #define TASK_STACK_DEPTH    32
+#endif
 #define TASK_PRIORITY       4
 
-#define YAW_TASK_HZ         100
+#define YAW_DEG_PER_COUNT   NUM_CONST(0.8)  // num_t (heli_math.h)
+
+#ifndef YAW_USE_QEI
+#define YAW_USE_QEI         0  // 1: count in QEI0, 0: GPIO interrupt on every edge
+#endif
+#define YAW_COUNTS_PER_REV  450  // Counts in 360 degrees at YAW_DEG_PER_COUNT
+
+#define YAW_INT_PRIORITY    (1 << 5)  // Highest that may call FreeRTOS (configMAX_SYSCALL_INTERRUPT_PRIORITY)
+
+// Publishing
+#define YAW_NOTIFY_COUNTS   2  // Movement that wakes getYawTask, above the 1 count an encoder sat on an edge jitters by
+#define YAW_PUBLISH_MIN_MS  40  // Least time between angles sent, limits the OLED traffic
+#define YAW_MAX_STALE_MS    500  // Most time between angles sent
+#define YAW_EVENT_MOVED     (1 << 0)  // getYawTask notification bits
+#define YAW_EVENT_REF       (1 << 1)
+
+#define QUAD_PINS           (GPIO_PIN_0 | GPIO_PIN_1)  // A on PB0, B on PB1
+#define QUAD_ILLEGAL_MASK   ((1 << 0x3) | (1 << 0x6) | (1 << 0x9) | (1 << 0xC))  // Transitions 00<->11 and 01<->10, by table index
+
+// Velocity estimate, GPIO backend
+#define YAW_TIMER_BASE      TIMER2_BASE  // Free running 32 bit timer for edge times
+#define YAW_TIMER_PERIPH    SYSCTL_PERIPH_TIMER2
+#define YAW_EDGE_HISTORY    8  // Edge times kept, a power of 2 above YAW_PERIOD_EDGES
+#define YAW_PERIOD_EDGES    4  // Edges the period based estimate spans, one A/B cycle
+#define YAW_COUNT_EDGES     16  // Edges since the last estimate from which it is count based
+#define YAW_VEL_MIN         4  // Counts per second, slower reads as 0
+#define YAW_SNAPSHOT_TRIES  4  // Copies of the edge record tried before the last estimate is kept instead
+
+// QEI backend
+#define QEI_BASE            QEI0_BASE
+#define QEI_PERIPH          SYSCTL_PERIPH_QEI0
+#define QEI_GPIO_BASE       GPIO_PORTD_BASE
+#define QEI_GPIO_PERIPH     SYSCTL_PERIPH_GPIOD
+#define QEI_GPIO_PINS       (GPIO_PIN_6 | GPIO_PIN_7)
+#define QEI_PHA_PIN         GPIO_PD6_PHA0
+#define QEI_PHB_PIN         GPIO_PD7_PHB0
+#define QEI_VEL_HZ          100  // Velocity periods per second (counts per period * QEI_VEL_HZ = counts/s), and movement checks
+
+// Yaw reference, for both backends (QEI0's own index input is on PD3/PF4, not PC4)
+#define YAW_REF_BASE        GPIO_PORTC_BASE
+#define YAW_REF_PERIPH      SYSCTL_PERIPH_GPIOC
+#define YAW_REF_PIN         GPIO_PIN_4  // Low while over the reference
+#define YAW_REF_INT_PIN     GPIO_INT_PIN_4
+
+#ifndef YAW_FIND_REF  // Only the CONTROL_AUTOTUNE build arms the rotors (autotune_task.h), set both in the build options
+#define YAW_FIND_REF        CONTROL_AUTOTUNE  // 1: once armed, the control loop turns the helicopter until the reference is found
+#endif
+#define YAW_FIND_REF_DUTY   20  // Tail duty cycle (%) while finding the reference
+#define YAW_FIND_REF_POLL_MS        10
+#define YAW_FIND_REF_TIMEOUT_MS     30000  // Of turning, then the loop carries on from the power on heading
 
 #define QUEUE_LENGTH 5
 #define QUAD_QUEUE_ITEM_SIZE sizeof(int8_t)
 
+// Absolute (multi-turn) yaw, followed from snapshots of the quadrature count.
+// Each reader keeps its own, the count itself is only written by the interrupt side.
+typedef struct Yaw_Position
+{
+    int64_t count;  // Counts from the reference (or the start position until it is found), never wraps in practice
+    uint32_t snapshot;  // Quadrature count at the last update
+    bool referenced;  // count is from the reference
+    int32_t rebase;  // Counts the last update moved count by on top of the change, when it found the reference, else 0
+} YawPosition;
+
+
+// Velocity estimate for one reader (e.g. the controller), see updateYawVelocity()
+typedef struct Yaw_Velocity
+{
+    uint32_t edgeCount;  // Quadrature count at the newest edge at the last update
+    uint32_t edgeTime;  // Time of that edge, in edge timer ticks
+    int32_t counts;  // The last estimate, counts per second
+} YawVelocity;
 
 /*******************************************************
  * Function: quadIntHandler
  *
  * Initialises the GPIO interrupt handler
+ *      Decodes each A/B edge from one read of Port B
+ *      and the transition table, and timestamps it
+ *      Notifies getYawTask every YAW_NOTIFY_COUNTS
  *******************************************************/
  
 void quadIntHandler(void);
 
+/*******************************************************
+ * Function: getQuadCount
+ *
+ * returns: the quadrature count, owned by the interrupt
+ *          side (or the QEI). It runs over the full 32
+ *          bits and wraps, use a YawPosition for the
+ *          angle or the absolute position.
+ *******************************************************/
+
+int32_t getQuadCount(void);
+
+/*******************************************************
+ * Function: qeiIntHandler
+ *
+ * QEI backend interrupt handler, run at the end of each
+ * velocity period to notify getYawTask if the count has
+ * moved YAW_NOTIFY_COUNTS, and on a phase error (A and B
+ * changed together)
+ *******************************************************/
+
+void qeiIntHandler(void);
+
+/*******************************************************
+ * Function: getQuadVelocity
+ *
+ * returns: the yaw rate in counts per second, positive
+ *          counting up. Measured over the last QEI
+ *          velocity period, or from the period of the
+ *          newest edges for the GPIO backend (the rate it
+ *          last returned if an edge was being recorded,
+ *          see updateYawVelocity()).
+ *******************************************************/
+
+int32_t getQuadVelocity(void);
+
+/*******************************************************
+ * Function: yawRefIntHandler
+ *
+ * Port C interrupt handler, run on the falling edge of
+ * the reference signal. Latches the quadrature count the
+ * first time it is reached turning forwards, and notifies
+ * getYawTask.
+ *******************************************************/
+
+void yawRefIntHandler(void);
+
+/*******************************************************
+ * Function: getYawRefFound
+ *
+ * returns: true once the reference has been latched
+ *******************************************************/
+
+bool getYawRefFound(void);
+
+/*******************************************************
+ * Function: getQuadIllegal
+ *
+ * returns: the number of illegal transitions (missed edges)
+ *          since start up
+ *******************************************************/
+
+uint32_t getQuadIllegal(void);
+
 /*******************************************************
  * Function: initGPIOInt
  *
- * Initialises the GPIO Pins for interrupt
+ * Initialises the GPIO Pins for interrupt, and the
+ * timer the edges are timed with
  *******************************************************/
 
 void initGPIOInt(void);
 
+/*******************************************************
+ * Function: initQEI
+ *
+ * Initialises QEI0 to count A/B edges and measure
+ * velocity, for the YAW_USE_QEI backend
+ *******************************************************/
+
+void initQEI(void);
+
+/*******************************************************
+ * Function: initYawRef
+ *
+ * Initialises the reference input and its interrupt.
+ * Latches the reference straight away if the helicopter
+ * is already over it. Must be called once the count is
+ * running.
+ *******************************************************/
+
+void initYawRef(void);
+
+/*******************************************************
+ * Function: initYawPosition
+ *
+ * Starts following the quadrature count from where it
+ * is now: from the reference if it has been found,
+ * otherwise as absolute position 0
+ *******************************************************/
+
+void initYawPosition(YawPosition *position);
+
+/*******************************************************
+ * Function: updateYawPosition
+ *
+ * Adds the counts since the last update to the absolute
+ * position. Must be called at least once per 2^31 counts.
+ * The first update after the reference is found moves the
+ * position over to count from the reference, and sets
+ * rebase to how far, for a reader that has to move its
+ * own set points over with it.
+ *
+ * returns: the change in count since the last update
+ *******************************************************/
+
+int32_t updateYawPosition(YawPosition *position);
+
+/*******************************************************
+ * Function: yawCountInRev
+ *
+ * returns: the position within the current revolution,
+ *          0 to YAW_COUNTS_PER_REV - 1
+ *******************************************************/
+
+int32_t yawCountInRev(const YawPosition *position);
+
+/*******************************************************
+ * Function: yawRevolutions
+ *
+ * returns: the number of whole revolutions from the start
+ *          position, rounded down (-1 just below it)
+ *******************************************************/
+
+int32_t yawRevolutions(const YawPosition *position);
+
+/*******************************************************
+ * Function: initYawVelocity
+ *
+ * Starts a velocity estimate from the edges so far
+ *******************************************************/
+
+void initYawVelocity(YawVelocity *velocity);
+
+/*******************************************************
+ * Function: updateYawVelocity
+ *
+ * Estimates the velocity now, from the edge times: count
+ * based when YAW_COUNT_EDGES or more edges arrived since
+ * the last update, period based below that. Can be called
+ * at any rate, e.g. once per control step, and from an
+ * interrupt above YAW_INT_PRIORITY (CONTROL_IN_ISR). One
+ * that preempts quadIntHandler part way through an edge
+ * cannot wait for it, so keeps the last estimate for that
+ * call.
+ *
+ * returns: the velocity in counts per second
+ *******************************************************/
+
+int32_t updateYawVelocity(YawVelocity *velocity);
+
 /*******************************************************
  * Function: getYawTask
  *
  * Processes the change in the quadrature and converts it
  * into change in degrees
  * Writes the current angle to the FreeRTOS Queue OLEDQueue
+ * when notified that it moved, or it has gone stale
+ * With YAW_FIND_REF, first waits for the control loop to
+ * take the yaw over (the reference found, or given up on)
  *******************************************************/
 
 void getYawTask (void *pvParameters);
@@ -55,7 +306,8 @@ void getYawTask (void *pvParameters);
  * Function: initGetYawTask
  *
  * Creates the FreeRTOS task GetYawTask
- * Initialises the GPOI interrupt pins
+ * Initialises the GPOI interrupt pins, or QEI0, and the
+ * reference input
  *
  * returns: 0 on successful creation of GetYawTask
  *          1 on failed attempt
@@ -0,0 +1,297 @@
+#ifndef __HELI_MATH_H__
+#define __HELI_MATH_H__
+
+/*******************************************************
+ * heli_math.h
+ *
+ * Numeric type used by the control and sensing path
+ * (PID terms, height mapping and yaw scaling).
+ *
+ * The Cortex-M4F FPU only does single precision, so every
+ * double operation is a software library call. num_t is
+ * either a float, which the FPU handles directly, or a
+ * Q16.16 fixed-point value, which only needs integer
+ * instructions (a 32 x 32 -> 64 bit SMULL for multiplies).
+ * Select with HELI_MATH_TYPE, in the project build options
+ * or before this file is included.
+ *
+ * Q16.16 covers -32768 to +32767.99998 with a resolution of
+ * 1/65536. Adds and subtracts are not saturated, so keep
+ * values (including PID integrals) well inside that range.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <math.h>
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define HELI_MATH_FLOAT     0  // num_t is a single precision float
+#define HELI_MATH_FIXED     1  // num_t is a Q16.16 fixed-point int32_t
+
+#ifndef HELI_MATH_TYPE
+#define HELI_MATH_TYPE      HELI_MATH_FLOAT
+#endif
+
+
+#if HELI_MATH_TYPE == HELI_MATH_FIXED
+
+typedef int32_t num_t;
+
+#define NUM_FRAC_BITS       16
+#define NUM_ONE             ((num_t) 1 << NUM_FRAC_BITS)
+#define NUM_MAX             ((num_t) INT32_MAX)
+#define NUM_MIN             ((num_t) INT32_MIN)
+#define NUM_NAME            "Q16.16"
+
+// Converts a constant at compile time, rounded to the nearest step
+#define NUM_CONST(x)        ((num_t) ((x) * 65536.0 + (((x) >= 0) ? 0.5 : -0.5)))
+
+
+/*******************************************************
+ * Function: numFromInt
+ *******************************************************/
+static inline num_t
+numFromInt (int32_t i32Value)
+{
+    return (num_t) (i32Value * NUM_ONE);
+}
+
+
+/*******************************************************
+ * Function: numToInt
+ *
+ * returns: the value rounded to the nearest integer
+ *******************************************************/
+static inline int32_t
+numToInt (num_t xValue)
+{
+    return (xValue + (NUM_ONE >> 1)) >> NUM_FRAC_BITS;  // Arithmetic shift rounds half up
+}
+
+
+/*******************************************************
+ * Function: numFloor
+ *
+ * returns: the greatest integer no more than the value
+ *******************************************************/
+static inline int32_t
+numFloor (num_t xValue)
+{
+    return xValue >> NUM_FRAC_BITS;  // Arithmetic shift rounds down
+}
+
+
+/*******************************************************
+ * Function: numToScaled
+ *
+ * For printing without floats (UARTprintf has no %f)
+ *
+ * returns: the value times i32Scale, rounded to the
+ *          nearest integer, without overflowing num_t
+ *******************************************************/
+static inline int32_t
+numToScaled (num_t xValue, int32_t i32Scale)
+{
+    return (int32_t) (((int64_t) xValue * i32Scale + (NUM_ONE >> 1)) >> NUM_FRAC_BITS);
+}
+
+
+/*******************************************************
+ * Function: numFromFloat
+ *
+ * For values only known at run time (e.g. gains passed to
+ * an init function), not for use in the control loop
+ *******************************************************/
+static inline num_t
+numFromFloat (float fValue)
+{
+    return (num_t) (fValue * 65536.0f + ((fValue >= 0.0f) ? 0.5f : -0.5f));
+}
+
+
+/*******************************************************
+ * Function: numToFloat
+ *******************************************************/
+static inline float
+numToFloat (num_t xValue)
+{
+    return (float) xValue * (1.0f / 65536.0f);
+}
+
+
+/*******************************************************
+ * Function: numMul
+ *
+ * returns: xA * xB, rounded to the nearest step
+ *******************************************************/
+static inline num_t
+numMul (num_t xA, num_t xB)
+{
+    return (num_t) (((int64_t) xA * xB + (1 << (NUM_FRAC_BITS - 1))) >> NUM_FRAC_BITS);
+}
+
+
+/*******************************************************
+ * Function: numDiv
+ *
+ * returns: xA / xB, truncated. This is a 64 bit library
+ *          divide, so divide by a constant with numMul()
+ *          and its reciprocal where possible.
+ *******************************************************/
+static inline num_t
+numDiv (num_t xA, num_t xB)
+{
+    return (num_t) (((int64_t) xA * NUM_ONE) / xB);
+}
+
+
+/*******************************************************
+ * Function: numSqrt
+ *
+ * returns: the square root of xValue (0 for xValue <= 0),
+ *          truncated. Bit by bit, a fixed 24 steps
+ *          whatever the value, so it takes the same time
+ *          every call.
+ *******************************************************/
+static inline num_t
+numSqrt (num_t xValue)
+{
+    uint64_t ui64Rem = (uint64_t) ((xValue > 0) ? xValue : 0) << NUM_FRAC_BITS;
+    uint64_t ui64Root = 0;
+    uint64_t ui64Bit;
+
+    for (ui64Bit = (uint64_t) 1 << 46; ui64Bit != 0; ui64Bit >>= 2) {
+        if (ui64Rem >= ui64Root + ui64Bit) {
+            ui64Rem -= ui64Root + ui64Bit;
+            ui64Root = (ui64Root >> 1) + ui64Bit;
+        } else {
+            ui64Root >>= 1;
+        }
+    }
+    return (num_t) ui64Root;
+}
+
+#elif HELI_MATH_TYPE == HELI_MATH_FLOAT
+
+typedef float num_t;
+
+#define NUM_ONE             1.0f
+#define NUM_MAX             3.402823466e+38f
+#define NUM_MIN             (-3.402823466e+38f)
+#define NUM_NAME            "float"
+
+#define NUM_CONST(x)        ((num_t) (x))
+
+
+/*******************************************************
+ * Function: numFromInt
+ *******************************************************/
+static inline num_t
+numFromInt (int32_t i32Value)
+{
+    return (num_t) i32Value;
+}
+
+
+/*******************************************************
+ * Function: numToInt
+ *
+ * returns: the value rounded to the nearest integer
+ *******************************************************/
+static inline int32_t
+numToInt (num_t xValue)
+{
+    return (int32_t) (xValue + ((xValue >= 0.0f) ? 0.5f : -0.5f));
+}
+
+
+/*******************************************************
+ * Function: numFloor
+ *
+ * returns: the greatest integer no more than the value
+ *******************************************************/
+static inline int32_t
+numFloor (num_t xValue)
+{
+    int32_t i32Value = (int32_t) xValue;  // Towards zero
+
+    return (xValue < (float) i32Value) ? i32Value - 1 : i32Value;
+}
+
+
+/*******************************************************
+ * Function: numToScaled
+ *
+ * returns: the value times i32Scale, rounded to the
+ *          nearest integer
+ *******************************************************/
+static inline int32_t
+numToScaled (num_t xValue, int32_t i32Scale)
+{
+    return numToInt(xValue * (float) i32Scale);
+}
+
+
+/*******************************************************
+ * Function: numFromFloat
+ *******************************************************/
+static inline num_t
+numFromFloat (float fValue)
+{
+    return fValue;
+}
+
+
+/*******************************************************
+ * Function: numToFloat
+ *******************************************************/
+static inline float
+numToFloat (num_t xValue)
+{
+    return xValue;
+}
+
+
+/*******************************************************
+ * Function: numMul
+ *******************************************************/
+static inline num_t
+numMul (num_t xA, num_t xB)
+{
+    return xA * xB;
+}
+
+
+/*******************************************************
+ * Function: numDiv
+ *******************************************************/
+static inline num_t
+numDiv (num_t xA, num_t xB)
+{
+    return xA / xB;
+}
+
+
+/*******************************************************
+ * Function: numSqrt
+ *
+ * returns: the square root of xValue (0 for xValue <= 0),
+ *          a single VSQRT instruction on the FPU
+ *******************************************************/
+static inline num_t
+numSqrt (num_t xValue)
+{
+    return (xValue > 0.0f) ? sqrtf(xValue) : 0.0f;
+}
+
+#else
+#error "HELI_MATH_TYPE must be HELI_MATH_FLOAT or HELI_MATH_FIXED"
+#endif
+
+
+#endif /* __HELI_MATH_H__ */
@@ -17,16 +17,3 @@ typedef struct OLED_Message
     uint8_t charLine;  // Shows what line to display the string on
     uint8_t charPos;  //Show what character the string starts on
 } OLEDMessage;
-
-// Structure used by the Quad
-typedef struct Quad_Type
-{
-    uint8_t A;
-    uint8_t B;
-    uint8_t L;
-    uint8_t R;
-    uint8_t Ap;
-    uint8_t Bp;
-    int32_t sum;
-
-} QuadType;
@@ -28,6 +28,8 @@
 #include "driverlib/pin_map.h"
 #include "driverlib/timer.h"
 #include "driverlib/uart.h"
+// Motors
+#include "rotorPWM.h"
 
 // Orbit OLED Display
 #include "OrbitOLED/OrbitOLEDInterface.h"
@@ -46,6 +48,11 @@
 #include "get_height_task.h"
 #include "get_yaw_task.h"
 #include "OLED_display_task.h"
+#include "heli_math.h"
+#include "relay_tune.h"
+#include "control_task.h"
+#include "autotune_task.h"
+#include "initUART.h"
 #include "helirig_structs.c"
 
 
@@ -78,6 +85,24 @@ initDisplay (void)
 }
 
 
+/*******************************************************
+ * Function: vApplicationStackOverflowHook
+ *
+ * Called by FreeRTOS (configCHECK_FOR_STACK_OVERFLOW) when
+ * a task is switched out having overrun its stack
+ *      Stops here, so the debugger shows pcTaskName
+ *******************************************************/
+void
+vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
+{
+    (void) xTask;
+    (void) pcTaskName;
+
+    IntMasterDisable();  // Stop everything, the overrun task may already have corrupted another
+    while(1);
+}
+
+
 /*******************************************************
  * Function: main
  *
@@ -89,6 +114,7 @@ uint32_t
 main(void)
 {
     initCLK();  // Initialise the Clock
+    initRotorPWM();  // Motors off and disarmed, until armControl()
     initDisplay();  // Initialise the Display
 
     // Random Test
@@ -103,6 +129,13 @@ main(void)
 
     if(initOLEDDisplayTask(&OLEDQueue) != 0) {while(1);}
 
+    if(initControlTask() != 0) {while(1);}
+
+#if CONTROL_AUTOTUNE
+    initUART();  // The tunes are streamed over the UART
+    if(initAutotuneTask() != 0) {while(1);}
+#endif
+
     IntMasterEnable();  // Enable interrupts
 
     vTaskStartScheduler();  // Start FreeRTOS
@@ -0,0 +1,234 @@
+/*******************************************************
+ * relay_tune.c
+ *
+ * Relay feedback experiment that finds the ultimate gain
+ * and period of a loop, and PI gains from them. See
+ * relay_tune.h.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "utils/uartstdio.h"
+
+#include "heli_math.h"
+#include "relay_tune.h"
+
+
+/*******************************************************
+ * Function: relayOutput
+ *
+ * returns: bias +- amplitude for the relay's side,
+ *          restricted to min/max
+ *******************************************************/
+static num_t
+relayOutput (const RelayTune *tune)
+{
+    num_t output = tune->high ? tune->bias + tune->amplitude : tune->bias - tune->amplitude;
+
+    if (output > tune->max)
+    {
+        return tune->max;
+    }
+    if (output < tune->min)
+    {
+        return tune->min;
+    }
+    return output;
+}
+
+
+/*******************************************************
+ * Function: finishRelayTune
+ *
+ * Works out Ku and Tu from the averaged cycles, and the
+ * gains from the tuning rule
+ *******************************************************/
+static void
+finishRelayTune (RelayTune *tune)
+{
+    RelayTuneResult *result = &tune->result;
+    num_t a = numMul(tune->swing_sum, NUM_CONST(0.5 / RELAY_TUNE_CYCLES));  // Amplitude of the oscillation
+    num_t root = numSqrt(numMul(a, a) - numMul(tune->hysteresis, tune->hysteresis));  // Less the hysteresis
+
+    if (root <= 0)
+    {
+        result->state = RELAY_TUNE_FAILED;  // No bigger than the hysteresis, nothing to measure
+        return;
+    }
+
+    result->ku = numDiv(numMul(NUM_CONST(4.0 / 3.14159265), tune->amplitude), root);  // 4 d / (pi a)
+    result->tu = numMul(numMul(numFromInt((int32_t) tune->period_sum), tune->dt), NUM_CONST(1.0 / RELAY_TUNE_CYCLES));
+    result->kp = numMul(result->ku, RELAY_TUNE_KP_KU);
+    result->ki = numDiv(result->kp, numMul(result->tu, RELAY_TUNE_TI_TU));
+    result->state = RELAY_TUNE_DONE;
+}
+
+
+/*******************************************************
+ * Function: stepRelayTune
+ *
+ * Switches the relay on the present value, and once
+ * enough cycles are in, works out Ku, Tu and the gains
+ * Call once every dt
+ *
+ * A cycle runs from one switch up to the next, and its
+ * swing is the highest less the lowest present value
+ * seen in between.
+ *
+ * tune: the experiment
+ * pv: the present value being measured
+ *
+ * returns: the output, bias once it is no longer running
+ *******************************************************/
+num_t
+stepRelayTune (RelayTune *tune, num_t pv)
+{
+    num_t error = tune->setpoint - pv;
+
+    if (tune->result.state != RELAY_TUNE_RUNNING)
+    {
+        return tune->bias;
+    }
+
+    tune->steps++;
+    if (pv > tune->pv_max)
+    {
+        tune->pv_max = pv;
+    }
+    if (pv < tune->pv_min)
+    {
+        tune->pv_min = pv;
+    }
+
+    if (tune->high && error < -tune->hysteresis)
+    {
+        tune->high = false;  // Gone over, push it back down
+    }
+    else if (!tune->high && error > tune->hysteresis)
+    {
+        tune->high = true;  // Gone under, push it back up, the end of a cycle
+        if (tune->last_rise != 0)
+        {
+            tune->cycles++;
+            if (tune->cycles > RELAY_TUNE_SKIP)
+            {
+                tune->period_sum += tune->steps - tune->last_rise;
+                tune->swing_sum += tune->pv_max - tune->pv_min;
+                if (tune->cycles == RELAY_TUNE_SKIP + RELAY_TUNE_CYCLES)
+                {
+                    finishRelayTune(tune);
+                    return tune->bias;
+                }
+            }
+        }
+        tune->last_rise = tune->steps;
+        tune->pv_max = pv;
+        tune->pv_min = pv;
+    }
+
+    if (tune->steps >= tune->timeout)
+    {
+        tune->result.state = RELAY_TUNE_FAILED;  // Never settled into an oscillation
+        return tune->bias;
+    }
+
+    return relayOutput(tune);
+}
+
+
+/*******************************************************
+ * Function: initRelayTune
+ *
+ * Sets up and starts a relay experiment
+ *
+ * tune: the experiment
+ * dt: time step
+ * setpoint: present value to oscillate about
+ * bias: output to switch about
+ * amplitude: relay d
+ * hysteresis: present value must cross the set point by
+ *             this much to switch
+ * max: maximum output
+ * min: minimum output
+ * timeout: steps before it gives up
+ *******************************************************/
+void
+initRelayTune (RelayTune *tune, num_t dt, num_t setpoint, num_t bias, num_t amplitude, num_t hysteresis,
+               num_t max, num_t min, uint32_t timeout)
+{
+    static const RelayTuneResult running = { RELAY_TUNE_RUNNING, 0, 0, 0, 0 };
+
+    tune->dt = dt;
+    tune->setpoint = setpoint;
+    tune->bias = bias;
+    tune->amplitude = amplitude;
+    tune->hysteresis = hysteresis;
+    tune->max = max;
+    tune->min = min;
+    tune->timeout = timeout;
+
+    tune->steps = 0;
+    tune->last_rise = 0;  // None yet, the first switch up starts the first cycle
+    tune->cycles = 0;
+    tune->high = true;  // Starts by pushing up, it switches on the first step if already over
+    tune->pv_max = setpoint;
+    tune->pv_min = setpoint;
+    tune->period_sum = 0;
+    tune->swing_sum = 0;
+    tune->result = running;
+}
+
+
+/*******************************************************
+ * Function: shiftRelayTune
+ *
+ * Moves the set point and the extremes seen this cycle by
+ * an offset, so the experiment carries on when the
+ * measurement moves over to a new origin
+ *
+ * tune: the experiment
+ * offset: added to the set point and the extremes
+ *******************************************************/
+void
+shiftRelayTune (RelayTune *tune, num_t offset)
+{
+    tune->setpoint += offset;
+    tune->pv_max += offset;
+    tune->pv_min += offset;
+}
+
+
+/*******************************************************
+ * Function: printRelayTuneSample
+ *
+ * Streams one sample over the UART console
+ *
+ * name: the loop
+ * step: loop cycle the sample is from
+ *******************************************************/
+void
+printRelayTuneSample (const char *name, uint32_t step, num_t setpoint, num_t pv, num_t output)
+{
+    UARTprintf("tune,%s,%u,%d,%d,%d\n", name, step, numToScaled(setpoint, 100), numToScaled(pv, 100),
+               numToScaled(output, 10000));
+}
+
+
+/*******************************************************
+ * Function: printRelayTuneResult
+ *
+ * Streams the result over the UART console
+ *
+ * name: the loop
+ *******************************************************/
+void
+printRelayTuneResult (const char *name, const RelayTuneResult *result)
+{
+    UARTprintf("tune,%s,%s,%d,%d,%d,%d\n", name, (result->state == RELAY_TUNE_DONE) ? "done" : "failed",
+               numToScaled(result->ku, 1000000), numToScaled(result->tu, 1000), numToScaled(result->kp, 1000000),
+               numToScaled(result->ki, 1000000));
+}
@@ -0,0 +1,181 @@
+#ifndef _RELAY_TUNE_H_
+#define _RELAY_TUNE_H_
+
+/*******************************************************
+ * relay_tune.h
+ *
+ * Finds PI gains for a loop by relay feedback (Astrom and
+ * Hagglund): in place of the controller, the output is
+ * switched between bias + amplitude and bias - amplitude
+ * each time the present value crosses the set point (with
+ * a little hysteresis, so noise and the last count do not
+ * chatter it). Any loop with enough lag settles into a
+ * steady oscillation at its ultimate period Tu, where it
+ * lags 180 degrees, and the swing of the present value
+ * gives the ultimate gain Ku = 4 d / (pi a), for a relay
+ * of amplitude d and an oscillation of amplitude a (less
+ * the hysteresis, which also moves the point found a
+ * little short of the ultimate, to a lower gain and
+ * longer period). The PI gains then follow from a tuning
+ * rule (RELAY_TUNE_KP_KU, RELAY_TUNE_TI_TU).
+ *
+ * A RelayTune is stepped in place of stepPID(), once every
+ * dt, by the loop that owns it. Like PIDController it
+ * holds all its own state, takes no locks and calls
+ * nothing but heli_math.h, so it runs in the control
+ * interrupt as well as a task, and on the host against
+ * the simulated plant. The first RELAY_TUNE_SKIP cycles
+ * are let go by while the oscillation settles, then
+ * RELAY_TUNE_CYCLES are averaged.
+ *
+ * printRelayTuneSample() and printRelayTuneResult() stream
+ * the identification data over the UART console
+ * (UARTprintf), as comma separated lines. They block, so
+ * are for a task, never the loop.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "heli_math.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define RELAY_TUNE_SKIP         2  // Cycles let go by while the oscillation settles
+#define RELAY_TUNE_CYCLES       4  // Cycles averaged for Ku and Tu
+
+// Tuning rule, Tyreus-Luyben: better damped than Ziegler-Nichols (kp = 0.45 Ku, Ti = Tu / 1.2)
+#define RELAY_TUNE_KP_KU        NUM_CONST(1.0 / 3.2)  // kp = Ku / 3.2
+#define RELAY_TUNE_TI_TU        NUM_CONST(2.2)  // Integral time kp / ki = 2.2 Tu
+
+// States
+#define RELAY_TUNE_IDLE         0  // Not started
+#define RELAY_TUNE_RUNNING      1
+#define RELAY_TUNE_DONE         2  // Ku, Tu, kp and ki are valid
+#define RELAY_TUNE_FAILED       3  // No steady oscillation before the timeout, or too small to measure
+
+
+// What a tune found, num_t (heli_math.h)
+typedef struct Relay_Tune_Result_Struct
+{
+    uint8_t state;  // RELAY_TUNE_
+    num_t ku;  // Ultimate gain, output per unit of present value
+    num_t tu;  // Ultimate period, s
+    num_t kp;  // PI gains by the tuning rule
+    num_t ki;
+} RelayTuneResult;
+
+
+// Relay experiment on one loop
+typedef struct Relay_Tune_Struct
+{
+    //Set values
+    num_t dt;  // Time step, the period stepRelayTune() is called at
+    num_t setpoint;
+    num_t bias;  // Output the relay switches about, e.g. what the loop held before
+    num_t amplitude;  // Relay d, the output is bias +- amplitude
+    num_t hysteresis;  // Present value must cross the set point by this much to switch
+    num_t max;
+    num_t min;
+    uint32_t timeout;  // Steps before it gives up
+
+    //Variables
+    uint32_t steps;  // Since initRelayTune()
+    uint32_t last_rise;  // Step the output last switched high at
+    uint8_t cycles;  // Whole cycles seen, including those let go by
+    bool high;  // Output at bias + amplitude
+    num_t pv_max;  // Extremes of the present value this cycle
+    num_t pv_min;
+    uint32_t period_sum;  // Steps, over the cycles averaged
+    num_t swing_sum;  // Peak to peak, over the cycles averaged
+
+    RelayTuneResult result;
+} RelayTune;
+
+
+/*******************************************************
+ * Function: initRelayTune
+ *
+ * Sets up and starts a relay experiment
+ *
+ * tune: the experiment
+ * dt: time step
+ * setpoint: present value to oscillate about
+ * bias: output to switch about, e.g. what held the set point
+ * amplitude: relay d, big enough for a swing of several
+ *            counts of the measurement
+ * hysteresis: at least the measurement's noise or a count
+ * max: maximum output
+ * min: minimum output
+ * timeout: steps before it gives up
+ *******************************************************/
+void
+initRelayTune (RelayTune *tune, num_t dt, num_t setpoint, num_t bias, num_t amplitude, num_t hysteresis,
+               num_t max, num_t min, uint32_t timeout);
+
+
+/*******************************************************
+ * Function: stepRelayTune
+ *
+ * Switches the relay on the present value, and once
+ * enough cycles are in, works out Ku, Tu and the gains
+ * Call once every dt, in place of stepPID()
+ *
+ * tune: the experiment
+ * pv: the present value being measured
+ *
+ * returns: the output, bias once it is no longer running
+ *******************************************************/
+num_t
+stepRelayTune (RelayTune *tune, num_t pv);
+
+
+/*******************************************************
+ * Function: shiftRelayTune
+ *
+ * Moves the set point and the extremes seen this cycle by
+ * an offset, so the experiment carries on when the
+ * measurement moves over to a new origin
+ *
+ * tune: the experiment
+ * offset: added to the set point and the extremes
+ *******************************************************/
+void
+shiftRelayTune (RelayTune *tune, num_t offset);
+
+
+/*******************************************************
+ * Function: printRelayTuneSample
+ *
+ * Streams one sample over the UART console as
+ *     tune,<name>,<step>,<set point>,<pv>,<output>
+ * the set point and pv in hundredths, the output in ten
+ * thousandths
+ *
+ * name: the loop, e.g. "height"
+ * step: loop cycle the sample is from
+ *******************************************************/
+void
+printRelayTuneSample (const char *name, uint32_t step, num_t setpoint, num_t pv, num_t output);
+
+
+/*******************************************************
+ * Function: printRelayTuneResult
+ *
+ * Streams the result over the UART console as
+ *     tune,<name>,done,<Ku>,<Tu>,<kp>,<ki>
+ * Ku, kp and ki in millionths, Tu in ms. "failed" in
+ * place of "done" if it did not finish.
+ *
+ * name: the loop
+ *******************************************************/
+void
+printRelayTuneResult (const char *name, const RelayTuneResult *result);
+
+
+#endif /* _RELAY_TUNE_H_ */
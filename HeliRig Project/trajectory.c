@@ -0,0 +1,282 @@
+/*******************************************************
+ * trajectory.c
+ *
+ * Rate, acceleration and jerk limited set point profiles,
+ * worked out a step at a time. See trajectory.h.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "heli_math.h"
+#include "trajectory.h"
+
+
+/*******************************************************
+ * Function: clampNum
+ *
+ * returns: value restricted to -limit to limit
+ *******************************************************/
+static num_t
+clampNum (num_t value, num_t limit)
+{
+    if (value > limit)
+    {
+        return limit;
+    }
+    if (value < -limit)
+    {
+        return -limit;
+    }
+    return value;
+}
+
+
+/*******************************************************
+ * Function: absNum
+ *******************************************************/
+static num_t
+absNum (num_t value)
+{
+    return (value < 0) ? -value : value;
+}
+
+
+/*******************************************************
+ * Function: stopDistance
+ *
+ * How far the profile goes before it comes to rest if it
+ * brakes as hard as the limits allow from now: the
+ * acceleration is taken down at jmax to a peak braking
+ * acceleration, held there, then brought back to 0 at
+ * jmax as the velocity reaches 0. The peak is amax, or
+ * less if the velocity runs out first.
+ *
+ * traj: the profile, for its limits
+ * velocity: towards the target, > 0
+ * accel: in the same sense
+ *
+ * returns: distance towards the target, 0 if it is
+ *          already braking harder than it needs to
+ *******************************************************/
+static num_t
+stopDistance (const Trajectory *traj, num_t velocity, num_t accel)
+{
+    num_t peak;  // Braking acceleration reached, > 0
+    num_t t1, t2, t3;  // Times to take the acceleration down to -peak, hold it, bring it back to 0
+    num_t distance;
+
+    // Velocity lost bringing the acceleration to -amax and back: (accel^2 / 2 - amax^2) / jmax
+    peak = numSqrt(velocity + numMul(accel, numMul(accel, traj->half_inv_jmax)));  // sqrt(v + a^2 / 2 jmax)
+    peak = numMul(peak, traj->sqrt_jmax);  // sqrt(jmax v + a^2 / 2), the peak if amax is never reached
+    if (peak > traj->amax)
+    {
+        peak = traj->amax;
+    }
+    if (-accel >= peak)
+    {
+        return 0;  // Braking harder already, easing off stops it sooner
+    }
+
+    t1 = numMul(accel + peak, traj->inv_jmax);
+    t3 = numMul(peak, traj->inv_jmax);
+
+    // Phase 1, acceleration falls from accel to -peak
+    distance = numMul(velocity, t1) + numMul(numMul(accel, t1), numMul(t1, NUM_CONST(0.5)))
+               - numMul(numMul(numMul(traj->jmax, t1), t1), numMul(t1, NUM_CONST(1.0 / 6.0)));
+    velocity += numMul(accel - peak, numMul(t1, NUM_CONST(0.5)));
+
+    // Phase 2, held at -peak for whatever velocity is left over phase 3's share
+    t2 = numMul(velocity - numMul(peak, numMul(t3, NUM_CONST(0.5))), traj->inv_amax);
+    if (peak == traj->amax && t2 > 0)
+    {
+        distance += numMul(velocity, t2) - numMul(numMul(peak, t2), numMul(t2, NUM_CONST(0.5)));
+        velocity -= numMul(peak, t2);
+    }
+
+    // Phase 3, acceleration rises from -peak to 0
+    distance += numMul(velocity, t3) - numMul(numMul(peak, t3), numMul(t3, NUM_CONST(0.5)))
+                + numMul(numMul(numMul(traj->jmax, t3), t3), numMul(t3, NUM_CONST(1.0 / 6.0)));
+    return distance;
+}
+
+
+/*******************************************************
+ * Function: canStop
+ *
+ * Works out where the profile would be after a step at
+ * the acceleration accel, and whether from there it can
+ * still stop at (not past) the target, and stays under
+ * vmax as the acceleration is brought back to 0
+ *
+ * traj: the profile
+ * accel: acceleration to try for the next step
+ * sense: 1 if the target is above the position, -1 below
+ *
+ * returns: true if accel is safe to take
+ *******************************************************/
+static bool
+canStop (const Trajectory *traj, num_t accel, int32_t sense)
+{
+    num_t velocity = traj->velocity + numMul(accel, traj->dt);
+    num_t position = traj->position + numMul(velocity, traj->dt);
+    num_t remaining = traj->target - position;
+
+    // All towards the target from here
+    if (sense < 0)
+    {
+        velocity = -velocity;
+        accel = -accel;
+        remaining = -remaining;
+    }
+
+    // Still speeding up once the acceleration is brought back to 0
+    if (accel > 0 && velocity + numMul(accel, numMul(accel, traj->half_inv_jmax)) > traj->vmax)
+    {
+        return false;
+    }
+    if (velocity <= 0)
+    {
+        return remaining >= 0;  // Heading away or at rest, braking does not come into it
+    }
+    return stopDistance(traj, velocity, accel) <= remaining;
+}
+
+
+/*******************************************************
+ * Function: stepTrajectory
+ *
+ * Moves the profile on one step towards the target
+ * Call once every dt
+ *
+ * The jerk is always full on, off or full the other way:
+ * it speeds up if it can still stop in time from where
+ * that takes it, holds its acceleration if that can, and
+ * otherwise brakes. At most three tries a step.
+ *
+ * traj: the profile
+ * target: where it is to end up, can change at any time
+ *
+ * returns: the set point for this step
+ *******************************************************/
+num_t
+stepTrajectory (Trajectory *traj, num_t target)
+{
+    num_t error = target - traj->position;
+    int32_t sense = (error < 0) ? -1 : 1;
+    num_t jerk = (error < 0) ? -traj->jerk_dt : traj->jerk_dt;
+    num_t accel;
+
+    traj->target = target;
+
+    // Close enough and slow enough to stop on it in a step
+    if (absNum(error) <= traj->settle && absNum(traj->velocity) <= traj->settle_v && absNum(traj->accel) <= traj->jerk_dt)
+    {
+        resetTrajectory(traj, target);
+        return target;
+    }
+
+    accel = clampNum(traj->accel + jerk, traj->amax);
+    if (!canStop(traj, accel, sense))
+    {
+        accel = traj->accel;
+        if (!canStop(traj, accel, sense))
+        {
+            accel = clampNum(traj->accel - jerk, traj->amax);
+        }
+    }
+
+    traj->jerk = numMul(accel - traj->accel, traj->inv_dt);
+    traj->accel = accel;
+    traj->velocity = clampNum(traj->velocity + numMul(accel, traj->dt), traj->vmax);
+    traj->position += numMul(traj->velocity, traj->dt);
+
+    return traj->position;
+}
+
+
+/*******************************************************
+ * Function: resetTrajectory
+ *
+ * Puts the profile at rest at a position, keeping the
+ * limits
+ *
+ * traj: the profile
+ * position: set point to start from
+ *******************************************************/
+void
+resetTrajectory (Trajectory *traj, num_t position)
+{
+    traj->position = position;
+    traj->velocity = 0;
+    traj->accel = 0;
+    traj->jerk = 0;
+    traj->target = position;
+}
+
+
+/*******************************************************
+ * Function: shiftTrajectory
+ *
+ * Moves the profile and its target by an offset, keeping
+ * its motion, e.g. when the measurement it is followed
+ * against moves over to a new origin
+ *
+ * traj: the profile
+ * offset: added to the position and the target
+ *******************************************************/
+void
+shiftTrajectory (Trajectory *traj, num_t offset)
+{
+    traj->position += offset;
+    traj->target += offset;
+}
+
+
+/*******************************************************
+ * Function: initTrajectory
+ *
+ * Sets the limits of a profile and puts it at rest
+ *
+ * traj: the profile
+ * dt: time step
+ * vmax: most rate of change of the set point, per s
+ * amax: most acceleration, per s^2
+ * jmax: most jerk, per s^3
+ * position: set point to start from
+ *******************************************************/
+void
+initTrajectory (Trajectory *traj, num_t dt, num_t vmax, num_t amax, num_t jmax, num_t position)
+{
+    traj->vmax = vmax;
+    traj->amax = amax;
+    traj->jmax = jmax;
+
+    traj->dt = dt;
+    traj->inv_dt = numDiv(NUM_ONE, dt);
+    traj->jerk_dt = numMul(jmax, dt);
+    traj->inv_amax = numDiv(NUM_ONE, amax);
+    traj->inv_jmax = numDiv(NUM_ONE, jmax);
+    traj->half_inv_jmax = numDiv(NUM_ONE, 2 * jmax);
+    traj->sqrt_jmax = numSqrt(jmax);
+    // A few steps' worth of jerk, well clear of float resolution at set points in the thousands
+    traj->settle_v = numMul(traj->jerk_dt, 4 * dt);
+    traj->settle = numMul(traj->settle_v, 4 * dt);
+
+    resetTrajectory(traj, position);
+}
+
+
+/*******************************************************
+ * Function: isTrajectoryDone
+ *
+ * returns: true once the profile is at rest on its target
+ *******************************************************/
+bool
+isTrajectoryDone (const Trajectory *traj)
+{
+    return traj->position == traj->target && traj->velocity == 0 && traj->accel == 0 && traj->jerk == 0;
+}
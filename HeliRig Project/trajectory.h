@@ -0,0 +1,135 @@
+#ifndef _TRAJECTORY_H_
+#define _TRAJECTORY_H_
+
+/*******************************************************
+ * trajectory.h
+ *
+ * Turns set point steps (e.g. a button press moving the
+ * height 5% or the yaw 10 degrees) into a smooth profile
+ * for a loop to follow, limited in rate, acceleration and
+ * jerk, so the loop is never asked for more than the
+ * motors can give and does not saturate and overshoot.
+ *
+ * The profile is worked out a step at a time as it is
+ * followed, from its present position, velocity and
+ * acceleration, rather than planned in advance, so the
+ * target can change at any time (even part way through a
+ * move, or in the other direction) and every step costs
+ * the same: no loops or tables, at most three braking
+ * distances of one square root each.
+ *
+ * Each step the jerk is full on, off, or full the other
+ * way: the profile speeds up if from where that takes it,
+ * it can still brake to rest at the target (an S-curve
+ * stop, the acceleration ramped at jmax to at most amax
+ * and back), otherwise holds its acceleration if that
+ * can, and otherwise brakes. It arrives on the target
+ * without overshoot, to within a step.
+ *
+ * Like PIDController, each loop keeps its own Trajectory
+ * and steps it from the one place.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdbool.h>
+
+#include "heli_math.h"
+
+
+// Profile state and limits, num_t (heli_math.h) in the units of the loop's set point
+typedef struct Trajectory_Struct
+{
+    //Limits
+    num_t vmax;  // Rate, units per s
+    num_t amax;  // Acceleration, units per s^2
+    num_t jmax;  // Jerk, units per s^3
+
+    //Worked out once by initTrajectory() (a fixed point divide is a library call)
+    num_t dt;  // Time step, the period stepTrajectory() is called at
+    num_t inv_dt;  // 1 / dt
+    num_t jerk_dt;  // Most the acceleration changes in a step, jmax * dt
+    num_t inv_amax;  // 1 / amax
+    num_t inv_jmax;  // 1 / jmax
+    num_t half_inv_jmax;  // 1 / (2 jmax)
+    num_t sqrt_jmax;
+    num_t settle_v;  // Snaps to the target from this slow ...
+    num_t settle;  // ... and this close, a few steps' worth of jerk
+
+    //Variables
+    num_t position;  // The set point to follow
+    num_t velocity;
+    num_t accel;
+    num_t jerk;  // Over the last step, for feed-forward through a lagging motor
+    num_t target;
+} Trajectory;
+
+
+/*******************************************************
+ * Function: stepTrajectory
+ *
+ * Moves the profile on one step towards the target
+ * Call once every dt
+ *
+ * traj: the profile
+ * target: where it is to end up, can change at any time
+ *
+ * returns: the set point for this step
+ *******************************************************/
+num_t
+stepTrajectory (Trajectory *traj, num_t target);
+
+
+/*******************************************************
+ * Function: resetTrajectory
+ *
+ * Puts the profile at rest at a position, e.g. where the
+ * loop is when it takes over, keeping the limits
+ *
+ * traj: the profile
+ * position: set point to start from
+ *******************************************************/
+void
+resetTrajectory (Trajectory *traj, num_t position);
+
+
+/*******************************************************
+ * Function: shiftTrajectory
+ *
+ * Moves the profile and its target by an offset, keeping
+ * its motion, e.g. when the measurement it is followed
+ * against moves over to a new origin
+ *
+ * traj: the profile
+ * offset: added to the position and the target
+ *******************************************************/
+void
+shiftTrajectory (Trajectory *traj, num_t offset);
+
+/*******************************************************
+ * Function: initTrajectory
+ *
+ * Sets the limits of a profile and puts it at rest
+ *
+ * traj: the profile
+ * dt: time step
+ * vmax: most rate of change of the set point, per s
+ * amax: most acceleration, per s^2
+ * jmax: most jerk, per s^3
+ * position: set point to start from
+ *******************************************************/
+void
+initTrajectory (Trajectory *traj, num_t dt, num_t vmax, num_t amax, num_t jmax, num_t position);
+
+
+/*******************************************************
+ * Function: isTrajectoryDone
+ *
+ * returns: true once the profile is at rest on its target
+ *******************************************************/
+bool
+isTrajectoryDone (const Trajectory *traj);
+
+
+#endif /* _TRAJECTORY_H_ */
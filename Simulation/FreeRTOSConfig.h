@@ -0,0 +1,61 @@
+/*
+ * FreeRTOSConfig.h (host simulation)
+ *
+ * Configuration for running the HeliRig firmware on the FreeRTOS
+ * POSIX port. Kept in step with ../FreeRTOSConfig.h, apart from
+ * the stack and heap sizes and the tick hook that drives the
+ * simulated peripherals (see sim_freertos.c).
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ */
+
+#ifndef FREERTOSCONFIG_H_
+#define FREERTOSCONFIG_H_
+
+
+/* Per-Project FreeRTOS Configuration */
+
+#define configMINIMAL_STACK_SIZE 4096 // Every task is a pthread, which needs at least PTHREAD_STACK_MIN
+
+#define configMAX_PRIORITIES 8
+
+#define configUSE_PREEMPTION 1
+
+#define configUSE_IDLE_HOOK 0
+
+#define configUSE_TICK_HOOK 1 // Advances the simulated peripherals once per tick
+
+#define INCLUDE_vTaskPrioritySet 0
+
+#define INCLUDE_uxTaskPriorityGet 0
+
+#define INCLUDE_vTaskDelete 1
+
+#define INCLUDE_vTaskSuspend 1
+
+#define INCLUDE_vTaskDelayUntil 1
+
+#define INCLUDE_vTaskDelay 1
+
+#define configUSE_16_BIT_TICKS 0
+
+#define configKERNEL_INTERRUPT_PRIORITY (7 << 5) // Unused by the POSIX port, kept so shared code sees the target values
+
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY (1 << 5)
+
+#define configTOTAL_HEAP_SIZE (512 * 1024) // Task stacks back pthreads, so the heap is much larger than on the Tiva
+
+#define configCPU_CLOCK_HZ 80000000UL // Simulated clock, matches initCLK()
+
+#define configTICK_RATE_HZ 1000 // 1ms SysTick ticker
+
+
+/* Application task stacks (32 words on the Tiva) must also hold a pthread */
+#define TASK_STACK_DEPTH configMINIMAL_STACK_SIZE
+#define AUTOTUNE_STACK_DEPTH configMINIMAL_STACK_SIZE
+#define HEIGHT_STACK_DEPTH configMINIMAL_STACK_SIZE
+#define CONTROL_STACK_DEPTH configMINIMAL_STACK_SIZE
+
+
+#endif /* FREERTOSCONFIG_H_ */
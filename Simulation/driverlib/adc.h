@@ -0,0 +1,47 @@
+#ifndef __DRIVERLIB_ADC_H__
+#define __DRIVERLIB_ADC_H__
+
+/*******************************************************
+ * driverlib/adc.h (host stand-in)
+ *
+ * ADC0 sequencer API, implemented against the simulated
+ * sample FIFOs in sim_peripherals.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ADC_TRIGGER_PROCESSOR   0x00000000
+#define ADC_TRIGGER_COMP0       0x00000001
+#define ADC_TRIGGER_EXTERNAL    0x00000004
+#define ADC_TRIGGER_TIMER       0x00000005
+#define ADC_TRIGGER_PWM0        0x00000006
+#define ADC_TRIGGER_ALWAYS      0x0000000F
+
+#define ADC_CTL_TS              0x00000080
+#define ADC_CTL_IE              0x00000040
+#define ADC_CTL_END             0x00000020
+#define ADC_CTL_D               0x00000010
+#define ADC_CTL_CH0             0x00000000
+#define ADC_CTL_CH1             0x00000001
+#define ADC_CTL_CH2             0x00000002
+#define ADC_CTL_CH3             0x00000003
+#define ADC_CTL_CH9             0x00000009
+
+void ADCSequenceConfigure (uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t ui32Trigger, uint32_t ui32Priority);
+void ADCSequenceStepConfigure (uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t ui32Step, uint32_t ui32Config);
+void ADCSequenceEnable (uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCSequenceDisable (uint32_t ui32Base, uint32_t ui32SequenceNum);
+int32_t ADCSequenceDataGet (uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t *pui32Buffer);
+void ADCProcessorTrigger (uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCIntRegister (uint32_t ui32Base, uint32_t ui32SequenceNum, void (*pfnHandler)(void));
+void ADCIntEnable (uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCIntDisable (uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCIntClear (uint32_t ui32Base, uint32_t ui32SequenceNum);
+uint32_t ADCIntStatus (uint32_t ui32Base, uint32_t ui32SequenceNum, bool bMasked);
+void ADCHardwareOversampleConfigure (uint32_t ui32Base, uint32_t ui32Factor);
+
+#endif /* __DRIVERLIB_ADC_H__ */
@@ -0,0 +1,20 @@
+#ifndef __DRIVERLIB_DEBUG_H__
+#define __DRIVERLIB_DEBUG_H__
+
+/*******************************************************
+ * driverlib/debug.h (host stand-in)
+ *
+ * Maps the TivaWare ASSERT() onto the C library assert
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <assert.h>
+
+#define ASSERT(expr)    assert(expr)
+
+#endif /* __DRIVERLIB_DEBUG_H__ */
@@ -0,0 +1,19 @@
+#ifndef __DRIVERLIB_FPU_H__
+#define __DRIVERLIB_FPU_H__
+
+/*******************************************************
+ * driverlib/fpu.h (host stand-in)
+ *
+ * The host always has a hardware FPU, so these are no-ops
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FPUEnable()         ((void)0)
+#define FPULazyStackingEnable() ((void)0)
+
+#endif /* __DRIVERLIB_FPU_H__ */
@@ -0,0 +1,71 @@
+#ifndef __DRIVERLIB_GPIO_H__
+#define __DRIVERLIB_GPIO_H__
+
+/*******************************************************
+ * driverlib/gpio.h (host stand-in)
+ *
+ * GPIO port API, implemented against the simulated pin
+ * levels and edge detection in sim_peripherals.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define GPIO_PIN_0              0x00000001
+#define GPIO_PIN_1              0x00000002
+#define GPIO_PIN_2              0x00000004
+#define GPIO_PIN_3              0x00000008
+#define GPIO_PIN_4              0x00000010
+#define GPIO_PIN_5              0x00000020
+#define GPIO_PIN_6              0x00000040
+#define GPIO_PIN_7              0x00000080
+
+#define GPIO_INT_PIN_0          0x00000001
+#define GPIO_INT_PIN_1          0x00000002
+#define GPIO_INT_PIN_2          0x00000004
+#define GPIO_INT_PIN_3          0x00000008
+#define GPIO_INT_PIN_4          0x00000010
+#define GPIO_INT_PIN_5          0x00000020
+#define GPIO_INT_PIN_6          0x00000040
+#define GPIO_INT_PIN_7          0x00000080
+
+#define GPIO_DIR_MODE_IN        0x00000000
+#define GPIO_DIR_MODE_OUT       0x00000001
+#define GPIO_DIR_MODE_HW        0x00000002
+
+#define GPIO_FALLING_EDGE       0x00000000
+#define GPIO_RISING_EDGE        0x00000004
+#define GPIO_BOTH_EDGES         0x00000001
+#define GPIO_LOW_LEVEL          0x00000002
+#define GPIO_HIGH_LEVEL         0x00000006
+
+#define GPIO_STRENGTH_2MA       0x00000001
+#define GPIO_STRENGTH_4MA       0x00000002
+#define GPIO_STRENGTH_8MA       0x00000066
+#define GPIO_PIN_TYPE_STD       0x00000008
+#define GPIO_PIN_TYPE_STD_WPU   0x0000000A
+#define GPIO_PIN_TYPE_STD_WPD   0x0000000C
+
+void GPIOPinTypeGPIOInput (uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinTypeGPIOOutput (uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinTypeSSI (uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinTypeUART (uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinTypePWM (uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinTypeQEI (uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinTypeADC (uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinConfigure (uint32_t ui32PinConfig);
+void GPIOPadConfigSet (uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32Strength, uint32_t ui32PadType);
+void GPIODirModeSet (uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32PinIO);
+int32_t GPIOPinRead (uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinWrite (uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val);
+void GPIOIntRegister (uint32_t ui32Port, void (*pfnIntHandler)(void));
+void GPIOIntTypeSet (uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32IntType);
+void GPIOIntEnable (uint32_t ui32Port, uint32_t ui32IntFlags);
+void GPIOIntDisable (uint32_t ui32Port, uint32_t ui32IntFlags);
+void GPIOIntClear (uint32_t ui32Port, uint32_t ui32IntFlags);
+uint32_t GPIOIntStatus (uint32_t ui32Port, bool bMasked);
+
+#endif /* __DRIVERLIB_GPIO_H__ */
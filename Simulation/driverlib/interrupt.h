@@ -0,0 +1,23 @@
+#ifndef __DRIVERLIB_INTERRUPT_H__
+#define __DRIVERLIB_INTERRUPT_H__
+
+/*******************************************************
+ * driverlib/interrupt.h (host stand-in)
+ *
+ * NVIC API. Masking interrupts defers the simulated
+ * interrupt handlers until they are unmasked again
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+bool IntMasterEnable (void);
+bool IntMasterDisable (void);
+void IntEnable (uint32_t ui32Interrupt);
+void IntDisable (uint32_t ui32Interrupt);
+void IntPrioritySet (uint32_t ui32Interrupt, uint8_t ui8Priority);
+
+#endif /* __DRIVERLIB_INTERRUPT_H__ */
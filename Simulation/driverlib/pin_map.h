@@ -0,0 +1,31 @@
+#ifndef __DRIVERLIB_PIN_MAP_H__
+#define __DRIVERLIB_PIN_MAP_H__
+
+/*******************************************************
+ * driverlib/pin_map.h (host stand-in)
+ *
+ * Pin mux codes for the TM4C123GH6PM pins the HeliRig
+ * firmware configures
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define GPIO_PA0_U0RX           0x00000001
+#define GPIO_PA1_U0TX           0x00000401
+#define GPIO_PB6_M0PWM0         0x00011804
+#define GPIO_PC5_M0PWM7         0x00021404
+#define GPIO_PD0_SSI3CLK        0x00030001
+#define GPIO_PD3_SSI3TX         0x00030C01
+#define GPIO_PD6_PHA0           0x00031806
+#define GPIO_PD7_PHB0           0x00031C06
+#define GPIO_PF0_PHA0           0x00050006
+#define GPIO_PF1_PHB0           0x00050406
+#define GPIO_PF1_M1PWM5         0x00050405
+#define GPIO_PC5_PHA1           0x00021406
+#define GPIO_PC6_PHB1           0x00021806
+
+#endif /* __DRIVERLIB_PIN_MAP_H__ */
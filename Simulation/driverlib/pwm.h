@@ -0,0 +1,56 @@
+#ifndef __DRIVERLIB_PWM_H__
+#define __DRIVERLIB_PWM_H__
+
+/*******************************************************
+ * driverlib/pwm.h (host stand-in)
+ *
+ * PWM generator API. The simulated generators keep their
+ * load and compare values in their registers (inc/hw_pwm.h),
+ * worked out as driverlib does, so the plant can read the
+ * duty cycle back with simPWMDutyGet()
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PWM_GEN_0               0x00000040
+#define PWM_GEN_1               0x00000080
+#define PWM_GEN_2               0x000000C0
+#define PWM_GEN_3               0x00000100
+
+#define PWM_OUT_0               0x00000040
+#define PWM_OUT_1               0x00000041
+#define PWM_OUT_2               0x00000080
+#define PWM_OUT_3               0x00000081
+#define PWM_OUT_4               0x000000C0
+#define PWM_OUT_5               0x000000C1
+#define PWM_OUT_6               0x00000100
+#define PWM_OUT_7               0x00000101
+
+#define PWM_OUT_0_BIT           0x00000001
+#define PWM_OUT_1_BIT           0x00000002
+#define PWM_OUT_2_BIT           0x00000004
+#define PWM_OUT_3_BIT           0x00000008
+#define PWM_OUT_4_BIT           0x00000010
+#define PWM_OUT_5_BIT           0x00000020
+#define PWM_OUT_6_BIT           0x00000040
+#define PWM_OUT_7_BIT           0x00000080
+
+#define PWM_GEN_MODE_DOWN       0x00000000
+#define PWM_GEN_MODE_UP_DOWN    0x00000002
+#define PWM_GEN_MODE_SYNC       0x00000038
+#define PWM_GEN_MODE_NO_SYNC    0x00000000
+
+void PWMGenConfigure (uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Config);
+void PWMGenPeriodSet (uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Period);
+uint32_t PWMGenPeriodGet (uint32_t ui32Base, uint32_t ui32Gen);
+void PWMGenEnable (uint32_t ui32Base, uint32_t ui32Gen);
+void PWMGenDisable (uint32_t ui32Base, uint32_t ui32Gen);
+void PWMPulseWidthSet (uint32_t ui32Base, uint32_t ui32PWMOut, uint32_t ui32Width);
+uint32_t PWMPulseWidthGet (uint32_t ui32Base, uint32_t ui32PWMOut);
+void PWMOutputState (uint32_t ui32Base, uint32_t ui32PWMOutBits, bool bEnable);
+
+#endif /* __DRIVERLIB_PWM_H__ */
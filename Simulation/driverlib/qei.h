@@ -0,0 +1,58 @@
+#ifndef __DRIVERLIB_QEI_H__
+#define __DRIVERLIB_QEI_H__
+
+/*******************************************************
+ * driverlib/qei.h (host stand-in)
+ *
+ * Quadrature encoder interface API, implemented against
+ * the QEI registers (inc/hw_qei.h) in the simulated
+ * register file
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define QEI_CONFIG_CAPTURE_A    0x00000000
+#define QEI_CONFIG_CAPTURE_A_B  0x00000008
+#define QEI_CONFIG_NO_RESET     0x00000000
+#define QEI_CONFIG_RESET_IDX    0x00000010
+#define QEI_CONFIG_QUADRATURE   0x00000000
+#define QEI_CONFIG_CLOCK_DIR    0x00000004
+#define QEI_CONFIG_NO_SWAP      0x00000000
+#define QEI_CONFIG_SWAP         0x00000002
+
+#define QEI_VELDIV_1            0x00000000
+#define QEI_VELDIV_2            0x00000040
+#define QEI_VELDIV_4            0x00000080
+#define QEI_VELDIV_8            0x000000C0
+#define QEI_VELDIV_16           0x00000100
+#define QEI_VELDIV_32           0x00000140
+#define QEI_VELDIV_64           0x00000180
+#define QEI_VELDIV_128          0x000001C0
+
+#define QEI_INTERROR            0x00000008
+#define QEI_INTDIR              0x00000004
+#define QEI_INTTIMER            0x00000002
+#define QEI_INTINDEX            0x00000001
+
+void QEIEnable (uint32_t ui32Base);
+void QEIDisable (uint32_t ui32Base);
+void QEIConfigure (uint32_t ui32Base, uint32_t ui32Config, uint32_t ui32MaxPosition);
+uint32_t QEIPositionGet (uint32_t ui32Base);
+void QEIPositionSet (uint32_t ui32Base, uint32_t ui32Position);
+int32_t QEIDirectionGet (uint32_t ui32Base);
+bool QEIErrorGet (uint32_t ui32Base);
+void QEIVelocityEnable (uint32_t ui32Base);
+void QEIVelocityDisable (uint32_t ui32Base);
+void QEIVelocityConfigure (uint32_t ui32Base, uint32_t ui32PreDiv, uint32_t ui32Period);
+uint32_t QEIVelocityGet (uint32_t ui32Base);
+void QEIIntRegister (uint32_t ui32Base, void (*pfnHandler)(void));
+void QEIIntEnable (uint32_t ui32Base, uint32_t ui32IntFlags);
+void QEIIntDisable (uint32_t ui32Base, uint32_t ui32IntFlags);
+uint32_t QEIIntStatus (uint32_t ui32Base, bool bMasked);
+void QEIIntClear (uint32_t ui32Base, uint32_t ui32IntFlags);
+
+#endif /* __DRIVERLIB_QEI_H__ */
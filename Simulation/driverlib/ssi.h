@@ -0,0 +1,29 @@
+#ifndef __DRIVERLIB_SSI_H__
+#define __DRIVERLIB_SSI_H__
+
+/*******************************************************
+ * driverlib/ssi.h (host stand-in)
+ *
+ * Synchronous serial API. Every byte written with
+ * SSIDataPut() is counted so display throughput can be
+ * measured on the host
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SSI_CLOCK_SYSTEM        0x00000000
+#define SSI_FRF_MOTO_MODE_0     0x00000000
+#define SSI_MODE_MASTER         0x00000000
+
+void SSIClockSourceSet (uint32_t ui32Base, uint32_t ui32Source);
+void SSIConfigSetExpClk (uint32_t ui32Base, uint32_t ui32SSIClk, uint32_t ui32Protocol, uint32_t ui32Mode, uint32_t ui32BitRate, uint32_t ui32DataWidth);
+void SSIEnable (uint32_t ui32Base);
+bool SSIBusy (uint32_t ui32Base);
+void SSIDataPut (uint32_t ui32Base, uint32_t ui32Data);
+void SSIDataGet (uint32_t ui32Base, uint32_t *pui32Data);
+
+#endif /* __DRIVERLIB_SSI_H__ */
@@ -0,0 +1,62 @@
+#ifndef __DRIVERLIB_SYSCTL_H__
+#define __DRIVERLIB_SYSCTL_H__
+
+/*******************************************************
+ * driverlib/sysctl.h (host stand-in)
+ *
+ * System control API. The simulated clock reports the
+ * frequency last set by SysCtlClockSet()
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SYSCTL_PERIPH_ADC0      0xf0003800
+#define SYSCTL_PERIPH_ADC1      0xf0003801
+#define SYSCTL_PERIPH_GPIOA     0xf0000800
+#define SYSCTL_PERIPH_GPIOB     0xf0000801
+#define SYSCTL_PERIPH_GPIOC     0xf0000802
+#define SYSCTL_PERIPH_GPIOD     0xf0000803
+#define SYSCTL_PERIPH_GPIOE     0xf0000804
+#define SYSCTL_PERIPH_GPIOF     0xf0000805
+#define SYSCTL_PERIPH_PWM0      0xf0004000
+#define SYSCTL_PERIPH_PWM1      0xf0004001
+#define SYSCTL_PERIPH_QEI0      0xf0004400
+#define SYSCTL_PERIPH_QEI1      0xf0004401
+#define SYSCTL_PERIPH_SSI3      0xf0001c03
+#define SYSCTL_PERIPH_TIMER0    0xf0000400
+#define SYSCTL_PERIPH_TIMER1    0xf0000401
+#define SYSCTL_PERIPH_TIMER2    0xf0000402
+#define SYSCTL_PERIPH_TIMER3    0xf0000403
+#define SYSCTL_PERIPH_UART0     0xf0001800
+#define SYSCTL_PERIPH_UDMA      0xf0000c00
+
+#define SYSCTL_SYSDIV_1         0x07800000
+#define SYSCTL_SYSDIV_2_5       0xC1000000
+#define SYSCTL_SYSDIV_10        0x84800000
+#define SYSCTL_USE_PLL          0x00000000
+#define SYSCTL_USE_OSC          0x00003800
+#define SYSCTL_OSC_MAIN         0x00000000
+#define SYSCTL_XTAL_16MHZ       0x00000540
+
+#define SYSCTL_PWMDIV_1         0x00000000
+#define SYSCTL_PWMDIV_2         0x00100000
+#define SYSCTL_PWMDIV_4         0x00120000
+#define SYSCTL_PWMDIV_8         0x00140000
+#define SYSCTL_PWMDIV_16        0x00160000
+#define SYSCTL_PWMDIV_32        0x00180000
+#define SYSCTL_PWMDIV_64        0x001A0000
+
+void SysCtlClockSet (uint32_t ui32Config);
+uint32_t SysCtlClockGet (void);
+void SysCtlPWMClockSet (uint32_t ui32Config);
+uint32_t SysCtlPWMClockGet (void);
+void SysCtlPeripheralEnable (uint32_t ui32Peripheral);
+void SysCtlPeripheralReset (uint32_t ui32Peripheral);
+bool SysCtlPeripheralReady (uint32_t ui32Peripheral);
+void SysCtlDelay (uint32_t ui32Count);
+
+#endif /* __DRIVERLIB_SYSCTL_H__ */
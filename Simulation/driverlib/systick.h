@@ -0,0 +1,22 @@
+#ifndef __DRIVERLIB_SYSTICK_H__
+#define __DRIVERLIB_SYSTICK_H__
+
+/*******************************************************
+ * driverlib/systick.h (host stand-in)
+ *
+ * SysTick API. The FreeRTOS port owns the tick on the
+ * host, so these only record the requested settings
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+void SysTickPeriodSet (uint32_t ui32Period);
+void SysTickIntRegister (void (*pfnHandler)(void));
+void SysTickIntEnable (void);
+void SysTickEnable (void);
+
+#endif /* __DRIVERLIB_SYSTICK_H__ */
@@ -0,0 +1,41 @@
+#ifndef __DRIVERLIB_TIMER_H__
+#define __DRIVERLIB_TIMER_H__
+
+/*******************************************************
+ * driverlib/timer.h (host stand-in)
+ *
+ * General purpose timer API, implemented against the
+ * simulated timers advanced by simStep()
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TIMER_CFG_ONE_SHOT      0x00000021
+#define TIMER_CFG_ONE_SHOT_UP   0x00000031
+#define TIMER_CFG_PERIODIC      0x00000022
+#define TIMER_CFG_PERIODIC_UP   0x00000032
+
+#define TIMER_A                 0x000000ff
+#define TIMER_B                 0x0000ff00
+#define TIMER_BOTH              0x0000ffff
+
+#define TIMER_TIMA_TIMEOUT      0x00000001
+
+void TimerConfigure (uint32_t ui32Base, uint32_t ui32Config);
+void TimerLoadSet (uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value);
+uint32_t TimerLoadGet (uint32_t ui32Base, uint32_t ui32Timer);
+uint32_t TimerValueGet (uint32_t ui32Base, uint32_t ui32Timer);
+void TimerEnable (uint32_t ui32Base, uint32_t ui32Timer);
+void TimerDisable (uint32_t ui32Base, uint32_t ui32Timer);
+void TimerControlTrigger (uint32_t ui32Base, uint32_t ui32Timer, bool bEnable);
+void TimerIntRegister (uint32_t ui32Base, uint32_t ui32Timer, void (*pfnHandler)(void));
+void TimerIntEnable (uint32_t ui32Base, uint32_t ui32IntFlags);
+void TimerIntDisable (uint32_t ui32Base, uint32_t ui32IntFlags);
+void TimerIntClear (uint32_t ui32Base, uint32_t ui32IntFlags);
+uint32_t TimerIntStatus (uint32_t ui32Base, bool bMasked);
+
+#endif /* __DRIVERLIB_TIMER_H__ */
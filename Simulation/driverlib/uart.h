@@ -0,0 +1,22 @@
+#ifndef __DRIVERLIB_UART_H__
+#define __DRIVERLIB_UART_H__
+
+/*******************************************************
+ * driverlib/uart.h (host stand-in)
+ *
+ * UART configuration API. Console output on the host
+ * goes through the utils/uartstdio.h stand-in instead
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define UART_CLOCK_SYSTEM       0x00000000
+#define UART_CLOCK_PIOSC        0x00000005
+
+void UARTClockSourceSet (uint32_t ui32Base, uint32_t ui32Source);
+
+#endif /* __DRIVERLIB_UART_H__ */
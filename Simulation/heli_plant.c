@@ -0,0 +1,259 @@
+/*******************************************************
+ * heli_plant.c
+ *
+ * Discrete-time model of the HeliRig for the host
+ * simulation. See heli_plant.h.
+ *
+ * The model is integrated with semi-implicit Euler, which
+ * is stable at the 1 ms step the simulation runs at. The
+ * parameters are a first guess at the rig (hover near 45%
+ * main duty, tail near 35% to hold yaw at hover) and
+ * should be refined against recorded data.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <math.h>
+
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pwm.h"
+
+#include "sim_peripherals.h"
+#include "heli_plant.h"
+
+
+static heliPlant_t *g_psAttached;  // Plant driven by the simulation step hook
+static int32_t g_i32EmittedCount;  // Quadrature count already put on PB0/PB1
+
+
+/*******************************************************
+ * Function: firstOrder
+ *
+ * One step of a first order lag towards fTarget
+ *******************************************************/
+static float
+firstOrder (float fState, float fTarget, float fTau, float fDt)
+{
+    return fState + (fTarget - fState) * (fDt / (fTau + fDt));
+}
+
+
+/*******************************************************
+ * Function: clampDuty
+ *******************************************************/
+static float
+clampDuty (float fDuty)
+{
+    if (fDuty < 0.0f) {
+        return 0.0f;
+    }
+    if (fDuty > 1.0f) {
+        return 1.0f;
+    }
+    return fDuty;
+}
+
+
+/*******************************************************
+ * Function: initHeliPlant
+ *
+ * Loads the default parameters and lands the helicopter
+ * at zero yaw
+ *******************************************************/
+void
+initHeliPlant (heliPlant_t *psPlant)
+{
+    psPlant->sParams.fMainTau = 0.10f;
+    psPlant->sParams.fTailTau = 0.05f;
+    psPlant->sParams.fGravity = 2.0f;
+    psPlant->sParams.fLiftGain = 2.0f / 0.45f;  // Hover at 45% main duty
+    psPlant->sParams.fHeightDamping = 6.0f;
+    psPlant->sParams.fTailGain = 900.0f;
+    psPlant->sParams.fCouplingGain = 700.0f;  // Tail near 35% holds yaw at hover
+    psPlant->sParams.fYawDamping = 6.0f;
+    psPlant->sParams.ui32ADCNoise = 0;
+
+    psPlant->fMainThrust = 0.0f;
+    psPlant->fTailThrust = 0.0f;
+    psPlant->fHeight = 0.0f;
+    psPlant->fHeightRate = 0.0f;
+    psPlant->fYaw = 0.0f;
+    psPlant->fYawRate = 0.0f;
+    psPlant->ui32NoiseSeed = 0x12345678;
+}
+
+
+/*******************************************************
+ * Function: heliPlantStep
+ *
+ * Integrates the model over one time step
+ *******************************************************/
+void
+heliPlantStep (heliPlant_t *psPlant, float fDt, float fMainDuty, float fTailDuty)
+{
+    const heliPlantParams_t *psP = &psPlant->sParams;
+    float fAccel;
+
+    psPlant->fMainThrust = firstOrder(psPlant->fMainThrust, clampDuty(fMainDuty), psP->fMainTau, fDt);
+    psPlant->fTailThrust = firstOrder(psPlant->fTailThrust, clampDuty(fTailDuty), psP->fTailTau, fDt);
+
+    // Height, held between the landed and full-height stops
+    fAccel = psP->fLiftGain * psPlant->fMainThrust - psP->fGravity - psP->fHeightDamping * psPlant->fHeightRate;
+    if (psPlant->fHeight <= 0.0f && fAccel < 0.0f) {
+        fAccel = 0.0f;  // Resting on the ground
+    }
+    psPlant->fHeightRate += fAccel * fDt;
+    psPlant->fHeight += psPlant->fHeightRate * fDt;
+    if (psPlant->fHeight < 0.0f) {
+        psPlant->fHeight = 0.0f;
+        psPlant->fHeightRate = 0.0f;
+    } else if (psPlant->fHeight > 1.0f) {
+        psPlant->fHeight = 1.0f;
+        psPlant->fHeightRate = 0.0f;
+    }
+
+    // Yaw, the main rotor reaction torque only acts once the rig is off the ground
+    fAccel = psP->fTailGain * psPlant->fTailThrust - psP->fYawDamping * psPlant->fYawRate;
+    if (psPlant->fHeight > 0.0f) {
+        fAccel -= psP->fCouplingGain * psPlant->fMainThrust;
+    }
+    psPlant->fYawRate += fAccel * fDt;
+    psPlant->fYaw += psPlant->fYawRate * fDt;
+}
+
+
+/*******************************************************
+ * Function: heliPlantADCCounts
+ *
+ * returns: the ADC reading for the current height,
+ *          including noise
+ *******************************************************/
+uint32_t
+heliPlantADCCounts (heliPlant_t *psPlant)
+{
+    int32_t i32Counts = PLANT_ADC_LANDED - (int32_t) lroundf(psPlant->fHeight * PLANT_ADC_FULL_DROP);
+    uint32_t ui32Noise = psPlant->sParams.ui32ADCNoise;
+
+    if (ui32Noise) {
+        // xorshift32, so runs are repeatable
+        psPlant->ui32NoiseSeed ^= psPlant->ui32NoiseSeed << 13;
+        psPlant->ui32NoiseSeed ^= psPlant->ui32NoiseSeed >> 17;
+        psPlant->ui32NoiseSeed ^= psPlant->ui32NoiseSeed << 5;
+        i32Counts += (int32_t) (psPlant->ui32NoiseSeed % (2 * ui32Noise + 1)) - (int32_t) ui32Noise;
+    }
+
+    if (i32Counts < 0) {
+        i32Counts = 0;
+    } else if (i32Counts > SIM_ADC_MAX_COUNTS) {
+        i32Counts = SIM_ADC_MAX_COUNTS;
+    }
+    return (uint32_t) i32Counts;
+}
+
+
+/*******************************************************
+ * Function: heliPlantQuadCount
+ *
+ * returns: the signed quadrature count for the current
+ *          yaw (one count per A/B edge)
+ *******************************************************/
+int32_t
+heliPlantQuadCount (const heliPlant_t *psPlant)
+{
+    return (int32_t) floorf(psPlant->fYaw * PLANT_YAW_COUNTS_PER_REV / 360.0f);
+}
+
+
+/*******************************************************
+ * Function: quadPinsForCount
+ *
+ * Gray code phase on PB0 (A) and PB1 (B) for a count.
+ * Counting up, B leads A (00, 01, 11, 10), which is the
+ * direction quadIntHandler counts as positive.
+ *******************************************************/
+static uint8_t
+quadPinsForCount (int32_t i32Count)
+{
+    static const uint8_t pui8Phase[4] = {
+        0,
+        GPIO_PIN_1,
+        GPIO_PIN_0 | GPIO_PIN_1,
+        GPIO_PIN_0,
+    };
+
+    return pui8Phase[i32Count & 3];
+}
+
+
+/*******************************************************
+ * Function: refPinForCount
+ *
+ * Level of the reference signal on PC4 for a count, low
+ * over the reference slot in every revolution
+ *******************************************************/
+static uint8_t
+refPinForCount (int32_t i32Count)
+{
+    int32_t i32InRev = i32Count % PLANT_YAW_COUNTS_PER_REV;
+
+    if (i32InRev < 0) {
+        i32InRev += PLANT_YAW_COUNTS_PER_REV;
+    }
+    return (i32InRev >= PLANT_YAW_REF_COUNT && i32InRev < PLANT_YAW_REF_COUNT + PLANT_YAW_REF_WIDTH) ? 0 : GPIO_PIN_4;
+}
+
+
+/*******************************************************
+ * Function: heliPlantSimHook
+ *
+ * simStep() hook installed by heliPlantAttach()
+ *******************************************************/
+static void
+heliPlantSimHook (uint32_t ui32Microseconds)
+{
+    int32_t i32Target;
+
+    heliPlantStep(g_psAttached, ui32Microseconds * 1e-6f,
+                  simPWMDutyGet(PWM0_BASE, PWM_OUT_7), simPWMDutyGet(PWM1_BASE, PWM_OUT_5));
+
+    simADCInputSet(PLANT_ADC_CHANNEL, heliPlantADCCounts(g_psAttached));
+
+    // One edge per pin change, as the encoder would produce them
+    i32Target = heliPlantQuadCount(g_psAttached);
+    while (g_i32EmittedCount != i32Target) {
+        int32_t i32Edge = (i32Target > g_i32EmittedCount) ? 1 : -1;
+
+        g_i32EmittedCount += i32Edge;
+        simGPIOInputSet(GPIO_PORTB_BASE, GPIO_PIN_0 | GPIO_PIN_1, quadPinsForCount(g_i32EmittedCount));
+        simQEIInputStep(QEI0_BASE, i32Edge);
+        simGPIOInputSet(GPIO_PORTC_BASE, GPIO_PIN_4, refPinForCount(g_i32EmittedCount));
+    }
+}
+
+
+/*******************************************************
+ * Function: heliPlantAttach
+ *
+ * Connects the plant to the simulated peripherals
+ *******************************************************/
+void
+heliPlantAttach (heliPlant_t *psPlant)
+{
+    g_psAttached = psPlant;
+
+    if (!psPlant) {
+        simStepHookSet(NULL);
+        return;
+    }
+
+    g_i32EmittedCount = heliPlantQuadCount(psPlant);
+    simADCInputSet(PLANT_ADC_CHANNEL, heliPlantADCCounts(psPlant));
+    simGPIOInputSet(GPIO_PORTB_BASE, GPIO_PIN_0 | GPIO_PIN_1, quadPinsForCount(g_i32EmittedCount));
+    simGPIOInputSet(GPIO_PORTC_BASE, GPIO_PIN_4, refPinForCount(g_i32EmittedCount));
+    simStepHookSet(heliPlantSimHook);
+}
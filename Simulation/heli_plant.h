@@ -0,0 +1,134 @@
+#ifndef __HELI_PLANT_H__
+#define __HELI_PLANT_H__
+
+/*******************************************************
+ * heli_plant.h
+ *
+ * Discrete-time model of the HeliRig for the host
+ * simulation.
+ *
+ * Height: the main rotor thrust follows the main duty
+ * cycle through a first order motor lag, and lifts the
+ * helicopter against gravity and damping between the
+ * landed and full-height stops.
+ *
+ * Yaw: the tail rotor torque follows the tail duty cycle
+ * through its own motor lag, and is opposed by the main
+ * rotor reaction torque (main-to-yaw coupling) and friction.
+ *
+ * The outputs are the ADC counts read by ADCIntHandler,
+ * the quadrature count whose A/B edges quadIntHandler
+ * (or QEI0) decodes, and the yaw reference signal, low
+ * over a slot PLANT_YAW_REF_WIDTH counts wide once per
+ * revolution. heliPlantAttach() connects a plant to the
+ * simulated peripherals so the firmware drives it through
+ * its PWM outputs.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define PLANT_ADC_CHANNEL           0  // ADC_CTL_CH0, the emulator height output
+#define PLANT_ADC_LANDED            2988  // Counts at 0% height (y = 242 - 0.081x gives 0)
+#define PLANT_ADC_FULL_DROP         1235  // Counts the reading falls by at 100% height
+#define PLANT_YAW_COUNTS_PER_REV    448  // 112 slots, 4 edges per slot
+#define PLANT_YAW_REF_COUNT         150  // Start of the reference slot, counts from zero yaw
+#define PLANT_YAW_REF_WIDTH         4  // Counts the reference signal is low for
+
+
+// Model parameters, set to the defaults by initHeliPlant()
+typedef struct
+{
+    float fMainTau;  // Main motor time constant (s)
+    float fTailTau;  // Tail motor time constant (s)
+    float fLiftGain;  // Height acceleration per unit main thrust (1/s^2)
+    float fGravity;  // Height deceleration from gravity (1/s^2)
+    float fHeightDamping;  // (1/s)
+    float fTailGain;  // Yaw acceleration per unit tail thrust (deg/s^2)
+    float fCouplingGain;  // Yaw deceleration per unit main thrust (deg/s^2)
+    float fYawDamping;  // (1/s)
+    uint32_t ui32ADCNoise;  // Peak uniform noise on the ADC reading (counts)
+} heliPlantParams_t;
+
+// Plant state
+typedef struct
+{
+    heliPlantParams_t sParams;
+    float fMainThrust;  // Lagged main duty (0 to 1)
+    float fTailThrust;  // Lagged tail duty (0 to 1)
+    float fHeight;  // 0 (landed) to 1 (full height)
+    float fHeightRate;  // (1/s)
+    float fYaw;  // Absolute yaw (deg), not wrapped
+    float fYawRate;  // (deg/s)
+    uint32_t ui32NoiseSeed;
+} heliPlant_t;
+
+
+/*******************************************************
+ * Function: initHeliPlant
+ *
+ * Loads the default parameters and lands the helicopter
+ * at zero yaw
+ *******************************************************/
+void
+initHeliPlant (heliPlant_t *psPlant);
+
+
+/*******************************************************
+ * Function: heliPlantStep
+ *
+ * Integrates the model over one time step
+ *
+ * fDt: time step (s)
+ * fMainDuty: main rotor duty cycle (0 to 1)
+ * fTailDuty: tail rotor duty cycle (0 to 1)
+ *******************************************************/
+void
+heliPlantStep (heliPlant_t *psPlant, float fDt, float fMainDuty, float fTailDuty);
+
+
+/*******************************************************
+ * Function: heliPlantADCCounts
+ *
+ * returns: the ADC reading for the current height,
+ *          including noise
+ *******************************************************/
+uint32_t
+heliPlantADCCounts (heliPlant_t *psPlant);
+
+
+/*******************************************************
+ * Function: heliPlantQuadCount
+ *
+ * returns: the signed quadrature count for the current
+ *          yaw (one count per A/B edge)
+ *******************************************************/
+int32_t
+heliPlantQuadCount (const heliPlant_t *psPlant);
+
+
+/*******************************************************
+ * Function: heliPlantAttach
+ *
+ * Connects the plant to the simulated peripherals. On
+ * every simStep() it reads the main (M0PWM7) and tail
+ * (M1PWM5) duty cycles, integrates the model, sets the
+ * height ADC input and drives PB0/PB1 one edge at a time
+ * until they match the new yaw. The same edges are fed to
+ * QEI0, for the YAW_USE_QEI build. The reference signal on
+ * PC4 is updated after every edge.
+ *
+ * psPlant: plant to drive, or NULL to detach
+ *******************************************************/
+void
+heliPlantAttach (heliPlant_t *psPlant);
+
+
+#endif /* __HELI_PLANT_H__ */
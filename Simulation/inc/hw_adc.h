@@ -0,0 +1,32 @@
+#ifndef __HW_ADC_H__
+#define __HW_ADC_H__
+
+/*******************************************************
+ * inc/hw_adc.h (host stand-in)
+ *
+ * ADC register offsets and fields that the simulated
+ * driverlib mirrors into the register file, so tests can
+ * check the configuration the firmware leaves behind.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#define ADC_O_ACTSS             0x00000000  // Active sample sequencer
+#define ADC_O_IM                0x00000008  // Interrupt mask
+#define ADC_O_EMUX              0x00000014  // Event multiplexer select
+#define ADC_O_SSPRI             0x00000020  // Sample sequencer priority
+#define ADC_O_SAC               0x00000030  // Sample averaging control
+#define ADC_O_SSMUX0            0x00000040  // SS0 input multiplexer select
+#define ADC_O_SSCTL0            0x00000044  // SS0 control
+#define ADC_O_SSFIFO0           0x00000048  // SS0 result FIFO
+#define ADC_O_SEQ_STRIDE        0x00000020  // SSMUXn/SSCTLn of sequence n are n * stride above SS0's
+
+#define ADC_EMUX_EM3_M          0x0000F000  // SS3 trigger select
+#define ADC_EMUX_EM3_PROCESSOR  0x00000000
+#define ADC_EMUX_EM3_TIMER      0x00005000
+
+#define ADC_SSCTL_IE            0x4  // Per step nibble fields of SSCTLn
+#define ADC_SSCTL_END           0x2
+
+#endif /* __HW_ADC_H__ */
@@ -0,0 +1,21 @@
+#ifndef __HW_GPIO_H__
+#define __HW_GPIO_H__
+
+/*******************************************************
+ * inc/hw_gpio.h (host stand-in)
+ *
+ * GPIO register offsets referenced directly through
+ * HWREG() by the Orbit OLED library.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#define GPIO_O_DATA         0x00000000
+#define GPIO_O_DIR          0x00000400
+#define GPIO_O_LOCK         0x00000520
+#define GPIO_O_CR           0x00000524
+
+#define GPIO_LOCK_KEY       0x4C4F434B
+
+#endif /* __HW_GPIO_H__ */
@@ -0,0 +1,36 @@
+#ifndef __HW_INTS_H__
+#define __HW_INTS_H__
+
+/*******************************************************
+ * inc/hw_ints.h (host stand-in)
+ *
+ * Interrupt vector numbers for the peripherals the
+ * HeliRig firmware uses on the TM4C123GH6PM.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#define INT_GPIOA           16
+#define INT_GPIOB           17
+#define INT_GPIOC           18
+#define INT_GPIOD           19
+#define INT_GPIOE           20
+#define INT_UART0           21
+#define INT_SSI0            23
+#define INT_PWM0_0          26
+#define INT_QEI0            29
+#define INT_ADC0SS0         30
+#define INT_ADC0SS1         31
+#define INT_ADC0SS2         32
+#define INT_ADC0SS3         33
+#define INT_TIMER0A         35
+#define INT_TIMER1A         37
+#define INT_TIMER2A         39
+#define INT_TIMER3A         51
+#define INT_GPIOF           46
+#define INT_UDMA            62
+#define INT_SSI3            74
+#define INT_QEI1            54
+
+#endif /* __HW_INTS_H__ */
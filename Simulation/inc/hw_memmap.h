@@ -0,0 +1,41 @@
+#ifndef __HW_MEMMAP_H__
+#define __HW_MEMMAP_H__
+
+/*******************************************************
+ * inc/hw_memmap.h (host stand-in)
+ *
+ * TM4C123GH6PM peripheral base addresses used by the
+ * HeliRig firmware. Values match the TivaWare header so
+ * the simulated register file uses the real offsets.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#define GPIO_PORTA_BASE     0x40004000
+#define GPIO_PORTB_BASE     0x40005000
+#define GPIO_PORTC_BASE     0x40006000
+#define GPIO_PORTD_BASE     0x40007000
+#define SSI0_BASE           0x40008000
+#define SSI1_BASE           0x40009000
+#define SSI2_BASE           0x4000A000
+#define SSI3_BASE           0x4000B000
+#define UART0_BASE          0x4000C000
+#define UART1_BASE          0x4000D000
+#define GPIO_PORTE_BASE     0x40024000
+#define GPIO_PORTF_BASE     0x40025000
+#define PWM0_BASE           0x40028000
+#define PWM1_BASE           0x40029000
+#define QEI0_BASE           0x4002C000
+#define QEI1_BASE           0x4002D000
+#define TIMER0_BASE         0x40030000
+#define TIMER1_BASE         0x40031000
+#define TIMER2_BASE         0x40032000
+#define TIMER3_BASE         0x40033000
+#define TIMER4_BASE         0x40034000
+#define TIMER5_BASE         0x40035000
+#define ADC0_BASE           0x40038000
+#define ADC1_BASE           0x40039000
+#define UDMA_BASE           0x400FF000
+
+#endif /* __HW_MEMMAP_H__ */
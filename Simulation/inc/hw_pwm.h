@@ -0,0 +1,33 @@
+#ifndef __HW_PWM_H__
+#define __HW_PWM_H__
+
+/*******************************************************
+ * inc/hw_pwm.h (host stand-in)
+ *
+ * PWM module register offsets and fields. The simulated
+ * generators keep their whole state in these registers of
+ * the HWREG register file, so a test can check the load
+ * and compare values the firmware worked out, and a
+ * compare written directly reaches the plant.
+ *
+ * Generator registers are at the generator's offset
+ * (PWM_GEN_n) plus PWM_O_X_.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#define PWM_O_ENABLE            0x00000008  // Output enable, a PWM_OUT_n_BIT each
+
+#define PWM_O_X_CTL             0x00000000  // Generator control
+#define PWM_O_X_LOAD            0x00000010  // Counter load, 16 bits
+#define PWM_O_X_COUNT           0x00000014  // Counter
+#define PWM_O_X_CMPA            0x00000018  // Compare A, sets the even output
+#define PWM_O_X_CMPB            0x0000001C  // Compare B, sets the odd output
+
+#define PWM_X_CTL_ENABLE        0x00000001  // Generator running
+#define PWM_X_CTL_MODE          0x00000002  // Counts up and down, rather than down
+
+#define PWM_X_LOAD_M            0x0000FFFF
+
+#endif /* __HW_PWM_H__ */
@@ -0,0 +1,45 @@
+#ifndef __HW_QEI_H__
+#define __HW_QEI_H__
+
+/*******************************************************
+ * inc/hw_qei.h (host stand-in)
+ *
+ * Quadrature encoder interface register offsets and
+ * fields. The simulated QEI keeps its whole state in these
+ * registers of the HWREG register file, so a test can set
+ * the position, speed and status directly.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#define QEI_O_CTL               0x00000000  // Control
+#define QEI_O_STAT              0x00000004  // Status
+#define QEI_O_POS               0x00000008  // Position
+#define QEI_O_MAXPOS            0x0000000C  // Maximum position
+#define QEI_O_LOAD              0x00000010  // Velocity timer load
+#define QEI_O_TIME              0x00000014  // Velocity timer
+#define QEI_O_COUNT             0x00000018  // Velocity pulse counter
+#define QEI_O_SPEED             0x0000001C  // Velocity (pulses in the last period)
+#define QEI_O_INTEN             0x00000020  // Interrupt enable
+#define QEI_O_RIS               0x00000024  // Raw interrupt status
+#define QEI_O_ISC               0x00000028  // Interrupt status and clear
+
+#define QEI_CTL_ENABLE          0x00000001  // Enable QEI
+#define QEI_CTL_SWAP            0x00000002  // Swap PhA and PhB
+#define QEI_CTL_SIGMODE         0x00000004  // Clock/direction rather than quadrature
+#define QEI_CTL_CAPMODE         0x00000008  // Count edges of PhA and PhB
+#define QEI_CTL_RESMODE         0x00000010  // Reset position on index
+#define QEI_CTL_VELEN           0x00000020  // Capture velocity
+#define QEI_CTL_VELDIV_M        0x000001C0  // Velocity predivider
+#define QEI_CTL_VELDIV_S        6
+
+#define QEI_STAT_ERROR          0x00000001  // PhA and PhB changed together
+#define QEI_STAT_DIRECTION      0x00000002  // Counting down
+
+#define QEI_INT_INDEX           0x00000001
+#define QEI_INT_TIMER           0x00000002
+#define QEI_INT_DIR             0x00000004
+#define QEI_INT_ERROR           0x00000008
+
+#endif /* __HW_QEI_H__ */
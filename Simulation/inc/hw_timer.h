@@ -0,0 +1,29 @@
+#ifndef __HW_TIMER_H__
+#define __HW_TIMER_H__
+
+/*******************************************************
+ * inc/hw_timer.h (host stand-in)
+ *
+ * General purpose timer register offsets referenced
+ * directly through HWREG() by the Orbit OLED delay code,
+ * and the registers the simulated driverlib mirrors its
+ * configuration into.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#define TIMER_O_CFG         0x00000000
+#define TIMER_O_TAMR        0x00000004
+#define TIMER_O_CTL         0x0000000C
+#define TIMER_O_IMR         0x00000018
+#define TIMER_O_TAILR       0x00000028
+#define TIMER_O_TAR         0x00000048
+#define TIMER_O_TAV         0x00000050
+
+#define TIMER_CTL_TAEN      0x00000001  // Timer A enable
+#define TIMER_CTL_TAOTE     0x00000020  // Timer A ADC trigger enable
+#define TIMER_CTL_TBOTE     0x00002000  // Timer B ADC trigger enable
+#define TIMER_IMR_TATOIM    0x00000001  // Timer A timeout interrupt mask
+
+#endif /* __HW_TIMER_H__ */
@@ -0,0 +1,26 @@
+#ifndef __HW_TYPES_H__
+#define __HW_TYPES_H__
+
+/*******************************************************
+ * inc/hw_types.h (host stand-in)
+ *
+ * Replaces the TivaWare header of the same name for the
+ * host simulation build. Register access through HWREG()
+ * is routed to the simulated register file in
+ * sim_peripherals.c rather than to a physical address.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+volatile uint32_t *
+simRegister (uint32_t ui32Address);
+
+#define HWREG(x)    (*simRegister((uint32_t)(x)))
+#define HWREGH(x)   (*(volatile uint16_t *)simRegister((uint32_t)(x)))
+#define HWREGB(x)   (*(volatile uint8_t *)simRegister((uint32_t)(x)))
+
+#endif /* __HW_TYPES_H__ */
@@ -0,0 +1,24 @@
+#ifndef __TM4C123GH6PM_H__
+#define __TM4C123GH6PM_H__
+
+/*******************************************************
+ * inc/tm4c123gh6pm.h (host stand-in)
+ *
+ * The firmware only includes the device header for the
+ * port unlock registers, so just those are provided.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include "inc/hw_types.h"
+
+#define GPIO_PORTF_LOCK_R   HWREG(0x40025520)
+#define GPIO_PORTF_CR_R     HWREG(0x40025524)
+#define GPIO_PORTD_LOCK_R   HWREG(0x40007520)
+#define GPIO_PORTD_CR_R     HWREG(0x40007524)
+
+#define GPIO_LOCK_M         0xFFFFFFFF
+#define GPIO_LOCK_KEY       0x4C4F434B
+
+#endif /* __TM4C123GH6PM_H__ */
@@ -0,0 +1,32 @@
+/*******************************************************
+ * sim_freertos.c
+ *
+ * Glue between the FreeRTOS POSIX port and the simulated
+ * peripherals. The tick interrupt stands in for the passage
+ * of time on the Tiva: every tick advances the peripherals
+ * by one tick period, so the timer, ADC and GPIO handlers
+ * run in interrupt context just as they do on the rig.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "sim_peripherals.h"
+
+
+/*******************************************************
+ * Function: vApplicationTickHook
+ *
+ * Called by the kernel from the tick interrupt
+ *******************************************************/
+void
+vApplicationTickHook (void)
+{
+    simStep(1000000 / configTICK_RATE_HZ);
+}
@@ -0,0 +1,1324 @@
+/*******************************************************
+ * sim_peripherals.c
+ *
+ * Host-side stand-ins for the TivaWare peripherals used by
+ * the HeliRig firmware. See sim_peripherals.h.
+ *
+ * Interrupts are modelled as level sensitive: a handler is
+ * run while its raw status and enable bits are both set, so
+ * a handler that forgets to clear its source is called again
+ * (and counted in ui32StuckInts) just like on the Tiva.
+ * Pending handlers are run in vector order, GPIO before ADC
+ * before timers before QEI, and never nest.
+ *
+ * The ADC and timer configuration calls also write the
+ * matching registers (inc/hw_adc.h, inc/hw_timer.h) into the
+ * HWREG register file, so a test can check what the
+ * firmware configured at register level. The QEI modules
+ * go further and keep all their state in their registers
+ * (inc/hw_qei.h), so a test can also set the position,
+ * speed and status the firmware reads, as do the PWM
+ * generators (inc/hw_pwm.h), so the plant sees a compare
+ * register written directly as well as through driverlib.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_adc.h"
+#include "inc/hw_timer.h"
+#include "inc/hw_qei.h"
+#include "inc/hw_pwm.h"
+#include "driverlib/adc.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pwm.h"
+#include "driverlib/qei.h"
+#include "driverlib/ssi.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/systick.h"
+#include "driverlib/timer.h"
+#include "driverlib/uart.h"
+#include "utils/uartstdio.h"
+
+#include "sim_peripherals.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define SIM_NUM_GPIO        6
+#define SIM_NUM_TIMERS      6
+#define SIM_NUM_ADC         2
+#define SIM_NUM_ADC_SEQ     4
+#define SIM_NUM_ADC_CH      12
+#define SIM_NUM_PWM         2
+#define SIM_NUM_PWM_GEN     4
+#define SIM_NUM_QEI         2
+#define SIM_NUM_REGS        512  // Simulated register file slots (HWREG)
+
+#define SIM_ADC_SEQ_STEPS   8
+
+
+/*******************************************************
+ * Peripheral state
+ *******************************************************/
+typedef struct
+{
+    uint8_t ui8Data;  // Pin levels
+    uint8_t ui8IntMask;  // Pins with interrupts enabled
+    uint8_t ui8RawInt;  // Edge detected, not yet cleared
+    uint8_t ui8BothEdges;  // Pins interrupting on both edges
+    uint8_t ui8Rising;  // Pins interrupting on rising (otherwise falling) edges
+    void (*pfnHandler)(void);
+} simGPIO_t;
+
+typedef struct
+{
+    uint32_t ui32Config;
+    uint32_t ui32Load;
+    uint32_t ui32Count;  // Ticks until the next timeout
+    bool bEnabled;
+    bool bADCTrigger;  // Each timeout starts the ADC_TRIGGER_TIMER sequences
+    uint32_t ui32IntMask;
+    uint32_t ui32RawInt;
+    void (*pfnHandler)(void);
+} simTimer_t;
+
+typedef struct
+{
+    uint32_t ui32Trigger;
+    uint32_t pui32Step[SIM_ADC_SEQ_STEPS];
+    bool bEnabled;
+    uint32_t pui32Fifo[SIM_ADC_FIFO_DEPTH];
+    uint32_t ui32FifoCount;
+    bool bIntEnabled;
+    bool bRawInt;
+    void (*pfnHandler)(void);
+} simADCSeq_t;
+
+// Everything else a QEI holds is in its registers
+typedef struct
+{
+    bool bOddEdge;  // PhA only capture counts every second edge
+    void (*pfnHandler)(void);
+} simQEI_t;
+
+typedef struct
+{
+    uint32_t ui32Address;
+    uint32_t ui32Value;
+} simReg_t;
+
+
+static simGPIO_t g_psGPIO[SIM_NUM_GPIO];
+static simTimer_t g_psTimer[SIM_NUM_TIMERS];
+static simADCSeq_t g_psADCSeq[SIM_NUM_ADC][SIM_NUM_ADC_SEQ];
+static uint32_t g_pui32ADCInput[SIM_NUM_ADC_CH];
+static simQEI_t g_psQEI[SIM_NUM_QEI];
+static simReg_t g_psRegs[SIM_NUM_REGS];
+
+static uint32_t g_ui32ClockHz = SIM_RESET_CLOCK_HZ;
+static uint32_t g_ui32PWMClockConfig;
+static uint64_t g_ui64TimeUs;
+static uint64_t g_ui64TickRemainder;  // Sub-tick carry between steps
+static bool g_bIntMasked = true;  // The Tiva leaves reset with interrupts enabled, but nothing runs before main()
+static bool g_bInHandler;
+static void (*g_pfnStepHook)(uint32_t ui32Microseconds);
+static simStats_t g_sStats;
+
+
+/*******************************************************
+ * Base address to array index helpers
+ *******************************************************/
+static simGPIO_t *
+gpioGet (uint32_t ui32Port)
+{
+    switch (ui32Port)
+    {
+    case GPIO_PORTA_BASE: return &g_psGPIO[0];
+    case GPIO_PORTB_BASE: return &g_psGPIO[1];
+    case GPIO_PORTC_BASE: return &g_psGPIO[2];
+    case GPIO_PORTD_BASE: return &g_psGPIO[3];
+    case GPIO_PORTE_BASE: return &g_psGPIO[4];
+    case GPIO_PORTF_BASE: return &g_psGPIO[5];
+    default: return NULL;
+    }
+}
+
+static simTimer_t *
+timerGet (uint32_t ui32Base)
+{
+    uint32_t ui32Index = (ui32Base - TIMER0_BASE) / 0x1000;
+
+    return (ui32Index < SIM_NUM_TIMERS) ? &g_psTimer[ui32Index] : NULL;
+}
+
+static simADCSeq_t *
+adcSeqGet (uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    uint32_t ui32Index = (ui32Base - ADC0_BASE) / 0x1000;
+
+    if (ui32Index >= SIM_NUM_ADC || ui32SequenceNum >= SIM_NUM_ADC_SEQ) {
+        return NULL;
+    }
+    return &g_psADCSeq[ui32Index][ui32SequenceNum];
+}
+
+static simQEI_t *
+qeiGet (uint32_t ui32Base)
+{
+    uint32_t ui32Index = (ui32Base - QEI0_BASE) / 0x1000;
+
+    return (ui32Index < SIM_NUM_QEI) ? &g_psQEI[ui32Index] : NULL;
+}
+
+static uint32_t
+qeiBase (uint32_t ui32Index)
+{
+    return QEI0_BASE + ui32Index * 0x1000;
+}
+
+// PWM_GEN_n is 0x40 * (n + 1), PWM_OUT_n is PWM_GEN_(n / 2) + (n & 1)
+#define PWM_GEN_INDEX(gen)      (((gen) >> 6) - 1)
+#define PWM_OUT_GEN(out)        ((out) & ~1U)
+#define PWM_OUT_CMP(out)        (((out) & 1U) ? PWM_O_X_CMPB : PWM_O_X_CMPA)
+
+// Address of a generator's registers, or 0 if there is no such generator
+static uint32_t
+pwmGen (uint32_t ui32Base, uint32_t ui32Gen)
+{
+    uint32_t ui32Index = (ui32Base - PWM0_BASE) / 0x1000;
+
+    if (ui32Index >= SIM_NUM_PWM || (ui32Base & 0xFFF) || (ui32Gen & 0x3F)
+        || PWM_GEN_INDEX(ui32Gen) >= SIM_NUM_PWM_GEN) {
+        return 0;
+    }
+    return ui32Base + ui32Gen;
+}
+
+
+/*******************************************************
+ * Function: simDispatch
+ *
+ * Runs pending interrupt handlers until none are pending.
+ * Does nothing when called from inside a handler, the
+ * outer call picks the new interrupt up (tail chaining).
+ *******************************************************/
+static void
+simDispatch (void)
+{
+    bool bRan;
+    uint32_t ui32Rounds = 0;
+    uint32_t i, j;
+
+    if (g_bIntMasked || g_bInHandler) {
+        return;
+    }
+
+    g_bInHandler = true;
+    do
+    {
+        bRan = false;
+
+        for (i = 0; i < SIM_NUM_GPIO; i++) {
+            if ((g_psGPIO[i].ui8RawInt & g_psGPIO[i].ui8IntMask) && g_psGPIO[i].pfnHandler) {
+                g_psGPIO[i].pfnHandler();
+                g_sStats.ui32GPIOInts++;
+                bRan = true;
+            }
+        }
+
+        for (i = 0; i < SIM_NUM_ADC; i++) {
+            for (j = 0; j < SIM_NUM_ADC_SEQ; j++) {
+                simADCSeq_t *psSeq = &g_psADCSeq[i][j];
+
+                if (psSeq->bRawInt && psSeq->bIntEnabled && psSeq->pfnHandler) {
+                    psSeq->pfnHandler();
+                    g_sStats.ui32ADCInts++;
+                    bRan = true;
+                }
+            }
+        }
+
+        for (i = 0; i < SIM_NUM_TIMERS; i++) {
+            if ((g_psTimer[i].ui32RawInt & g_psTimer[i].ui32IntMask) && g_psTimer[i].pfnHandler) {
+                g_psTimer[i].pfnHandler();
+                g_sStats.ui32TimerInts++;
+                bRan = true;
+            }
+        }
+
+        for (i = 0; i < SIM_NUM_QEI; i++) {
+            uint32_t ui32Base = qeiBase(i);
+
+            if ((HWREG(ui32Base + QEI_O_RIS) & HWREG(ui32Base + QEI_O_INTEN)) && g_psQEI[i].pfnHandler) {
+                g_psQEI[i].pfnHandler();
+                g_sStats.ui32QEIInts++;
+                bRan = true;
+            }
+        }
+
+        // A source still asserted after this many rounds is never being cleared
+        if (bRan && ++ui32Rounds >= SIM_MAX_TAIL_CHAIN) {
+            g_sStats.ui32StuckInts++;
+            break;
+        }
+    } while (bRan);
+    g_bInHandler = false;
+}
+
+
+/*******************************************************
+ * Function: adcSequenceTrigger
+ *
+ * Converts every step of a sequence into its FIFO and
+ * raises the sequence interrupt if a step has ADC_CTL_IE
+ *******************************************************/
+static void
+adcSequenceTrigger (simADCSeq_t *psSeq)
+{
+    uint32_t ui32Step;
+
+    if (!psSeq->bEnabled) {
+        return;
+    }
+
+    for (ui32Step = 0; ui32Step < SIM_ADC_SEQ_STEPS; ui32Step++) {
+        uint32_t ui32Config = psSeq->pui32Step[ui32Step];
+
+        if (psSeq->ui32FifoCount < SIM_ADC_FIFO_DEPTH) {
+            psSeq->pui32Fifo[psSeq->ui32FifoCount++] = g_pui32ADCInput[(ui32Config & 0x0F) % SIM_NUM_ADC_CH];
+        } else {
+            g_sStats.ui32ADCOverflows++;
+        }
+
+        if (ui32Config & ADC_CTL_IE) {
+            psSeq->bRawInt = true;
+        }
+        if (ui32Config & ADC_CTL_END) {
+            break;
+        }
+    }
+}
+
+
+/*******************************************************
+ * Function: adcTimerTrigger
+ *
+ * Starts every enabled sequence whose trigger source is
+ * ADC_TRIGGER_TIMER
+ *******************************************************/
+static void
+adcTimerTrigger (void)
+{
+    uint32_t i, j;
+
+    for (i = 0; i < SIM_NUM_ADC; i++) {
+        for (j = 0; j < SIM_NUM_ADC_SEQ; j++) {
+            if (g_psADCSeq[i][j].ui32Trigger == ADC_TRIGGER_TIMER) {
+                adcSequenceTrigger(&g_psADCSeq[i][j]);
+            }
+        }
+    }
+}
+
+
+/*******************************************************
+ * Function: timerAdvance
+ *
+ * Counts a periodic down-counting timer forward and
+ * raises its timeout interrupt (and ADC trigger, if
+ * enabled) once per expiry. As on the part, it counts
+ * from the load value down to 0 and reloads on the next
+ * clock, so a period is the load value + 1.
+ *******************************************************/
+static void
+timerAdvance (simTimer_t *psTimer, uint64_t ui64Ticks)
+{
+    if (!psTimer->bEnabled || psTimer->ui32Load == 0 || psTimer->ui32Config != TIMER_CFG_PERIODIC) {
+        return;
+    }
+
+    while (ui64Ticks > psTimer->ui32Count) {
+        ui64Ticks -= (uint64_t) psTimer->ui32Count + 1;
+        psTimer->ui32Count = psTimer->ui32Load;
+        psTimer->ui32RawInt |= TIMER_TIMA_TIMEOUT;
+        if (psTimer->bADCTrigger) {
+            adcTimerTrigger();
+        }
+        simDispatch();
+    }
+    psTimer->ui32Count -= (uint32_t) ui64Ticks;
+}
+
+
+/*******************************************************
+ * Function: qeiAdvance
+ *
+ * Counts a QEI velocity timer forward and latches the
+ * pulses of each period into QEI_O_SPEED
+ *******************************************************/
+static void
+qeiAdvance (uint32_t ui32Base, uint64_t ui64Ticks)
+{
+    uint32_t ui32Ctl = HWREG(ui32Base + QEI_O_CTL);
+    uint32_t ui32Time;
+
+    if (!(ui32Ctl & QEI_CTL_ENABLE) || !(ui32Ctl & QEI_CTL_VELEN)) {
+        return;
+    }
+
+    // The timer counts down from QEI_O_LOAD and reloads after reaching 0
+    ui32Time = HWREG(ui32Base + QEI_O_TIME);
+    while (ui64Ticks > ui32Time) {
+        ui64Ticks -= ui32Time + 1;
+        ui32Time = HWREG(ui32Base + QEI_O_LOAD);
+        HWREG(ui32Base + QEI_O_SPEED) = HWREG(ui32Base + QEI_O_COUNT);
+        HWREG(ui32Base + QEI_O_COUNT) = 0;
+        HWREG(ui32Base + QEI_O_RIS) |= QEI_INT_TIMER;
+        simDispatch();
+    }
+    HWREG(ui32Base + QEI_O_TIME) = ui32Time - (uint32_t) ui64Ticks;
+}
+
+
+/*******************************************************
+ * Simulation control (see sim_peripherals.h)
+ *******************************************************/
+void
+simReset (void)
+{
+    memset(g_psGPIO, 0, sizeof(g_psGPIO));
+    memset(g_psTimer, 0, sizeof(g_psTimer));
+    memset(g_psADCSeq, 0, sizeof(g_psADCSeq));
+    memset(g_pui32ADCInput, 0, sizeof(g_pui32ADCInput));
+    memset(g_psQEI, 0, sizeof(g_psQEI));
+    memset(g_psRegs, 0, sizeof(g_psRegs));
+    memset(&g_sStats, 0, sizeof(g_sStats));
+
+    g_ui32ClockHz = SIM_RESET_CLOCK_HZ;
+    g_ui32PWMClockConfig = SYSCTL_PWMDIV_1;
+    g_ui64TimeUs = 0;
+    g_ui64TickRemainder = 0;
+    g_bIntMasked = true;
+    g_bInHandler = false;
+    g_pfnStepHook = NULL;
+}
+
+void
+simStep (uint32_t ui32Microseconds)
+{
+    uint64_t ui64Ticks;
+    uint32_t i;
+
+    g_ui64TimeUs += ui32Microseconds;
+
+    if (g_pfnStepHook) {
+        g_pfnStepHook(ui32Microseconds);
+    }
+
+    // Convert to clock ticks, carrying the remainder so long runs don't drift
+    ui64Ticks = (uint64_t) ui32Microseconds * g_ui32ClockHz + g_ui64TickRemainder;
+    g_ui64TickRemainder = ui64Ticks % 1000000;
+    ui64Ticks /= 1000000;
+
+    for (i = 0; i < SIM_NUM_TIMERS; i++) {
+        timerAdvance(&g_psTimer[i], ui64Ticks);
+    }
+    for (i = 0; i < SIM_NUM_QEI; i++) {
+        qeiAdvance(qeiBase(i), ui64Ticks);
+    }
+
+    simDispatch();
+}
+
+uint64_t
+simTimeGet (void)
+{
+    return g_ui64TimeUs;
+}
+
+void
+simStepHookSet (void (*pfnHook)(uint32_t ui32Microseconds))
+{
+    g_pfnStepHook = pfnHook;
+}
+
+void
+simADCInputSet (uint32_t ui32Channel, uint32_t ui32Counts)
+{
+    if (ui32Channel < SIM_NUM_ADC_CH) {
+        g_pui32ADCInput[ui32Channel] = (ui32Counts > SIM_ADC_MAX_COUNTS) ? SIM_ADC_MAX_COUNTS : ui32Counts;
+    }
+}
+
+void
+simGPIOInputSet (uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val)
+{
+    simGPIO_t *psPort = gpioGet(ui32Port);
+    uint8_t ui8Old, ui8Changed, ui8Rose;
+
+    if (!psPort) {
+        return;
+    }
+
+    ui8Old = psPort->ui8Data;
+    psPort->ui8Data = (ui8Old & ~ui8Pins) | (ui8Val & ui8Pins);
+    ui8Changed = ui8Old ^ psPort->ui8Data;
+    ui8Rose = ui8Changed & psPort->ui8Data;
+
+    psPort->ui8RawInt |= ui8Changed & psPort->ui8BothEdges;
+    psPort->ui8RawInt |= ui8Rose & psPort->ui8Rising & ~psPort->ui8BothEdges;
+    psPort->ui8RawInt |= (ui8Changed & ~ui8Rose) & ~psPort->ui8Rising & ~psPort->ui8BothEdges;
+
+    simDispatch();
+}
+
+void
+simQEIInputStep (uint32_t ui32Base, int32_t i32Edges)
+{
+    simQEI_t *psQEI = qeiGet(ui32Base);
+    uint32_t ui32Ctl, ui32Pos, ui32Max, ui32Stat;
+    bool bUp;
+
+    if (!psQEI || i32Edges == 0) {
+        return;
+    }
+    ui32Ctl = HWREG(ui32Base + QEI_O_CTL);
+    if (!(ui32Ctl & QEI_CTL_ENABLE)) {
+        return;
+    }
+
+    // Without swap the QEI counts up when PhA leads
+    bUp = (i32Edges > 0) == ((ui32Ctl & QEI_CTL_SWAP) != 0);
+    ui32Pos = HWREG(ui32Base + QEI_O_POS);
+    ui32Max = HWREG(ui32Base + QEI_O_MAXPOS);
+
+    for (; i32Edges != 0; i32Edges += (i32Edges > 0) ? -1 : 1) {
+        if (!(ui32Ctl & QEI_CTL_CAPMODE)) {
+            psQEI->bOddEdge = !psQEI->bOddEdge;
+            if (psQEI->bOddEdge) {
+                continue;
+            }
+        }
+        if (bUp) {
+            ui32Pos = (ui32Pos >= ui32Max) ? 0 : ui32Pos + 1;
+        } else {
+            ui32Pos = (ui32Pos == 0) ? ui32Max : ui32Pos - 1;
+        }
+        HWREG(ui32Base + QEI_O_COUNT) += 1;
+    }
+    HWREG(ui32Base + QEI_O_POS) = ui32Pos;
+
+    ui32Stat = HWREG(ui32Base + QEI_O_STAT);
+    if (((ui32Stat & QEI_STAT_DIRECTION) == 0) != bUp) {
+        HWREG(ui32Base + QEI_O_STAT) = ui32Stat ^ QEI_STAT_DIRECTION;
+        HWREG(ui32Base + QEI_O_RIS) |= QEI_INT_DIR;
+    }
+
+    simDispatch();
+}
+
+float
+simPWMDutyGet (uint32_t ui32Base, uint32_t ui32PWMOut)
+{
+    uint32_t ui32Gen = pwmGen(ui32Base, PWM_OUT_GEN(ui32PWMOut));
+    uint32_t ui32Ctl, ui32Load, ui32Compare;
+
+    if (!ui32Gen || !(HWREG(ui32Base + PWM_O_ENABLE) & (1U << (PWM_GEN_INDEX(PWM_OUT_GEN(ui32PWMOut)) * 2
+                                                               + (ui32PWMOut & 1U))))) {
+        return 0.0f;
+    }
+    ui32Ctl = HWREG(ui32Gen + PWM_O_X_CTL);
+    ui32Load = HWREG(ui32Gen + PWM_O_X_LOAD);
+    ui32Compare = HWREG(ui32Gen + PWM_OUT_CMP(ui32PWMOut));
+    if (!(ui32Ctl & PWM_X_CTL_ENABLE) || ui32Load == 0 || ui32Compare > ui32Load) {
+        return 0.0f;
+    }
+
+    // High from the compare on the way down to it on the way up, or from the load down to the compare
+    if (ui32Ctl & PWM_X_CTL_MODE) {
+        return (float) (ui32Load - ui32Compare) / (float) ui32Load;
+    }
+    return (float) (ui32Load - ui32Compare) / (float) (ui32Load + 1);
+}
+
+const simStats_t *
+simStatsGet (void)
+{
+    return &g_sStats;
+}
+
+volatile uint32_t *
+simRegister (uint32_t ui32Address)
+{
+    uint32_t ui32Slot = (ui32Address >> 2) % SIM_NUM_REGS;
+    uint32_t i;
+
+    // Open addressing, address 0 marks a free slot
+    for (i = 0; i < SIM_NUM_REGS; i++) {
+        simReg_t *psReg = &g_psRegs[(ui32Slot + i) % SIM_NUM_REGS];
+
+        if (psReg->ui32Address == ui32Address || psReg->ui32Address == 0) {
+            psReg->ui32Address = ui32Address;
+            return &psReg->ui32Value;
+        }
+    }
+
+    fprintf(stderr, "sim: register file full at 0x%08x\n", (unsigned) ui32Address);
+    return &g_psRegs[ui32Slot].ui32Value;
+}
+
+
+/*******************************************************
+ * driverlib/sysctl.h
+ *******************************************************/
+void
+SysCtlClockSet (uint32_t ui32Config)
+{
+    if ((ui32Config & SYSCTL_USE_OSC) == SYSCTL_USE_OSC) {
+        g_ui32ClockHz = SIM_RESET_CLOCK_HZ;
+    } else if ((ui32Config & SYSCTL_SYSDIV_2_5) == SYSCTL_SYSDIV_2_5) {
+        g_ui32ClockHz = 80000000;
+    } else if ((ui32Config & SYSCTL_SYSDIV_10) == SYSCTL_SYSDIV_10) {
+        g_ui32ClockHz = 20000000;
+    } else {
+        g_ui32ClockHz = SIM_RESET_CLOCK_HZ;
+    }
+}
+
+uint32_t
+SysCtlClockGet (void)
+{
+    return g_ui32ClockHz;
+}
+
+void
+SysCtlPWMClockSet (uint32_t ui32Config)
+{
+    g_ui32PWMClockConfig = ui32Config;
+}
+
+uint32_t
+SysCtlPWMClockGet (void)
+{
+    return g_ui32PWMClockConfig;
+}
+
+void SysCtlPeripheralEnable (uint32_t ui32Peripheral) { (void) ui32Peripheral; }
+void SysCtlPeripheralReset (uint32_t ui32Peripheral) { (void) ui32Peripheral; }
+bool SysCtlPeripheralReady (uint32_t ui32Peripheral) { (void) ui32Peripheral; return true; }
+void SysCtlDelay (uint32_t ui32Count) { (void) ui32Count; }
+
+
+/*******************************************************
+ * driverlib/interrupt.h
+ *******************************************************/
+bool
+IntMasterEnable (void)
+{
+    bool bWasMasked = g_bIntMasked;
+
+    g_bIntMasked = false;
+    simDispatch();  // Run anything that became pending while masked
+    return bWasMasked;
+}
+
+bool
+IntMasterDisable (void)
+{
+    bool bWasMasked = g_bIntMasked;
+
+    g_bIntMasked = true;
+    return bWasMasked;
+}
+
+void IntEnable (uint32_t ui32Interrupt) { (void) ui32Interrupt; }
+void IntDisable (uint32_t ui32Interrupt) { (void) ui32Interrupt; }
+void IntPrioritySet (uint32_t ui32Interrupt, uint8_t ui8Priority) { (void) ui32Interrupt; (void) ui8Priority; }
+
+
+/*******************************************************
+ * driverlib/gpio.h
+ *******************************************************/
+void GPIOPinTypeGPIOInput (uint32_t ui32Port, uint8_t ui8Pins) { (void) ui32Port; (void) ui8Pins; }
+void GPIOPinTypeGPIOOutput (uint32_t ui32Port, uint8_t ui8Pins) { (void) ui32Port; (void) ui8Pins; }
+void GPIOPinTypeSSI (uint32_t ui32Port, uint8_t ui8Pins) { (void) ui32Port; (void) ui8Pins; }
+void GPIOPinTypeUART (uint32_t ui32Port, uint8_t ui8Pins) { (void) ui32Port; (void) ui8Pins; }
+void GPIOPinTypePWM (uint32_t ui32Port, uint8_t ui8Pins) { (void) ui32Port; (void) ui8Pins; }
+void GPIOPinTypeQEI (uint32_t ui32Port, uint8_t ui8Pins) { (void) ui32Port; (void) ui8Pins; }
+void GPIOPinTypeADC (uint32_t ui32Port, uint8_t ui8Pins) { (void) ui32Port; (void) ui8Pins; }
+void GPIOPinConfigure (uint32_t ui32PinConfig) { (void) ui32PinConfig; }
+void GPIOPadConfigSet (uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32Strength, uint32_t ui32PadType) { (void) ui32Port; (void) ui8Pins; (void) ui32Strength; (void) ui32PadType; }
+void GPIODirModeSet (uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32PinIO) { (void) ui32Port; (void) ui8Pins; (void) ui32PinIO; }
+
+int32_t
+GPIOPinRead (uint32_t ui32Port, uint8_t ui8Pins)
+{
+    simGPIO_t *psPort = gpioGet(ui32Port);
+
+    return psPort ? (psPort->ui8Data & ui8Pins) : 0;
+}
+
+void
+GPIOPinWrite (uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val)
+{
+    simGPIO_t *psPort = gpioGet(ui32Port);
+
+    if (psPort) {
+        psPort->ui8Data = (psPort->ui8Data & ~ui8Pins) | (ui8Val & ui8Pins);
+    }
+}
+
+void
+GPIOIntRegister (uint32_t ui32Port, void (*pfnIntHandler)(void))
+{
+    simGPIO_t *psPort = gpioGet(ui32Port);
+
+    if (psPort) {
+        psPort->pfnHandler = pfnIntHandler;
+    }
+}
+
+void
+GPIOIntTypeSet (uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32IntType)
+{
+    simGPIO_t *psPort = gpioGet(ui32Port);
+
+    if (!psPort) {
+        return;
+    }
+
+    psPort->ui8BothEdges = (ui32IntType == GPIO_BOTH_EDGES) ? (psPort->ui8BothEdges | ui8Pins) : (psPort->ui8BothEdges & ~ui8Pins);
+    psPort->ui8Rising = (ui32IntType == GPIO_RISING_EDGE) ? (psPort->ui8Rising | ui8Pins) : (psPort->ui8Rising & ~ui8Pins);
+}
+
+void
+GPIOIntEnable (uint32_t ui32Port, uint32_t ui32IntFlags)
+{
+    simGPIO_t *psPort = gpioGet(ui32Port);
+
+    if (psPort) {
+        psPort->ui8IntMask |= (uint8_t) ui32IntFlags;
+    }
+}
+
+void
+GPIOIntDisable (uint32_t ui32Port, uint32_t ui32IntFlags)
+{
+    simGPIO_t *psPort = gpioGet(ui32Port);
+
+    if (psPort) {
+        psPort->ui8IntMask &= (uint8_t) ~ui32IntFlags;
+    }
+}
+
+void
+GPIOIntClear (uint32_t ui32Port, uint32_t ui32IntFlags)
+{
+    simGPIO_t *psPort = gpioGet(ui32Port);
+
+    if (psPort) {
+        psPort->ui8RawInt &= (uint8_t) ~ui32IntFlags;
+    }
+}
+
+uint32_t
+GPIOIntStatus (uint32_t ui32Port, bool bMasked)
+{
+    simGPIO_t *psPort = gpioGet(ui32Port);
+
+    if (!psPort) {
+        return 0;
+    }
+    return bMasked ? (psPort->ui8RawInt & psPort->ui8IntMask) : psPort->ui8RawInt;
+}
+
+
+/*******************************************************
+ * driverlib/adc.h
+ *******************************************************/
+void
+ADCSequenceConfigure (uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t ui32Trigger, uint32_t ui32Priority)
+{
+    simADCSeq_t *psSeq = adcSeqGet(ui32Base, ui32SequenceNum);
+
+    if (psSeq) {
+        psSeq->ui32Trigger = ui32Trigger;
+        HWREG(ui32Base + ADC_O_EMUX) = (HWREG(ui32Base + ADC_O_EMUX) & ~(0xF << (ui32SequenceNum * 4)))
+                                       | ((ui32Trigger & 0xF) << (ui32SequenceNum * 4));
+        HWREG(ui32Base + ADC_O_SSPRI) = (HWREG(ui32Base + ADC_O_SSPRI) & ~(0x3 << (ui32SequenceNum * 4)))
+                                        | ((ui32Priority & 0x3) << (ui32SequenceNum * 4));
+    }
+}
+
+void
+ADCSequenceStepConfigure (uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t ui32Step, uint32_t ui32Config)
+{
+    simADCSeq_t *psSeq = adcSeqGet(ui32Base, ui32SequenceNum);
+
+    if (psSeq && ui32Step < SIM_ADC_SEQ_STEPS) {
+        uint32_t ui32Offset = ui32SequenceNum * ADC_O_SEQ_STRIDE;
+        uint32_t ui32Shift = ui32Step * 4;
+
+        psSeq->pui32Step[ui32Step] = ui32Config;
+        HWREG(ui32Base + ADC_O_SSMUX0 + ui32Offset) = (HWREG(ui32Base + ADC_O_SSMUX0 + ui32Offset) & ~(0xF << ui32Shift))
+                                                     | ((ui32Config & 0xF) << ui32Shift);
+        HWREG(ui32Base + ADC_O_SSCTL0 + ui32Offset) = (HWREG(ui32Base + ADC_O_SSCTL0 + ui32Offset) & ~(0xF << ui32Shift))
+                                                     | (((ui32Config >> 4) & 0xF) << ui32Shift);
+    }
+}
+
+void
+ADCSequenceEnable (uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    simADCSeq_t *psSeq = adcSeqGet(ui32Base, ui32SequenceNum);
+
+    if (psSeq) {
+        psSeq->bEnabled = true;
+        HWREG(ui32Base + ADC_O_ACTSS) |= 1 << ui32SequenceNum;
+    }
+}
+
+void
+ADCSequenceDisable (uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    simADCSeq_t *psSeq = adcSeqGet(ui32Base, ui32SequenceNum);
+
+    if (psSeq) {
+        psSeq->bEnabled = false;
+        HWREG(ui32Base + ADC_O_ACTSS) &= ~(1 << ui32SequenceNum);
+    }
+}
+
+int32_t
+ADCSequenceDataGet (uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t *pui32Buffer)
+{
+    simADCSeq_t *psSeq = adcSeqGet(ui32Base, ui32SequenceNum);
+    int32_t i32Count;
+
+    if (!psSeq) {
+        return 0;
+    }
+
+    i32Count = (int32_t) psSeq->ui32FifoCount;
+    memcpy(pui32Buffer, psSeq->pui32Fifo, psSeq->ui32FifoCount * sizeof(uint32_t));
+    psSeq->ui32FifoCount = 0;
+    return i32Count;
+}
+
+void
+ADCProcessorTrigger (uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    simADCSeq_t *psSeq = adcSeqGet(ui32Base, ui32SequenceNum);
+
+    if (psSeq && psSeq->ui32Trigger == ADC_TRIGGER_PROCESSOR) {
+        adcSequenceTrigger(psSeq);
+        simDispatch();
+    }
+}
+
+void
+ADCIntRegister (uint32_t ui32Base, uint32_t ui32SequenceNum, void (*pfnHandler)(void))
+{
+    simADCSeq_t *psSeq = adcSeqGet(ui32Base, ui32SequenceNum);
+
+    if (psSeq) {
+        psSeq->pfnHandler = pfnHandler;
+    }
+}
+
+void
+ADCIntEnable (uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    simADCSeq_t *psSeq = adcSeqGet(ui32Base, ui32SequenceNum);
+
+    if (psSeq) {
+        psSeq->bIntEnabled = true;
+        HWREG(ui32Base + ADC_O_IM) |= 1 << ui32SequenceNum;
+    }
+}
+
+void
+ADCIntDisable (uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    simADCSeq_t *psSeq = adcSeqGet(ui32Base, ui32SequenceNum);
+
+    if (psSeq) {
+        psSeq->bIntEnabled = false;
+        HWREG(ui32Base + ADC_O_IM) &= ~(1 << ui32SequenceNum);
+    }
+}
+
+void
+ADCIntClear (uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    simADCSeq_t *psSeq = adcSeqGet(ui32Base, ui32SequenceNum);
+
+    if (psSeq) {
+        psSeq->bRawInt = false;
+    }
+}
+
+uint32_t
+ADCIntStatus (uint32_t ui32Base, uint32_t ui32SequenceNum, bool bMasked)
+{
+    simADCSeq_t *psSeq = adcSeqGet(ui32Base, ui32SequenceNum);
+
+    if (!psSeq) {
+        return 0;
+    }
+    return (psSeq->bRawInt && (!bMasked || psSeq->bIntEnabled)) ? 1 : 0;
+}
+
+void
+ADCHardwareOversampleConfigure (uint32_t ui32Base, uint32_t ui32Factor)
+{
+    uint32_t ui32Log2 = 0;
+
+    // Only recorded: the simulated input is constant over a step, so averaging changes nothing
+    while (ui32Factor > 1) {
+        ui32Factor >>= 1;
+        ui32Log2++;
+    }
+    HWREG(ui32Base + ADC_O_SAC) = ui32Log2;
+}
+
+
+/*******************************************************
+ * driverlib/timer.h
+ *******************************************************/
+void
+TimerConfigure (uint32_t ui32Base, uint32_t ui32Config)
+{
+    simTimer_t *psTimer = timerGet(ui32Base);
+
+    if (psTimer) {
+        psTimer->ui32Config = ui32Config;
+        psTimer->bEnabled = false;
+        HWREG(ui32Base + TIMER_O_CTL) &= ~TIMER_CTL_TAEN;
+        HWREG(ui32Base + TIMER_O_CFG) = ui32Config >> 24;
+        HWREG(ui32Base + TIMER_O_TAMR) = ui32Config & 0xFF;
+    }
+}
+
+void
+TimerLoadSet (uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value)
+{
+    simTimer_t *psTimer = timerGet(ui32Base);
+
+    (void) ui32Timer;
+    if (psTimer) {
+        psTimer->ui32Load = ui32Value;
+        psTimer->ui32Count = ui32Value;
+        HWREG(ui32Base + TIMER_O_TAILR) = ui32Value;
+    }
+}
+
+uint32_t
+TimerLoadGet (uint32_t ui32Base, uint32_t ui32Timer)
+{
+    simTimer_t *psTimer = timerGet(ui32Base);
+
+    (void) ui32Timer;
+    return psTimer ? psTimer->ui32Load : 0;
+}
+
+uint32_t
+TimerValueGet (uint32_t ui32Base, uint32_t ui32Timer)
+{
+    simTimer_t *psTimer = timerGet(ui32Base);
+
+    (void) ui32Timer;
+    if (!psTimer) {
+        return 0;
+    }
+
+    // Up counters are only busy-polled (Orbit OLED DelayMs), so each
+    // poll is charged one microsecond against the value register
+    if (psTimer->ui32Config == TIMER_CFG_PERIODIC_UP || psTimer->ui32Config == TIMER_CFG_ONE_SHOT_UP) {
+        HWREG(ui32Base + TIMER_O_TAV) += g_ui32ClockHz / 1000000;
+        return HWREG(ui32Base + TIMER_O_TAV);
+    }
+    return psTimer->ui32Count;
+}
+
+void
+TimerEnable (uint32_t ui32Base, uint32_t ui32Timer)
+{
+    simTimer_t *psTimer = timerGet(ui32Base);
+
+    (void) ui32Timer;
+    if (psTimer) {
+        psTimer->bEnabled = true;
+        HWREG(ui32Base + TIMER_O_CTL) |= TIMER_CTL_TAEN;
+    }
+}
+
+void
+TimerDisable (uint32_t ui32Base, uint32_t ui32Timer)
+{
+    simTimer_t *psTimer = timerGet(ui32Base);
+
+    (void) ui32Timer;
+    if (psTimer) {
+        psTimer->bEnabled = false;
+        HWREG(ui32Base + TIMER_O_CTL) &= ~TIMER_CTL_TAEN;
+    }
+}
+
+void
+TimerControlTrigger (uint32_t ui32Base, uint32_t ui32Timer, bool bEnable)
+{
+    simTimer_t *psTimer = timerGet(ui32Base);
+    uint32_t ui32Bits = ui32Timer & (TIMER_CTL_TAOTE | TIMER_CTL_TBOTE);
+
+    // Only timer A counts in the simulation, timer B's bit is just recorded
+    if (psTimer) {
+        if (ui32Timer & TIMER_A) {
+            psTimer->bADCTrigger = bEnable;
+        }
+        if (bEnable) {
+            HWREG(ui32Base + TIMER_O_CTL) |= ui32Bits;
+        } else {
+            HWREG(ui32Base + TIMER_O_CTL) &= ~ui32Bits;
+        }
+    }
+}
+
+void
+TimerIntRegister (uint32_t ui32Base, uint32_t ui32Timer, void (*pfnHandler)(void))
+{
+    simTimer_t *psTimer = timerGet(ui32Base);
+
+    (void) ui32Timer;
+    if (psTimer) {
+        psTimer->pfnHandler = pfnHandler;
+    }
+}
+
+void
+TimerIntEnable (uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    simTimer_t *psTimer = timerGet(ui32Base);
+
+    if (psTimer) {
+        psTimer->ui32IntMask |= ui32IntFlags;
+        HWREG(ui32Base + TIMER_O_IMR) = psTimer->ui32IntMask;
+    }
+}
+
+void
+TimerIntDisable (uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    simTimer_t *psTimer = timerGet(ui32Base);
+
+    if (psTimer) {
+        psTimer->ui32IntMask &= ~ui32IntFlags;
+        HWREG(ui32Base + TIMER_O_IMR) = psTimer->ui32IntMask;
+    }
+}
+
+void
+TimerIntClear (uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    simTimer_t *psTimer = timerGet(ui32Base);
+
+    if (psTimer) {
+        psTimer->ui32RawInt &= ~ui32IntFlags;
+    }
+}
+
+uint32_t
+TimerIntStatus (uint32_t ui32Base, bool bMasked)
+{
+    simTimer_t *psTimer = timerGet(ui32Base);
+
+    if (!psTimer) {
+        return 0;
+    }
+    return bMasked ? (psTimer->ui32RawInt & psTimer->ui32IntMask) : psTimer->ui32RawInt;
+}
+
+
+/*******************************************************
+ * driverlib/pwm.h
+ *******************************************************/
+void
+PWMGenConfigure (uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Config)
+{
+    uint32_t ui32GenBase = pwmGen(ui32Base, ui32Gen);
+
+    if (ui32GenBase) {
+        HWREG(ui32GenBase + PWM_O_X_CTL) = (HWREG(ui32GenBase + PWM_O_X_CTL) & PWM_X_CTL_ENABLE)
+                                           | (ui32Config & ~PWM_X_CTL_ENABLE);
+    }
+}
+
+// As driverlib, the load is half the period counting up and down, one less counting down
+void
+PWMGenPeriodSet (uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Period)
+{
+    uint32_t ui32GenBase = pwmGen(ui32Base, ui32Gen);
+
+    if (ui32GenBase) {
+        HWREG(ui32GenBase + PWM_O_X_LOAD) = ((HWREG(ui32GenBase + PWM_O_X_CTL) & PWM_X_CTL_MODE) ? ui32Period / 2
+                                             : ui32Period - 1) & PWM_X_LOAD_M;
+    }
+}
+
+uint32_t
+PWMGenPeriodGet (uint32_t ui32Base, uint32_t ui32Gen)
+{
+    uint32_t ui32GenBase = pwmGen(ui32Base, ui32Gen);
+
+    if (ui32GenBase) {
+        return (HWREG(ui32GenBase + PWM_O_X_CTL) & PWM_X_CTL_MODE) ? HWREG(ui32GenBase + PWM_O_X_LOAD) * 2
+                                                                  : HWREG(ui32GenBase + PWM_O_X_LOAD) + 1;
+    }
+    return 0;
+}
+
+void
+PWMGenEnable (uint32_t ui32Base, uint32_t ui32Gen)
+{
+    uint32_t ui32GenBase = pwmGen(ui32Base, ui32Gen);
+
+    if (ui32GenBase) {
+        HWREG(ui32GenBase + PWM_O_X_CTL) |= PWM_X_CTL_ENABLE;
+    }
+}
+
+void
+PWMGenDisable (uint32_t ui32Base, uint32_t ui32Gen)
+{
+    uint32_t ui32GenBase = pwmGen(ui32Base, ui32Gen);
+
+    if (ui32GenBase) {
+        HWREG(ui32GenBase + PWM_O_X_CTL) &= ~PWM_X_CTL_ENABLE;
+    }
+}
+
+// The compare is the load less the width, halved counting up and down
+void
+PWMPulseWidthSet (uint32_t ui32Base, uint32_t ui32PWMOut, uint32_t ui32Width)
+{
+    uint32_t ui32GenBase = pwmGen(ui32Base, PWM_OUT_GEN(ui32PWMOut));
+
+    if (ui32GenBase) {
+        if (HWREG(ui32GenBase + PWM_O_X_CTL) & PWM_X_CTL_MODE) {
+            ui32Width /= 2;
+        }
+        HWREG(ui32GenBase + PWM_OUT_CMP(ui32PWMOut)) = HWREG(ui32GenBase + PWM_O_X_LOAD) - ui32Width;
+    }
+}
+
+uint32_t
+PWMPulseWidthGet (uint32_t ui32Base, uint32_t ui32PWMOut)
+{
+    uint32_t ui32GenBase = pwmGen(ui32Base, PWM_OUT_GEN(ui32PWMOut));
+    uint32_t ui32Width;
+
+    if (ui32GenBase) {
+        ui32Width = HWREG(ui32GenBase + PWM_O_X_LOAD) - HWREG(ui32GenBase + PWM_OUT_CMP(ui32PWMOut));
+        return (HWREG(ui32GenBase + PWM_O_X_CTL) & PWM_X_CTL_MODE) ? ui32Width * 2 : ui32Width;
+    }
+    return 0;
+}
+
+void
+PWMOutputState (uint32_t ui32Base, uint32_t ui32PWMOutBits, bool bEnable)
+{
+    if (pwmGen(ui32Base, PWM_GEN_0)) {
+        HWREG(ui32Base + PWM_O_ENABLE) = bEnable ? (HWREG(ui32Base + PWM_O_ENABLE) | ui32PWMOutBits)
+                                                 : (HWREG(ui32Base + PWM_O_ENABLE) & ~ui32PWMOutBits);
+    }
+}
+
+
+/*******************************************************
+ * driverlib/qei.h
+ *******************************************************/
+void
+QEIEnable (uint32_t ui32Base)
+{
+    HWREG(ui32Base + QEI_O_CTL) |= QEI_CTL_ENABLE;
+}
+
+void
+QEIDisable (uint32_t ui32Base)
+{
+    HWREG(ui32Base + QEI_O_CTL) &= ~QEI_CTL_ENABLE;
+}
+
+void
+QEIConfigure (uint32_t ui32Base, uint32_t ui32Config, uint32_t ui32MaxPosition)
+{
+    HWREG(ui32Base + QEI_O_CTL) = (HWREG(ui32Base + QEI_O_CTL)
+        & ~(QEI_CTL_CAPMODE | QEI_CTL_RESMODE | QEI_CTL_SIGMODE | QEI_CTL_SWAP)) | ui32Config;
+    HWREG(ui32Base + QEI_O_MAXPOS) = ui32MaxPosition;
+}
+
+uint32_t
+QEIPositionGet (uint32_t ui32Base)
+{
+    return HWREG(ui32Base + QEI_O_POS);
+}
+
+void
+QEIPositionSet (uint32_t ui32Base, uint32_t ui32Position)
+{
+    HWREG(ui32Base + QEI_O_POS) = ui32Position;
+}
+
+int32_t
+QEIDirectionGet (uint32_t ui32Base)
+{
+    return (HWREG(ui32Base + QEI_O_STAT) & QEI_STAT_DIRECTION) ? -1 : 1;
+}
+
+bool
+QEIErrorGet (uint32_t ui32Base)
+{
+    return (HWREG(ui32Base + QEI_O_STAT) & QEI_STAT_ERROR) ? true : false;
+}
+
+void
+QEIVelocityEnable (uint32_t ui32Base)
+{
+    HWREG(ui32Base + QEI_O_CTL) |= QEI_CTL_VELEN;
+}
+
+void
+QEIVelocityDisable (uint32_t ui32Base)
+{
+    HWREG(ui32Base + QEI_O_CTL) &= ~QEI_CTL_VELEN;
+}
+
+void
+QEIVelocityConfigure (uint32_t ui32Base, uint32_t ui32PreDiv, uint32_t ui32Period)
+{
+    // The predivider is recorded only, the simulation counts every pulse
+    HWREG(ui32Base + QEI_O_CTL) = (HWREG(ui32Base + QEI_O_CTL) & ~QEI_CTL_VELDIV_M) | ui32PreDiv;
+    HWREG(ui32Base + QEI_O_LOAD) = ui32Period - 1;
+    HWREG(ui32Base + QEI_O_TIME) = ui32Period - 1;
+}
+
+uint32_t
+QEIVelocityGet (uint32_t ui32Base)
+{
+    return HWREG(ui32Base + QEI_O_SPEED);
+}
+
+void
+QEIIntRegister (uint32_t ui32Base, void (*pfnHandler)(void))
+{
+    simQEI_t *psQEI = qeiGet(ui32Base);
+
+    if (psQEI) {
+        psQEI->pfnHandler = pfnHandler;
+    }
+}
+
+void
+QEIIntEnable (uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    HWREG(ui32Base + QEI_O_INTEN) |= ui32IntFlags;
+}
+
+void
+QEIIntDisable (uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    HWREG(ui32Base + QEI_O_INTEN) &= ~ui32IntFlags;
+}
+
+uint32_t
+QEIIntStatus (uint32_t ui32Base, bool bMasked)
+{
+    uint32_t ui32Status = HWREG(ui32Base + QEI_O_RIS);
+
+    return bMasked ? (ui32Status & HWREG(ui32Base + QEI_O_INTEN)) : ui32Status;
+}
+
+void
+QEIIntClear (uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    HWREG(ui32Base + QEI_O_RIS) &= ~ui32IntFlags;
+}
+
+
+/*******************************************************
+ * driverlib/ssi.h
+ *******************************************************/
+void SSIClockSourceSet (uint32_t ui32Base, uint32_t ui32Source) { (void) ui32Base; (void) ui32Source; }
+void SSIConfigSetExpClk (uint32_t ui32Base, uint32_t ui32SSIClk, uint32_t ui32Protocol, uint32_t ui32Mode, uint32_t ui32BitRate, uint32_t ui32DataWidth) { (void) ui32Base; (void) ui32SSIClk; (void) ui32Protocol; (void) ui32Mode; (void) ui32BitRate; (void) ui32DataWidth; }
+void SSIEnable (uint32_t ui32Base) { (void) ui32Base; }
+bool SSIBusy (uint32_t ui32Base) { (void) ui32Base; return false; }
+
+void
+SSIDataPut (uint32_t ui32Base, uint32_t ui32Data)
+{
+    (void) ui32Base;
+    (void) ui32Data;
+    g_sStats.ui32SSIBytes++;
+}
+
+void
+SSIDataGet (uint32_t ui32Base, uint32_t *pui32Data)
+{
+    (void) ui32Base;
+    *pui32Data = 0;
+}
+
+
+/*******************************************************
+ * driverlib/uart.h, driverlib/systick.h
+ *******************************************************/
+void UARTClockSourceSet (uint32_t ui32Base, uint32_t ui32Source) { (void) ui32Base; (void) ui32Source; }
+void SysTickPeriodSet (uint32_t ui32Period) { (void) ui32Period; }
+void SysTickIntRegister (void (*pfnHandler)(void)) { (void) pfnHandler; }
+void SysTickIntEnable (void) { }
+void SysTickEnable (void) { }
+
+
+/*******************************************************
+ * utils/uartstdio.h, written to stdout on the host
+ *******************************************************/
+void
+UARTStdioConfig (uint32_t ui32PortNum, uint32_t ui32Baud, uint32_t ui32SrcClock)
+{
+    (void) ui32PortNum;
+    (void) ui32Baud;
+    (void) ui32SrcClock;
+}
+
+int
+UARTwrite (const char *pcBuf, uint32_t ui32Len)
+{
+    return (int) fwrite(pcBuf, 1, ui32Len, stdout);
+}
+
+void
+UARTvprintf (const char *pcString, va_list vaArgP)
+{
+    vprintf(pcString, vaArgP);
+}
+
+void
+UARTprintf (const char *pcString, ...)
+{
+    va_list vaArgP;
+
+    va_start(vaArgP, pcString);
+    vprintf(pcString, vaArgP);
+    va_end(vaArgP);
+}
@@ -0,0 +1,156 @@
+#ifndef __SIM_PERIPHERALS_H__
+#define __SIM_PERIPHERALS_H__
+
+/*******************************************************
+ * sim_peripherals.h
+ *
+ * Host-side stand-ins for the TivaWare peripherals used by
+ * the HeliRig firmware (ADC0, GPIO, general purpose timers,
+ * PWM, QEI, SSI3 and the UART console).
+ *
+ * The firmware calls the normal driverlib API. This module
+ * keeps the peripheral state in memory, advances simulated
+ * time with simStep(), and runs the registered interrupt
+ * handlers when their interrupt conditions are met.
+ *
+ * A plant model (or a test) drives the inputs with
+ * simADCInputSet(), simGPIOInputSet() and simQEIInputStep(),
+ * and reads the motor outputs back with simPWMDutyGet().
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define SIM_RESET_CLOCK_HZ      16000000  // PIOSC, before SysCtlClockSet()
+#define SIM_ADC_MAX_COUNTS      4095
+#define SIM_ADC_FIFO_DEPTH      8
+#define SIM_MAX_TAIL_CHAIN      16  // Handler runs before a stuck interrupt is reported
+
+
+// Interrupt and bus activity counters, useful for benchmarks
+typedef struct
+{
+    uint32_t ui32TimerInts;  // Timer handlers run
+    uint32_t ui32ADCInts;  // ADC sequence handlers run
+    uint32_t ui32GPIOInts;  // GPIO port handlers run
+    uint32_t ui32QEIInts;  // QEI handlers run
+    uint32_t ui32StuckInts;  // Handlers that returned without clearing their interrupt
+    uint32_t ui32ADCOverflows;  // Samples dropped because a sequence FIFO was full
+    uint32_t ui32SSIBytes;  // Bytes written with SSIDataPut()
+} simStats_t;
+
+
+/*******************************************************
+ * Function: simReset
+ *
+ * Returns every simulated peripheral and the simulated
+ * clock to their power-on state
+ *******************************************************/
+void
+simReset (void);
+
+
+/*******************************************************
+ * Function: simStep
+ *
+ * Advances simulated time, calls the step hook, then
+ * expires timers and runs any interrupt handlers that
+ * become pending
+ *
+ * ui32Microseconds: length of the step
+ *******************************************************/
+void
+simStep (uint32_t ui32Microseconds);
+
+
+/*******************************************************
+ * Function: simTimeGet
+ *
+ * returns: simulated time since simReset() in microseconds
+ *******************************************************/
+uint64_t
+simTimeGet (void);
+
+
+/*******************************************************
+ * Function: simStepHookSet
+ *
+ * Registers a function called at the start of every
+ * simStep(), before any timers expire. This is where a
+ * plant model updates the simulated inputs.
+ *
+ * pfnHook: hook to call, or NULL to remove it
+ *******************************************************/
+void
+simStepHookSet (void (*pfnHook)(uint32_t ui32Microseconds));
+
+
+/*******************************************************
+ * Function: simADCInputSet
+ *
+ * Sets the value the ADC returns for a channel
+ *
+ * ui32Channel: ADC_CTL_CHx channel number
+ * ui32Counts: conversion result, clamped to 12 bits
+ *******************************************************/
+void
+simADCInputSet (uint32_t ui32Channel, uint32_t ui32Counts);
+
+
+/*******************************************************
+ * Function: simGPIOInputSet
+ *
+ * Drives input pins on a GPIO port. Edges on pins with
+ * interrupts enabled raise the port interrupt.
+ *
+ * ui32Port: GPIO_PORTx_BASE
+ * ui8Pins: pins to drive
+ * ui8Val: new pin levels
+ *******************************************************/
+void
+simGPIOInputSet (uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val);
+
+
+/*******************************************************
+ * Function: simQEIInputStep
+ *
+ * Moves the encoder on a QEI's PhA/PhB pins by a number of
+ * edges. Does nothing until the QEI is enabled. Counts the
+ * position up or down (wrapping at QEI_O_MAXPOS), and the
+ * pulses for the velocity period.
+ *
+ * ui32Base: QEIx_BASE
+ * i32Edges: edges, positive when PhB leads PhA (the
+ *           direction heli_plant drives as positive yaw)
+ *******************************************************/
+void
+simQEIInputStep (uint32_t ui32Base, int32_t i32Edges);
+
+
+/*******************************************************
+ * Function: simPWMDutyGet
+ *
+ * returns: duty cycle of a PWM output (0.0 to 1.0), or 0
+ *          if the generator or output is disabled
+ *******************************************************/
+float
+simPWMDutyGet (uint32_t ui32Base, uint32_t ui32PWMOut);
+
+
+/*******************************************************
+ * Function: simStatsGet
+ *
+ * returns: the interrupt and bus activity counters
+ *******************************************************/
+const simStats_t *
+simStatsGet (void);
+
+
+#endif /* __SIM_PERIPHERALS_H__ */
@@ -0,0 +1,25 @@
+#ifndef __UARTSTDIO_H__
+#define __UARTSTDIO_H__
+
+/*******************************************************
+ * utils/uartstdio.h (host stand-in)
+ *
+ * Console API used by the firmware. On the host the
+ * implementation in sim_peripherals.c writes to stdout
+ * instead of UART0, so utils/uartstdio.c is left out of
+ * the host build.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+void UARTStdioConfig (uint32_t ui32PortNum, uint32_t ui32Baud, uint32_t ui32SrcClock);
+int UARTwrite (const char *pcBuf, uint32_t ui32Len);
+void UARTprintf (const char *pcString, ...);
+void UARTvprintf (const char *pcString, va_list vaArgP);
+
+#endif /* __UARTSTDIO_H__ */
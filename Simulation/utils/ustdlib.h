@@ -0,0 +1,35 @@
+#ifndef __USTDLIB_H__
+#define __USTDLIB_H__
+
+/*******************************************************
+ * utils/ustdlib.h (host stand-in)
+ *
+ * Prototypes for the TivaWare string utilities in
+ * utils/ustdlib.c, which builds unchanged on the host.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <time.h>
+
+char *ustrncpy (char * restrict s1, const char * restrict s2, size_t n);
+int uvsnprintf (char * restrict s, size_t n, const char * restrict format, va_list arg);
+int usprintf (char * restrict s, const char *format, ...);
+int usnprintf (char * restrict s, size_t n, const char * restrict format, ...);
+void ulocaltime (time_t timer, struct tm *tm);
+time_t umktime (struct tm *timeptr);
+unsigned long ustrtoul (const char * restrict nptr, const char ** restrict endptr, int base);
+float ustrtof (const char *nptr, const char **endptr);
+size_t ustrlen (const char *s);
+char *ustrstr (const char *s1, const char *s2);
+int ustrncasecmp (const char *s1, const char *s2, size_t n);
+int ustrcasecmp (const char *s1, const char *s2);
+int ustrncmp (const char *s1, const char *s2, size_t n);
+int ustrcmp (const char *s1, const char *s2);
+void usrand (unsigned int seed);
+int urand (void);
+
+#endif /* __USTDLIB_H__ */
@@ -0,0 +1,250 @@
+/*******************************************************
+ * adcTriggerTest.c
+ *
+ * Host test of the hardware-timed height sampling in
+ * get_height_task.c, run against the simulated peripherals.
+ *
+ * Checks at register level that initGetHeightTask() leaves
+ * ADC0 sequence ADC_SEQUENCE triggered by TIMER1 (EMUX),
+ * with ADC_STEPS_PER_TRIGGER steps and the interrupt on the
+ * last one, and TIMER1 running at ADC_TRIGGER_RATE_HZ with
+ * its ADC trigger output on and its own interrupt off.
+ * Then runs one simulated second and checks there was
+ * exactly one interrupt (the ADC's) per block of samples.
+ * Finally runs getHeightTask, with simulated time passing
+ * in its delays and notification waits, through the
+ * calibration window with the reading held at the landed
+ * value and on to a reading for 50%, and checks the
+ * calibration and the height it reports.
+ *
+ * Rebuild with -D overrides of the ADC_ settings in
+ * get_height_task.h to test the other capture modes.
+ *
+ * The FreeRTOS calls made by get_height_task.c are stubbed
+ * below, only the headers from the POSIX port are needed.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -ISimulation -I. -I"HeliRig Project" -IDrivers -Iutils
+ *         -IFreeRTOS/include -I$POSIX_PORT -o adc_trigger_test Testing/adcTriggerTest.c
+ *         "HeliRig Project"/get_height_task.c Drivers/spscBuf.c Drivers/pingPongBuf.c Drivers/filter.c
+ *         utils/ustdlib.c Simulation/sim_peripherals.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <setjmp.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_adc.h"
+#include "inc/hw_timer.h"
+#include "driverlib/adc.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "sim_peripherals.h"
+#include "get_height_task.h"
+#include "helirig_structs.c"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_CLOCK_HZ       80000000
+#define TEST_LANDED_COUNTS  2900  // Landed reading, within HEIGHT_CAL_TOLERANCE of the nominal
+#define TEST_ADC_COUNTS     2280  // 620 counts below landed, 620 / 1241 = 50%
+#define TEST_HEIGHT_TEXT    "Height (/): 50 "
+#define TEST_CAL_TEXT       "Height (/): cal "
+#define TEST_RUN_MS         (HEIGHT_CAL_MS + 250)  // Task run time, time for the height to settle after calibration
+
+#define SEQ_SHIFT           (ADC_SEQUENCE * 4)  // Nibble of EMUX, ACTSS bit etc. for the sequence
+#define SEQ_OFFSET          (ADC_SEQUENCE * ADC_O_SEQ_STRIDE)
+#define LAST_STEP_CTL       ((ADC_SSCTL_IE | ADC_SSCTL_END) << ((ADC_STEPS_PER_TRIGGER - 1) * 4))
+
+
+static TaskFunction_t g_pfnTask;
+static void *g_pvTaskParameters;
+static OLEDMessage g_sLastMessage;
+static uint32_t g_ui32Messages;
+static uint32_t g_ui32CalMessages;
+static uint64_t g_ui64TaskStart;  // Simulated time the task was started at
+static uint32_t g_ui32Notified;  // Bits notified to the task, not yet waited for
+static jmp_buf g_sTaskExit;
+static uint32_t g_ui32Failures;
+
+
+/*******************************************************
+ * FreeRTOS stubs
+ *******************************************************/
+BaseType_t
+xTaskCreate (TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth,
+             void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    (void) pcName;
+    (void) usStackDepth;
+    (void) uxPriority;
+    g_pfnTask = pxTaskCode;
+    g_pvTaskParameters = pvParameters;
+    *pxCreatedTask = (TaskHandle_t) &g_pfnTask;  // Never dereferenced by the stubs
+    return pdPASS;
+}
+
+BaseType_t
+xQueueGenericSend (QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait,
+                   const BaseType_t xCopyPosition)
+{
+    (void) xQueue;
+    (void) xTicksToWait;
+    (void) xCopyPosition;
+    memcpy(&g_sLastMessage, pvItemToQueue, sizeof(g_sLastMessage));
+    g_ui32Messages++;
+    if (strcmp(g_sLastMessage.strBuf, TEST_CAL_TEXT) == 0) {
+        g_ui32CalMessages++;
+    }
+    if (g_ui32Messages == HEIGHT_CAL_PASSES) {
+        simADCInputSet(0, TEST_ADC_COUNTS);  // Calibration over, take off
+    }
+    return pdPASS;
+}
+
+void
+vTaskDelay (const TickType_t xTicksToDelay)
+{
+    TickType_t xTick;
+
+    for (xTick = 0; xTick < xTicksToDelay; xTick++) {
+        if (simTimeGet() - g_ui64TaskStart >= TEST_RUN_MS * 1000ull) {
+            longjmp(g_sTaskExit, 1);  // End the task
+        }
+        simStep(1000 * portTICK_RATE_MS);
+    }
+}
+
+BaseType_t
+xTaskNotifyWait (uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue,
+                 TickType_t xTicksToWait)
+{
+    TickType_t xTick;
+
+    (void) pulNotificationValue;
+    g_ui32Notified &= ~ulBitsToClearOnEntry;
+    for (xTick = 0; xTick < xTicksToWait && g_ui32Notified == 0; xTick++) {
+        vTaskDelay(1);
+    }
+    if (g_ui32Notified == 0) {
+        return pdFALSE;
+    }
+    g_ui32Notified &= ~ulBitsToClearOnExit;
+    return pdTRUE;
+}
+
+BaseType_t
+xTaskGenericNotifyFromISR (TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                           uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void) xTaskToNotify;
+    (void) eAction;
+    (void) pulPreviousNotificationValue;
+    g_ui32Notified |= ulValue;
+    *pxHigherPriorityTaskWoken = pdTRUE;
+    return pdPASS;
+}
+
+TickType_t
+xTaskGetTickCount (void)
+{
+    return (TickType_t) (simTimeGet() / (1000 * portTICK_RATE_MS));
+}
+
+void
+vPortYield (void)
+{
+}
+
+void
+vPortEnterCritical (void)
+{
+}
+
+void
+vPortExitCritical (void)
+{
+}
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-52s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+int
+main (void)
+{
+    QueueHandle_t xQueue = (QueueHandle_t) &g_ui32Messages;  // Never dereferenced by the stubs
+    const simStats_t *psStats;
+    HeightCalibration sCalibration;
+
+    simReset();
+    SysCtlClockSet(SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    simADCInputSet(0, TEST_LANDED_COUNTS);
+
+    check(initGetHeightTask(&xQueue) == 0 && g_pfnTask != NULL, "initGetHeightTask creates the task");
+
+    // Register level configuration
+    printf("sequence %u, %u steps per trigger, hardware averaging x%u, %s\n", ADC_SEQUENCE,
+           ADC_STEPS_PER_TRIGGER, ADC_HW_OVERSAMPLE, ADC_BLOCK_AVERAGE ? "block mean" : "every step");
+    check(((HWREG(ADC0_BASE + ADC_O_EMUX) >> SEQ_SHIFT) & 0xF) == ADC_TRIGGER_TIMER, "ADC0 sequence triggered by timer (EMUX)");
+    check(HWREG(ADC0_BASE + ADC_O_ACTSS) & (1 << ADC_SEQUENCE), "ADC0 sequence enabled (ACTSS)");
+    check(HWREG(ADC0_BASE + ADC_O_IM) & (1 << ADC_SEQUENCE), "ADC0 sequence interrupt enabled (IM)");
+    check(HWREG(ADC0_BASE + ADC_O_SSCTL0 + SEQ_OFFSET) == LAST_STEP_CTL, "steps end, and interrupt, on the last (SSCTLn)");
+    check(HWREG(ADC0_BASE + ADC_O_SSMUX0 + SEQ_OFFSET) == 0, "every step samples channel 0 (SSMUXn)");
+    check((1u << HWREG(ADC0_BASE + ADC_O_SAC)) == ADC_HW_OVERSAMPLE, "hardware averaging factor (SAC)");
+    check(HWREG(TIMER1_BASE + TIMER_O_CTL) & TIMER_CTL_TAOTE, "TIMER1A ADC trigger output on (CTL TAOTE)");
+    check(HWREG(TIMER1_BASE + TIMER_O_CTL) & TIMER_CTL_TAEN, "TIMER1A enabled (CTL TAEN)");
+    check(!(HWREG(TIMER1_BASE + TIMER_O_IMR) & TIMER_IMR_TATOIM), "TIMER1A timeout interrupt off (IMR)");
+    check(HWREG(TIMER1_BASE + TIMER_O_TAILR) == TEST_CLOCK_HZ / ADC_TRIGGER_RATE_HZ - 1, "TIMER1A period is ADC_TRIGGER_RATE_HZ (TAILR)");
+
+    // One simulated second at the FreeRTOS tick rate
+    IntMasterEnable();
+    for (uint32_t i = 0; i < 1000; i++) {
+        simStep(1000);
+    }
+    psStats = simStatsGet();
+    printf("1 s: %u ADC interrupts, %u timer interrupts\n", psStats->ui32ADCInts, psStats->ui32TimerInts);
+    check(psStats->ui32ADCInts == ADC_TRIGGER_RATE_HZ, "one ADC interrupt per block of samples");
+    check(psStats->ui32TimerInts == 0, "no timer interrupts");
+    check(psStats->ui32StuckInts == 0 && psStats->ui32ADCOverflows == 0, "no stuck interrupts or FIFO overflows");
+
+    // The task calibrates on the landed reading, then reports the height
+    g_ui64TaskStart = simTimeGet();
+    if (setjmp(g_sTaskExit) == 0) {
+        g_pfnTask(g_pvTaskParameters);
+    }
+    getHeightCalibration(&sCalibration);
+    printf("calibration: landed %u, full scale %u counts, scale %d / 2^%u\n", sCalibration.landed,
+           sCalibration.fullScale, sCalibration.scale, HEIGHT_CAL_SHIFT);
+    check(g_ui32CalMessages == HEIGHT_CAL_PASSES, "getHeightTask calibrates for HEIGHT_CAL_MS");
+    check(sCalibration.complete && !sCalibration.fallback && sCalibration.landed == TEST_LANDED_COUNTS,
+          "landed reading calibrated");
+    check(heightFromADC(TEST_LANDED_COUNTS) == 0 && heightFromADC(TEST_LANDED_COUNTS - sCalibration.fullScale) == 100,
+          "0% at landed, 100% a full scale drop below");
+    check(strcmp(g_sLastMessage.strBuf, TEST_HEIGHT_TEXT) == 0, "getHeightTask reports 50%");
+
+    printf("%u failures\n", g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
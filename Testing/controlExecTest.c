@@ -0,0 +1,517 @@
+/*******************************************************
+ * controlExecTest.c
+ *
+ * Host test of the fixed rate control executive in
+ * control_task.c: controlTask released by
+ * vTaskDelayUntil() every CONTROL_PERIOD_TICKS, flying the
+ * simulated HeliRig plant (Simulation/heli_plant.c).
+ *
+ * The task runs under a small stand in for the kernel.
+ * vTaskDelayUntil() steps the simulation to the tick the
+ * task is due at, then on by a random release latency
+ * (the tick interrupt and anything above the task), up
+ * to TEST_LATENCY_US. The height and yaw are read straight
+ * from the plant by the sensing stubs, which also charge
+ * the cycle's execution time (TEST_EXEC_US) to simulated
+ * time. TIMER3, which the releases are timed on, is the
+ * simulated one.
+ *
+ * Runs:
+ *   - steady: every cycle takes TEST_EXEC_US, more than a
+ *     tick, which a vTaskDelay() loop would add to every
+ *     period
+ *   - overrun: every TEST_OVERRUN_EVERY cycles one takes
+ *     TEST_OVERRUN_US, longer than a period
+ * Checks that
+ *   - the number of cycles is exactly the run time over the
+ *     period (no drift), against the vTaskDelay() loop of
+ *     the other tasks
+ *   - every sample is taken within the release latency of
+ *     its tick (phase aligned)
+ *   - the stats report the injected latency as jitter, the
+ *     execution time, and each overrun once, and can be
+ *     read and reset part way through a run
+ *   - nothing turns until the rotors are armed
+ *   - a tune asked for before the height loop is running
+ *     fails, and leaves it to fly as normal
+ *   - the yaw error does not step when the reference is
+ *     passed in flight, and the count jumps over to it
+ *   - the executive flies the plant to the set points
+ *     and its duties are out on the rotor PWMs
+ *   - in the overrun run, set back to a height of 0 part
+ *     way through, it lands and turns both motors off
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -ISimulation -I. -I"HeliRig Project" -IFreeRTOS/include -I$POSIX_PORT
+ *         -IDrivers -o control_exec_test Testing/controlExecTest.c "HeliRig Project"/control_task.c
+ *         "HeliRig Project"/PI_controller.c "HeliRig Project"/trajectory.c "HeliRig Project"/relay_tune.c
+ *         "HeliRig Project"/gain_schedule.c Drivers/dblBuf.c Drivers/rotorPWM.c Simulation/heli_plant.c
+ *         Simulation/sim_peripherals.c -lm
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+#include <setjmp.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/pwm.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "sim_peripherals.h"
+#include "rotorPWM.h"
+#include "heli_plant.h"
+#include "heli_math.h"
+#include "PI_controller.h"
+#include "get_height_task.h"
+#include "get_yaw_task.h"
+#include "relay_tune.h"
+#include "control_task.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_RUN_MS         10000
+#define TEST_SNAPSHOT_MS    5000  // Stats read (and in the overrun run, reset) part way through
+#define TEST_CAL_MS         HEIGHT_CAL_MS  // getHeight() has no height until then
+#define TEST_LATENCY_US     80  // Most a release is held up by
+#define TEST_EXEC_US        1200  // Time a cycle takes, over a tick
+#define TEST_OVERRUN_EVERY  100  // Cycles between overruns, in the overrun run
+#define TEST_OVERRUN_US     7000  // ... which take this long
+#define TEST_PERIOD_US      (CONTROL_PERIOD_TICKS * 1000 / configTICK_RATE_HZ * 1000)
+
+#define TEST_HEIGHT_TARGET  50  // %
+#define TEST_YAW_TARGET     90  // Degrees
+#define TEST_HEIGHT_TOL     3.0
+#define TEST_YAW_TOL        5.0
+#define TEST_PWM_TOL        0.0001  // Duty out to within a PWM count and a Q16.16 LSB
+#define TEST_ARM_MS         200  // Armed by another task, before the height is calibrated
+#define TEST_REF_MS         3000  // The yaw counts from power on until the reference is passed, in flight, here
+#define TEST_REF_OFFSET     100  // Counts the power on heading is from the reference
+#define TEST_YAW_STEP_MAX   1.0  // Most the yaw error moves in a cycle, degrees
+
+
+static TaskFunction_t g_pfnTask;
+static jmp_buf g_sTaskExit;
+static uint32_t g_ui32Failures;
+
+static heliPlant_t g_sPlant;
+static uint64_t g_ui64Start;  // Simulated time the run was started at
+static uint64_t g_ui64PlantUs;  // Simulated time the plant has been stepped to
+
+static uint32_t g_ui32OverrunEvery;  // 0 for none, and the stats are reset at TEST_SNAPSHOT_MS if not
+static uint32_t g_ui32Releases;
+static uint32_t g_ui32DueMs;  // Tick the task was last due at
+static uint32_t g_ui32LatencyMin;
+static uint32_t g_ui32LatencyMax;
+static uint32_t g_ui32SenseMax;  // Latest a sample was taken after its tick, not counting the catch up after an overrun
+static bool g_bCatchUp;  // This release was already due, the last cycle overran
+static uint32_t g_ui32Seed;
+static bool g_bSnapshot;
+static ControlStats g_sSnapshot;
+static ControlTune g_sTune;  // Read at TEST_SNAPSHOT_MS
+static bool g_bTurned;  // A rotor output was seen on before the rotors were armed
+static bool g_bYawError;  // g_fYawError is from the last release
+static float g_fYawError;  // Yaw set point less the yaw, at the last release
+static float g_fYawStepMax;  // Most it moved from one release to the next
+
+
+/*******************************************************
+ * Function: nowUs
+ *
+ * returns: us since the run started
+ *******************************************************/
+static uint64_t
+nowUs (void)
+{
+    return simTimeGet() - g_ui64Start;
+}
+
+
+/*******************************************************
+ * Function: advance
+ *
+ * Steps the simulation, and the plant in 1 ms steps
+ * behind it with the last duties of the executive
+ *******************************************************/
+static void
+advance (uint32_t ui32Us)
+{
+    ControlOutput sOutput;
+
+    simStep(ui32Us);
+    getControlOutput(&sOutput);
+    while (g_ui64PlantUs + 1000 <= simTimeGet()) {
+        heliPlantStep(&g_sPlant, 0.001f, numToFloat(sOutput.mainDuty), numToFloat(sOutput.tailDuty));
+        g_ui64PlantUs += 1000;
+    }
+}
+
+
+/*******************************************************
+ * Function: latency
+ *
+ * returns: a release latency, 0 to TEST_LATENCY_US
+ *******************************************************/
+static uint32_t
+latency (void)
+{
+    uint32_t ui32Us;
+
+    g_ui32Seed = g_ui32Seed * 1664525 + 1013904223;
+    ui32Us = (g_ui32Seed >> 16) % (TEST_LATENCY_US + 1);
+    g_ui32LatencyMin = (ui32Us < g_ui32LatencyMin) ? ui32Us : g_ui32LatencyMin;
+    g_ui32LatencyMax = (ui32Us > g_ui32LatencyMax) ? ui32Us : g_ui32LatencyMax;
+    return ui32Us;
+}
+
+
+/*******************************************************
+ * Function: trackYawError
+ *
+ * Records the most the yaw error moved from one cycle to
+ * the next
+ *******************************************************/
+static void
+trackYawError (void)
+{
+    ControlOutput sOutput;
+    float fError;
+
+    getControlOutput(&sOutput);
+    if (!sOutput.yawAuto) {
+        return;
+    }
+    fError = numToFloat(sOutput.yawSetpoint) - numToFloat(sOutput.yaw);
+    if (g_bYawError && fabsf(fError - g_fYawError) > g_fYawStepMax) {
+        g_fYawStepMax = fabsf(fError - g_fYawError);
+    }
+    g_fYawError = fError;
+    g_bYawError = true;
+}
+
+
+/*******************************************************
+ * FreeRTOS stubs
+ *******************************************************/
+BaseType_t
+xTaskCreate (TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth,
+             void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    (void) pcName;
+    (void) usStackDepth;
+    (void) pvParameters;
+    (void) uxPriority;
+    (void) pxCreatedTask;
+    g_pfnTask = pxTaskCode;
+    return pdPASS;
+}
+
+void
+vTaskDelayUntil (TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement)
+{
+    uint32_t ui32WakeUs;
+
+    *pxPreviousWakeTime += xTimeIncrement;
+    g_ui32DueMs = *pxPreviousWakeTime;
+    if (g_ui32DueMs >= TEST_RUN_MS) {
+        longjmp(g_sTaskExit, 1);
+    }
+    if (g_ui32Releases == 0 && !g_ui32OverrunEvery) {
+        startControlTune(CONTROL_TUNE_HEIGHT);  // Before the height is calibrated
+    }
+    if (g_ui32DueMs < TEST_ARM_MS) {
+        g_bTurned = g_bTurned || simPWMDutyGet(ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_OUTNUM) != 0.0f
+                    || simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM) != 0.0f;
+    } else if (g_ui32DueMs - xTimeIncrement < TEST_ARM_MS) {
+        armControl(true);  // As another task would, on a button press
+    }
+    if (!g_bSnapshot && g_ui32DueMs >= TEST_SNAPSHOT_MS) {
+        getControlStats(&g_sSnapshot);  // As another task would
+        getControlTune(&g_sTune);
+        if (g_ui32OverrunEvery) {
+            resetControlStats();
+            setControlTarget(0, TEST_YAW_TARGET);  // Land
+        }
+        g_bSnapshot = true;
+    }
+
+    // Block until the tick it is due at, or run straight on if that has passed
+    ui32WakeUs = g_ui32DueMs * 1000;
+    g_bCatchUp = nowUs() >= ui32WakeUs;
+    if (!g_bCatchUp) {
+        advance(ui32WakeUs - (uint32_t) nowUs());
+        advance(latency());
+    }
+    g_ui32Releases++;
+    trackYawError();
+}
+
+TickType_t
+xTaskGetTickCount (void)
+{
+    return (TickType_t) (nowUs() / 1000);
+}
+
+void
+vPortEnterCritical (void)
+{
+}
+
+void
+vPortExitCritical (void)
+{
+}
+
+
+/*******************************************************
+ * Sensing stubs, in place of get_yaw_task.c and
+ * get_height_task.c
+ *
+ * The loop steers by the yaw from the start, as it does
+ * once getYawTask gives up on the reference, and the
+ * reference is passed at TEST_REF_MS, in flight, moving
+ * the count over to it as updateYawPosition() does
+ *******************************************************/
+void
+initYawPosition (YawPosition *position)
+{
+    position->count = 0;
+    position->snapshot = 0;
+    position->referenced = false;
+    position->rebase = 0;
+}
+
+int32_t
+updateYawPosition (YawPosition *position)
+{
+    int32_t i32Count = heliPlantQuadCount(&g_sPlant);
+    int32_t i32Change;
+
+    position->rebase = 0;
+    if (position->referenced) {
+        i32Count += TEST_REF_OFFSET;
+    } else if (nowUs() >= TEST_REF_MS * 1000) {
+        i32Count += TEST_REF_OFFSET;
+        position->rebase = TEST_REF_OFFSET;
+        position->referenced = true;
+    }
+    i32Change = i32Count - (int32_t) position->count - position->rebase;
+    position->count = i32Count;
+    return i32Change;
+}
+
+bool
+getYawRefFound (void)
+{
+    return true;
+}
+
+void
+initYawVelocity (YawVelocity *velocity)
+{
+    velocity->counts = 0;
+}
+
+int32_t
+updateYawVelocity (YawVelocity *velocity)
+{
+    velocity->counts = (int32_t) lroundf(g_sPlant.fYawRate / 0.8f);  // YAW_DEG_PER_COUNT
+    return velocity->counts;
+}
+
+bool
+getHeight (int32_t *height)
+{
+    uint32_t ui32Since = (uint32_t) nowUs() - g_ui32DueMs * 1000;
+
+    if (!g_bCatchUp && ui32Since > g_ui32SenseMax) {
+        g_ui32SenseMax = ui32Since;
+    }
+    *height = (int32_t) lroundf(g_sPlant.fHeight * 100.0f);
+
+    // The rest of the cycle
+    advance((g_ui32OverrunEvery && g_ui32Releases % g_ui32OverrunEvery == 0) ? TEST_OVERRUN_US : TEST_EXEC_US);
+
+    return nowUs() >= TEST_CAL_MS * 1000;
+}
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: runExecutive
+ *
+ * Creates the executive and runs it for TEST_RUN_MS
+ *
+ * ui32OverrunEvery: cycles between overruns, 0 for none
+ *******************************************************/
+static void
+runExecutive (uint32_t ui32OverrunEvery, ControlStats *psStats, ControlOutput *psOutput)
+{
+    initHeliPlant(&g_sPlant);
+    g_sPlant.sParams.ui32ADCNoise = 0;
+    g_ui64Start = g_ui64PlantUs = simTimeGet();
+    g_ui32OverrunEvery = ui32OverrunEvery;
+    g_ui32Releases = 0;
+    g_ui32LatencyMin = UINT32_MAX;
+    g_ui32LatencyMax = 0;
+    g_ui32SenseMax = 0;
+    g_ui32Seed = 12345;
+    g_bSnapshot = false;
+    g_bTurned = false;
+    g_bYawError = false;
+    g_fYawStepMax = 0;
+
+    if (initControlTask() != 0) {
+        return;
+    }
+    setControlTarget(TEST_HEIGHT_TARGET, TEST_YAW_TARGET);
+    if (setjmp(g_sTaskExit) == 0) {
+        g_pfnTask(NULL);
+    }
+    getControlStats(psStats);
+    getControlOutput(psOutput);
+}
+
+
+/*******************************************************
+ * Function: delayLoopCycles
+ *
+ * Counts the cycles a vTaskDelay(CONTROL_PERIOD_TICKS)
+ * loop gets through in TEST_RUN_MS, with the same work
+ * and no latency: it wakes CONTROL_PERIOD_TICKS after
+ * the tick it finished in
+ *******************************************************/
+static uint32_t
+delayLoopCycles (void)
+{
+    uint32_t ui32Us = 0, ui32Cycles = 0;
+
+    while (1) {
+        ui32Us = (ui32Us + TEST_EXEC_US) / 1000 * 1000 + TEST_PERIOD_US;
+        if (ui32Us >= TEST_RUN_MS * 1000) {
+            return ui32Cycles;
+        }
+        ui32Cycles++;
+    }
+}
+
+
+/*******************************************************
+ * Function: printStats
+ *******************************************************/
+static void
+printStats (const char *pcRun, const ControlStats *psStats)
+{
+    printf("  %s: %u cycles, %u overruns, jitter max %.3f us mean %.3f us, execution max %.3f us\n", pcRun,
+           (unsigned) psStats->cycles, (unsigned) psStats->overruns, psStats->jitterMax / 1000.0,
+           psStats->cycles ? (double) psStats->jitterSum / psStats->cycles / 1000.0 : 0.0, psStats->execMax / 1000.0);
+}
+
+
+/*******************************************************
+ * Function: checkSteady
+ *******************************************************/
+static void
+checkSteady (void)
+{
+    const uint32_t ui32Expected = TEST_RUN_MS * 1000 / TEST_PERIOD_US - 1;  // Released at 1 to n - 1 periods
+    ControlStats sStats;
+    ControlOutput sOutput;
+    uint32_t ui32DelayLoop = delayLoopCycles();
+
+    runExecutive(0, &sStats, &sOutput);
+    printf("%u Hz executive, %u us a cycle, release latency %u to %u us\n", (unsigned) CONTROL_RATE_HZ,
+           (unsigned) TEST_EXEC_US, (unsigned) g_ui32LatencyMin, (unsigned) g_ui32LatencyMax);
+    printStats("steady", &sStats);
+    printf("  vTaskDelay(%u) loop: %u cycles (%.1f Hz), executive %u (%.1f Hz)\n", (unsigned) CONTROL_PERIOD_TICKS,
+           (unsigned) ui32DelayLoop, ui32DelayLoop * 1000.0 / TEST_RUN_MS, (unsigned) sStats.cycles,
+           sStats.cycles * 1000.0 / TEST_RUN_MS);
+    printf("  samples taken at most %u us after their tick\n", (unsigned) g_ui32SenseMax);
+    printf("  yaw error moved at most %.2f deg in a cycle\n", g_fYawStepMax);
+    printf("  at %u ms: %u cycles\n", (unsigned) TEST_SNAPSHOT_MS, (unsigned) g_sSnapshot.cycles);
+    printf("  height %.1f%% (target %d), yaw %.1f deg (target %d), main %.3f tail %.3f\n",
+           numToFloat(sOutput.height), TEST_HEIGHT_TARGET, numToFloat(sOutput.yaw), TEST_YAW_TARGET,
+           numToFloat(sOutput.mainDuty), numToFloat(sOutput.tailDuty));
+
+    check(sStats.cycles == ui32Expected && sStats.cycles == g_ui32Releases, "one cycle every period, no drift");
+    check(ui32DelayLoop < ui32Expected, "a vTaskDelay loop drifts by its execution time");
+    check(g_ui32SenseMax <= TEST_LATENCY_US, "sensing phase aligned to the release");
+    check(sStats.overruns == 0, "no overruns");
+    check(sStats.jitterMax <= g_ui32LatencyMax * 1000 && sStats.jitterMax + 1000 >= (g_ui32LatencyMax - g_ui32LatencyMin) * 1000,
+          "jitter is the release latency");
+    check(sStats.execMax == TEST_EXEC_US * 1000 && sStats.execLast == TEST_EXEC_US * 1000, "execution time measured");
+    check(g_sSnapshot.cycles == TEST_SNAPSHOT_MS * 1000 / TEST_PERIOD_US - 1, "stats read part way through");
+    check(g_sTune.runs == 1 && g_sTune.axis == CONTROL_TUNE_HEIGHT && g_sTune.result.state == RELAY_TUNE_FAILED
+          && sOutput.tuning == CONTROL_TUNE_NONE, "a tune of a loop not yet running fails");
+    check(!g_bTurned, "nothing turns until armed");
+    check(g_fYawStepMax <= TEST_YAW_STEP_MAX, "yaw error does not step as the reference is passed");
+    check(sOutput.heightAuto && sOutput.yawAuto && fabs(numToFloat(sOutput.height) - TEST_HEIGHT_TARGET) <= TEST_HEIGHT_TOL
+          && fabs(numToFloat(sOutput.yaw) - TEST_YAW_TARGET) <= TEST_YAW_TOL, "flies to the set points");
+    check(fabs(simPWMDutyGet(ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_OUTNUM) - numToFloat(sOutput.mainDuty)) <= TEST_PWM_TOL
+          && fabs(simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM) - numToFloat(sOutput.tailDuty)) <= TEST_PWM_TOL,
+          "duties out on the rotor PWMs");
+}
+
+
+/*******************************************************
+ * Function: checkOverrun
+ *******************************************************/
+static void
+checkOverrun (void)
+{
+    const uint32_t ui32Expected = TEST_RUN_MS * 1000 / TEST_PERIOD_US - 1;
+    ControlStats sStats;
+    ControlOutput sOutput;
+
+    runExecutive(TEST_OVERRUN_EVERY, &sStats, &sOutput);
+    printStats("overrun, to the reset", &g_sSnapshot);
+    printStats("overrun, from the reset", &sStats);
+
+    check(g_sSnapshot.cycles + sStats.cycles == ui32Expected && sStats.cycles == g_ui32Releases - g_sSnapshot.cycles,
+          "overruns caught up, no drift");
+    check(g_sSnapshot.overruns + sStats.overruns == ui32Expected / TEST_OVERRUN_EVERY, "each overrun counted once");
+    check(sStats.jitterMax >= (TEST_OVERRUN_US - TEST_PERIOD_US) * 1000
+          && sStats.jitterMax <= (TEST_OVERRUN_US - TEST_PERIOD_US + TEST_LATENCY_US) * 1000,
+          "the release after is late by the overrun");
+    check(sStats.execMax == TEST_OVERRUN_US * 1000, "longest cycle measured");
+    check(sStats.cycles == (TEST_RUN_MS - TEST_SNAPSHOT_MS) * 1000 / TEST_PERIOD_US, "stats reset part way through");
+    check(sOutput.armed && sOutput.landed && sOutput.mainDuty == 0 && sOutput.tailDuty == 0
+          && simPWMDutyGet(ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_OUTNUM) == 0.0f
+          && simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM) == 0.0f, "set back to 0, lands with both motors off");
+}
+
+
+int
+main (void)
+{
+    simReset();
+    SysCtlClockSet(SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    initRotorPWM();
+
+    checkSteady();
+    checkOverrun();
+
+    printf("%u failures\n", (unsigned) g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
@@ -0,0 +1,428 @@
+/*******************************************************
+ * controlIsrTest.c
+ *
+ * Host test of the control loop hosted in the control
+ * timer interrupt (control_task.c built with
+ * CONTROL_IN_ISR), flying the simulated HeliRig plant
+ * (Simulation/heli_plant.c).
+ *
+ * The simulated TIMER3 times out every period and runs
+ * the handler at the timeout, as the target would with
+ * nothing at or above CONTROL_INT_PRIORITY. The height and
+ * yaw are read straight from the plant by the sensing
+ * stubs, which also charge the cycle's execution time
+ * (TEST_EXEC_US) to simulated time, so the timer counts on
+ * through it as it would on the target.
+ *
+ * Runs:
+ *   - steady: released at the timeout every time
+ *   - held off: each release is held off by up to
+ *     TEST_LATENCY_US (as by another interrupt at the same
+ *     priority, or interrupts masked), and from the stats
+ *     reset part way through, every TEST_OVERRUN_EVERY
+ *     cycles one takes TEST_OVERRUN_US, longer than a period
+ * Checks that
+ *   - the loop runs once every period, with no drift
+ *   - with nothing holding it off the jitter is 0 (the
+ *     timer is read to the clock cycle), and otherwise is
+ *     exactly how long it was held off
+ *   - the execution time and each overrun are measured,
+ *     and the stats can be reset part way through a run
+ *   - the loop flies the plant to the set points
+ *     and its duties are out on the rotor PWMs
+ * Then reports the host cost of one cycle of the handler,
+ * with the sensing stubs charging no time.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -DCONTROL_IN_ISR=1 -ISimulation -I. -I"HeliRig Project" -IFreeRTOS/include -I$POSIX_PORT
+ *         -IDrivers -o control_isr_test Testing/controlIsrTest.c "HeliRig Project"/control_task.c
+ *         "HeliRig Project"/PI_controller.c "HeliRig Project"/trajectory.c "HeliRig Project"/relay_tune.c
+ *         "HeliRig Project"/gain_schedule.c Drivers/dblBuf.c Drivers/rotorPWM.c Simulation/heli_plant.c
+ *         Simulation/sim_peripherals.c -lm
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pwm.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "sim_peripherals.h"
+#include "rotorPWM.h"
+#include "heli_plant.h"
+#include "heli_math.h"
+#include "PI_controller.h"
+#include "get_height_task.h"
+#include "get_yaw_task.h"
+#include "relay_tune.h"
+#include "control_task.h"
+
+#if !CONTROL_IN_ISR
+#error "Build with -DCONTROL_IN_ISR=1"
+#endif
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_RUN_MS         10000
+#define TEST_SNAPSHOT_MS    5000  // Stats read, and in the held off run reset and overruns started, part way through
+#define TEST_CAL_MS         HEIGHT_CAL_MS  // getHeightFromISR() has no height until then
+#define TEST_LATENCY_US     3  // Most a release is held off by, in the held off run
+#define TEST_EXEC_US        1200  // Time a cycle takes
+#define TEST_OVERRUN_EVERY  100  // Cycles between overruns, in the held off run
+#define TEST_OVERRUN_US     7000  // ... which take this long
+#define TEST_PERIOD_US      (1000000 / CONTROL_RATE_HZ)
+#define TEST_BENCH_CYCLES   1000000  // Handler calls timed for the step cost
+
+#define TEST_HEIGHT_TARGET  50  // %
+#define TEST_YAW_TARGET     90  // Degrees
+#define TEST_HEIGHT_TOL     3.0
+#define TEST_YAW_TOL        5.0
+#define TEST_PWM_TOL        0.0001  // Duty out to within a PWM count and a Q16.16 LSB
+
+
+static uint32_t g_ui32Failures;
+
+static heliPlant_t g_sPlant;
+static uint64_t g_ui64Start;  // Simulated time the run was started at
+static uint64_t g_ui64PlantUs;  // Simulated time the plant has been stepped to
+
+static bool g_bHeldOff;  // The held off run
+static bool g_bOverruns;  // Inject overruns
+static bool g_bCharge;  // The sensing stubs charge the cycle's execution time
+static uint32_t g_ui32Releases;
+static uint32_t g_ui32Overruns;  // Injected
+static uint32_t g_ui32LatencyMax;
+static uint32_t g_ui32SnapshotLatencyMax;  // g_ui32LatencyMax when g_sSnapshot was read
+static uint32_t g_ui32Seed;
+static ControlStats g_sSnapshot;
+
+
+/*******************************************************
+ * Function: nowUs
+ *
+ * returns: us since the run started
+ *******************************************************/
+static uint64_t
+nowUs (void)
+{
+    return simTimeGet() - g_ui64Start;
+}
+
+
+/*******************************************************
+ * Function: advance
+ *
+ * Steps the simulation, and the plant in 1 ms steps
+ * behind it with the last duties of the loop
+ *******************************************************/
+static void
+advance (uint32_t ui32Us)
+{
+    ControlOutput sOutput;
+
+    simStep(ui32Us);
+    getControlOutput(&sOutput);
+    while (g_ui64PlantUs + 1000 <= simTimeGet()) {
+        heliPlantStep(&g_sPlant, 0.001f, numToFloat(sOutput.mainDuty), numToFloat(sOutput.tailDuty));
+        g_ui64PlantUs += 1000;
+    }
+}
+
+
+/*******************************************************
+ * Function: latency
+ *
+ * returns: how long a release is held off, 0 to
+ *          TEST_LATENCY_US
+ *******************************************************/
+static uint32_t
+latency (void)
+{
+    uint32_t ui32Us;
+
+    g_ui32Seed = g_ui32Seed * 1664525 + 1013904223;
+    ui32Us = (g_ui32Seed >> 16) % (TEST_LATENCY_US + 1);
+    g_ui32LatencyMax = (ui32Us > g_ui32LatencyMax) ? ui32Us : g_ui32LatencyMax;
+    return ui32Us;
+}
+
+
+/*******************************************************
+ * Function: testIntHandler
+ *
+ * Registered in place of controlIntHandler. In the held
+ * off run, holds a release off before the handler runs,
+ * unless it is the catch up after an overrun (the timer
+ * has already counted on from the timeout).
+ *******************************************************/
+static void
+testIntHandler (void)
+{
+    if (g_bHeldOff && TimerValueGet(CONTROL_TIMER_BASE, TIMER_A) == TimerLoadGet(CONTROL_TIMER_BASE, TIMER_A)) {
+        simStep(latency());  // Interrupts stay masked meanwhile, as in a handler
+    }
+    g_ui32Releases++;
+    controlIntHandler();
+}
+
+
+/*******************************************************
+ * FreeRTOS stubs, setControlTarget()'s critical section
+ *******************************************************/
+void
+vPortEnterCritical (void)
+{
+}
+
+void
+vPortExitCritical (void)
+{
+}
+
+
+/*******************************************************
+ * Sensing stubs, in place of get_yaw_task.c and
+ * get_height_task.c
+ *******************************************************/
+void
+initYawPosition (YawPosition *position)
+{
+    position->count = 0;
+    position->snapshot = 0;
+    position->referenced = true;
+}
+
+int32_t
+updateYawPosition (YawPosition *position)
+{
+    int32_t i32Change = heliPlantQuadCount(&g_sPlant) - (int32_t) position->count;
+
+    position->count += i32Change;
+    return i32Change;
+}
+
+bool
+getYawRefFound (void)
+{
+    return true;
+}
+
+void
+initYawVelocity (YawVelocity *velocity)
+{
+    velocity->counts = 0;
+}
+
+int32_t
+updateYawVelocity (YawVelocity *velocity)
+{
+    velocity->counts = (int32_t) lroundf(g_sPlant.fYawRate / 0.8f);  // YAW_DEG_PER_COUNT
+    return velocity->counts;
+}
+
+bool
+getHeightFromISR (int32_t *height)
+{
+    *height = (int32_t) lroundf(g_sPlant.fHeight * 100.0f);
+
+    // The rest of the cycle, the timer counts on through it. Overruns are mid run, so the last is caught up in it
+    if (g_bCharge && g_bOverruns && g_ui32Releases % TEST_OVERRUN_EVERY == TEST_OVERRUN_EVERY / 2) {
+        simStep(TEST_OVERRUN_US);
+        g_ui32Overruns++;
+    } else if (g_bCharge) {
+        simStep(TEST_EXEC_US);
+    }
+
+    return nowUs() >= TEST_CAL_MS * 1000;
+}
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: runLoop
+ *
+ * Starts the control interrupt and runs it for
+ * TEST_RUN_MS
+ *
+ * bHeldOff: hold releases off, and inject overruns from
+ *           the snapshot
+ *******************************************************/
+static void
+runLoop (bool bHeldOff, ControlStats *psStats, ControlOutput *psOutput)
+{
+    initHeliPlant(&g_sPlant);
+    g_sPlant.sParams.ui32ADCNoise = 0;
+    g_ui64Start = g_ui64PlantUs = simTimeGet();
+    g_bHeldOff = bHeldOff;
+    g_bOverruns = false;
+    g_bCharge = true;
+    g_ui32Releases = 0;
+    g_ui32Overruns = 0;
+    g_ui32LatencyMax = 0;
+    g_ui32Seed = 12345;
+
+    if (initControlTask() != 0) {
+        return;
+    }
+    TimerIntRegister(CONTROL_TIMER_BASE, TIMER_A, testIntHandler);
+    setControlTarget(TEST_HEIGHT_TARGET, TEST_YAW_TARGET);
+    armControl(true);  // As a task would, on a button press
+
+    while (nowUs() < TEST_SNAPSHOT_MS * 1000) {
+        advance(1000);
+    }
+    getControlStats(&g_sSnapshot);  // As a task would
+    g_ui32SnapshotLatencyMax = g_ui32LatencyMax;
+    if (bHeldOff) {
+        resetControlStats();
+        g_bOverruns = true;
+    }
+    while (nowUs() < TEST_RUN_MS * 1000) {
+        advance(1000);
+    }
+
+    TimerDisable(CONTROL_TIMER_BASE, TIMER_A);
+    getControlStats(psStats);
+    getControlOutput(psOutput);
+}
+
+
+/*******************************************************
+ * Function: printStats
+ *******************************************************/
+static void
+printStats (const char *pcRun, const ControlStats *psStats)
+{
+    printf("  %s: %u cycles, %u overruns, jitter max %.3f us mean %.3f us, execution max %.3f us\n", pcRun,
+           (unsigned) psStats->cycles, (unsigned) psStats->overruns, psStats->jitterMax / 1000.0,
+           psStats->cycles ? (double) psStats->jitterSum / psStats->cycles / 1000.0 : 0.0, psStats->execMax / 1000.0);
+}
+
+
+/*******************************************************
+ * Function: checkSteady
+ *******************************************************/
+static void
+checkSteady (void)
+{
+    const uint32_t ui32Expected = TEST_RUN_MS * 1000 / TEST_PERIOD_US;
+    ControlStats sStats;
+    ControlOutput sOutput;
+
+    runLoop(false, &sStats, &sOutput);
+    printf("%u Hz control interrupt, %u us a cycle\n", (unsigned) CONTROL_RATE_HZ, (unsigned) TEST_EXEC_US);
+    printStats("steady", &sStats);
+    printf("  height %.1f%% (target %d), yaw %.1f deg (target %d), main %.3f tail %.3f\n",
+           numToFloat(sOutput.height), TEST_HEIGHT_TARGET, numToFloat(sOutput.yaw), TEST_YAW_TARGET,
+           numToFloat(sOutput.mainDuty), numToFloat(sOutput.tailDuty));
+
+    check(sStats.cycles == g_ui32Releases && sStats.cycles + 1 >= ui32Expected && sStats.cycles <= ui32Expected,
+          "one cycle every period, no drift");
+    check(sStats.overruns == 0, "no overruns");
+    check(sStats.jitterMax == 0 && sStats.jitterSum == 0, "no jitter with nothing holding it off");
+    check(sStats.execMax == TEST_EXEC_US * 1000 && sStats.execLast == TEST_EXEC_US * 1000, "execution time measured");
+    check(g_sSnapshot.cycles + 1 >= TEST_SNAPSHOT_MS * 1000 / TEST_PERIOD_US
+          && g_sSnapshot.cycles <= TEST_SNAPSHOT_MS * 1000 / TEST_PERIOD_US, "stats read part way through");
+    check(sOutput.heightAuto && sOutput.yawAuto && fabs(numToFloat(sOutput.height) - TEST_HEIGHT_TARGET) <= TEST_HEIGHT_TOL
+          && fabs(numToFloat(sOutput.yaw) - TEST_YAW_TARGET) <= TEST_YAW_TOL, "flies to the set points");
+    check(fabs(simPWMDutyGet(ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_OUTNUM) - numToFloat(sOutput.mainDuty)) <= TEST_PWM_TOL
+          && fabs(simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM) - numToFloat(sOutput.tailDuty)) <= TEST_PWM_TOL,
+          "duties out on the rotor PWMs");
+}
+
+
+/*******************************************************
+ * Function: checkHeldOff
+ *******************************************************/
+static void
+checkHeldOff (void)
+{
+    const uint32_t ui32Expected = TEST_RUN_MS * 1000 / TEST_PERIOD_US;
+    ControlStats sStats;
+    ControlOutput sOutput;
+
+    runLoop(true, &sStats, &sOutput);
+    printStats("held off, to the reset", &g_sSnapshot);
+    printStats("held off with overruns, from the reset", &sStats);
+
+    check(g_sSnapshot.cycles + sStats.cycles == g_ui32Releases && g_ui32Releases + 1 >= ui32Expected
+          && g_ui32Releases <= ui32Expected, "overruns caught up, no drift");
+    check(g_sSnapshot.jitterMax == g_ui32SnapshotLatencyMax * 1000 && g_sSnapshot.overruns == 0,
+          "jitter is exactly how long it was held off");
+    check(sStats.overruns == g_ui32Overruns && g_ui32Overruns > 0, "each overrun counted once");
+    check(sStats.jitterMax >= (TEST_OVERRUN_US - TEST_PERIOD_US) * 1000
+          && sStats.jitterMax <= (TEST_OVERRUN_US - TEST_PERIOD_US + TEST_LATENCY_US) * 1000,
+          "the release after is late by the overrun");
+    check(sStats.execMax == TEST_OVERRUN_US * 1000, "longest cycle measured");
+    check(sStats.cycles + 1 >= (TEST_RUN_MS - TEST_SNAPSHOT_MS) * 1000 / TEST_PERIOD_US
+          && sStats.cycles <= (TEST_RUN_MS - TEST_SNAPSHOT_MS) * 1000 / TEST_PERIOD_US + 1, "stats reset part way through");
+}
+
+
+/*******************************************************
+ * Function: benchStep
+ *
+ * Times the handler on the host, sensing charging no
+ * time, as a guide to its share of a period
+ *******************************************************/
+static void
+benchStep (void)
+{
+    struct timespec sStart, sEnd;
+    double dNs;
+    uint32_t i;
+
+    g_bCharge = false;
+    clock_gettime(CLOCK_MONOTONIC, &sStart);
+    for (i = 0; i < TEST_BENCH_CYCLES; i++) {
+        controlIntHandler();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &sEnd);
+
+    dNs = ((sEnd.tv_sec - sStart.tv_sec) * 1e9 + (sEnd.tv_nsec - sStart.tv_nsec)) / TEST_BENCH_CYCLES;
+    printf("  host step cost (HELI_MATH_TYPE %d): %.1f ns a cycle, %.4f%% of the period\n", HELI_MATH_TYPE, dNs,
+           dNs / (TEST_PERIOD_US * 10.0));
+}
+
+
+int
+main (void)
+{
+    simReset();
+    SysCtlClockSet(SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    initRotorPWM();
+    IntMasterEnable();
+
+    checkSteady();
+    checkHeldOff();
+    benchStep();
+
+    printf("%u failures\n", (unsigned) g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
@@ -0,0 +1,192 @@
+/*******************************************************
+ * dblBufTest.c
+ *
+ * Host test of the lock-free double buffer the control
+ * loop exchanges its set points and telemetry through
+ * (Drivers/dblBuf.c).
+ *
+ * A writer thread publishes records whose every word is
+ * the record's number, as fast as it can, while reader
+ * threads copy out the newest. On the target the writer
+ * can only interrupt a reader (or not at all), here the
+ * two really run at once, which is the harder case.
+ *
+ * Checks that
+ *   - a new buffer reads back the initial record
+ *   - every record a reader gets is whole (all its words
+ *     agree) and matches the sequence number returned
+ *   - a reader never goes back to an older record
+ *   - after the writer stops, the last record is read
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -pthread -IDrivers -o dbl_buf_test Testing/dblBufTest.c
+ *         Drivers/dblBuf.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <pthread.h>
+
+#include "dblBuf.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_WORDS          64  // Words in a record, more than a ControlTelemetry so copies are often cut short
+#define TEST_RECORDS        2000000  // Records published by the writer
+#define TEST_READERS        2
+
+
+typedef struct
+{
+    uint32_t pui32Word[TEST_WORDS];
+} testRecord_t;
+
+typedef struct
+{
+    uint32_t ui32Reads;
+    uint32_t ui32Torn;  // Records whose words disagree (must stay 0)
+    uint32_t ui32Mismatched;  // Records that are not the sequence number returned (must stay 0)
+    uint32_t ui32Backwards;  // Records older than the one before (must stay 0)
+} testReader_t;
+
+
+static dblBuf_t g_sBuffer;
+static testRecord_t g_psCopies[2];
+static volatile bool g_bWriting;
+static uint32_t g_ui32Failures;
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcName)
+{
+    printf("%-56s %s\n", pcName, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: fillRecord
+ *******************************************************/
+static void
+fillRecord (testRecord_t *psRecord, uint32_t ui32Value)
+{
+    uint32_t i;
+
+    for (i = 0; i < TEST_WORDS; i++) {
+        psRecord->pui32Word[i] = ui32Value;
+    }
+}
+
+
+/*******************************************************
+ * Function: readAndCheck
+ *
+ * Reads the newest record and checks it against the
+ * last one this reader got
+ *
+ * returns: the record's number
+ *******************************************************/
+static uint32_t
+readAndCheck (testReader_t *psReader, uint32_t ui32Last)
+{
+    testRecord_t sRecord;
+    uint32_t ui32Seq, i;
+    bool bWhole = true;
+
+    ui32Seq = readDblBuf(&g_sBuffer, &sRecord);
+    for (i = 1; i < TEST_WORDS; i++) {
+        bWhole &= (sRecord.pui32Word[i] == sRecord.pui32Word[0]);
+    }
+
+    psReader->ui32Reads++;
+    psReader->ui32Torn += !bWhole;
+    psReader->ui32Mismatched += (sRecord.pui32Word[0] != ui32Seq);
+    psReader->ui32Backwards += (ui32Seq < ui32Last);
+    return sRecord.pui32Word[0];
+}
+
+
+/*******************************************************
+ * Function: writerThread
+ *******************************************************/
+static void *
+writerThread (void *pvArg)
+{
+    testRecord_t sRecord;
+    uint32_t ui32Record;
+
+    (void) pvArg;
+    for (ui32Record = 1; ui32Record <= TEST_RECORDS; ui32Record++) {
+        fillRecord(&sRecord, ui32Record);
+        writeDblBuf(&g_sBuffer, &sRecord);
+    }
+    g_bWriting = false;
+    return NULL;
+}
+
+
+/*******************************************************
+ * Function: readerThread
+ *******************************************************/
+static void *
+readerThread (void *pvArg)
+{
+    testReader_t *psReader = (testReader_t *) pvArg;
+    uint32_t ui32Last = 0;
+
+    while (g_bWriting) {
+        ui32Last = readAndCheck(psReader, ui32Last);
+    }
+    return NULL;
+}
+
+
+int
+main (void)
+{
+    pthread_t sWriter, psReaderThreads[TEST_READERS];
+    testReader_t psReaders[TEST_READERS] = { { 0, 0, 0, 0 } };
+    testReader_t sTotal = { 0, 0, 0, 0 };
+    testRecord_t sRecord;
+    uint32_t i;
+
+    fillRecord(&sRecord, 0);
+    initDblBuf(&g_sBuffer, g_psCopies, sizeof(testRecord_t), &sRecord);
+    fillRecord(&sRecord, 0xFFFFFFFF);
+    check(readDblBuf(&g_sBuffer, &sRecord) == 0 && sRecord.pui32Word[0] == 0
+          && sRecord.pui32Word[TEST_WORDS - 1] == 0, "a new buffer reads the initial record");
+
+    g_bWriting = true;
+    for (i = 0; i < TEST_READERS; i++) {
+        pthread_create(&psReaderThreads[i], NULL, readerThread, &psReaders[i]);
+    }
+    pthread_create(&sWriter, NULL, writerThread, NULL);
+
+    pthread_join(sWriter, NULL);
+    for (i = 0; i < TEST_READERS; i++) {
+        pthread_join(psReaderThreads[i], NULL);
+        sTotal.ui32Reads += psReaders[i].ui32Reads;
+        sTotal.ui32Torn += psReaders[i].ui32Torn;
+        sTotal.ui32Mismatched += psReaders[i].ui32Mismatched;
+        sTotal.ui32Backwards += psReaders[i].ui32Backwards;
+    }
+    printf("  %u records written, %u read by %u readers\n", TEST_RECORDS, sTotal.ui32Reads, TEST_READERS);
+
+    check(sTotal.ui32Reads > 0, "readers ran while the writer did");
+    check(sTotal.ui32Torn == 0, "no record read part written");
+    check(sTotal.ui32Mismatched == 0, "records match their sequence number");
+    check(sTotal.ui32Backwards == 0, "readers never go back to an older record");
+    check(readAndCheck(&sTotal, 0) == TEST_RECORDS && sTotal.ui32Torn == 0, "the last record is read after");
+
+    printf("%u failures\n", g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
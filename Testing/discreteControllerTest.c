@@ -0,0 +1,365 @@
+/*******************************************************
+ * discreteControllerTest.c
+ *
+ * Host test and benchmark of the compile time discretised
+ * controllers in discrete_controller.h, against stepPID()
+ * in PI_controller.c.
+ *
+ * Checks that
+ *   - a PI holding a constant error follows the continuous
+ *     kp e + ki e t to within rounding, even for an error
+ *     whose integral gains less than an LSB a step (the
+ *     remainder is carried in fixed point)
+ *   - it gives stepPID()'s output, to within the half step
+ *     of integral the two integration rules differ by
+ *   - a lead-lag has gain k at DC and k wp / wz at the
+ *     Nyquist frequency, as the Tustin transform keeps
+ *   - a PID with a filtered derivative kicks by kd / tf on
+ *     an error step, which dies away to kp + ki t
+ *   - an integrator does not wind up against the output
+ *     limit
+ *   - flying the simulated HeliRig plant's height
+ *     (Simulation/heli_plant.c) with the control_task.h
+ *     gains flies a set point step as stepPID() does
+ * Then times a step of each against stepPID().
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -ISimulation -I"HeliRig Project" -o discrete_controller_test
+ *         Testing/discreteControllerTest.c "HeliRig Project"/PI_controller.c Simulation/heli_plant.c
+ *         Simulation/sim_peripherals.c -lm
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#include "heli_plant.h"
+#include "heli_math.h"
+#include "PI_controller.h"
+#include "discrete_controller.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define PLANT_DT_S          0.001f  // Plant integration step
+#define CONTROL_DIVIDER     5  // Control runs every 5 plant steps (CONTROL_RATE_HZ, 200 Hz)
+#define STEP_TO             52.0f  // Height set point step, from 50%
+#define FLIGHT_TOL          0.1f  // Heights the same to within 5% of the step, %
+#define HOVER_STEPS         6000  // Hovered for, 30 s, long enough for both to settle to the same state
+#define MANOEUVRE_STEPS     3000  // Flown for, 15 s, from the set point change
+#define STEPS               2000  // Steps the responses are checked over (10 s)
+#define TOL                 0.0002f  // Outputs to within this, a few Q16.16 LSBs
+#define BENCH_STEPS         10000000  // Steps timed
+
+// control_task.h
+#define HEIGHT_KP           0.04
+#define HEIGHT_KI           0.01
+#define HEIGHT_FF_HOVER     0.45f
+#define DUTY_MIN            0.02
+#define DUTY_MAX            0.98
+#define CONTROL_DT          0.005
+
+// A PID and a lead-lag to check the others against
+#define TEST_KP             0.5
+#define TEST_KI             0.2
+#define TEST_KD             0.05
+#define TEST_TF             0.02  // Derivative filter, s
+#define TEST_K              2.0
+#define TEST_WZ             5.0  // Lead zero and pole, rad/s
+#define TEST_WP             50.0
+#define TEST_LIMIT          100.0  // Well out of the way
+
+
+static uint32_t g_ui32Failures;
+static volatile num_t g_xSink;  // Benchmarked outputs go here, so the steps are not optimised out
+
+static const DiscreteCoeffs g_sHeightPI = DISCRETE_PI(HEIGHT_KP, HEIGHT_KI, CONTROL_DT, DUTY_MAX, DUTY_MIN);
+static const DiscreteCoeffs g_sHoverPI = DISCRETE_PI(HEIGHT_KP, HEIGHT_KI, CONTROL_DT, DUTY_MAX - HEIGHT_FF_HOVER,
+                                                     DUTY_MIN - HEIGHT_FF_HOVER);  // The hover duty added after
+static const DiscreteCoeffs g_sTestPI = DISCRETE_PI(HEIGHT_KP, HEIGHT_KI, CONTROL_DT, TEST_LIMIT, -TEST_LIMIT);
+static const DiscreteCoeffs g_sTestPID = DISCRETE_PID(TEST_KP, TEST_KI, TEST_KD, TEST_TF, CONTROL_DT, TEST_LIMIT,
+                                                      -TEST_LIMIT);
+static const DiscreteCoeffs g_sTestLead = DISCRETE_LEAD_LAG(TEST_K, TEST_WZ, TEST_WP, CONTROL_DT, TEST_LIMIT,
+                                                            -TEST_LIMIT);
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: checkPI
+ *
+ * A constant error, large and then smaller than an LSB
+ * of integral a step
+ *******************************************************/
+static void
+checkPI (void)
+{
+    static const float pfErrors[2] = { 2.0f, 0.01f };  // 0.01 * ki * dt is 5e-7 a step, Q16.16 is 1.5e-5
+    DiscreteController sPI;
+    float fExpected, fWorst = 0.0f;
+    num_t xOutput = 0;
+    uint32_t i, n;
+
+    for (i = 0; i < 2; i++) {
+        initDiscrete(&sPI, &g_sTestPI);
+        for (n = 0; n < STEPS; n++) {
+            xOutput = stepDiscrete(&sPI, numFromFloat(pfErrors[i]), 0);
+            fExpected = pfErrors[i] * (HEIGHT_KP + HEIGHT_KI * CONTROL_DT * (n + 0.5f));  // Tustin, the mid point
+            fWorst = fmaxf(fWorst, fabsf(numToFloat(xOutput) - fExpected));
+        }
+        printf("  PI, error %.2f: %.6f after %u steps, %.6f continuous\n", pfErrors[i], numToFloat(xOutput),
+               STEPS, pfErrors[i] * (HEIGHT_KP + HEIGHT_KI * CONTROL_DT * STEPS));
+    }
+    check(fWorst <= TOL, "PI follows kp e + ki e t, however small the error");
+}
+
+
+/*******************************************************
+ * Function: checkAgainstPID
+ *
+ * The same error sequence through both, a sine and steps
+ *******************************************************/
+static void
+checkAgainstPID (void)
+{
+    DiscreteController sPI;
+    PIDController sPID;
+    float fError, fWorst = 0.0f, fBound = 0.0f;
+    uint32_t n;
+
+    initDiscrete(&sPI, &g_sTestPI);
+    initPID(&sPID, NUM_CONST(CONTROL_DT), NUM_CONST(TEST_LIMIT), NUM_CONST(-TEST_LIMIT), NUM_CONST(HEIGHT_KP),
+            NUM_CONST(HEIGHT_KI), 0);
+    for (n = 0; n < STEPS; n++) {
+        fError = 5.0f * sinf(n * 0.01f) + ((n / 300) % 2 ? 3.0f : -1.0f);
+        fWorst = fmaxf(fWorst, fabsf(numToFloat(stepDiscrete(&sPI, numFromFloat(fError), 0))
+                                     - numToFloat(stepPID(&sPID, numFromFloat(fError), 0))));
+        fBound = fmaxf(fBound, fabsf(fError) * HEIGHT_KI * CONTROL_DT * 0.5f);  // Trapezium against rectangle
+    }
+    printf("  PI against stepPID: at most %.6f apart (half a step of integral %.6f)\n", fWorst, fBound);
+    check(fWorst <= fBound + TOL, "PI gives stepPID's output");
+}
+
+
+/*******************************************************
+ * Function: checkLeadLag
+ *******************************************************/
+static void
+checkLeadLag (void)
+{
+    DiscreteController sLead;
+    float fDC, fNyquist;
+    uint32_t n;
+
+    initDiscrete(&sLead, &g_sTestLead);
+    for (n = 0; n < STEPS; n++) {
+        fDC = numToFloat(stepDiscrete(&sLead, NUM_ONE, 0));
+    }
+    initDiscrete(&sLead, &g_sTestLead);
+    for (n = 0; n < STEPS; n++) {
+        fNyquist = numToFloat(stepDiscrete(&sLead, (n % 2) ? NUM_ONE : -NUM_ONE, 0));
+    }
+    printf("  lead-lag: DC gain %.4f (%.4f), Nyquist gain %.4f (%.4f)\n", fDC, TEST_K, fabsf(fNyquist),
+           TEST_K * TEST_WP / TEST_WZ);
+    check(fabs(fDC - TEST_K) <= TOL && fabs(fabsf(fNyquist) - TEST_K * TEST_WP / TEST_WZ) <= 0.01f,
+          "lead-lag gains at DC and Nyquist");
+}
+
+
+/*******************************************************
+ * Function: checkPIDStep
+ *******************************************************/
+static void
+checkPIDStep (void)
+{
+    const float fKick = TEST_KP + TEST_KI * CONTROL_DT / 2 + 2 * TEST_KD / (2 * TEST_TF + CONTROL_DT);  // b0
+    DiscreteController sPID;
+    float fFirst = 0.0f, fOutput = 0.0f;
+    uint32_t n;
+
+    initDiscrete(&sPID, &g_sTestPID);
+    for (n = 0; n < STEPS; n++) {
+        fOutput = numToFloat(stepDiscrete(&sPID, NUM_ONE, 0));
+        fFirst = (n == 0) ? fOutput : fFirst;
+    }
+    printf("  PID: kick %.4f (kd / tf %.4f), %.4f after %u steps (kp + ki t %.4f)\n", fFirst, TEST_KD / TEST_TF,
+           fOutput, STEPS, TEST_KP + TEST_KI * CONTROL_DT * STEPS);
+    check(fabsf(fFirst - fKick) <= TOL && fFirst > TEST_KP + 0.8f * TEST_KD / TEST_TF
+          && fabs(fOutput - (TEST_KP + TEST_KI * CONTROL_DT * (STEPS - 0.5f))) <= 0.001f,
+          "PID derivative kicks and dies away to the PI");
+}
+
+
+/*******************************************************
+ * Function: checkWindup
+ *
+ * Held at the limit, then the error reverses
+ *******************************************************/
+static void
+checkWindup (void)
+{
+    DiscreteController sPI;
+    num_t xOutput;
+    uint32_t n;
+
+    initDiscrete(&sPI, &g_sHeightPI);
+    for (n = 0; n < STEPS; n++) {
+        (void) stepDiscrete(&sPI, NUM_CONST(50.0), 0);  // Would be 50 * (0.04 + 0.01 t) unclamped
+    }
+    xOutput = stepDiscrete(&sPI, NUM_CONST(-1.0), 0);
+    check(xOutput < g_sHeightPI.max - NUM_CONST(0.05), "leaves the limit as soon as the error reverses");
+}
+
+
+/*******************************************************
+ * Function: flyHeight
+ *
+ * Hovers at 50%, then steps to STEP_TO, small enough to
+ * keep off the output limits, where the two differ, with a
+ * discrete PI or stepPID and the hover duty fed forward
+ *
+ * bDiscrete: fly with the discrete PI
+ * pfHeights: filled with the height each control step
+ *            after the set point change, %
+ *******************************************************/
+static void
+flyHeight (bool bDiscrete, float *pfHeights)
+{
+    heliPlant_t sPlant;
+    DiscreteController sPI;
+    PIDController sPID;
+    float fHeight, fMain;
+    num_t xSet;
+    uint32_t i, k;
+
+    initHeliPlant(&sPlant);
+    initDiscrete(&sPI, &g_sHoverPI);
+    initPID(&sPID, NUM_CONST(CONTROL_DT), NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN), NUM_CONST(HEIGHT_KP),
+            NUM_CONST(HEIGHT_KI), 0);
+    setPIDFeedForward(&sPID, NUM_CONST(HEIGHT_FF_HOVER));
+
+    for (k = 0; k < HOVER_STEPS + MANOEUVRE_STEPS; k++) {
+        xSet = (k < HOVER_STEPS) ? NUM_CONST(50.0) : NUM_CONST(STEP_TO);
+        fHeight = 242.0f - 0.081f * (float) heliPlantADCCounts(&sPlant);
+        if (bDiscrete) {
+            fMain = HEIGHT_FF_HOVER + numToFloat(stepDiscrete(&sPI, xSet, numFromFloat(fHeight)));
+        } else {
+            fMain = numToFloat(stepPID(&sPID, xSet, numFromFloat(fHeight)));
+        }
+        for (i = 0; i < CONTROL_DIVIDER; i++) {
+            heliPlantStep(&sPlant, PLANT_DT_S, fMain, 0.0f);
+        }
+        if (k >= HOVER_STEPS) {
+            pfHeights[k - HOVER_STEPS] = sPlant.fHeight * 100.0f;
+        }
+    }
+}
+
+
+/*******************************************************
+ * Function: nsSince
+ *******************************************************/
+static double
+nsSince (const struct timespec *psStart)
+{
+    struct timespec sEnd;
+
+    clock_gettime(CLOCK_MONOTONIC, &sEnd);
+    return ((sEnd.tv_sec - psStart->tv_sec) * 1e9 + (sEnd.tv_nsec - psStart->tv_nsec)) / BENCH_STEPS;
+}
+
+
+/*******************************************************
+ * Function: benchmark
+ *
+ * Times a step of each, on a varying present value so
+ * nothing is worked out once
+ *******************************************************/
+static void
+benchmark (void)
+{
+    DiscreteController sDiscrete;
+    PIDController sPID;
+    struct timespec sStart;
+    double dPI, dPID, dDiscretePI, dDiscretePID;
+    uint32_t n;
+
+    initPID(&sPID, NUM_CONST(CONTROL_DT), NUM_CONST(TEST_LIMIT), NUM_CONST(-TEST_LIMIT), NUM_CONST(HEIGHT_KP),
+            NUM_CONST(HEIGHT_KI), 0);
+    clock_gettime(CLOCK_MONOTONIC, &sStart);
+    for (n = 0; n < BENCH_STEPS; n++) {
+        g_xSink = stepPID(&sPID, 0, (num_t) (n & 0xFF));
+    }
+    dPI = nsSince(&sStart);
+
+    initPID(&sPID, NUM_CONST(CONTROL_DT), NUM_CONST(TEST_LIMIT), NUM_CONST(-TEST_LIMIT), NUM_CONST(TEST_KP),
+            NUM_CONST(TEST_KI), NUM_CONST(TEST_KD));
+    clock_gettime(CLOCK_MONOTONIC, &sStart);
+    for (n = 0; n < BENCH_STEPS; n++) {
+        g_xSink = stepPID(&sPID, 0, (num_t) (n & 0xFF));
+    }
+    dPID = nsSince(&sStart);
+
+    initDiscrete(&sDiscrete, &g_sTestPI);
+    clock_gettime(CLOCK_MONOTONIC, &sStart);
+    for (n = 0; n < BENCH_STEPS; n++) {
+        g_xSink = stepDiscrete(&sDiscrete, 0, (num_t) (n & 0xFF));
+    }
+    dDiscretePI = nsSince(&sStart);
+
+    initDiscrete(&sDiscrete, &g_sTestPID);
+    clock_gettime(CLOCK_MONOTONIC, &sStart);
+    for (n = 0; n < BENCH_STEPS; n++) {
+        g_xSink = stepDiscrete(&sDiscrete, 0, (num_t) (n & 0xFF));
+    }
+    dDiscretePID = nsSince(&sStart);
+
+    printf("  host step cost (HELI_MATH_TYPE %d): PI %.2f ns, stepPID %.2f ns; PID %.2f ns, stepPID %.2f ns\n",
+           HELI_MATH_TYPE, dDiscretePI, dPI, dDiscretePID, dPID);
+}
+
+
+int
+main (void)
+{
+    static float pfDiscrete[MANOEUVRE_STEPS], pfPID[MANOEUVRE_STEPS];
+    float fWorst = 0.0f, fPeak = 0.0f;
+    uint32_t k;
+
+    printf("Discrete controllers (" NUM_NAME ")\n");
+    checkPI();
+    checkAgainstPID();
+    checkLeadLag();
+    checkPIDStep();
+    checkWindup();
+
+    flyHeight(true, pfDiscrete);
+    flyHeight(false, pfPID);
+    for (k = 0; k < MANOEUVRE_STEPS; k++) {
+        fWorst = fmaxf(fWorst, fabsf(pfDiscrete[k] - pfPID[k]));
+        fPeak = fmaxf(fPeak, pfDiscrete[k]);
+    }
+    printf("  height 50 -> %.0f%%: peaks at %.3f%%, at most %.3f%% from stepPID's flight\n", STEP_TO, fPeak,
+           fWorst);
+    check(fWorst <= FLIGHT_TOL, "flies the height as stepPID does");
+
+    benchmark();
+
+    printf("%u failures\n", g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
@@ -0,0 +1,178 @@
+/*******************************************************
+ * filterBench.c
+ *
+ * Host benchmark of the filter library (Drivers/filter.c).
+ * Reports samples per second through each filter type on
+ * its own, through the height pipeline used with
+ * HEIGHT_FILTER, and through the spscBuf moving average it
+ * replaces. The pipeline runs at 2560 samples per second
+ * on the target.
+ *
+ * The FIR on the host uses the plain C form of SMLAD, so
+ * it shows the relative cost of the stages rather than the
+ * target speed. Built for the Cortex-M4 (print through the
+ * CCS console) the FIR takes two taps per SMLAD.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -IDrivers -o filter_bench Testing/filterBench.c
+ *         Drivers/filter.c Drivers/spscBuf.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "filter.h"
+#include "spscBuf.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define BENCH_SAMPLES       20000000
+#define BENCH_INPUTS        4096  // Distinct samples cycled through
+#define AVERAGE_SIZE        64
+
+// Height pipeline, as initHeightFilter() in get_height_task.c
+#define HEIGHT_MEDIAN_SIZE      5
+#define HEIGHT_FIR_TAPS         32
+#define HEIGHT_BIQUAD_SECTIONS  1
+
+static const int16_t g_pi16HeightFirCoeffs[HEIGHT_FIR_TAPS] = {
+      85,  105,  151,  227,  335,  475,  643,  836, 1045, 1262, 1475, 1675, 1850, 1990, 2089, 2141,
+    2141, 2089, 1990, 1850, 1675, 1475, 1262, 1045,  836,  643,  475,  335,  227,  151,  105,   85
+};
+
+static const biquadCoeffs_t g_psHeightBiquadCoeffs[HEIGHT_BIQUAD_SECTIONS] = {
+    { 5.820761342e-04f, 1.164152268e-03f, 5.820761342e-04f, -1.930606427e+00f, 9.329347318e-01f }
+};
+
+
+static int32_t g_pi32Inputs[BENCH_INPUTS];
+static volatile uint32_t g_pui32AverageData[AVERAGE_SIZE];
+
+
+/*******************************************************
+ * Function: secondsSince
+ *******************************************************/
+static double
+secondsSince (clock_t sStart)
+{
+    return (double) (clock() - sStart) / CLOCKS_PER_SEC;
+}
+
+
+/*******************************************************
+ * Function: benchStep
+ *
+ * Times BENCH_SAMPLES samples through one step function
+ *
+ * returns: the run time in seconds
+ *******************************************************/
+static double
+benchStep (filterStep_t pfnStep, void *pvFilter)
+{
+    volatile int32_t i32Sink = 0;
+    int32_t i32Out = 0;
+    uint32_t i;
+    clock_t sStart = clock();
+
+    for (i = 0; i < BENCH_SAMPLES; i++) {
+        i32Out += pfnStep(pvFilter, g_pi32Inputs[i % BENCH_INPUTS]);
+    }
+    i32Sink = i32Out;
+    (void) i32Sink;
+
+    return secondsSince(sStart);
+}
+
+
+/*******************************************************
+ * Function: stepChain
+ *
+ * filterStep_t form of stepFilterChain()
+ *******************************************************/
+static int32_t
+stepChain (void *pvChain, int32_t i32Sample)
+{
+    return stepFilterChain((filterChain_t *) pvChain, i32Sample);
+}
+
+
+/*******************************************************
+ * Function: stepAverage
+ *
+ * The moving average of getHeightTask without
+ * HEIGHT_FILTER, worked out for every sample
+ *******************************************************/
+static int32_t
+stepAverage (void *pvBuffer, int32_t i32Sample)
+{
+    spscBuf_t *psBuffer = (spscBuf_t *) pvBuffer;
+    uint32_t ui32Sum, ui32Count;
+
+    writeSpscBuf(psBuffer, (uint32_t) i32Sample);
+    ui32Sum = sumSpscBuf(psBuffer, &ui32Count);
+    return (int32_t) ((2 * ui32Sum + ui32Count) / 2 / ui32Count);
+}
+
+
+/*******************************************************
+ * Function: report
+ *******************************************************/
+static void
+report (const char *pcName, double dSeconds)
+{
+    printf("%-30s %8.2f M samples/s  %6.1f ns/sample\n", pcName, BENCH_SAMPLES / dSeconds / 1e6,
+           dSeconds * 1e9 / BENCH_SAMPLES);
+}
+
+
+int
+main (void)
+{
+    medianFilter_t sMedian;
+    int32_t pi32MedianHistory[HEIGHT_MEDIAN_SIZE], pi32MedianSorted[HEIGHT_MEDIAN_SIZE];
+    firFilter_t sFir;
+    int16_t pi16FirHistory[2 * HEIGHT_FIR_TAPS];
+    biquadFilter_t sBiquad;
+    float pfBiquadState[2 * HEIGHT_BIQUAD_SECTIONS];
+    filterChain_t sChain;
+    spscBuf_t sAverage;
+    uint32_t ui32Seed = 1, i;
+
+    // A noisy 12 bit signal around mid scale
+    for (i = 0; i < BENCH_INPUTS; i++) {
+        ui32Seed = ui32Seed * 1664525u + 1013904223u;
+        g_pi32Inputs[i] = 2000 + (int32_t) ((ui32Seed >> 20) % 200) - 100;
+    }
+
+    printf("%u samples per filter\n", BENCH_SAMPLES);
+
+    initMedianFilter(&sMedian, pi32MedianHistory, pi32MedianSorted, HEIGHT_MEDIAN_SIZE);
+    report("median, 5 samples", benchStep(stepMedianFilter, &sMedian));
+
+    initFirFilter(&sFir, g_pi16HeightFirCoeffs, pi16FirHistory, HEIGHT_FIR_TAPS);
+    report("FIR, 32 taps", benchStep(stepFirFilter, &sFir));
+
+    initBiquadFilter(&sBiquad, g_psHeightBiquadCoeffs, pfBiquadState, HEIGHT_BIQUAD_SECTIONS);
+    report("biquad, 1 section", benchStep(stepBiquadFilter, &sBiquad));
+
+    initMedianFilter(&sMedian, pi32MedianHistory, pi32MedianSorted, HEIGHT_MEDIAN_SIZE);
+    initFirFilter(&sFir, g_pi16HeightFirCoeffs, pi16FirHistory, HEIGHT_FIR_TAPS);
+    initBiquadFilter(&sBiquad, g_psHeightBiquadCoeffs, pfBiquadState, HEIGHT_BIQUAD_SECTIONS);
+    initFilterChain(&sChain);
+    addFilterChain(&sChain, stepMedianFilter, &sMedian);
+    addFilterChain(&sChain, stepFirFilter, &sFir);
+    addFilterChain(&sChain, stepBiquadFilter, &sBiquad);
+    report("height pipeline", benchStep(stepChain, &sChain));
+
+    initSpscBuf(&sAverage, g_pui32AverageData, AVERAGE_SIZE);
+    report("moving average, 64 (spscBuf)", benchStep(stepAverage, &sAverage));
+
+    return 0;
+}
@@ -0,0 +1,471 @@
+/*******************************************************
+ * filterTest.c
+ *
+ * Host test of the filter library (Drivers/filter.c) and
+ * of the height pipeline built from it with HEIGHT_FILTER.
+ *
+ * Each filter is checked against a plain reference over
+ * random 12 bit samples: the FIR (odd and even tap counts,
+ * through the SMLAD pairing) must match an exact integer
+ * convolution, the running median a full sort of the
+ * window, and the biquad cascade a double precision version
+ * to within one count.
+ *
+ * The pipeline is then run over noisy height traces made
+ * from the ADC to height mapping of the firmware: a set of
+ * height steps through a second order plant, plus sensor
+ * noise, ripple at the PWM frequency and occasional single
+ * sample spikes. The height it reports every 25 ms is
+ * compared with the clean height, alongside the 64 sample
+ * moving average used without HEIGHT_FILTER.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -I"HeliRig Project" -IDrivers -o filter_test Testing/filterTest.c
+ *         Drivers/filter.c -lm
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "filter.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_SAMPLES        200000  // Per reference check
+#define TEST_MAX_TAPS       33
+#define TEST_MAX_MEDIAN     15
+#define ADC_MASK            0x0FFF  // 12 bit ADC samples
+
+// Height traces, as get_height_task.h
+#define SAMPLE_RATE_HZ      2560
+#define SAMPLES_PER_DISPLAY 64  // One 25 ms display period
+#define AVERAGE_SIZE        64  // BUF_SIZE without HEIGHT_FILTER
+#define HEIGHT_MAP_SLOPE    -0.081
+#define HEIGHT_MAP_OFFSET   242.0
+#define TRACE_SECONDS       8
+#define TRACE_SAMPLES       (TRACE_SECONDS * SAMPLE_RATE_HZ)
+#define PLANT_HZ            1.5  // Natural frequency and damping of the height response
+#define PLANT_DAMPING       0.7
+#define PWM_HZ              250.0
+#define SETTLE_SECONDS      1.5  // Time allowed after each step before the steady state check
+
+// Height pipeline, as initHeightFilter() in get_height_task.c
+#define HEIGHT_MEDIAN_SIZE      5
+#define HEIGHT_FIR_TAPS         32
+#define HEIGHT_BIQUAD_SECTIONS  1
+
+static const int16_t g_pi16HeightFirCoeffs[HEIGHT_FIR_TAPS] = {
+      85,  105,  151,  227,  335,  475,  643,  836, 1045, 1262, 1475, 1675, 1850, 1990, 2089, 2141,
+    2141, 2089, 1990, 1850, 1675, 1475, 1262, 1045,  836,  643,  475,  335,  227,  151,  105,   85
+};
+
+static const biquadCoeffs_t g_psHeightBiquadCoeffs[HEIGHT_BIQUAD_SECTIONS] = {
+    { 5.820761342e-04f, 1.164152268e-03f, 5.820761342e-04f, -1.930606427e+00f, 9.329347318e-01f }
+};
+
+// Noise on each trace, in ADC counts
+typedef struct
+{
+    const char *pcName;
+    double dNoise;  // Standard deviation of the sensor noise
+    double dRipple;  // Amplitude of the PWM ripple
+    uint32_t ui32SpikeEvery;  // Mean samples between spikes, 0 for none
+    double dSpike;  // Spike size
+    double dMaxRMS;  // Largest steady state RMS height error allowed from the pipeline (%)
+} testTrace_t;
+
+static const testTrace_t g_psTraces[] = {
+    { "sensor noise",           12.0,  0.0,    0,   0.0, 0.3 },
+    { "noise + PWM ripple",     12.0, 40.0,    0,   0.0, 0.3 },
+    { "noise, ripple + spikes", 12.0, 40.0,  200, 600.0, 0.3 },
+};
+
+// Height steps (%) and when they are made (s)
+static const double g_pdSteps[][2] = {
+    { 0.0, 10.0 }, { 1.0, 50.0 }, { 3.0, 90.0 }, { 5.0, 30.0 }, { 6.5, 60.0 },
+};
+#define TEST_STEPS          (sizeof(g_pdSteps) / sizeof(g_pdSteps[0]))
+
+
+static uint32_t g_ui32Failures;
+static int32_t g_pi32CleanTrace[TRACE_SAMPLES];  // ADC counts x 16, so the reference keeps sub-count detail
+static int32_t g_pi32NoisyTrace[TRACE_SAMPLES];
+
+
+/*******************************************************
+ * Function: nextRandom
+ *******************************************************/
+static uint32_t
+nextRandom (uint32_t *pui32Seed)
+{
+    *pui32Seed ^= *pui32Seed << 13;
+    *pui32Seed ^= *pui32Seed >> 17;
+    *pui32Seed ^= *pui32Seed << 5;
+    return *pui32Seed;
+}
+
+
+/*******************************************************
+ * Function: nextGaussian
+ *
+ * returns: a normally distributed value, mean 0 and
+ *          standard deviation 1 (Box-Muller)
+ *******************************************************/
+static double
+nextGaussian (uint32_t *pui32Seed)
+{
+    double dU1 = (nextRandom(pui32Seed) + 1.0) / 4294967296.0;
+    double dU2 = nextRandom(pui32Seed) / 4294967296.0;
+
+    return sqrt(-2.0 * log(dU1)) * cos(2.0 * M_PI * dU2);
+}
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-68s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: checkFir
+ *
+ * returns: the number of outputs that differ from an exact
+ *          convolution over a window primed with the first
+ *          sample
+ *******************************************************/
+static uint32_t
+checkFir (uint32_t ui32Taps, uint32_t ui32Seed)
+{
+    int16_t pi16Coeffs[TEST_MAX_TAPS];
+    int16_t pi16History[2 * TEST_MAX_TAPS];
+    int32_t pi32Window[TEST_MAX_TAPS];  // Newest first
+    firFilter_t sFir;
+    int64_t i64Acc;
+    int32_t i32Sample, i32Expected;
+    uint32_t ui32Errors = 0, i, k;
+
+    // Random coefficients of either sign, at most 8.0 in total so the accumulator is in range
+    for (k = 0; k < ui32Taps; k++) {
+        pi16Coeffs[k] = (int16_t) ((int32_t) (nextRandom(&ui32Seed) % (2 * 8 * 32768 / ui32Taps)) - 8 * 32768 / ui32Taps);
+    }
+    initFirFilter(&sFir, pi16Coeffs, pi16History, ui32Taps);
+
+    for (i = 0; i < TEST_SAMPLES; i++) {
+        i32Sample = nextRandom(&ui32Seed) & ADC_MASK;
+        if (i == 0) {
+            for (k = 0; k < ui32Taps; k++) {
+                pi32Window[k] = i32Sample;
+            }
+        }
+        for (k = ui32Taps - 1; k > 0; k--) {
+            pi32Window[k] = pi32Window[k - 1];
+        }
+        pi32Window[0] = i32Sample;
+
+        i64Acc = 0;
+        for (k = 0; k < ui32Taps; k++) {
+            i64Acc += (int64_t) pi16Coeffs[k] * pi32Window[k];
+        }
+        i32Expected = (int32_t) ((i64Acc + (1 << (FIR_FRAC_BITS - 1))) >> FIR_FRAC_BITS);
+
+        ui32Errors += (stepFirFilter(&sFir, i32Sample) != i32Expected);
+    }
+
+    return ui32Errors;
+}
+
+
+/*******************************************************
+ * Function: compareInt32
+ *******************************************************/
+static int
+compareInt32 (const void *pvA, const void *pvB)
+{
+    int32_t i32A = *(const int32_t *) pvA, i32B = *(const int32_t *) pvB;
+
+    return (i32A > i32B) - (i32A < i32B);
+}
+
+
+/*******************************************************
+ * Function: checkMedian
+ *
+ * Samples are drawn from a small range so the window
+ * often holds repeated values
+ *
+ * returns: the number of outputs that differ from sorting
+ *          the window
+ *******************************************************/
+static uint32_t
+checkMedian (uint32_t ui32Size, uint32_t ui32Range, uint32_t ui32Seed)
+{
+    int32_t pi32History[TEST_MAX_MEDIAN], pi32Sorted[TEST_MAX_MEDIAN];
+    int32_t pi32Window[TEST_MAX_MEDIAN], pi32Copy[TEST_MAX_MEDIAN];
+    medianFilter_t sMedian;
+    int32_t i32Sample;
+    uint32_t ui32Errors = 0, i, k;
+
+    initMedianFilter(&sMedian, pi32History, pi32Sorted, ui32Size);
+
+    for (i = 0; i < TEST_SAMPLES; i++) {
+        i32Sample = (int32_t) (nextRandom(&ui32Seed) % ui32Range) - (int32_t) ui32Range / 2;
+        if (i == 0) {
+            for (k = 0; k < ui32Size; k++) {
+                pi32Window[k] = i32Sample;
+            }
+        }
+        pi32Window[i % ui32Size] = i32Sample;
+        for (k = 0; k < ui32Size; k++) {
+            pi32Copy[k] = pi32Window[k];
+        }
+        qsort(pi32Copy, ui32Size, sizeof(int32_t), compareInt32);
+
+        ui32Errors += (stepMedianFilter(&sMedian, i32Sample) != pi32Copy[ui32Size / 2]);
+    }
+
+    return ui32Errors;
+}
+
+
+/*******************************************************
+ * Function: checkBiquad
+ *
+ * returns: the largest difference, in counts, from a
+ *          double precision cascade primed the same way
+ *******************************************************/
+static double
+checkBiquad (const biquadCoeffs_t *psCoeffs, uint32_t ui32Sections, uint32_t ui32Seed)
+{
+    float pfState[2 * 4];
+    double pdState[2 * 4];
+    biquadFilter_t sBiquad;
+    const biquadCoeffs_t *c;
+    double dX, dY, dError = 0.0;
+    int32_t i32Sample;
+    uint32_t i, s;
+
+    initBiquadFilter(&sBiquad, psCoeffs, pfState, ui32Sections);
+
+    for (i = 0; i < TEST_SAMPLES; i++) {
+        // A slow random walk, as a height signal, so the low-pass outputs are not all near the mean
+        i32Sample = (i == 0) ? 2000 : i32Sample + (int32_t) (nextRandom(&ui32Seed) % 41) - 20;
+        i32Sample = (i32Sample < 0) ? 0 : (i32Sample > ADC_MASK) ? ADC_MASK : i32Sample;
+
+        dX = i32Sample;
+        for (s = 0, c = psCoeffs; s < ui32Sections; s++, c++) {
+            if (i == 0) {
+                dY = dX * ((double) c->b0 + c->b1 + c->b2) / (1.0 + c->a1 + c->a2);
+                pdState[2 * s] = dY - c->b0 * dX;
+                pdState[2 * s + 1] = c->b2 * dX - c->a2 * dY;
+            }
+            dY = c->b0 * dX + pdState[2 * s];
+            pdState[2 * s] = c->b1 * dX - c->a1 * dY + pdState[2 * s + 1];
+            pdState[2 * s + 1] = c->b2 * dX - c->a2 * dY;
+            dX = dY;
+        }
+
+        dError = fmax(dError, fabs(stepBiquadFilter(&sBiquad, i32Sample) - dX));
+    }
+
+    return dError;
+}
+
+
+/*******************************************************
+ * Function: makeTrace
+ *
+ * Fills the clean and noisy traces with the height steps
+ * through the plant, as ADC counts
+ *******************************************************/
+static void
+makeTrace (const testTrace_t *psTrace, uint32_t ui32Seed)
+{
+    double dT = 1.0 / SAMPLE_RATE_HZ;
+    double dWn = 2.0 * M_PI * PLANT_HZ;
+    double dHeight = g_pdSteps[0][1], dRate = 0.0, dTarget = dHeight;
+    double dCounts, dNoisy;
+    uint32_t i, ui32Step = 0;
+
+    for (i = 0; i < TRACE_SAMPLES; i++) {
+        if (ui32Step < TEST_STEPS && i * dT >= g_pdSteps[ui32Step][0]) {
+            dTarget = g_pdSteps[ui32Step++][1];
+        }
+        dRate += (dWn * dWn * (dTarget - dHeight) - 2.0 * PLANT_DAMPING * dWn * dRate) * dT;
+        dHeight += dRate * dT;
+
+        dCounts = (dHeight - HEIGHT_MAP_OFFSET) / HEIGHT_MAP_SLOPE;
+        dNoisy = dCounts + psTrace->dNoise * nextGaussian(&ui32Seed)
+                 + psTrace->dRipple * sin(2.0 * M_PI * PWM_HZ * i * dT);
+        if (psTrace->ui32SpikeEvery != 0 && nextRandom(&ui32Seed) % psTrace->ui32SpikeEvery == 0) {
+            dNoisy += (nextRandom(&ui32Seed) & 1) ? psTrace->dSpike : -psTrace->dSpike;
+        }
+
+        g_pi32CleanTrace[i] = (int32_t) lround(dCounts * 16.0);
+        g_pi32NoisyTrace[i] = (int32_t) lround(fmin(fmax(dNoisy, 0.0), ADC_MASK));
+    }
+}
+
+
+/*******************************************************
+ * Function: isSettled
+ *
+ * returns: true if sample i is at least SETTLE_SECONDS
+ *          after the last height step
+ *******************************************************/
+static bool
+isSettled (uint32_t i)
+{
+    double dTime = (double) i / SAMPLE_RATE_HZ;
+    uint32_t s;
+
+    for (s = 0; s < TEST_STEPS; s++) {
+        if (dTime >= g_pdSteps[s][0] && dTime < g_pdSteps[s][0] + SETTLE_SECONDS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/*******************************************************
+ * Function: runTrace
+ *
+ * Runs the height pipeline and the moving average over one
+ * trace, sampling both every display period as
+ * getHeightTask does, and compares them with the clean
+ * height: RMS error once settled, largest error once
+ * settled, and the lag at the half way (30%) crossing of the
+ * 10 -> 50% step
+ *******************************************************/
+static void
+runTrace (const testTrace_t *psTrace, uint32_t ui32Seed)
+{
+    medianFilter_t sMedian;
+    int32_t pi32MedianHistory[HEIGHT_MEDIAN_SIZE], pi32MedianSorted[HEIGHT_MEDIAN_SIZE];
+    firFilter_t sFir;
+    int16_t pi16FirHistory[2 * HEIGHT_FIR_TAPS];
+    biquadFilter_t sBiquad;
+    float pfBiquadState[2 * HEIGHT_BIQUAD_SECTIONS];
+    filterChain_t sChain;
+    int32_t pi32Average[AVERAGE_SIZE];
+    int32_t i32Filtered = 0, i32AverageSum = 0;
+    double dClean, dFiltered, dAverage;
+    double pdSquares[2] = { 0.0, 0.0 }, pdMax[2] = { 0.0, 0.0 }, pdLag[2] = { -1.0, -1.0 };
+    double dCleanLag = -1.0, dCrossing = 30.0;  // Height half way through the 10 -> 50% step
+    uint32_t ui32Settled = 0, i, k;
+    char pcWhat[80];
+
+    makeTrace(psTrace, ui32Seed);
+
+    initMedianFilter(&sMedian, pi32MedianHistory, pi32MedianSorted, HEIGHT_MEDIAN_SIZE);
+    initFirFilter(&sFir, g_pi16HeightFirCoeffs, pi16FirHistory, HEIGHT_FIR_TAPS);
+    initBiquadFilter(&sBiquad, g_psHeightBiquadCoeffs, pfBiquadState, HEIGHT_BIQUAD_SECTIONS);
+    initFilterChain(&sChain);
+    addFilterChain(&sChain, stepMedianFilter, &sMedian);
+    addFilterChain(&sChain, stepFirFilter, &sFir);
+    addFilterChain(&sChain, stepBiquadFilter, &sBiquad);
+
+    for (k = 0; k < AVERAGE_SIZE; k++) {
+        pi32Average[k] = g_pi32NoisyTrace[0];
+        i32AverageSum += g_pi32NoisyTrace[0];
+    }
+
+    for (i = 0; i < TRACE_SAMPLES; i++) {
+        i32Filtered = stepFilterChain(&sChain, g_pi32NoisyTrace[i]);
+        i32AverageSum += g_pi32NoisyTrace[i] - pi32Average[i % AVERAGE_SIZE];
+        pi32Average[i % AVERAGE_SIZE] = g_pi32NoisyTrace[i];
+
+        // Heights in %, from whole counts as the firmware maps them
+        dClean = HEIGHT_MAP_SLOPE * g_pi32CleanTrace[i] / 16.0 + HEIGHT_MAP_OFFSET;
+        dFiltered = HEIGHT_MAP_SLOPE * i32Filtered + HEIGHT_MAP_OFFSET;
+        dAverage = HEIGHT_MAP_SLOPE * ((2 * i32AverageSum + AVERAGE_SIZE) / 2 / AVERAGE_SIZE) + HEIGHT_MAP_OFFSET;
+
+        // Lag is measured at every sample, the display period would hide it
+        if (dCleanLag < 0.0 && dClean >= dCrossing) {
+            dCleanLag = (double) i / SAMPLE_RATE_HZ;
+        }
+        if (pdLag[0] < 0.0 && dFiltered >= dCrossing) {
+            pdLag[0] = (double) i / SAMPLE_RATE_HZ;
+        }
+        if (pdLag[1] < 0.0 && dAverage >= dCrossing) {
+            pdLag[1] = (double) i / SAMPLE_RATE_HZ;
+        }
+
+        if ((i + 1) % SAMPLES_PER_DISPLAY == 0 && isSettled(i)) {  // getHeightTask only reports once per display period
+            pdSquares[0] += (dFiltered - dClean) * (dFiltered - dClean);
+            pdSquares[1] += (dAverage - dClean) * (dAverage - dClean);
+            pdMax[0] = fmax(pdMax[0], fabs(dFiltered - dClean));
+            pdMax[1] = fmax(pdMax[1], fabs(dAverage - dClean));
+            ui32Settled++;
+        }
+    }
+
+    printf("%s, settled RMS / max error, lag at the 30%% crossing:\n", psTrace->pcName);
+    printf("    pipeline       %5.2f%% / %5.2f%%, %+3.0f ms\n", sqrt(pdSquares[0] / ui32Settled), pdMax[0],
+           (pdLag[0] - dCleanLag) * 1000.0);
+    printf("    moving average %5.2f%% / %5.2f%%, %+3.0f ms\n", sqrt(pdSquares[1] / ui32Settled), pdMax[1],
+           (pdLag[1] - dCleanLag) * 1000.0);
+
+    snprintf(pcWhat, sizeof(pcWhat), "%s: pipeline settled RMS error under %.1f%%", psTrace->pcName, psTrace->dMaxRMS);
+    check(sqrt(pdSquares[0] / ui32Settled) < psTrace->dMaxRMS, pcWhat);
+    snprintf(pcWhat, sizeof(pcWhat), "%s: pipeline settled error never over 1%%", psTrace->pcName);
+    check(pdMax[0] <= 1.0, pcWhat);
+    snprintf(pcWhat, sizeof(pcWhat), "%s: pipeline lag under 2 display periods (50 ms)", psTrace->pcName);
+    check(pdLag[0] >= 0.0 && pdLag[0] - dCleanLag < 0.050, pcWhat);
+}
+
+
+int
+main (void)
+{
+    // Two sections of a 4th order Butterworth low-pass at 10 Hz, the poles closest to 1 of any in use
+    static const biquadCoeffs_t psFourthOrder[2] = {
+        { 1.472519872e-04f, 2.945039744e-04f, 1.472519872e-04f, -1.955070063e+00f, 9.556590706e-01f },
+        { 1.491895352e-04f, 2.983790704e-04f, 1.491895352e-04f, -1.980794959e+00f, 9.813917170e-01f },
+    };
+    static const uint32_t pui32Taps[] = { 1, 2, 7, 16, 32, 33 };
+    static const uint32_t pui32Sizes[] = { 1, 3, 5, 8, 15 };
+    char pcWhat[80];
+    double dError;
+    uint32_t i;
+
+    // Each filter against its reference
+    for (i = 0; i < sizeof(pui32Taps) / sizeof(pui32Taps[0]); i++) {
+        snprintf(pcWhat, sizeof(pcWhat), "FIR, %u taps, matches exact convolution", pui32Taps[i]);
+        check(checkFir(pui32Taps[i], 0x1234567 + i) == 0, pcWhat);
+    }
+    for (i = 0; i < sizeof(pui32Sizes) / sizeof(pui32Sizes[0]); i++) {
+        snprintf(pcWhat, sizeof(pcWhat), "median of %u, repeated values, matches sorted window", pui32Sizes[i]);
+        check(checkMedian(pui32Sizes[i], 8, 0xBEEF + i) == 0, pcWhat);
+        snprintf(pcWhat, sizeof(pcWhat), "median of %u, 12 bit values, matches sorted window", pui32Sizes[i]);
+        check(checkMedian(pui32Sizes[i], ADC_MASK + 1, 0xCAFE + i) == 0, pcWhat);
+    }
+    dError = checkBiquad(g_psHeightBiquadCoeffs, HEIGHT_BIQUAD_SECTIONS, 0x5EED);
+    printf("biquad, height low-pass: largest difference from double %.3f counts\n", dError);
+    check(dError <= 1.0, "biquad, height low-pass, within 1 count of double");
+    dError = checkBiquad(psFourthOrder, 2, 0x5EED);
+    printf("biquad, 4th order 10 Hz: largest difference from double %.3f counts\n", dError);
+    check(dError <= 1.0, "biquad, 2 sections, within 1 count of double");
+
+    // The height pipeline over noisy traces
+    for (i = 0; i < sizeof(g_psTraces) / sizeof(g_psTraces[0]); i++) {
+        runTrace(&g_psTraces[i], 0xA5A5A5 + i);
+    }
+
+    printf("%u failures\n", g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
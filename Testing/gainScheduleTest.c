@@ -0,0 +1,403 @@
+/*******************************************************
+ * gainScheduleTest.c
+ *
+ * Host test of the gain schedules in gain_schedule.c, and
+ * of the main rotor feed-forward to the tail that
+ * control_task.c runs with them.
+ *
+ * First the lookup alone: a table gives its own gains at
+ * its points, interpolates in between, holds at the ends,
+ * and fitGainSchedule() scales it to a tuned point.
+ *
+ * Then flown against the simulated HeliRig plant
+ * (Simulation/heli_plant.c), both loops at
+ * CONTROL_RATE_HZ with the control_task.h gains, profiles,
+ * feed-forward and schedules as control_task.c runs them:
+ * take off, then height changes with the yaw held at 0,
+ * with and without the main rotor feed-forward. The
+ * height is measured in ADC counts and the yaw in
+ * quadrature counts, as in Testing/trajectoryTest.c. The
+ * largest yaw error during each height change is
+ * reported, the main rotor's torque change knocks the
+ * yaw off unless the tail is fed it.
+ *
+ * Checks that
+ *   - the feed-forward at least halves the yaw error on
+ *     every height change, and keeps it within a few counts
+ *   - every height change still settles within the 5
+ *     second requirement
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -ISimulation -I"HeliRig Project" -o gain_schedule_test Testing/gainScheduleTest.c
+ *         "HeliRig Project"/gain_schedule.c "HeliRig Project"/trajectory.c "HeliRig Project"/PI_controller.c
+ *         Simulation/heli_plant.c Simulation/sim_peripherals.c -lm
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "heli_plant.h"
+#include "heli_math.h"
+#include "PI_controller.h"
+#include "trajectory.h"
+#include "gain_schedule.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define PLANT_DT_S          0.001f  // Plant integration step
+#define CONTROL_DIVIDER     5  // Control runs every 5 plant steps (CONTROL_RATE_HZ, 200 Hz)
+#define CONTROL_DT_S        (PLANT_DT_S * CONTROL_DIVIDER)
+#define SETTLE_LIMIT_S      5.0f  // README hard requirement 5
+#define SETTLE_BAND         0.05f  // Settled within 5% of the step size
+#define MANOEUVRE_S         10.0f  // Flown for, from the set point change
+#define YAW_DEG_PER_COUNT   (360.0f / PLANT_YAW_COUNTS_PER_REV)  // Yaw resolution, one quadrature count
+#define YAW_HELD_COUNTS     3  // Most the yaw may be knocked off with the feed-forward
+#define LOOKUP_TOL          0.0005f  // Gains from a lookup, to within fixed point rounding
+
+// control_task.h
+#define HEIGHT_KP           0.04f
+#define HEIGHT_KI           0.01f
+#define YAW_KP              0.008f
+#define YAW_KI              0.002f
+#define HEIGHT_TT           0.0f
+#define YAW_TT              1.0f
+#define DUTY_MIN            0.02f
+#define DUTY_MAX            0.98f
+#define HEIGHT_RATE         20.0f
+#define HEIGHT_ACCEL        40.0f
+#define HEIGHT_JERK         200.0f
+#define YAW_RATE            60.0f
+#define YAW_ACCEL           120.0f
+#define YAW_JERK            600.0f
+#define HEIGHT_FF_HOVER     0.45f
+#define HEIGHT_FF_RATE      0.0135f
+#define HEIGHT_FF_ACCEL     0.0036f
+#define HEIGHT_FF_JERK      0.000225f
+#define YAW_FF_RATE         0.0067f
+#define YAW_FF_ACCEL        0.00144f
+#define YAW_FF_JERK         0.0000556f
+#define YAW_FF_MAIN         0.778f
+#define YAW_FF_LEAD         (0.05f / 0.1f)  // Tail over main motor lag
+#define MAIN_LAG            (CONTROL_DT_S / 0.1f)
+#define HEIGHT_SCHED_START  0.0f
+#define HEIGHT_SCHED_STEP   25.0f
+#define YAW_SCHED_START     0.2f
+#define YAW_SCHED_STEP      0.15f
+
+
+static uint32_t g_ui32Failures;
+
+
+// The plant and both loops
+typedef struct
+{
+    heliPlant_t sPlant;
+    PIDController sHeight;
+    PIDController sYaw;
+    Trajectory sHeightProfile;
+    Trajectory sYawProfile;
+    GainSchedule sHeightSchedule;
+    GainSchedule sYawSchedule;
+    bool bMainFF;  // Main rotor feed-forward to the tail
+    num_t xMainThrust;  // Estimate, as control_task.c
+    float fHeightSet;  // %
+    float fYawSet;  // deg
+    float fMainDuty;
+    float fTailDuty;
+} flight_t;
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: near
+ *
+ * returns: a lookup gave the expected gains
+ *******************************************************/
+static bool
+near (const GainPoint *psGains, float fKp, float fKi)
+{
+    return fabsf(numToFloat(psGains->kp) - fKp) <= LOOKUP_TOL && fabsf(numToFloat(psGains->ki) - fKi) <= LOOKUP_TOL;
+}
+
+
+/*******************************************************
+ * Function: checkLookup
+ *******************************************************/
+static void
+checkLookup (void)
+{
+    static const GainPoint psTable[] = {
+        { NUM_CONST(0.1), NUM_CONST(0.01) },
+        { NUM_CONST(0.3), NUM_CONST(0.02) },
+        { NUM_CONST(0.2), NUM_CONST(0.06) },
+    };
+    GainSchedule sSchedule;
+    GainPoint sGains;
+    bool bPass = true;
+    uint32_t i;
+
+    initGainSchedule(&sSchedule, psTable, 3, NUM_CONST(20.0), NUM_CONST(10.0));  // At 20, 30 and 40
+
+    for (i = 0; i < 3; i++) {
+        lookupGainSchedule(&sSchedule, numFromInt(20 + 10 * (int32_t) i), &sGains);
+        bPass &= near(&sGains, numToFloat(psTable[i].kp), numToFloat(psTable[i].ki));  // 1 / step rounds in fixed point
+    }
+    check(bPass, "a table gives its own gains at its points");
+
+    lookupGainSchedule(&sSchedule, NUM_CONST(25.0), &sGains);
+    bPass = near(&sGains, 0.2f, 0.015f);
+    lookupGainSchedule(&sSchedule, NUM_CONST(37.5), &sGains);
+    bPass &= near(&sGains, 0.225f, 0.05f);
+    check(bPass, "interpolates between its points");
+
+    lookupGainSchedule(&sSchedule, NUM_CONST(-5.0), &sGains);
+    bPass = sGains.kp == psTable[0].kp && sGains.ki == psTable[0].ki;
+    lookupGainSchedule(&sSchedule, NUM_CONST(1000.0), &sGains);
+    bPass &= sGains.kp == psTable[2].kp && sGains.ki == psTable[2].ki;
+    initGainSchedule(&sSchedule, psTable, 1, NUM_CONST(20.0), NUM_CONST(10.0));
+    lookupGainSchedule(&sSchedule, NUM_CONST(25.0), &sGains);
+    bPass &= sGains.kp == psTable[0].kp && sGains.ki == psTable[0].ki;
+    check(bPass, "holds at the ends, and a single point anywhere");
+
+    initGainSchedule(&sSchedule, psTable, 3, NUM_CONST(20.0), NUM_CONST(10.0));
+    sGains.kp = NUM_CONST(0.4);
+    sGains.ki = NUM_CONST(0.03);
+    fitGainSchedule(&sSchedule, NUM_CONST(25.0), &sGains);  // Was 0.2 and 0.015 there, doubled
+    lookupGainSchedule(&sSchedule, NUM_CONST(25.0), &sGains);
+    bPass = near(&sGains, 0.4f, 0.03f);
+    lookupGainSchedule(&sSchedule, NUM_CONST(40.0), &sGains);
+    bPass &= near(&sGains, 0.4f, 0.12f);
+    check(bPass, "fitted to a tuned point, keeping its shape");
+}
+
+
+/*******************************************************
+ * Function: heightPct
+ *
+ * returns: the height the firmware would map from the
+ *          plant's ADC reading, %
+ *******************************************************/
+static float
+heightPct (flight_t *psFlight)
+{
+    return 242.0f - 0.081f * (float) heliPlantADCCounts(&psFlight->sPlant);
+}
+
+
+/*******************************************************
+ * Function: yawDeg
+ *******************************************************/
+static float
+yawDeg (flight_t *psFlight)
+{
+    return heliPlantQuadCount(&psFlight->sPlant) * YAW_DEG_PER_COUNT;
+}
+
+
+/*******************************************************
+ * Function: initFlight
+ *
+ * Lands the plant and sets up both loops, profiles and
+ * schedules, flat at the gains as in control_task.c
+ *******************************************************/
+static void
+initFlight (flight_t *psFlight, bool bMainFF)
+{
+    static const GainPoint psHeightGains[5] = {
+        { NUM_CONST(HEIGHT_KP), NUM_CONST(HEIGHT_KI) }, { NUM_CONST(HEIGHT_KP), NUM_CONST(HEIGHT_KI) },
+        { NUM_CONST(HEIGHT_KP), NUM_CONST(HEIGHT_KI) }, { NUM_CONST(HEIGHT_KP), NUM_CONST(HEIGHT_KI) },
+        { NUM_CONST(HEIGHT_KP), NUM_CONST(HEIGHT_KI) },
+    };
+    static const GainPoint psYawGains[5] = {
+        { NUM_CONST(YAW_KP), NUM_CONST(YAW_KI) }, { NUM_CONST(YAW_KP), NUM_CONST(YAW_KI) },
+        { NUM_CONST(YAW_KP), NUM_CONST(YAW_KI) }, { NUM_CONST(YAW_KP), NUM_CONST(YAW_KI) },
+        { NUM_CONST(YAW_KP), NUM_CONST(YAW_KI) },
+    };
+
+    initHeliPlant(&psFlight->sPlant);
+    initPID(&psFlight->sHeight, NUM_CONST(CONTROL_DT_S), NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN),
+            NUM_CONST(HEIGHT_KP), NUM_CONST(HEIGHT_KI), 0);
+    initPID(&psFlight->sYaw, NUM_CONST(CONTROL_DT_S), NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN),
+            NUM_CONST(YAW_KP), NUM_CONST(YAW_KI), 0);
+    setPIDWindup(&psFlight->sHeight, PID_WINDUP_BACK_CALC, NUM_CONST(HEIGHT_TT));
+    setPIDWindup(&psFlight->sYaw, PID_WINDUP_BACK_CALC, NUM_CONST(YAW_TT));
+    initTrajectory(&psFlight->sHeightProfile, NUM_CONST(CONTROL_DT_S), NUM_CONST(HEIGHT_RATE),
+                   NUM_CONST(HEIGHT_ACCEL), NUM_CONST(HEIGHT_JERK), 0);
+    initTrajectory(&psFlight->sYawProfile, NUM_CONST(CONTROL_DT_S), NUM_CONST(YAW_RATE), NUM_CONST(YAW_ACCEL),
+                   NUM_CONST(YAW_JERK), 0);
+    initGainSchedule(&psFlight->sHeightSchedule, psHeightGains, 5, NUM_CONST(HEIGHT_SCHED_START),
+                     NUM_CONST(HEIGHT_SCHED_STEP));
+    initGainSchedule(&psFlight->sYawSchedule, psYawGains, 5, NUM_CONST(YAW_SCHED_START), NUM_CONST(YAW_SCHED_STEP));
+    psFlight->bMainFF = bMainFF;
+    psFlight->xMainThrust = 0;
+    psFlight->fHeightSet = 0.0f;
+    psFlight->fYawSet = 0.0f;
+    psFlight->fMainDuty = 0.0f;
+    psFlight->fTailDuty = 0.0f;
+}
+
+
+/*******************************************************
+ * Function: feedForward
+ *
+ * returns: the duty a profile's present rate,
+ *          acceleration and jerk need, as control_task.c
+ *******************************************************/
+static num_t
+feedForward (const Trajectory *psProfile, float fRateGain, float fAccelGain, float fJerkGain)
+{
+    return numMul(numFromFloat(fRateGain), psProfile->velocity) + numMul(numFromFloat(fAccelGain), psProfile->accel)
+           + numMul(numFromFloat(fJerkGain), psProfile->jerk);
+}
+
+
+/*******************************************************
+ * Function: scheduleGains
+ *
+ * Looks up a loop's gains, as control_task.c
+ *******************************************************/
+static void
+scheduleGains (PIDController *psPID, const GainSchedule *psSchedule, num_t xValue)
+{
+    GainPoint sGains;
+
+    lookupGainSchedule(psSchedule, xValue, &sGains);
+    if (sGains.kp != psPID->kp || sGains.ki != psPID->ki) {
+        setPIDGains(psPID, sGains.kp, sGains.ki, 0);
+    }
+}
+
+
+/*******************************************************
+ * Function: controlStep
+ *
+ * Steps both loops once as control_task.c, then the plant
+ * for one control period
+ *******************************************************/
+static void
+controlStep (flight_t *psFlight)
+{
+    num_t xHeight = numFromFloat(heightPct(psFlight));
+    num_t xHeightSet = stepTrajectory(&psFlight->sHeightProfile, numFromFloat(psFlight->fHeightSet));
+    num_t xYawSet = stepTrajectory(&psFlight->sYawProfile, numFromFloat(psFlight->fYawSet));
+    num_t xMainDuty, xFF;
+    uint32_t i;
+
+    scheduleGains(&psFlight->sHeight, &psFlight->sHeightSchedule, xHeightSet);
+    setPIDFeedForward(&psFlight->sHeight, NUM_CONST(HEIGHT_FF_HOVER)
+                      + feedForward(&psFlight->sHeightProfile, HEIGHT_FF_RATE, HEIGHT_FF_ACCEL, HEIGHT_FF_JERK));
+    xMainDuty = stepPID(&psFlight->sHeight, xHeightSet, xHeight);
+    psFlight->xMainThrust += numMul(NUM_CONST(MAIN_LAG), xMainDuty - psFlight->xMainThrust);
+
+    scheduleGains(&psFlight->sYaw, &psFlight->sYawSchedule, psFlight->xMainThrust);
+    xFF = feedForward(&psFlight->sYawProfile, YAW_FF_RATE, YAW_FF_ACCEL, YAW_FF_JERK);
+    if (psFlight->bMainFF && (numToInt(xHeight) > 0 || psFlight->xMainThrust >= NUM_CONST(HEIGHT_FF_HOVER))) {
+        xFF += numMul(NUM_CONST(YAW_FF_MAIN), psFlight->xMainThrust
+                                              + numMul(NUM_CONST(YAW_FF_LEAD), xMainDuty - psFlight->xMainThrust));
+    }
+    setPIDFeedForward(&psFlight->sYaw, xFF);
+
+    psFlight->fMainDuty = numToFloat(xMainDuty);
+    psFlight->fTailDuty = numToFloat(stepPID(&psFlight->sYaw, xYawSet, numFromFloat(yawDeg(psFlight))));
+    for (i = 0; i < CONTROL_DIVIDER; i++) {
+        heliPlantStep(&psFlight->sPlant, PLANT_DT_S, psFlight->fMainDuty, psFlight->fTailDuty);
+    }
+}
+
+
+/*******************************************************
+ * Function: fly
+ *
+ * Flies to a new height for MANOEUVRE_S
+ *
+ * pfYawError: the largest yaw error on the way, deg
+ * pfSettle: height 5% settling time, s
+ *******************************************************/
+static void
+fly (flight_t *psFlight, float fTo, float *pfYawError, float *pfSettle)
+{
+    float fFrom = psFlight->fHeightSet;
+    uint32_t k;
+
+    psFlight->fHeightSet = fTo;
+    *pfYawError = 0.0f;
+    *pfSettle = 0.0f;
+    for (k = 0; k < (uint32_t) (MANOEUVRE_S / CONTROL_DT_S + 0.5f); k++) {
+        controlStep(psFlight);
+        *pfYawError = fmaxf(*pfYawError, fabsf(yawDeg(psFlight) - psFlight->fYawSet));
+        if (fabsf(heightPct(psFlight) - fTo) > SETTLE_BAND * fabsf(fTo - fFrom)) {
+            *pfSettle = (k + 1) * CONTROL_DT_S;
+        }
+    }
+}
+
+
+/*******************************************************
+ * Function: flyHeights
+ *
+ * Takes off and flies the height changes, printing and
+ * returning the yaw error and settling time of each
+ *******************************************************/
+#define HEIGHT_MOVES        5
+static void
+flyHeights (bool bMainFF, float pfYawError[HEIGHT_MOVES], float pfSettle[HEIGHT_MOVES])
+{
+    static const float pfHeights[HEIGHT_MOVES] = { 50.0f, 55.0f, 80.0f, 20.0f, 50.0f };
+    flight_t sFlight;
+    uint32_t i;
+
+    initFlight(&sFlight, bMainFF);
+    printf("%-8s|", bMainFF ? "main ff" : "none");
+    for (i = 0; i < HEIGHT_MOVES; i++) {
+        fly(&sFlight, pfHeights[i], &pfYawError[i], &pfSettle[i]);
+        printf(" %5.2f deg %4.2fs |", pfYawError[i], pfSettle[i]);
+    }
+    printf("\n");
+}
+
+
+int
+main (void)
+{
+    float pfYawNone[HEIGHT_MOVES], pfSettleNone[HEIGHT_MOVES];
+    float pfYawFF[HEIGHT_MOVES], pfSettleFF[HEIGHT_MOVES];
+    bool bHalved = true, bHeld = true, bSettled = true;
+    uint32_t i;
+
+    printf("Gain schedules (" NUM_NAME ")\n");
+    checkLookup();
+
+    printf("\nLargest yaw error and height settling time\n");
+    printf("        | take off        | 50 -> 55%%       | 55 -> 80%%       | 80 -> 20%%       | 20 -> 50%%       |\n");
+    flyHeights(false, pfYawNone, pfSettleNone);
+    flyHeights(true, pfYawFF, pfSettleFF);
+
+    for (i = 0; i < HEIGHT_MOVES; i++) {
+        bHalved &= pfYawFF[i] <= 0.5f * pfYawNone[i];
+        bHeld &= pfYawFF[i] <= YAW_HELD_COUNTS * YAW_DEG_PER_COUNT;
+        bSettled &= pfSettleFF[i] < SETTLE_LIMIT_S;
+    }
+    check(bHalved, "main feed-forward halves the yaw error on height changes");
+    check(bHeld, "and holds the yaw within a few counts");
+    check(bSettled, "height changes settle within the 5 s requirement");
+
+    printf("%u failures\n", g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
@@ -0,0 +1,180 @@
+/*******************************************************
+ * gainSweep.c
+ *
+ * Host program that sweeps PI gains against the simulated
+ * HeliRig plant (Simulation/heli_plant.c) and reports the
+ * settling time of a height step and a yaw step, to check
+ * against the 5 second requirement.
+ *
+ * The loop runs as fast as the PC allows, so a full sweep
+ * of simulated flights takes well under a second.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -ISimulation -o gain_sweep Testing/gainSweep.c
+ *         Simulation/heli_plant.c Simulation/sim_peripherals.c -lm
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#include "heli_plant.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define PLANT_DT_S          0.001f  // Plant integration step
+#define CONTROL_DIVIDER     10  // Control runs every 10 plant steps (100 Hz)
+#define RUN_TIME_S          10.0f
+#define SETTLE_LIMIT_S      5.0f  // README hard requirement 5
+#define SETTLE_BAND         0.05f  // Settled within 5% of the step size
+
+#define HEIGHT_STEP_PCT     50.0f
+#define YAW_STEP_DEG        90.0f
+
+#define SWEEP_POINTS        4  // Kp and Ki values per axis
+#define HEIGHT_KP           0.04f  // Nominal gains, held while the other axis is swept
+#define HEIGHT_KI           0.01f
+#define YAW_KP              0.008f
+#define YAW_KI              0.002f
+
+
+// PI term matching stepPID() in PI_controller.c, with kd = 0
+typedef struct
+{
+    float fKp;
+    float fKi;
+    float fIntegral;
+    float fMin;
+    float fMax;
+} sweepPI_t;
+
+
+static float
+sweepPIStep (sweepPI_t *psPI, float fSetpoint, float fMeasured, float fDt)
+{
+    float fError = fSetpoint - fMeasured;
+    float fOutput;
+
+    psPI->fIntegral += fError * fDt;
+    fOutput = psPI->fKp * fError + psPI->fKi * psPI->fIntegral;
+
+    if (fOutput > psPI->fMax) {
+        fOutput = psPI->fMax;
+    } else if (fOutput < psPI->fMin) {
+        fOutput = psPI->fMin;
+    }
+    return fOutput;
+}
+
+
+/*******************************************************
+ * Function: flyStep
+ *
+ * Takes off and steps height and yaw together, returns
+ * the settling time of each axis (RUN_TIME_S if it never
+ * settles)
+ *******************************************************/
+static void
+flyStep (float fHeightKp, float fHeightKi, float fYawKp, float fYawKi,
+         float *pfHeightSettle, float *pfYawSettle)
+{
+    heliPlant_t sPlant;
+    sweepPI_t sHeightPI = { fHeightKp, fHeightKi, 0.0f, 0.02f, 0.98f };
+    sweepPI_t sYawPI = { fYawKp, fYawKi, 0.0f, 0.02f, 0.98f };
+    float fMainDuty = 0.0f, fTailDuty = 0.0f;
+    float fHeightPct, fYawDeg, fTime;
+    uint32_t ui32Step, ui32Steps = (uint32_t) (RUN_TIME_S / PLANT_DT_S);
+
+    initHeliPlant(&sPlant);
+    *pfHeightSettle = 0.0f;
+    *pfYawSettle = 0.0f;
+
+    for (ui32Step = 0; ui32Step < ui32Steps; ui32Step++) {
+        fTime = ui32Step * PLANT_DT_S;
+
+        if (ui32Step % CONTROL_DIVIDER == 0) {
+            // Sense through the same quantities the firmware sees
+            fHeightPct = 242.0f - 0.081f * (float) heliPlantADCCounts(&sPlant);
+            fYawDeg = heliPlantQuadCount(&sPlant) * 360.0f / PLANT_YAW_COUNTS_PER_REV;
+
+            fMainDuty = sweepPIStep(&sHeightPI, HEIGHT_STEP_PCT, fHeightPct, PLANT_DT_S * CONTROL_DIVIDER);
+            fTailDuty = sweepPIStep(&sYawPI, YAW_STEP_DEG, fYawDeg, PLANT_DT_S * CONTROL_DIVIDER);
+
+            // Remember the last time each axis was outside the band
+            if (fabsf(HEIGHT_STEP_PCT - fHeightPct) > SETTLE_BAND * HEIGHT_STEP_PCT) {
+                *pfHeightSettle = fTime;
+            }
+            if (fabsf(YAW_STEP_DEG - fYawDeg) > SETTLE_BAND * YAW_STEP_DEG) {
+                *pfYawSettle = fTime;
+            }
+        }
+
+        heliPlantStep(&sPlant, PLANT_DT_S, fMainDuty, fTailDuty);
+    }
+}
+
+
+/*******************************************************
+ * Function: sweepAxis
+ *
+ * Sweeps one axis over a Kp x Ki grid with the other axis
+ * held at its nominal gains, returns the number of gain
+ * pairs where both axes settle in time
+ *******************************************************/
+static uint32_t
+sweepAxis (bool bYaw, const float *pfKp, const float *pfKi, uint32_t ui32Count)
+{
+    uint32_t ui32Kp, ui32Ki, ui32Pass = 0;
+    float fHeightSettle, fYawSettle;
+
+    printf("%s     Kp     Ki |  height ts   yaw ts | pass\n", bYaw ? "yaw   " : "height");
+
+    for (ui32Kp = 0; ui32Kp < ui32Count; ui32Kp++) {
+        for (ui32Ki = 0; ui32Ki < ui32Count; ui32Ki++) {
+            bool bPass;
+
+            if (bYaw) {
+                flyStep(HEIGHT_KP, HEIGHT_KI, pfKp[ui32Kp], pfKi[ui32Ki], &fHeightSettle, &fYawSettle);
+            } else {
+                flyStep(pfKp[ui32Kp], pfKi[ui32Ki], YAW_KP, YAW_KI, &fHeightSettle, &fYawSettle);
+            }
+
+            bPass = (fHeightSettle < SETTLE_LIMIT_S) && (fYawSettle < SETTLE_LIMIT_S);
+            printf("       %6.3f %6.3f | %8.2fs %7.2fs | %s\n", pfKp[ui32Kp], pfKi[ui32Ki],
+                   fHeightSettle, fYawSettle, bPass ? "yes" : "no");
+            ui32Pass += bPass;
+        }
+    }
+
+    return ui32Pass;
+}
+
+
+int
+main (void)
+{
+    static const float pfHeightKp[SWEEP_POINTS] = { 0.01f, 0.02f, 0.04f, 0.08f };
+    static const float pfHeightKi[SWEEP_POINTS] = { 0.005f, 0.01f, 0.02f, 0.04f };
+    static const float pfYawKp[SWEEP_POINTS] = { 0.002f, 0.004f, 0.008f, 0.016f };
+    static const float pfYawKi[SWEEP_POINTS] = { 0.001f, 0.002f, 0.004f, 0.008f };
+    uint32_t ui32Runs = 2 * SWEEP_POINTS * SWEEP_POINTS, ui32Pass;
+    clock_t sStart = clock();
+    double dWall;
+
+    ui32Pass = sweepAxis(false, pfHeightKp, pfHeightKi, SWEEP_POINTS);
+    ui32Pass += sweepAxis(true, pfYawKp, pfYawKi, SWEEP_POINTS);
+
+    dWall = (double) (clock() - sStart) / CLOCKS_PER_SEC;
+    printf("%u of %u gain pairs settle within %.0fs\n", ui32Pass, ui32Runs, SETTLE_LIMIT_S);
+    printf("%.0fs simulated in %.3fs (%.0fx real time)\n", ui32Runs * RUN_TIME_S, dWall,
+           dWall > 0 ? ui32Runs * RUN_TIME_S / dWall : 0.0);
+
+    return 0;
+}
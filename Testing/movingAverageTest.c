@@ -0,0 +1,130 @@
+/*******************************************************
+ * movingAverageTest.c
+ *
+ * Host test of the running sum kept by spscBuf, which
+ * getHeightTask uses for its moving average. Writes
+ * millions of random samples at several buffer sizes and,
+ * after every write, checks sumSpscBuf() against a brute
+ * force sum of the same window kept separately here.
+ *
+ * Also runs samples with the top bits set so the running
+ * sum wraps, which must still give the exact (mod 2^32)
+ * window sum.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -IDrivers -o moving_average_test Testing/movingAverageTest.c
+ *         Drivers/spscBuf.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "spscBuf.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_MAX_SIZE       1024
+#define TEST_SAMPLES        4000000  // Per buffer size
+#define ADC_MASK            0x0FFF  // 12 bit ADC samples
+
+
+static volatile uint32_t g_pui32Storage[TEST_MAX_SIZE];
+static uint32_t g_pui32History[TEST_MAX_SIZE];  // Reference copy of the window
+
+
+/*******************************************************
+ * Function: nextRandom
+ *
+ * returns: the next xorshift32 value, so runs are
+ *          repeatable
+ *******************************************************/
+static uint32_t
+nextRandom (uint32_t *pui32Seed)
+{
+    *pui32Seed ^= *pui32Seed << 13;
+    *pui32Seed ^= *pui32Seed >> 17;
+    *pui32Seed ^= *pui32Seed << 5;
+    return *pui32Seed;
+}
+
+
+/*******************************************************
+ * Function: checkSize
+ *
+ * Streams TEST_SAMPLES samples through a buffer of
+ * ui32Size entries, comparing the running sum with the
+ * brute force window sum after every write
+ *
+ * returns: the number of mismatches
+ *******************************************************/
+static uint32_t
+checkSize (uint32_t ui32Size, uint32_t ui32SampleMask)
+{
+    spscBuf_t sBuffer;
+    uint32_t ui32Seed = 0x9E3779B9 ^ ui32Size;
+    uint32_t ui32Sample, ui32Sum, ui32Count, ui32Expected, ui32Held;
+    uint32_t ui32Errors = 0, i, j;
+
+    if (!initSpscBuf(&sBuffer, g_pui32Storage, ui32Size)) {
+        printf("size %u rejected\n", ui32Size);
+        return 1;
+    }
+
+    ui32Sum = sumSpscBuf(&sBuffer, &ui32Count);
+    ui32Errors += (ui32Sum != 0) || (ui32Count != 0);
+
+    for (i = 0; i < TEST_SAMPLES; i++) {
+        ui32Sample = nextRandom(&ui32Seed) & ui32SampleMask;
+        writeSpscBuf(&sBuffer, ui32Sample);
+        g_pui32History[i % ui32Size] = ui32Sample;
+
+        ui32Held = (i + 1 < ui32Size) ? i + 1 : ui32Size;
+        ui32Expected = 0;
+        for (j = 0; j < ui32Held; j++) {
+            ui32Expected += g_pui32History[j];
+        }
+
+        ui32Sum = sumSpscBuf(&sBuffer, &ui32Count);
+        if (ui32Sum != ui32Expected || ui32Count != ui32Held) {
+            if (ui32Errors < 5) {
+                printf("size %u sample %u: sum %u count %u, expected %u count %u\n",
+                       ui32Size, i, ui32Sum, ui32Count, ui32Expected, ui32Held);
+            }
+            ui32Errors++;
+        }
+    }
+
+    return ui32Errors;
+}
+
+
+int
+main (void)
+{
+    static const uint32_t pui32Sizes[] = { 1, 4, 64, 256 };
+    uint32_t ui32Errors = 0, ui32Total = 0, i;
+    clock_t sStart = clock();
+
+    for (i = 0; i < sizeof(pui32Sizes) / sizeof(pui32Sizes[0]); i++) {
+        uint32_t ui32Size = pui32Sizes[i];
+        uint32_t ui32AdcErrors = checkSize(ui32Size, ADC_MASK);
+        uint32_t ui32WrapErrors = checkSize(ui32Size, 0xFFFFFFFF);
+
+        printf("size %4u: 12 bit %s, full range %s\n", ui32Size,
+               ui32AdcErrors ? "FAIL" : "ok", ui32WrapErrors ? "FAIL" : "ok");
+        ui32Errors += ui32AdcErrors + ui32WrapErrors;
+        ui32Total += 2 * TEST_SAMPLES;
+    }
+
+    printf("%u samples checked in %.2fs, %u mismatches\n", ui32Total,
+           (double) (clock() - sStart) / CLOCKS_PER_SEC, ui32Errors);
+
+    return ui32Errors ? 1 : 0;
+}
@@ -0,0 +1,488 @@
+/*******************************************************
+ * notifyPublishTest.c
+ *
+ * Host test of the notification driven publishing in
+ * getYawTask and getHeightTask: each blocks on a task
+ * notification from its interrupt, and sends to the OLED
+ * queue only when its value changes (at most every
+ * YAW_ / HEIGHT_PUBLISH_MIN_MS), or when it has not sent
+ * for YAW_ / HEIGHT_MAX_STALE_MS.
+ *
+ * Each task is run on its own against the simulated
+ * peripherals, under a small stand in for the kernel:
+ * delays and notification waits step the simulation 1 ms
+ * (one tick) at a time, and a notification from an
+ * interrupt ends the wait at the end of that tick. Every
+ * time the task runs and every message it sends is logged
+ * against simulated time. A script drives the inputs:
+ *   - yaw: at rest, one move of YAW_NOTIFY_COUNTS edges,
+ *     at rest again, a steady turn, and a stop
+ *   - height: calibration, landed, and a step to 50%
+ * Checks that
+ *   - at rest each task runs and sends only at the stale
+ *     rate, against the fixed rate of the old delay loops
+ *   - a move after a rest is sent within a tick or two
+ *   - while the value keeps changing, messages are capped
+ *     at one per publish interval
+ *   - the final value is sent soon after it settles
+ *
+ * The FreeRTOS calls made by the tasks are stubbed below,
+ * only the headers from the POSIX port are needed.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -ISimulation -I. -I"HeliRig Project" -IDrivers -Iutils -IFreeRTOS/include
+ *         -I$POSIX_PORT -o notify_publish_test Testing/notifyPublishTest.c "HeliRig Project"/get_yaw_task.c
+ *         "HeliRig Project"/get_height_task.c Drivers/spscBuf.c Drivers/pingPongBuf.c Drivers/filter.c
+ *         utils/ustdlib.c Simulation/sim_peripherals.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <setjmp.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "sim_peripherals.h"
+#include "heli_math.h"
+#include "get_yaw_task.h"
+#include "get_height_task.h"
+#include "helirig_structs.c"
+
+#if YAW_USE_QEI || ADC_USE_UDMA
+#error notifyPublishTest.c tests the GPIO yaw backend and the interrupt driven ADC
+#endif
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_OLD_YAW_MS     100  // Fixed delay of the old getYawTask loop
+#define TEST_OLD_HEIGHT_MS  ADC_DISPLAY_RATE  // ... and of the old getHeightTask loop
+#define TEST_MAX_EVENTS     4096
+
+// Yaw script, in ms from the start of the task
+#define YAW_REST_MS         5000  // At rest until then
+#define YAW_MOVE_MS         5000  // YAW_NOTIFY_COUNTS edges
+#define YAW_TURN_MS         6000  // Steady turn from then,
+#define YAW_TURN_EDGES      5  // ... at this many edges per ms,
+#define YAW_STOP_MS         8000  // ... until then
+#define YAW_END_MS          9000
+
+// Height script
+#define HEIGHT_LANDED       2900  // ADC counts
+#define HEIGHT_HALF         2280  // 620 counts below landed, 620 / 1241 = 50%
+#define HEIGHT_REST_MS      1000  // At rest from then,
+#define HEIGHT_STEP_MS      6000  // ... until the step to 50%
+#define HEIGHT_END_MS       7000
+#if HEIGHT_FILTER
+#define HEIGHT_SENT_MS      (ADC_DISPLAY_RATE + 5)  // Step to first message, the filter delays it past the first look
+#define HEIGHT_SETTLED_MS   (3 * ADC_DISPLAY_RATE + HEIGHT_PUBLISH_MIN_MS)  // ... and to 50%
+#else
+#define HEIGHT_SENT_MS      (ADC_DISPLAY_RATE / 2)
+#define HEIGHT_SETTLED_MS   (2 * ADC_DISPLAY_RATE + HEIGHT_PUBLISH_MIN_MS)
+#endif
+
+
+// Pin states in Gray code order, counting up (B leads A)
+static const uint8_t g_pui8Phase[4] = { 0, GPIO_PIN_1, GPIO_PIN_0 | GPIO_PIN_1, GPIO_PIN_0 };
+
+// A time the task ran or sent, and what it sent
+typedef struct
+{
+    uint32_t ui32Ms;
+    int32_t i32Value;
+} event_t;
+
+static event_t g_psWakes[TEST_MAX_EVENTS];
+static event_t g_psMessages[TEST_MAX_EVENTS];
+static uint32_t g_ui32Wakes;
+static uint32_t g_ui32Messages;
+
+static TaskFunction_t g_pfnTask;
+static void *g_pvTaskParameters;
+static jmp_buf g_sTaskExit;
+static uint32_t g_ui32Failures;
+
+static uint64_t g_ui64Start;  // Simulated time the task was started at
+static void (*g_pfnScript)(uint32_t ui32Ms);  // Drives the inputs for the coming tick
+static uint32_t g_ui32EndMs;
+static uint32_t g_ui32Notified;  // Bits notified to the task, not yet waited for
+static int64_t g_i64Edges;  // Every yaw edge driven so far
+
+
+/*******************************************************
+ * Function: nowMs
+ *
+ * returns: ms since the task was started
+ *******************************************************/
+static uint32_t
+nowMs (void)
+{
+    return (uint32_t) ((simTimeGet() - g_ui64Start) / 1000);
+}
+
+
+/*******************************************************
+ * Function: logEvent
+ *******************************************************/
+static void
+logEvent (event_t *psLog, uint32_t *pui32Count, int32_t i32Value)
+{
+    if (*pui32Count < TEST_MAX_EVENTS) {
+        psLog[*pui32Count].ui32Ms = nowMs();
+        psLog[*pui32Count].i32Value = i32Value;
+        (*pui32Count)++;
+    }
+}
+
+
+/*******************************************************
+ * Function: tick
+ *
+ * Runs the script for the coming tick, then steps the
+ * simulation 1 ms. Ends the task at g_ui32EndMs.
+ *******************************************************/
+static void
+tick (void)
+{
+    if (nowMs() >= g_ui32EndMs) {
+        longjmp(g_sTaskExit, 1);
+    }
+    g_pfnScript(nowMs());
+    simStep(1000);
+}
+
+
+/*******************************************************
+ * FreeRTOS stubs
+ *******************************************************/
+BaseType_t
+xTaskCreate (TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth,
+             void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    (void) pcName;
+    (void) usStackDepth;
+    (void) uxPriority;
+    g_pfnTask = pxTaskCode;
+    g_pvTaskParameters = pvParameters;
+    *pxCreatedTask = (TaskHandle_t) &g_ui32Notified;  // Never dereferenced by the stubs
+    return pdPASS;
+}
+
+BaseType_t
+xQueueGenericSend (QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait,
+                   const BaseType_t xCopyPosition)
+{
+    const OLEDMessage *psMessage = (const OLEDMessage *) pvItemToQueue;
+    int32_t i32Value;
+
+    (void) xQueue;
+    (void) xTicksToWait;
+    (void) xCopyPosition;
+
+    if (sscanf(psMessage->strBuf, "Angle (deg): %d", &i32Value) == 1
+        || sscanf(psMessage->strBuf, "Height (/): %d", &i32Value) == 1) {
+        logEvent(g_psMessages, &g_ui32Messages, i32Value);
+    }
+    return pdPASS;
+}
+
+void
+vTaskDelay (const TickType_t xTicksToDelay)
+{
+    TickType_t xTick;
+
+    for (xTick = 0; xTick < xTicksToDelay; xTick++) {
+        tick();
+    }
+    logEvent(g_psWakes, &g_ui32Wakes, 0);
+}
+
+BaseType_t
+xTaskNotifyWait (uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue,
+                 TickType_t xTicksToWait)
+{
+    TickType_t xTick;
+    BaseType_t xNotified;
+
+    g_ui32Notified &= ~ulBitsToClearOnEntry;
+    for (xTick = 0; xTick < xTicksToWait && g_ui32Notified == 0; xTick++) {
+        tick();
+    }
+    if (pulNotificationValue != NULL) {
+        *pulNotificationValue = g_ui32Notified;
+    }
+    xNotified = (g_ui32Notified != 0) ? pdTRUE : pdFALSE;
+    g_ui32Notified &= ~ulBitsToClearOnExit;
+    logEvent(g_psWakes, &g_ui32Wakes, 0);
+    return xNotified;
+}
+
+BaseType_t
+xTaskGenericNotifyFromISR (TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                           uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void) xTaskToNotify;
+    (void) eAction;
+    (void) pulPreviousNotificationValue;
+    g_ui32Notified |= ulValue;
+    *pxHigherPriorityTaskWoken = pdTRUE;
+    return pdPASS;
+}
+
+TickType_t
+xTaskGetTickCount (void)
+{
+    return (TickType_t) (simTimeGet() / (1000 * portTICK_RATE_MS));
+}
+
+void
+vPortYield (void)
+{
+}
+
+void
+vPortEnterCritical (void)
+{
+}
+
+void
+vPortExitCritical (void)
+{
+}
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: countBetween
+ *
+ * returns: the events logged from ui32FromMs up to, not
+ *          including, ui32ToMs
+ *******************************************************/
+static uint32_t
+countBetween (const event_t *psLog, uint32_t ui32Count, uint32_t ui32FromMs, uint32_t ui32ToMs)
+{
+    uint32_t i, ui32In = 0;
+
+    for (i = 0; i < ui32Count; i++) {
+        ui32In += (psLog[i].ui32Ms >= ui32FromMs && psLog[i].ui32Ms < ui32ToMs);
+    }
+    return ui32In;
+}
+
+
+/*******************************************************
+ * Function: firstFrom
+ *
+ * bAny: any value, or only i32Value
+ *
+ * returns: the first message sent at or after ui32FromMs,
+ *          or NULL if there was none
+ *******************************************************/
+static const event_t *
+firstFrom (uint32_t ui32FromMs, bool bAny, int32_t i32Value)
+{
+    uint32_t i;
+
+    for (i = 0; i < g_ui32Messages; i++) {
+        if (g_psMessages[i].ui32Ms >= ui32FromMs && (bAny || g_psMessages[i].i32Value == i32Value)) {
+            return &g_psMessages[i];
+        }
+    }
+    return NULL;
+}
+
+
+/*******************************************************
+ * Function: runTask
+ *
+ * Runs the task last created until ui32EndMs, with
+ * pfnScript driving its inputs
+ *******************************************************/
+static void
+runTask (void (*pfnScript)(uint32_t ui32Ms), uint32_t ui32EndMs)
+{
+    g_ui32Wakes = g_ui32Messages = g_ui32Notified = 0;
+    g_pfnScript = pfnScript;
+    g_ui32EndMs = ui32EndMs;
+    g_ui64Start = simTimeGet();
+    if (setjmp(g_sTaskExit) == 0) {
+        g_pfnTask(g_pvTaskParameters);
+    }
+}
+
+
+/*******************************************************
+ * Function: printRest
+ *
+ * Prints how often the task ran and sent over a rest,
+ * against the old fixed delay loop
+ *
+ * ui32WakeMs: longest wait for a notification
+ *
+ * returns: true if it sent no more than the stale rate
+ *          allows, and ran no more than that and once a
+ *          wait
+ *******************************************************/
+static bool
+printRest (const char *pcTask, uint32_t ui32FromMs, uint32_t ui32ToMs, uint32_t ui32StaleMs, uint32_t ui32WakeMs,
+           uint32_t ui32OldMs)
+{
+    uint32_t ui32Wakes = countBetween(g_psWakes, g_ui32Wakes, ui32FromMs, ui32ToMs);
+    uint32_t ui32Messages = countBetween(g_psMessages, g_ui32Messages, ui32FromMs, ui32ToMs);
+    uint32_t ui32Periods = (ui32ToMs - ui32FromMs) / ui32StaleMs + 1;
+
+    printf("%s at rest for %u ms: ran %u times, sent %u messages (fixed delay loop: %u of each)\n", pcTask,
+           (unsigned) (ui32ToMs - ui32FromMs), (unsigned) ui32Wakes, (unsigned) ui32Messages,
+           (unsigned) ((ui32ToMs - ui32FromMs) / ui32OldMs));
+    return ui32Messages <= ui32Periods && ui32Wakes <= ui32Periods + (ui32ToMs - ui32FromMs) / ui32WakeMs + 1;
+}
+
+
+/*******************************************************
+ * Yaw
+ *******************************************************/
+static void
+yawScript (uint32_t ui32Ms)
+{
+    int32_t i32Edges = 0;
+
+    if (ui32Ms == YAW_MOVE_MS) {
+        i32Edges = YAW_NOTIFY_COUNTS;
+    } else if (ui32Ms >= YAW_TURN_MS && ui32Ms < YAW_STOP_MS) {
+        i32Edges = YAW_TURN_EDGES;
+    }
+    for (; i32Edges > 0; i32Edges--) {
+        g_i64Edges++;
+        simGPIOInputSet(GPIO_PORTB_BASE, QUAD_PINS, g_pui8Phase[g_i64Edges & 3]);
+    }
+}
+
+static int32_t
+yawAngle (void)
+{
+    return numToInt(numMul(numFromInt((int32_t) (g_i64Edges % YAW_COUNTS_PER_REV)), YAW_DEG_PER_COUNT));
+}
+
+static void
+checkYaw (void)
+{
+    xQueueHandle xQueue = NULL;
+    const event_t *psMove, *psFinal;
+    uint32_t ui32Turning;
+
+    g_pfnTask = NULL;
+    simGPIOInputSet(YAW_REF_BASE, YAW_REF_PIN, 0);  // Over the reference at count 0, found straight away
+    check(initGetYawTask(&xQueue) == 0 && g_pfnTask != NULL, "initGetYawTask creates the task");
+    runTask(yawScript, YAW_END_MS);
+
+    check(g_ui32Messages > 0 && g_psMessages[0].ui32Ms <= 1 && g_psMessages[0].i32Value == 0,
+          "yaw: sends the start heading at once");
+    check(printRest("yaw", 1, YAW_REST_MS, YAW_MAX_STALE_MS, YAW_MAX_STALE_MS, TEST_OLD_YAW_MS),
+          "yaw: at rest, runs and sends only at the stale rate");
+
+    psMove = firstFrom(YAW_MOVE_MS, true, 0);
+    printf("yaw: %u edges after a rest, sent %u ms later (fixed delay loop: up to %u ms)\n",
+           (unsigned) YAW_NOTIFY_COUNTS, psMove ? (unsigned) (psMove->ui32Ms - YAW_MOVE_MS) : 0,
+           (unsigned) TEST_OLD_YAW_MS);
+    check(psMove != NULL && psMove->ui32Ms - YAW_MOVE_MS <= 2 && psMove->i32Value != 0,
+          "yaw: a move after a rest is sent within 2 ms");
+
+    ui32Turning = countBetween(g_psMessages, g_ui32Messages, YAW_TURN_MS, YAW_STOP_MS);
+    printf("yaw: turning at %u counts/s for %u ms, sent %u messages\n", (unsigned) (YAW_TURN_EDGES * 1000),
+           (unsigned) (YAW_STOP_MS - YAW_TURN_MS), (unsigned) ui32Turning);
+    check(ui32Turning <= (YAW_STOP_MS - YAW_TURN_MS) / YAW_PUBLISH_MIN_MS + 1
+          && ui32Turning >= (YAW_STOP_MS - YAW_TURN_MS) / (2 * YAW_PUBLISH_MIN_MS),
+          "yaw: turning, one message per YAW_PUBLISH_MIN_MS");
+
+    psFinal = firstFrom(YAW_STOP_MS - YAW_PUBLISH_MIN_MS, false, yawAngle());
+    check(psFinal != NULL && psFinal->ui32Ms <= YAW_STOP_MS + YAW_PUBLISH_MIN_MS + 2
+          && g_psMessages[g_ui32Messages - 1].i32Value == yawAngle(),
+          "yaw: the final heading is sent within YAW_PUBLISH_MIN_MS");
+}
+
+
+/*******************************************************
+ * Height
+ *******************************************************/
+static void
+heightScript (uint32_t ui32Ms)
+{
+    if (ui32Ms == HEIGHT_STEP_MS) {
+        simADCInputSet(0, HEIGHT_HALF);
+    }
+}
+
+static void
+checkHeight (void)
+{
+    xQueueHandle xQueue = NULL;
+    const event_t *psStep, *psFinal;
+    uint32_t i;
+
+    g_pfnTask = NULL;
+    simADCInputSet(0, HEIGHT_LANDED);
+    check(initGetHeightTask(&xQueue) == 0 && g_pfnTask != NULL, "initGetHeightTask creates the task");
+    runTask(heightScript, HEIGHT_END_MS);
+
+    check(g_ui32Messages > 0 && g_psMessages[0].ui32Ms <= HEIGHT_CAL_MS + 2 * ADC_DISPLAY_RATE
+          && g_psMessages[0].i32Value == 0, "height: sends landed straight after calibrating");
+    check(printRest("height", HEIGHT_REST_MS, HEIGHT_STEP_MS, HEIGHT_MAX_STALE_MS,
+                    HEIGHT_FILTER ? ADC_DISPLAY_RATE : HEIGHT_MAX_STALE_MS, TEST_OLD_HEIGHT_MS),
+          "height: at rest, runs and sends only at the stale rate");
+
+    psStep = firstFrom(HEIGHT_STEP_MS, true, 0);
+    psFinal = firstFrom(HEIGHT_STEP_MS, false, 50);
+    printf("height: step to 50%% sent from %u ms, reached 50%% at %u ms, sent:",
+           psStep ? (unsigned) (psStep->ui32Ms - HEIGHT_STEP_MS) : 0,
+           psFinal ? (unsigned) (psFinal->ui32Ms - HEIGHT_STEP_MS) : 0);
+    for (i = 0; i < g_ui32Messages; i++) {
+        if (g_psMessages[i].ui32Ms >= HEIGHT_STEP_MS) {
+            printf(" %d", g_psMessages[i].i32Value);
+        }
+    }
+    printf("\n");
+    check(psStep != NULL && psStep->ui32Ms - HEIGHT_STEP_MS <= HEIGHT_SENT_MS, "height: a step is sent within HEIGHT_SENT_MS");
+    check(psFinal != NULL && psFinal->ui32Ms - HEIGHT_STEP_MS <= HEIGHT_SETTLED_MS
+          && g_psMessages[g_ui32Messages - 1].i32Value == 50, "height: settles on 50% within HEIGHT_SETTLED_MS");
+}
+
+
+int
+main (void)
+{
+    const simStats_t *psStats = simStatsGet();
+
+    simReset();
+    SysCtlClockSet(SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    IntMasterEnable();
+
+    checkYaw();
+    checkHeight();
+    check(psStats->ui32StuckInts == 0 && getQuadIllegal() == 0, "no stuck interrupts or illegal transitions");
+
+    printf("%u failures\n", (unsigned) g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
@@ -0,0 +1,212 @@
+/*******************************************************
+ * numericBench.c
+ *
+ * Cycle count of one control step (height mapping, yaw
+ * scaling and stepPID() from PI_controller.c per axis)
+ * using num_t from heli_math.h, against the same step in
+ * double as the firmware did it before. Also reports the
+ * largest difference between the two over the test inputs.
+ *
+ * Build once per numeric type to compare them:
+ *     gcc -std=gnu99 -O2 -I"HeliRig Project" -DHELI_MATH_TYPE=HELI_MATH_FLOAT
+ *         -o numeric_bench Testing/numericBench.c "HeliRig Project"/PI_controller.c -lm
+ *     gcc -std=gnu99 -O2 -I"HeliRig Project" -DHELI_MATH_TYPE=HELI_MATH_FIXED
+ *         -o numeric_bench Testing/numericBench.c "HeliRig Project"/PI_controller.c -lm
+ *
+ * Cycles are read from the DWT cycle counter when built for
+ * the Cortex-M4 (print through the CCS console), and from
+ * the time stamp counter on an x86 PC. The PC has hardware
+ * double precision, so only the target shows the soft-float
+ * cost of the double step.
+ *
+ * In Q16.16 the height slope rounds to -5308/65536, so a
+ * few readings land 1% away from the double result. That
+ * shows up as a difference of about Kp in the duty cycle.
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+#include "heli_math.h"
+#include "PI_controller.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define BENCH_STEPS         1000000
+#define BENCH_INPUTS        256  // Distinct ADC/quadrature inputs cycled through
+
+#define DWT_CTRL            (*(volatile uint32_t *) 0xE0001000)
+#define DWT_CYCCNT          (*(volatile uint32_t *) 0xE0001004)
+#define DEMCR               (*(volatile uint32_t *) 0xE000EDFC)
+#define DEMCR_TRCENA        0x01000000
+#define DWT_CTRL_CYCCNTENA  0x00000001
+
+// Same mapping and gains as the firmware and gainSweep.c
+#define HEIGHT_SLOPE        -0.081
+#define HEIGHT_OFFSET       242.0
+#define YAW_SCALE           0.8
+#define CONTROL_DT          0.01
+#define HEIGHT_KP           0.04
+#define HEIGHT_KI           0.01
+#define YAW_KP              0.008
+#define YAW_KI              0.002
+#define DUTY_MIN            0.02
+#define DUTY_MAX            0.98
+
+
+// stepPID() in double, as initPID() sets it up with kd = 0: back calculation over the integral time
+typedef struct
+{
+    double kp, ki, dt, max, min, integral;
+} benchPIDouble_t;
+
+
+static uint32_t g_pui32ADC[BENCH_INPUTS];
+static int32_t g_pi32Quad[BENCH_INPUTS];
+
+
+/*******************************************************
+ * Function: benchCycles
+ *
+ * returns: a free running cycle count
+ *******************************************************/
+static uint64_t
+benchCycles (void)
+{
+#if defined(__arm__)
+    return DWT_CYCCNT;
+#elif defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec sNow;
+    clock_gettime(CLOCK_MONOTONIC, &sNow);
+    return (uint64_t) sNow.tv_sec * 1000000000u + sNow.tv_nsec;  // ns, no cycle counter
+#endif
+}
+
+
+static double
+piStepDouble (benchPIDouble_t *psPI, double dSetpoint, double dMeasured)
+{
+    double dError = dSetpoint - dMeasured;
+    double dOutput, dClamped;
+
+    psPI->integral += dError * psPI->dt;
+    dOutput = psPI->kp * dError + psPI->ki * psPI->integral;
+    dClamped = fmin(fmax(dOutput, psPI->min), psPI->max);
+    psPI->integral += psPI->dt / psPI->kp * (dClamped - dOutput);  // dt / (ki * kp / ki)
+    return dClamped;
+}
+
+
+/*******************************************************
+ * Function: controlStep
+ *
+ * One control step in num_t, writes the two duty cycles
+ *******************************************************/
+static void
+controlStep (uint32_t ui32Index, PIDController *psHeight, PIDController *psYaw, num_t *pxMain, num_t *pxTail)
+{
+    int32_t i32Height, i32Yaw;
+
+    i32Height = numToInt(numMul(NUM_CONST(HEIGHT_SLOPE), numFromInt(g_pui32ADC[ui32Index])) + NUM_CONST(HEIGHT_OFFSET));
+    i32Yaw = numToInt(numMul(numFromInt(g_pi32Quad[ui32Index]), NUM_CONST(YAW_SCALE)));
+
+    *pxMain = stepPID(psHeight, NUM_CONST(50), numFromInt(i32Height));
+    *pxTail = stepPID(psYaw, NUM_CONST(90), numFromInt(i32Yaw));
+}
+
+
+/*******************************************************
+ * Function: controlStepDouble
+ *
+ * The same step in double, as the firmware was written
+ *******************************************************/
+static void
+controlStepDouble (uint32_t ui32Index, benchPIDouble_t *psHeight, benchPIDouble_t *psYaw,
+                   double *pdMain, double *pdTail)
+{
+    int32_t i32Height, i32Yaw;
+
+    i32Height = (int32_t) lround(HEIGHT_SLOPE * g_pui32ADC[ui32Index] + HEIGHT_OFFSET);
+    i32Yaw = (int32_t) lround(g_pi32Quad[ui32Index] * YAW_SCALE);
+
+    *pdMain = piStepDouble(psHeight, 50.0, i32Height);
+    *pdTail = piStepDouble(psYaw, 90.0, i32Yaw);
+}
+
+
+int
+main (void)
+{
+    PIDController sHeight, sYaw;
+    benchPIDouble_t sHeightDouble = { HEIGHT_KP, HEIGHT_KI, CONTROL_DT, DUTY_MAX, DUTY_MIN, 0 };
+    benchPIDouble_t sYawDouble = { YAW_KP, YAW_KI, CONTROL_DT, DUTY_MAX, DUTY_MIN, 0 };
+    volatile num_t xSink;
+    volatile double dSink;
+    num_t xMain, xTail;
+    double dMain, dTail, dError, dMaxError = 0.0;
+    uint64_t ui64Start, ui64Num, ui64Double;
+    uint32_t ui32Seed = 1, i;
+
+    initPID(&sHeight, NUM_CONST(CONTROL_DT), NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN), NUM_CONST(HEIGHT_KP),
+            NUM_CONST(HEIGHT_KI), 0);
+    initPID(&sYaw, NUM_CONST(CONTROL_DT), NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN), NUM_CONST(YAW_KP),
+            NUM_CONST(YAW_KI), 0);
+
+#if defined(__arm__)
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+#endif
+
+    // Inputs across the height range and a few turns of yaw either way
+    for (i = 0; i < BENCH_INPUTS; i++) {
+        ui32Seed = ui32Seed * 1664525u + 1013904223u;
+        g_pui32ADC[i] = 1700 + (ui32Seed >> 8) % 1400;
+        g_pi32Quad[i] = (int32_t) ((ui32Seed >> 4) % 2048) - 1024;
+    }
+
+    // Accuracy, stepping both versions through the same inputs
+    for (i = 0; i < BENCH_INPUTS * 16; i++) {
+        controlStep(i % BENCH_INPUTS, &sHeight, &sYaw, &xMain, &xTail);
+        controlStepDouble(i % BENCH_INPUTS, &sHeightDouble, &sYawDouble, &dMain, &dTail);
+        dError = fmax(fabs(numToFloat(xMain) - dMain), fabs(numToFloat(xTail) - dTail));
+        dMaxError = fmax(dMaxError, dError);
+    }
+
+    ui64Start = benchCycles();
+    for (i = 0; i < BENCH_STEPS; i++) {
+        controlStep(i % BENCH_INPUTS, &sHeight, &sYaw, &xMain, &xTail);
+        xSink = xMain + xTail;
+    }
+    ui64Num = benchCycles() - ui64Start;
+
+    ui64Start = benchCycles();
+    for (i = 0; i < BENCH_STEPS; i++) {
+        controlStepDouble(i % BENCH_INPUTS, &sHeightDouble, &sYawDouble, &dMain, &dTail);
+        dSink = dMain + dTail;
+    }
+    ui64Double = benchCycles() - ui64Start;
+
+    (void) xSink;
+    (void) dSink;
+    printf("%u control steps\n", BENCH_STEPS);
+    printf("%-6s: %7.1f cycles/step\n", NUM_NAME, (double) ui64Num / BENCH_STEPS);
+    printf("double: %7.1f cycles/step\n", (double) ui64Double / BENCH_STEPS);
+    printf("largest duty cycle difference from double: %.6f\n", dMaxError);
+
+    return 0;
+}
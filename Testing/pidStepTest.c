@@ -0,0 +1,354 @@
+/*******************************************************
+ * pidStepTest.c
+ *
+ * Host unit test of the PID controller in PI_controller.c,
+ * against analytic step responses.
+ *
+ * Checks:
+ *   - open loop, a constant error gives kp * e plus an
+ *     integral ramp of ki * e * dt a step, exactly as
+ *     worked out by hand
+ *   - open loop, a ramp in the measurement gives the
+ *     derivative -kd * rate from the second step on, and a
+ *     set point step gives no derivative kick
+ *   - closed loop around a first order plant
+ *     K / (tau s + 1), with the PI zero cancelling the
+ *     plant pole (ki / kp = 1 / tau), follows the first
+ *     order step response 1 - exp(-t / tau_c), where
+ *     tau_c = tau / (K kp), and settles in 4 tau_c
+ *   - the output never leaves min and max
+ *   - resetPID() gives back the response of a new controller
+ *   - two controllers stepped in turn give the same
+ *     outputs as each stepped on its own
+ *   - a feed-forward is added to the output as it is,
+ *     clamped with it, and handing back from manual with
+ *     one set does not bump the output
+ *
+ * Build with -DHELI_MATH_TYPE=1 to test the Q16.16 build,
+ * the tolerances allow for its rounding.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -I"HeliRig Project" -o pid_step_test Testing/pidStepTest.c
+ *         "HeliRig Project"/PI_controller.c -lm
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "heli_math.h"
+#include "PI_controller.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_DT             0.01  // Control period, 100 Hz as in gainSweep.c
+#define TEST_STEPS          500
+#define TEST_LIMIT          1000.0  // Output limits wide enough not to clamp
+
+#define PLANT_GAIN          2.0  // K
+#define PLANT_TAU           0.5  // s
+#define LOOP_KP             2.0
+#define LOOP_TAU_C          (PLANT_TAU / (PLANT_GAIN * LOOP_KP))  // Closed loop time constant, 0.125 s
+#define LOOP_STEP           50.0  // Set point step, e.g. 50% height
+
+#if HELI_MATH_TYPE == HELI_MATH_FIXED
+#define OPEN_TOL            0.002  // Q16.16 rounding, accumulated over TEST_STEPS
+#else
+#define OPEN_TOL            0.0005
+#endif
+#define LOOP_TOL            0.02  // Of the step, a sample of delay against the continuous response
+#define SETTLE_BAND         0.02
+
+
+static uint32_t g_ui32Failures;
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: initTestPID
+ *******************************************************/
+static void
+initTestPID (PIDController *psPID, double dKp, double dKi, double dKd, double dMin, double dMax)
+{
+    initPID(psPID, numFromFloat(TEST_DT), numFromFloat(dMax), numFromFloat(dMin), numFromFloat(dKp),
+            numFromFloat(dKi), numFromFloat(dKd));
+}
+
+
+/*******************************************************
+ * Function: step
+ *
+ * returns: stepPID() of plain values, as a double
+ *******************************************************/
+static double
+step (PIDController *psPID, double dSetpoint, double dPv)
+{
+    return numToFloat(stepPID(psPID, numFromFloat(dSetpoint), numFromFloat(dPv)));
+}
+
+
+/*******************************************************
+ * Function: checkOpenLoop
+ *
+ * returns: true if a constant error gives
+ *          u[k] = kp e + ki e dt (k + 1)
+ *******************************************************/
+static bool
+checkOpenLoop (void)
+{
+    const double dKp = 0.8, dKi = 0.3, dError = 5.0;
+    PIDController sPID;
+    double dU, dExpected, dMaxError = 0.0;
+    uint32_t k;
+
+    initTestPID(&sPID, dKp, dKi, 0.25, -TEST_LIMIT, TEST_LIMIT);
+    for (k = 0; k < TEST_STEPS; k++) {
+        dU = step(&sPID, dError, 0.0);  // The measurement never moves, so no derivative
+        dExpected = dKp * dError + dKi * dError * TEST_DT * (k + 1);
+        dMaxError = fmax(dMaxError, fabs(dU - dExpected));
+    }
+    printf("  constant error: max %.6f from kp e + ki e dt (k + 1), ends at %.4f\n", dMaxError, dU);
+
+    return dMaxError <= OPEN_TOL * dExpected;
+}
+
+
+/*******************************************************
+ * Function: checkDerivative
+ *
+ * Measurement ramps at dRate from 0 with the set point
+ * at 0, then the set point steps with the measurement
+ * held
+ *
+ * returns: true if the output matches
+ *          -kp r k dt - ki r dt^2 k (k + 1) / 2 - kd r
+ *          (no derivative on the first step), and the set
+ *          point step moves it only by kp * step and one
+ *          integral step
+ *******************************************************/
+static bool
+checkDerivative (void)
+{
+    const double dKp = 0.5, dKi = 0.2, dKd = 0.05, dRate = 4.0;
+    PIDController sPID;
+    double dU, dExpected, dPv, dMaxError = 0.0, dBefore, dKick;
+    uint32_t k;
+
+    initTestPID(&sPID, dKp, dKi, dKd, -TEST_LIMIT, TEST_LIMIT);
+    for (k = 0; k < 100; k++) {
+        dPv = dRate * k * TEST_DT;
+        dU = step(&sPID, 0.0, dPv);
+        dExpected = -dKp * dPv - dKi * dRate * TEST_DT * TEST_DT * k * (k + 1) / 2.0 - ((k > 0) ? dKd * dRate : 0.0);
+        dMaxError = fmax(dMaxError, fabs(dU - dExpected));
+    }
+    printf("  measurement ramp: max %.6f from the analytic PID output\n", dMaxError);
+
+    // Hold the measurement, let the derivative fall away, then step the set point by 1
+    dBefore = step(&sPID, 0.0, dPv);
+    dKick = step(&sPID, 1.0, dPv) - dBefore;
+    dExpected = dKp * 1.0 + dKi * (1.0 - dPv) * TEST_DT;  // The error moved by 1, and the integral by one step of it
+    printf("  set point step of 1: output moved %.4f, kp alone is %.4f (on the error, kd / dt adds %.1f)\n",
+           dKick, dKp, dKd / TEST_DT);
+
+    return dMaxError <= 0.001 && fabs(dKick - dExpected) <= 0.001;
+}
+
+
+/*******************************************************
+ * Function: checkClosedLoop
+ *
+ * Runs the PI loop around the plant, integrated exactly
+ * over each period with the output held
+ *
+ * returns: true if it follows the analytic first order
+ *          response within LOOP_TOL, and settles within
+ *          SETTLE_BAND in 4 tau_c
+ *******************************************************/
+static bool
+checkClosedLoop (void)
+{
+    const double dA = exp(-TEST_DT / PLANT_TAU);
+    PIDController sPID;
+    double dY = 0.0, dU, dT, dExpected, dMaxError = 0.0, dSettle = 0.0;
+    uint32_t k;
+
+    initTestPID(&sPID, LOOP_KP, LOOP_KP / PLANT_TAU, 0.0, -TEST_LIMIT, TEST_LIMIT);
+    for (k = 0; k < TEST_STEPS; k++) {
+        dT = k * TEST_DT;
+        dExpected = LOOP_STEP * (1.0 - exp(-dT / LOOP_TAU_C));
+        dMaxError = fmax(dMaxError, fabs(dY - dExpected));
+        if (fabs(dY - LOOP_STEP) > SETTLE_BAND * LOOP_STEP) {
+            dSettle = dT + TEST_DT;
+        }
+
+        dU = step(&sPID, LOOP_STEP, dY);
+        dY = dA * dY + (1.0 - dA) * PLANT_GAIN * dU;  // Zero order hold
+    }
+    printf("  closed loop, tau_c %.3f s: max %.3f from 1 - exp(-t / tau_c), settled to %.0f%% at %.3f s "
+           "(analytic %.3f s)\n", LOOP_TAU_C, dMaxError, SETTLE_BAND * 100, dSettle, -log(SETTLE_BAND) * LOOP_TAU_C);
+
+    return dMaxError <= LOOP_TOL * LOOP_STEP && dSettle <= 4.0 * LOOP_TAU_C;
+}
+
+
+/*******************************************************
+ * Function: checkLimits
+ *
+ * returns: true if the output stays within min and max
+ *          both ways
+ *******************************************************/
+static bool
+checkLimits (void)
+{
+    PIDController sPID;
+    double dU, dMin = 1e9, dMax = -1e9;
+    uint32_t k;
+
+    initTestPID(&sPID, 0.04, 0.01, 0.0, 0.02, 0.98);  // Duty limits as in gainSweep.c
+    for (k = 0; k < TEST_STEPS; k++) {
+        dU = step(&sPID, (k < TEST_STEPS / 2) ? 100.0 : -100.0, 0.0);
+        dMin = fmin(dMin, dU);
+        dMax = fmax(dMax, dU);
+    }
+
+    return dMin >= numToFloat(numFromFloat(0.02)) && dMax <= numToFloat(numFromFloat(0.98));
+}
+
+
+/*******************************************************
+ * Function: checkReset
+ *
+ * returns: true if a controller reset after a run gives
+ *          the same outputs as a new one
+ *******************************************************/
+static bool
+checkReset (void)
+{
+    PIDController sUsed, sNew;
+    bool bSame = true;
+    uint32_t k;
+
+    initTestPID(&sUsed, 0.8, 0.3, 0.1, -TEST_LIMIT, TEST_LIMIT);
+    initTestPID(&sNew, 0.8, 0.3, 0.1, -TEST_LIMIT, TEST_LIMIT);
+    for (k = 0; k < 100; k++) {
+        (void) stepPID(&sUsed, numFromInt(10), numFromInt(k % 7));
+    }
+
+    resetPID(&sUsed);
+    for (k = 0; k < 100; k++) {
+        bSame = bSame && stepPID(&sUsed, numFromInt(5), numFromInt(k % 3)) == stepPID(&sNew, numFromInt(5), numFromInt(k % 3));
+    }
+
+    return bSame;
+}
+
+
+/*******************************************************
+ * Function: checkInstances
+ *
+ * returns: true if height and yaw controllers stepped in
+ *          turn match each stepped on its own
+ *******************************************************/
+static bool
+checkInstances (void)
+{
+    PIDController sHeight, sYaw, sAlone;
+    num_t pxHeight[TEST_STEPS], pxYaw[TEST_STEPS];
+    bool bSame = true;
+    uint32_t k;
+
+    initTestPID(&sHeight, 0.04, 0.01, 0.0, 0.02, 0.98);
+    initTestPID(&sYaw, 0.008, 0.002, 0.001, 0.02, 0.98);
+    for (k = 0; k < TEST_STEPS; k++) {
+        pxHeight[k] = stepPID(&sHeight, numFromInt(50), numFromInt(k / 10));
+        pxYaw[k] = stepPID(&sYaw, numFromInt(90), numFromInt((k * 3) % 200));
+    }
+
+    initTestPID(&sAlone, 0.04, 0.01, 0.0, 0.02, 0.98);
+    for (k = 0; k < TEST_STEPS; k++) {
+        bSame = bSame && stepPID(&sAlone, numFromInt(50), numFromInt(k / 10)) == pxHeight[k];
+    }
+    initTestPID(&sAlone, 0.008, 0.002, 0.001, 0.02, 0.98);
+    for (k = 0; k < TEST_STEPS; k++) {
+        bSame = bSame && stepPID(&sAlone, numFromInt(90), numFromInt((k * 3) % 200)) == pxYaw[k];
+    }
+
+    return bSame;
+}
+
+
+/*******************************************************
+ * Function: checkFeedForward
+ *
+ * returns: true if the feed-forward adds to the open loop
+ *          output exactly, the sum is clamped, and the
+ *          output carries on from a manual value with it
+ *******************************************************/
+static bool
+checkFeedForward (void)
+{
+    const double dKp = 0.8, dKi = 0.3, dError = 5.0, dFf = 2.5;
+    PIDController sPlain, sFed;
+    double dPlain, dFed, dMaxError = 0.0, dClamped, dManual, dAuto;
+    uint32_t k;
+
+    initTestPID(&sPlain, dKp, dKi, 0.0, -TEST_LIMIT, TEST_LIMIT);
+    initTestPID(&sFed, dKp, dKi, 0.0, -TEST_LIMIT, TEST_LIMIT);
+    setPIDFeedForward(&sFed, numFromFloat(dFf));
+    for (k = 0; k < 100; k++) {
+        dPlain = step(&sPlain, dError, 0.0);
+        dFed = step(&sFed, dError, 0.0);
+        dMaxError = fmax(dMaxError, fabs(dFed - dPlain - dFf));
+    }
+
+    // Duty limits, the feed-forward alone is past max
+    initTestPID(&sFed, 0.04, 0.01, 0.0, 0.02, 0.98);
+    setPIDFeedForward(&sFed, numFromFloat(1.5));
+    dClamped = step(&sFed, 0.0, 0.0);
+
+    // Held at 0.3 with the feed-forward on, then handed back with the error still 0
+    setPIDFeedForward(&sFed, numFromFloat(0.2));
+    setPIDManual(&sFed, numFromFloat(0.3));
+    dManual = step(&sFed, 50.0, 50.0);
+    setPIDAuto(&sFed);
+    dAuto = step(&sFed, 50.0, 50.0);
+    printf("  feed-forward %.1f: max %.6f off the plain output plus it, manual %.4f then auto %.4f\n",
+           dFf, dMaxError, dManual, dAuto);
+
+    return dMaxError <= OPEN_TOL * dFf && dClamped == numToFloat(numFromFloat(0.98))
+           && fabs(dAuto - dManual) <= OPEN_TOL;
+}
+
+
+int
+main (void)
+{
+    printf("num_t is %s\n", NUM_NAME);
+
+    check(checkOpenLoop(), "open loop: proportional plus integral ramp");
+    check(checkDerivative(), "open loop: derivative on the measurement, no kick");
+    check(checkClosedLoop(), "closed loop: first order response, settles in 4 tau_c");
+    check(checkLimits(), "output held within min and max");
+    check(checkReset(), "resetPID gives the response of a new controller");
+    check(checkInstances(), "two controllers run independently");
+    check(checkFeedForward(), "feed-forward added before the clamp, no bump from manual");
+
+    printf("%u failures\n", (unsigned) g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
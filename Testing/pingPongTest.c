@@ -0,0 +1,254 @@
+/*******************************************************
+ * pingPongTest.c
+ *
+ * Host test of the uDMA half-buffer hand-off used by
+ * getHeightTask with ADC_USE_UDMA (Drivers/pingPongBuf.c).
+ *
+ * A stand-in for the uDMA writes a counting sequence into
+ * the ping and pong halves one sample at a time, counting
+ * down each half's transfer count, and moves straight on to
+ * the other half when one is full (stalling if it has not
+ * been re-armed). A separate interrupt step, run later like
+ * ADCIntHandler, re-arms each full half and publishes it.
+ * The consumer reads blocks like getHeightTask, one sample
+ * at a time, with the three interleaved in a random order
+ * and at a range of consumer speeds.
+ *
+ * Checks that every block the consumer accepts is one
+ * whole, untouched half (its samples are exactly the
+ * ticket's run of the sequence), that refilled halves are
+ * always rejected, and that tickets plus overruns account
+ * for every completed half. Also counts the torn blocks the
+ * ticket alone would have accepted, refilled before the
+ * interrupt published the next ticket.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -IDrivers -o ping_pong_test Testing/pingPongTest.c
+ *         Drivers/pingPongBuf.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stddef.h>
+
+#include "pingPongBuf.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_HALF_SIZE      64  // ADC_DMA_HALF_SIZE
+#define TEST_SAMPLES        2000000  // Samples written by the DMA stand-in per run
+#define TEST_SPEEDS         5
+#define TEST_ISR_PCT        2  // Share of the steps given to the interrupt stand-in
+
+
+static volatile uint16_t g_pui16Ping[TEST_HALF_SIZE];
+static volatile uint16_t g_pui16Pong[TEST_HALF_SIZE];
+
+
+// uDMA stand-in
+typedef struct
+{
+    uint32_t ui32Half;  // Half being filled
+    uint32_t pui32Remaining[2];  // Transfer count of each half, 0 once stopped
+    uint32_t ui32Pending;  // Halves filled but not yet handled by the interrupt
+    uint32_t ui32Sample;  // Next value of the counting sequence
+} testDMA_t;
+
+// Consumer state, as getHeightTask steps through a block
+typedef struct
+{
+    const volatile uint16_t *pui16Block;
+    uint32_t ui32Ticket;
+    uint32_t ui32Index;
+    uint32_t ui32LastTicket;
+    bool bIntact;  // Every sample read so far matched the ticket's run
+} testConsumer_t;
+
+typedef struct
+{
+    uint32_t ui32Accepted;
+    uint32_t ui32Rejected;
+    uint32_t ui32TornAccepted;  // Accepted blocks that were not whole (must stay 0)
+    uint32_t ui32TornTicketOnly;  // Torn blocks a newer ticket did not show
+    uint32_t ui32OrderErrors;  // Tickets that did not increase (must stay 0)
+} testResult_t;
+
+
+/*******************************************************
+ * Function: nextRandom
+ *******************************************************/
+static uint32_t
+nextRandom (uint32_t *pui32Seed)
+{
+    *pui32Seed ^= *pui32Seed << 13;
+    *pui32Seed ^= *pui32Seed >> 17;
+    *pui32Seed ^= *pui32Seed << 5;
+    return *pui32Seed;
+}
+
+
+/*******************************************************
+ * Function: dmaWrite
+ *
+ * Writes one sample, switching to the other half on its own
+ * when one is full
+ *
+ * returns: false if stalled on a half not yet re-armed
+ *******************************************************/
+static bool
+dmaWrite (testDMA_t *psDMA, pingPongBuf_t *psBuffer)
+{
+    uint32_t ui32Index = TEST_HALF_SIZE - psDMA->pui32Remaining[psDMA->ui32Half];
+
+    if (psDMA->pui32Remaining[psDMA->ui32Half] == 0) {
+        return false;
+    }
+
+    psBuffer->half[psDMA->ui32Half][ui32Index] = (uint16_t) psDMA->ui32Sample++;
+
+    if (--psDMA->pui32Remaining[psDMA->ui32Half] == 0) {
+        psDMA->ui32Pending++;
+        psDMA->ui32Half ^= 1;
+    }
+    return true;
+}
+
+
+/*******************************************************
+ * Function: isrStep
+ *
+ * The completion steps of ADCIntHandler: re-arm each full
+ * half in order, then publish it
+ *******************************************************/
+static void
+isrStep (testDMA_t *psDMA, pingPongBuf_t *psBuffer)
+{
+    uint32_t ui32Half;
+
+    while (psDMA->ui32Pending > 0) {
+        ui32Half = nextPingPongBuf(psBuffer);
+        if (psDMA->pui32Remaining[ui32Half] != 0) {
+            printf("DMA and hand-off disagree on the half\n");
+        }
+        psDMA->pui32Remaining[ui32Half] = TEST_HALF_SIZE;
+        completePingPongBuf(psBuffer);
+        psDMA->ui32Pending--;
+    }
+}
+
+
+/*******************************************************
+ * Function: consumerStep
+ *
+ * One step of the consumer: acquire a block, read one
+ * sample of it, or check it once it has all been read
+ *******************************************************/
+static void
+consumerStep (testConsumer_t *psCon, pingPongBuf_t *psBuffer, const testDMA_t *psDMA,
+              testResult_t *psResult)
+{
+    uint32_t ui32Remaining;
+
+    if (psCon->pui16Block == NULL) {
+        psCon->pui16Block = acquirePingPongBuf(psBuffer, &psCon->ui32Ticket);
+        if (psCon->pui16Block != NULL) {
+            psResult->ui32OrderErrors += (psCon->ui32Ticket <= psCon->ui32LastTicket);
+            psCon->ui32LastTicket = psCon->ui32Ticket;
+            psCon->ui32Index = 0;
+            psCon->bIntact = true;
+        }
+        return;
+    }
+
+    if (psCon->ui32Index < TEST_HALF_SIZE) {
+        uint16_t ui16Expected = (uint16_t) ((psCon->ui32Ticket - 1) * TEST_HALF_SIZE + psCon->ui32Index);
+
+        psCon->bIntact &= (psCon->pui16Block[psCon->ui32Index] == ui16Expected);
+        psCon->ui32Index++;
+        return;
+    }
+
+    ui32Remaining = psDMA->pui32Remaining[(psCon->ui32Ticket - 1) & 1];
+    if (checkPingPongBuf(psBuffer, psCon->ui32Ticket, ui32Remaining)) {
+        psResult->ui32Accepted++;
+        psResult->ui32TornAccepted += !psCon->bIntact;
+    } else {
+        psResult->ui32Rejected++;
+        psResult->ui32TornTicketOnly += !psCon->bIntact && (psBuffer->completed == psCon->ui32Ticket);
+    }
+    psCon->pui16Block = NULL;
+}
+
+
+/*******************************************************
+ * Function: runSpeed
+ *
+ * Runs the DMA, interrupt and consumer stand-ins
+ * interleaved at random, with the consumer getting
+ * ui32ConsumerPct% of the steps
+ *
+ * returns: true if every check passes
+ *******************************************************/
+static bool
+runSpeed (uint32_t ui32ConsumerPct, uint32_t ui32Seed)
+{
+    pingPongBuf_t sBuffer;
+    testDMA_t sDMA = { 0, { TEST_HALF_SIZE, TEST_HALF_SIZE }, 0, 0 };
+    testConsumer_t sCon = { NULL, 0, 0, 0, false };
+    testResult_t sResult = { 0, 0, 0, 0, 0 };
+    uint32_t ui32Written = 0, ui32Ticket, ui32Roll;
+    bool bPass;
+
+    initPingPongBuf(&sBuffer, g_pui16Ping, g_pui16Pong, TEST_HALF_SIZE);
+
+    while (ui32Written < TEST_SAMPLES) {
+        ui32Roll = nextRandom(&ui32Seed) % 100;
+        if (ui32Roll < TEST_ISR_PCT) {
+            isrStep(&sDMA, &sBuffer);
+        } else if (ui32Roll - TEST_ISR_PCT < ui32ConsumerPct * (100 - TEST_ISR_PCT) / 100) {
+            consumerStep(&sCon, &sBuffer, &sDMA, &sResult);
+        } else {
+            ui32Written += dmaWrite(&sDMA, &sBuffer);
+        }
+    }
+
+    // Publish the last half, finish the block in progress, then take any last half so every ticket is accounted for
+    isrStep(&sDMA, &sBuffer);
+    while (sCon.pui16Block != NULL) {
+        consumerStep(&sCon, &sBuffer, &sDMA, &sResult);
+    }
+    if (acquirePingPongBuf(&sBuffer, &ui32Ticket) != NULL) {
+        sResult.ui32Accepted++;
+    }
+
+    bPass = (sResult.ui32TornAccepted == 0) && (sResult.ui32OrderErrors == 0)
+            && (sResult.ui32Accepted + sResult.ui32Rejected + sBuffer.overruns == sBuffer.completed)
+            && (sBuffer.completed == TEST_SAMPLES / TEST_HALF_SIZE);
+
+    printf("consumer %3u%%: %6u halves, %6u accepted, %6u refilled while read (%5u before the next ticket), %6u skipped  %s\n",
+           ui32ConsumerPct, sBuffer.completed, sResult.ui32Accepted, sResult.ui32Rejected,
+           sResult.ui32TornTicketOnly, sBuffer.overruns, bPass ? "ok" : "FAIL");
+    return bPass;
+}
+
+
+int
+main (void)
+{
+    // From a consumer far slower than the DMA, to one that keeps up easily
+    static const uint32_t pui32ConsumerPct[TEST_SPEEDS] = { 5, 30, 50, 70, 95 };
+    uint32_t i, ui32Failures = 0;
+
+    for (i = 0; i < TEST_SPEEDS; i++) {
+        ui32Failures += !runSpeed(pui32ConsumerPct[i], 0x2545F491 + i);
+    }
+
+    printf("%u failures\n", ui32Failures);
+    return ui32Failures ? 1 : 0;
+}
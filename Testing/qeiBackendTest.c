@@ -0,0 +1,358 @@
+/*******************************************************
+ * qeiBackendTest.c
+ *
+ * Host test of the QEI yaw backend (get_yaw_task.c built
+ * with YAW_USE_QEI), against the simulated QEI0 whose state
+ * is held in its registers (inc/hw_qei.h).
+ *
+ * Checks:
+ *   - the registers initGetYawTask() leaves configured
+ *   - getQuadCount() and getQuadVelocity() read back the
+ *     position, speed and direction written straight into
+ *     the register file
+ *   - a random walk of encoder edges gives the same
+ *     position as a reference count, and the velocity of
+ *     each period
+ *   - a YawPosition follows the count across its 2^32 wrap
+ *   - counting the edges runs no interrupt handler, only
+ *     the velocity timer interrupts, once a period
+ *   - a phase error interrupt is counted as an illegal
+ *     transition and cleared
+ *
+ * The FreeRTOS calls made by get_yaw_task.c are stubbed
+ * below, only the headers from the POSIX port are needed.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -DYAW_USE_QEI=1 -ISimulation -I. -I"HeliRig Project" -Iutils
+ *         -IFreeRTOS/include -I$POSIX_PORT -o qei_backend_test Testing/qeiBackendTest.c
+ *         "HeliRig Project"/get_yaw_task.c utils/ustdlib.c Simulation/sim_peripherals.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_gpio.h"
+#include "inc/hw_qei.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "sim_peripherals.h"
+#include "get_yaw_task.h"
+
+#if !YAW_USE_QEI
+#error qeiBackendTest.c must be built with -DYAW_USE_QEI=1
+#endif
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_CLOCK_HZ       80000000
+#define TEST_PERIODS        2000  // Velocity periods in the random walk
+#define TEST_MAX_RATE       40  // Most edges per millisecond (about 32 rev/s)
+#define TEST_PERIOD_MS      (1000 / QEI_VEL_HZ)
+
+
+static uint32_t g_ui32Failures;
+
+
+/*******************************************************
+ * FreeRTOS stubs
+ *******************************************************/
+BaseType_t
+xTaskCreate (TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth,
+             void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    (void) pxTaskCode;
+    (void) pcName;
+    (void) usStackDepth;
+    (void) pvParameters;
+    (void) uxPriority;
+    (void) pxCreatedTask;
+    return pdPASS;  // The task itself is not run
+}
+
+BaseType_t
+xQueueGenericSend (QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait,
+                   const BaseType_t xCopyPosition)
+{
+    (void) xQueue;
+    (void) pvItemToQueue;
+    (void) xTicksToWait;
+    (void) xCopyPosition;
+    return pdPASS;
+}
+
+void
+vTaskDelay (const TickType_t xTicksToDelay)
+{
+    (void) xTicksToDelay;
+}
+
+BaseType_t
+xTaskNotifyWait (uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue,
+                 TickType_t xTicksToWait)
+{
+    (void) ulBitsToClearOnEntry;
+    (void) ulBitsToClearOnExit;
+    (void) pulNotificationValue;
+    (void) xTicksToWait;
+    return pdFALSE;
+}
+
+BaseType_t
+xTaskGenericNotifyFromISR (TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                           uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void) xTaskToNotify;
+    (void) ulValue;
+    (void) eAction;
+    (void) pulPreviousNotificationValue;
+    (void) pxHigherPriorityTaskWoken;
+    return pdPASS;  // Not reached, the task is never created so there is no handle
+}
+
+TickType_t
+xTaskGetTickCount (void)
+{
+    return (TickType_t) (simTimeGet() / 1000);  // One tick is 1 ms (configTICK_RATE_HZ)
+}
+
+void
+vPortYield (void)
+{
+}
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: checkConfig
+ *
+ * returns: true if QEI0 and its pins are set up as
+ *          initQEI() intends
+ *******************************************************/
+static bool
+checkConfig (void)
+{
+    uint32_t ui32Ctl = HWREG(QEI_BASE + QEI_O_CTL);
+    uint32_t ui32Want = QEI_CTL_ENABLE | QEI_CTL_SWAP | QEI_CTL_CAPMODE | QEI_CTL_VELEN;
+    bool bPass = true;
+
+    if (ui32Ctl != ui32Want) {
+        printf("  QEI_O_CTL 0x%08x, expected 0x%08x\n", (unsigned) ui32Ctl, (unsigned) ui32Want);
+        bPass = false;
+    }
+    if (HWREG(QEI_BASE + QEI_O_MAXPOS) != 0xFFFFFFFF) {
+        printf("  QEI_O_MAXPOS %u\n", (unsigned) HWREG(QEI_BASE + QEI_O_MAXPOS));
+        bPass = false;
+    }
+    if (HWREG(QEI_BASE + QEI_O_LOAD) != TEST_CLOCK_HZ / QEI_VEL_HZ - 1) {
+        printf("  QEI_O_LOAD %u\n", (unsigned) HWREG(QEI_BASE + QEI_O_LOAD));
+        bPass = false;
+    }
+    if (HWREG(QEI_BASE + QEI_O_INTEN) != (QEI_INT_ERROR | QEI_INT_TIMER)) {
+        printf("  QEI_O_INTEN 0x%08x, only the phase error and velocity timer should interrupt\n",
+               (unsigned) HWREG(QEI_BASE + QEI_O_INTEN));
+        bPass = false;
+    }
+    if ((HWREG(QEI_GPIO_BASE + GPIO_O_CR) & QEI_GPIO_PINS) != QEI_GPIO_PINS
+        || HWREG(QEI_GPIO_BASE + GPIO_O_LOCK) != 0) {
+        printf("  PD7 not committed, or port D left unlocked\n");
+        bPass = false;
+    }
+
+    return bPass;
+}
+
+
+/*******************************************************
+ * Function: checkRegisters
+ *
+ * Writes position, speed and direction into the register
+ * file and reads them back through the backend
+ *
+ * returns: true if every value reads back as expected
+ *******************************************************/
+static bool
+checkRegisters (void)
+{
+    static const struct
+    {
+        uint32_t ui32Pos, ui32Speed, ui32Stat;
+        int32_t i32Count, i32Velocity;
+    } psCases[] = {
+        {   0,   0, 0,                  0,                 0 },
+        { 123,  45, 0,                123,  45 * QEI_VEL_HZ },
+        { 449,  45, QEI_STAT_DIRECTION, 449, -45 * QEI_VEL_HZ },
+        { 200, 900, QEI_STAT_ERROR,     200, 900 * QEI_VEL_HZ },
+    };
+    uint32_t i;
+    bool bPass = true;
+
+    for (i = 0; i < sizeof(psCases) / sizeof(psCases[0]); i++) {
+        HWREG(QEI_BASE + QEI_O_POS) = psCases[i].ui32Pos;
+        HWREG(QEI_BASE + QEI_O_SPEED) = psCases[i].ui32Speed;
+        HWREG(QEI_BASE + QEI_O_STAT) = psCases[i].ui32Stat;
+
+        if (getQuadCount() != psCases[i].i32Count || getQuadVelocity() != psCases[i].i32Velocity) {
+            printf("  POS %u SPEED %u STAT %u: count %d velocity %d\n", (unsigned) psCases[i].ui32Pos,
+                   (unsigned) psCases[i].ui32Speed, (unsigned) psCases[i].ui32Stat, getQuadCount(),
+                   getQuadVelocity());
+            bPass = false;
+        }
+    }
+
+    HWREG(QEI_BASE + QEI_O_POS) = 0;
+    HWREG(QEI_BASE + QEI_O_SPEED) = 0;
+    HWREG(QEI_BASE + QEI_O_STAT) = 0;
+    return bPass;
+}
+
+
+/*******************************************************
+ * Function: walkEdges
+ *
+ * Drives a random walk of encoder edges, one velocity
+ * period at a time at a random rate and direction, and
+ * compares the backend with a reference count
+ *
+ * returns: true if position and velocity always match
+ *******************************************************/
+static bool
+walkEdges (uint32_t ui32Seed)
+{
+    uint32_t ui32Reference = (uint32_t) getQuadCount();
+    int32_t i32Rate, i32Velocity;
+    uint32_t ui32Period, ui32Ms;
+    bool bPass = true;
+
+    for (ui32Period = 0; ui32Period < TEST_PERIODS; ui32Period++) {
+        ui32Seed = ui32Seed * 1664525u + 1013904223u;
+        i32Rate = (int32_t) ((ui32Seed >> 16) % (2 * TEST_MAX_RATE + 1)) - TEST_MAX_RATE;
+
+        for (ui32Ms = 0; ui32Ms < TEST_PERIOD_MS; ui32Ms++) {
+            simQEIInputStep(QEI_BASE, i32Rate);
+            simStep(1000);
+            ui32Reference += (uint32_t) i32Rate;
+        }
+
+        // A period ends on every TEST_PERIOD_MS boundary, so it saw exactly this rate
+        i32Velocity = i32Rate * TEST_PERIOD_MS * QEI_VEL_HZ;
+        if ((uint32_t) getQuadCount() != ui32Reference || (i32Rate != 0 && getQuadVelocity() != i32Velocity)
+            || (i32Rate == 0 && getQuadVelocity() != 0)) {
+            printf("  period %u, rate %d: count %d (expected %d), velocity %d (expected %d)\n",
+                   (unsigned) ui32Period, i32Rate, getQuadCount(), (int32_t) ui32Reference, getQuadVelocity(),
+                   i32Velocity);
+            bPass = false;
+            break;
+        }
+    }
+
+    return bPass;
+}
+
+
+/*******************************************************
+ * Function: checkWrap
+ *
+ * Starts the QEI just below 2^32 and drives it down and
+ * then up across the wrap, following it with a YawPosition
+ *
+ * returns: true if the absolute position, revolutions and
+ *          position in the revolution stay continuous
+ *******************************************************/
+static bool
+checkWrap (void)
+{
+    YawPosition sPosition;
+    int64_t i64Expected = 0;
+    int32_t i32Step, i32Rev;
+    uint32_t i;
+    bool bPass = true;
+
+    HWREG(QEI_BASE + QEI_O_POS) = 0xFFFFFFFF - 3 * YAW_COUNTS_PER_REV;
+    initYawPosition(&sPosition);
+
+    for (i = 0; i < 40; i++) {
+        i32Step = (i < 20) ? YAW_COUNTS_PER_REV / 2 + 7 : -(YAW_COUNTS_PER_REV / 3 + 5);
+        simQEIInputStep(QEI_BASE, i32Step);
+        i64Expected += i32Step;
+
+        updateYawPosition(&sPosition);
+        i32Rev = (int32_t) ((i64Expected >= 0) ? i64Expected / YAW_COUNTS_PER_REV
+                                                : -((-i64Expected + YAW_COUNTS_PER_REV - 1) / YAW_COUNTS_PER_REV));
+        if (sPosition.count != i64Expected || yawRevolutions(&sPosition) != i32Rev
+            || yawCountInRev(&sPosition) != (int32_t) (i64Expected - (int64_t) i32Rev * YAW_COUNTS_PER_REV)) {
+            printf("  step %u: position %lld, expected %lld, revolution %d, in revolution %d\n", (unsigned) i,
+                   (long long) sPosition.count, (long long) i64Expected, yawRevolutions(&sPosition),
+                   yawCountInRev(&sPosition));
+            bPass = false;
+        }
+    }
+
+    return bPass;
+}
+
+
+int
+main (void)
+{
+    xQueueHandle xQueue = NULL;
+    const simStats_t *psStats = simStatsGet();
+    uint32_t ui32Ints, ui32QEIInts;
+    uint64_t ui64Start;
+
+    simReset();
+    SysCtlClockSet(SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    check(SysCtlClockGet() == TEST_CLOCK_HZ, "system clock at 80 MHz");
+    simGPIOInputSet(YAW_REF_BASE, YAW_REF_PIN, YAW_REF_PIN);  // Not over the reference, positions count from power on
+    check(initGetYawTask(&xQueue) == 0, "initGetYawTask");
+    IntMasterEnable();
+
+    check(checkConfig(), "QEI0 and PD6/PD7 configured");
+    check(getQuadCount() == 0 && getQuadVelocity() == 0 && getQuadIllegal() == 0, "count starts at 0");
+    check(checkRegisters(), "count and velocity read from the registers");
+
+    ui32Ints = psStats->ui32GPIOInts + psStats->ui32TimerInts;
+    ui32QEIInts = psStats->ui32QEIInts;
+    ui64Start = simTimeGet();
+    check(walkEdges(0x1234567), "random walk: count and velocity follow the edges");
+    check(walkEdges(0x89ABCDE), "random walk: second seed");
+    printf("%u simulated milliseconds, %u QEI interrupts\n", (unsigned) ((simTimeGet() - ui64Start) / 1000),
+           (unsigned) (psStats->ui32QEIInts - ui32QEIInts));
+    check(psStats->ui32GPIOInts + psStats->ui32TimerInts == ui32Ints
+          && psStats->ui32QEIInts - ui32QEIInts == (simTimeGet() - ui64Start) * QEI_VEL_HZ / 1000000,
+          "one velocity timer interrupt a period, none per edge");
+
+    check(checkWrap(), "YawPosition follows the count across 2^32");
+
+    HWREG(QEI_BASE + QEI_O_RIS) |= QEI_INT_ERROR;
+    simStep(1000);
+    check(getQuadIllegal() == 1 && !(HWREG(QEI_BASE + QEI_O_RIS) & QEI_INT_ERROR),
+          "phase error counted as illegal, and cleared");
+    check(psStats->ui32StuckInts == 0, "the handler always clears its interrupt");
+
+    printf("%u failures\n", (unsigned) g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
@@ -0,0 +1,368 @@
+/*******************************************************
+ * quadDecodeTest.c
+ *
+ * Host fuzz test of the table driven quadrature decoder
+ * (quadIntHandler in get_yaw_task.c), run against the
+ * simulated Port B.
+ *
+ * First checks the transition table against the XOR
+ * decoder it replaced, for all 16 transitions. Then drives
+ * PB0/PB1 with random streams of edges:
+ *   - valid edges only, a random walk with runs in each
+ *     direction, where the count must follow exactly and
+ *     no illegal transitions may be counted
+ *   - invalid jumps, where both pins change at once
+ *   - missed edges, where interrupts are held off for a
+ *     random number of edges so the handler sees the
+ *     result of several at once
+ * For the last two the count and illegal transitions are
+ * compared with a reference that decodes the pin states
+ * the handler actually saw from their Gray code positions.
+ *
+ * Also times the handler against the XOR decoder, both
+ * reading the simulated port.
+ *
+ * The FreeRTOS calls made by get_yaw_task.c are stubbed
+ * below, only the headers from the POSIX port are needed.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -ISimulation -I. -I"HeliRig Project" -Iutils -IFreeRTOS/include
+ *         -I$POSIX_PORT -o quad_decode_test Testing/quadDecodeTest.c "HeliRig Project"/get_yaw_task.c
+ *         utils/ustdlib.c Simulation/sim_peripherals.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "sim_peripherals.h"
+#include "get_yaw_task.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_EDGES          2000000  // Per fuzz run
+#define TEST_MAX_HOLD       5  // Most edges an interrupt is held off for
+#define BENCH_EDGES         10000000
+
+
+// Pin states in Gray code order, counting up (B leads A)
+static const uint8_t g_pui8Phase[4] = { 0, GPIO_PIN_1, GPIO_PIN_0 | GPIO_PIN_1, GPIO_PIN_0 };
+static const uint8_t g_pui8PhaseOf[4] = { 0, 3, 1, 2 };  // Position in g_pui8Phase of each AB
+
+static uint32_t g_ui32Failures;
+
+// The decoder quadIntHandler replaced, for comparison
+static volatile struct
+{
+    uint8_t A, B, L, R, Ap, Bp;
+    int32_t sum;
+} g_sLegacy;
+
+
+/*******************************************************
+ * FreeRTOS stubs
+ *******************************************************/
+BaseType_t
+xTaskCreate (TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth,
+             void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    (void) pxTaskCode;
+    (void) pcName;
+    (void) usStackDepth;
+    (void) pvParameters;
+    (void) uxPriority;
+    (void) pxCreatedTask;
+    return pdPASS;  // The task itself is not run
+}
+
+BaseType_t
+xQueueGenericSend (QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait,
+                   const BaseType_t xCopyPosition)
+{
+    (void) xQueue;
+    (void) pvItemToQueue;
+    (void) xTicksToWait;
+    (void) xCopyPosition;
+    return pdPASS;
+}
+
+void
+vTaskDelay (const TickType_t xTicksToDelay)
+{
+    (void) xTicksToDelay;
+}
+
+BaseType_t
+xTaskNotifyWait (uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue,
+                 TickType_t xTicksToWait)
+{
+    (void) ulBitsToClearOnEntry;
+    (void) ulBitsToClearOnExit;
+    (void) pulNotificationValue;
+    (void) xTicksToWait;
+    return pdFALSE;
+}
+
+BaseType_t
+xTaskGenericNotifyFromISR (TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                           uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void) xTaskToNotify;
+    (void) ulValue;
+    (void) eAction;
+    (void) pulPreviousNotificationValue;
+    (void) pxHigherPriorityTaskWoken;
+    return pdPASS;  // Not reached, the task is never created so there is no handle
+}
+
+TickType_t
+xTaskGetTickCount (void)
+{
+    return (TickType_t) (simTimeGet() / 1000);  // One tick is 1 ms (configTICK_RATE_HZ)
+}
+
+void
+vPortYield (void)
+{
+}
+
+
+/*******************************************************
+ * Function: legacyIntHandler
+ *
+ * The XOR decoder quadIntHandler replaced
+ *******************************************************/
+static void
+legacyIntHandler (void)
+{
+    g_sLegacy.A = (GPIOPinRead (GPIO_PORTB_BASE, GPIO_PIN_0) == GPIO_PIN_0);
+    g_sLegacy.B = (GPIOPinRead (GPIO_PORTB_BASE, GPIO_PIN_1) == GPIO_PIN_1);
+    g_sLegacy.L = (g_sLegacy.A ^ g_sLegacy.Bp);
+    g_sLegacy.R = (g_sLegacy.B ^ g_sLegacy.Ap);
+    g_sLegacy.sum = g_sLegacy.sum - g_sLegacy.L + g_sLegacy.R;
+    g_sLegacy.Ap = g_sLegacy.A;
+    g_sLegacy.Bp = g_sLegacy.B;
+
+    GPIOIntClear(GPIO_PORTB_BASE, GPIO_INT_PIN_0);
+    GPIOIntClear(GPIO_PORTB_BASE, GPIO_INT_PIN_1);
+}
+
+
+/*******************************************************
+ * Function: nextRandom
+ *******************************************************/
+static uint32_t
+nextRandom (uint32_t *pui32Seed)
+{
+    *pui32Seed ^= *pui32Seed << 13;
+    *pui32Seed ^= *pui32Seed >> 17;
+    *pui32Seed ^= *pui32Seed << 5;
+    return *pui32Seed;
+}
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: checkTable
+ *
+ * Every transition through quadIntHandler against the XOR
+ * decoder from the same previous and current pins
+ *
+ * returns: true if the legal transitions count the same
+ *          and only the illegal ones are flagged
+ *******************************************************/
+static bool
+checkTable (void)
+{
+    uint32_t ui32From, ui32To;
+    int32_t i32Count, i32Legacy;
+    uint32_t ui32Illegal;
+    bool bIllegal, bPass = true;
+
+    for (ui32From = 0; ui32From < 4; ui32From++) {
+        for (ui32To = 0; ui32To < 4; ui32To++) {
+            // Set the previous state with interrupts held off, then run both handlers from it
+            IntMasterDisable();
+            simGPIOInputSet(GPIO_PORTB_BASE, QUAD_PINS, ui32From);
+            quadIntHandler();
+            legacyIntHandler();
+            i32Count = getQuadCount();
+            i32Legacy = g_sLegacy.sum;
+            ui32Illegal = getQuadIllegal();
+
+            simGPIOInputSet(GPIO_PORTB_BASE, QUAD_PINS, ui32To);
+            quadIntHandler();
+            legacyIntHandler();
+            IntMasterEnable();
+
+            bIllegal = (ui32From ^ ui32To) == QUAD_PINS;
+            if (getQuadCount() - i32Count != g_sLegacy.sum - i32Legacy
+                || getQuadIllegal() - ui32Illegal != (uint32_t) bIllegal) {
+                printf("  AB %u%u -> %u%u: count %+d, legacy %+d, illegal %u\n", (ui32From >> 1) & 1, ui32From & 1,
+                       (ui32To >> 1) & 1, ui32To & 1, getQuadCount() - i32Count, g_sLegacy.sum - i32Legacy,
+                       getQuadIllegal() - ui32Illegal);
+                bPass = false;
+            }
+        }
+    }
+
+    return bPass;
+}
+
+
+/*******************************************************
+ * Function: fuzzEdges
+ *
+ * Drives ui32Edges random edges, with ui32JumpPct% of
+ * steps an invalid jump (both pins at once) and
+ * ui32HoldPct% of steps holding the interrupt off for up
+ * to TEST_MAX_HOLD edges. After each interrupt the decoder
+ * must agree with a reference that decodes the change in
+ * Gray code position since the state last seen.
+ *
+ * returns: true if the count and illegal transitions always
+ *          agreed with the reference
+ *******************************************************/
+static bool
+fuzzEdges (uint32_t ui32Edges, uint32_t ui32JumpPct, uint32_t ui32HoldPct, uint32_t ui32Seed)
+{
+    uint32_t ui32Position, ui32Seen, ui32Hold = 0, ui32Step;
+    int32_t i32Expected, i32Direction = 1;
+    uint32_t ui32ExpectedIllegal, ui32Mismatches = 0, i;
+
+    // Start from the current pins, as initGetYawTask() does
+    ui32Position = g_pui8PhaseOf[GPIOPinRead(GPIO_PORTB_BASE, QUAD_PINS)];
+    ui32Seen = ui32Position;
+    i32Expected = getQuadCount();
+    ui32ExpectedIllegal = getQuadIllegal();
+
+    for (i = 0; i < ui32Edges; i++) {
+        // Mostly keep turning the same way, as the rotor does
+        if (nextRandom(&ui32Seed) % 64 == 0) {
+            i32Direction = -i32Direction;
+        }
+
+        if (ui32Hold == 0 && nextRandom(&ui32Seed) % 100 < ui32HoldPct) {
+            ui32Hold = 2 + nextRandom(&ui32Seed) % (TEST_MAX_HOLD - 1);
+            IntMasterDisable();
+        }
+
+        ui32Step = (nextRandom(&ui32Seed) % 100 < ui32JumpPct) ? 2 : (uint32_t) i32Direction;
+        ui32Position = (ui32Position + ui32Step) & 3;
+        simGPIOInputSet(GPIO_PORTB_BASE, QUAD_PINS, g_pui8Phase[ui32Position]);
+
+        if (ui32Hold != 0 && --ui32Hold != 0) {
+            continue;  // Interrupt still held off
+        }
+        IntMasterEnable();  // The handler runs once, for every edge since the last
+
+        // Reference: the change in position the handler can see
+        switch ((ui32Position - ui32Seen) & 3) {
+        case 1: i32Expected++; break;
+        case 3: i32Expected--; break;
+        case 2: ui32ExpectedIllegal++; break;
+        default: break;
+        }
+        ui32Seen = ui32Position;
+
+        if (getQuadCount() != i32Expected || getQuadIllegal() != ui32ExpectedIllegal) {
+            if (ui32Mismatches++ < 5) {
+                printf("  edge %u: count %d, expected %d, illegal %u, expected %u\n", i, getQuadCount(),
+                       i32Expected, getQuadIllegal(), ui32ExpectedIllegal);
+            }
+        }
+    }
+
+    return ui32Mismatches == 0;
+}
+
+
+/*******************************************************
+ * Function: benchHandler
+ *
+ * returns: ns per edge for a handler, with interrupts held
+ *          off so only the direct calls run it
+ *******************************************************/
+static double
+benchHandler (void (*pfnHandler)(void))
+{
+    clock_t sStart;
+    uint32_t i;
+
+    IntMasterDisable();
+    sStart = clock();
+    for (i = 0; i < BENCH_EDGES; i++) {
+        simGPIOInputSet(GPIO_PORTB_BASE, QUAD_PINS, g_pui8Phase[i & 3]);
+        if (pfnHandler != NULL) {
+            pfnHandler();
+        }
+    }
+    IntMasterEnable();
+
+    return (double) (clock() - sStart) / CLOCKS_PER_SEC * 1e9 / BENCH_EDGES;
+}
+
+
+int
+main (void)
+{
+    QueueHandle_t xQueue = NULL;
+    const simStats_t *psStats;
+    uint32_t ui32Illegal, ui32Ints;
+    double dBase, dTable, dLegacy;
+
+    simReset();
+    simGPIOInputSet(GPIO_PORTB_BASE, QUAD_PINS, GPIO_PIN_0);  // Start part way through the cycle
+    check(initGetYawTask(&xQueue) == 0, "initGetYawTask");
+    IntMasterEnable();
+    check(getQuadCount() == 0 && getQuadIllegal() == 0, "count starts at 0 from the current pins");
+
+    check(checkTable(), "all 16 transitions match the XOR decoder");
+
+    ui32Illegal = getQuadIllegal();
+    check(fuzzEdges(TEST_EDGES, 0, 0, 0x1234567), "valid edges: count follows every edge");
+    check(getQuadIllegal() == ui32Illegal, "valid edges: no illegal transitions");
+    check(fuzzEdges(TEST_EDGES, 3, 0, 0x89ABCDE), "invalid jumps: counted illegal, count unchanged");
+    check(fuzzEdges(TEST_EDGES, 0, 5, 0x2468ACE), "missed edges: decoded as the handler saw them");
+    check(fuzzEdges(TEST_EDGES, 3, 5, 0x13579BD), "jumps and missed edges together");
+    printf("%u illegal transitions counted in all\n", getQuadIllegal());
+
+    psStats = simStatsGet();
+    ui32Ints = psStats->ui32GPIOInts;
+    check(psStats->ui32StuckInts == 0, "the handler always clears its interrupt");
+
+    // Cost of the handlers, less the cost of changing the simulated pins
+    dBase = benchHandler(NULL);
+    dTable = benchHandler(quadIntHandler) - dBase;
+    dLegacy = benchHandler(legacyIntHandler) - dBase;
+    printf("%u interrupts, handler on the host: table %.1f ns, XOR decoder %.1f ns per edge\n",
+           ui32Ints, dTable, dLegacy);
+
+    printf("%u failures\n", g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
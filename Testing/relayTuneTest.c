@@ -0,0 +1,468 @@
+/*******************************************************
+ * relayTuneTest.c
+ *
+ * Host test of the relay feedback autotuner in
+ * relay_tune.c, run against the simulated HeliRig plant
+ * (Simulation/heli_plant.c).
+ *
+ * The plant is flown at CONTROL_RATE_HZ as control_task.c
+ * flies it (control_task.h gains, set point profiles and
+ * feed-forward), measured in ADC and quadrature counts
+ * as in Testing/trajectoryTest.c. Once it
+ * hovers, each loop in turn is handed to a RelayTune, as
+ * control_task.c does for startControlTune(), with the
+ * control_task.h relay settings. The identification data
+ * is streamed to stdout through the UART console stand-in
+ * (Simulation/sim_peripherals.c), in the same lines the
+ * rig sends.
+ *
+ * Checks that
+ *   - each relay experiment finishes, with Ku and Tu near
+ *     where the plant's model, as a describing function,
+ *     says the relay makes it oscillate (the hysteresis
+ *     moves that a little short of the ultimate point)
+ *   - the output stays within the duty limits
+ *   - the loop takes back over with the new gains without
+ *     a bump
+ *   - with the tuned gains, button presses and a half turn
+ *     settle within the 5 second requirement
+ *   - a loop that never oscillates gives up at the timeout
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -ISimulation -I"HeliRig Project" -o relay_tune_test Testing/relayTuneTest.c
+ *         "HeliRig Project"/relay_tune.c "HeliRig Project"/trajectory.c "HeliRig Project"/PI_controller.c
+ *         Simulation/heli_plant.c Simulation/sim_peripherals.c -lm
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+#include <complex.h>
+
+#include "heli_plant.h"
+#include "heli_math.h"
+#include "PI_controller.h"
+#include "trajectory.h"
+#include "relay_tune.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define PLANT_DT_S          0.001f  // Plant integration step
+#define CONTROL_DIVIDER     5  // Control runs every 5 plant steps (CONTROL_RATE_HZ, 200 Hz)
+#define CONTROL_DT_S        (PLANT_DT_S * CONTROL_DIVIDER)
+#define SETTLE_LIMIT_S      5.0f  // README hard requirement 5
+#define SETTLE_BAND         0.05f  // Settled within 5% of the step size
+#define MANOEUVRE_S         10.0f  // Flown for, from the set point change
+#define STREAM_DIVIDER      4  // Samples streamed every 4 cycles (50 Hz)
+#define MODEL_TOL           0.15f  // Ku and Tu within 15% of the model's
+#define BUMP_TOL            0.02f  // Duty change allowed at the hand back
+
+// control_task.h
+#define HEIGHT_KP           0.04f
+#define HEIGHT_KI           0.01f
+#define YAW_KP              0.008f
+#define YAW_KI              0.002f
+#define HEIGHT_TT           0.0f
+#define YAW_TT              1.0f
+#define DUTY_MIN            0.02f
+#define DUTY_MAX            0.98f
+#define HEIGHT_RATE         20.0f
+#define HEIGHT_ACCEL        40.0f
+#define HEIGHT_JERK         200.0f
+#define YAW_RATE            60.0f
+#define YAW_ACCEL           120.0f
+#define YAW_JERK            600.0f
+#define HEIGHT_FF_HOVER     0.45f
+#define HEIGHT_FF_RATE      0.0135f
+#define HEIGHT_FF_ACCEL     0.0036f
+#define HEIGHT_FF_JERK      0.000225f
+#define YAW_FF_RATE         0.0067f
+#define YAW_FF_ACCEL        0.00144f
+#define YAW_FF_JERK         0.0000556f
+#define HEIGHT_TUNE_STEP    0.3f  // Relay amplitude, duty
+#define HEIGHT_TUNE_BAND    1.0f  // Relay hysteresis, % (a count of getHeight(), whole %)
+#define YAW_TUNE_STEP       0.3f
+#define YAW_TUNE_BAND       0.4f  // Degrees, half a count: the next count over switches it
+#define TUNE_TIMEOUT_S      30
+
+// heli_plant.c, for the model's ultimate gain and period
+#define MODEL_LIFT          (100.0f * 2.0f / 0.45f)  // % per s^2 per unit duty
+#define MODEL_HEIGHT_DAMP   6.0f
+#define MODEL_MAIN_TAU      0.10f
+#define MODEL_TAIL          900.0f  // Degrees per s^2 per unit duty
+#define MODEL_YAW_DAMP      6.0f
+#define MODEL_TAIL_TAU      0.05f
+#define MODEL_DELAY_S       (CONTROL_DT_S / 2.0f)  // Output held over the period
+
+
+static uint32_t g_ui32Failures;
+
+
+// The plant and both loops
+typedef struct
+{
+    heliPlant_t sPlant;
+    PIDController sHeight;
+    PIDController sYaw;
+    Trajectory sHeightProfile;
+    Trajectory sYawProfile;
+    RelayTune sTune;
+    PIDController *psTuning;  // Loop handed to sTune, NULL for none
+    uint32_t ui32Cycle;
+    float fHeightSet;  // %
+    float fYawSet;  // deg
+    float fMainDuty;
+    float fTailDuty;
+} flight_t;
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: heightPct
+ *
+ * returns: the height the firmware would map from the
+ *          plant's ADC reading, %
+ *******************************************************/
+static float
+heightPct (flight_t *psFlight)
+{
+    return 242.0f - 0.081f * (float) heliPlantADCCounts(&psFlight->sPlant);
+}
+
+
+/*******************************************************
+ * Function: yawDeg
+ *******************************************************/
+static float
+yawDeg (flight_t *psFlight)
+{
+    return heliPlantQuadCount(&psFlight->sPlant) * 360.0f / PLANT_YAW_COUNTS_PER_REV;
+}
+
+
+/*******************************************************
+ * Function: initFlight
+ *
+ * Lands the plant and sets up both loops and profiles
+ *******************************************************/
+static void
+initFlight (flight_t *psFlight)
+{
+    initHeliPlant(&psFlight->sPlant);
+    initPID(&psFlight->sHeight, NUM_CONST(CONTROL_DT_S), NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN),
+            NUM_CONST(HEIGHT_KP), NUM_CONST(HEIGHT_KI), 0);
+    initPID(&psFlight->sYaw, NUM_CONST(CONTROL_DT_S), NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN),
+            NUM_CONST(YAW_KP), NUM_CONST(YAW_KI), 0);
+    setPIDWindup(&psFlight->sHeight, PID_WINDUP_BACK_CALC, NUM_CONST(HEIGHT_TT));
+    setPIDWindup(&psFlight->sYaw, PID_WINDUP_BACK_CALC, NUM_CONST(YAW_TT));
+    initTrajectory(&psFlight->sHeightProfile, NUM_CONST(CONTROL_DT_S), NUM_CONST(HEIGHT_RATE),
+                   NUM_CONST(HEIGHT_ACCEL), NUM_CONST(HEIGHT_JERK), 0);
+    initTrajectory(&psFlight->sYawProfile, NUM_CONST(CONTROL_DT_S), NUM_CONST(YAW_RATE),
+                   NUM_CONST(YAW_ACCEL), NUM_CONST(YAW_JERK), 0);
+    psFlight->psTuning = NULL;
+    psFlight->ui32Cycle = 0;
+    psFlight->fHeightSet = 0.0f;
+    psFlight->fYawSet = 0.0f;
+    psFlight->fMainDuty = 0.0f;
+    psFlight->fTailDuty = 0.0f;
+}
+
+
+/*******************************************************
+ * Function: feedForward
+ *
+ * returns: the duty a profile's present rate,
+ *          acceleration and jerk need, as control_task.c
+ *******************************************************/
+static num_t
+feedForward (const Trajectory *psProfile, float fRateGain, float fAccelGain, float fJerkGain)
+{
+    return numMul(numFromFloat(fRateGain), psProfile->velocity) + numMul(numFromFloat(fAccelGain), psProfile->accel)
+           + numMul(numFromFloat(fJerkGain), psProfile->jerk);
+}
+
+
+/*******************************************************
+ * Function: stepLoop
+ *
+ * Steps one loop as control_task.c does: through its
+ * profile, or while it is being tuned, by the relay with
+ * the PID tracking it, streaming every STREAM_DIVIDER
+ * cycles
+ *
+ * returns: the duty
+ *******************************************************/
+static num_t
+stepLoop (flight_t *psFlight, PIDController *psPID, Trajectory *psProfile, float fSet, num_t xPv,
+          num_t xFeedForward, const char *pcName)
+{
+    num_t xDuty;
+
+    if (psFlight->psTuning == psPID) {
+        resetTrajectory(psProfile, psFlight->sTune.setpoint);  // Held while tuning
+        xDuty = stepRelayTune(&psFlight->sTune, xPv);
+        setPIDManual(psPID, xDuty);
+        (void) stepPID(psPID, psFlight->sTune.setpoint, xPv);
+        if (psFlight->ui32Cycle % STREAM_DIVIDER == 0) {
+            printRelayTuneSample(pcName, psFlight->ui32Cycle, psFlight->sTune.setpoint, xPv, xDuty);
+        }
+        if (psFlight->sTune.result.state != RELAY_TUNE_RUNNING) {
+            printRelayTuneResult(pcName, &psFlight->sTune.result);
+            if (psFlight->sTune.result.state == RELAY_TUNE_DONE) {
+                setPIDGains(psPID, psFlight->sTune.result.kp, psFlight->sTune.result.ki, 0);
+            }
+            setPIDAuto(psPID);
+            psFlight->psTuning = NULL;
+        }
+        return xDuty;
+    }
+
+    setPIDFeedForward(psPID, xFeedForward);
+    return stepPID(psPID, stepTrajectory(psProfile, numFromFloat(fSet)), xPv);
+}
+
+
+/*******************************************************
+ * Function: controlStep
+ *
+ * Steps both loops once, then the plant for one control
+ * period
+ *******************************************************/
+static void
+controlStep (flight_t *psFlight)
+{
+    uint32_t i;
+
+    psFlight->fMainDuty = numToFloat(stepLoop(psFlight, &psFlight->sHeight, &psFlight->sHeightProfile,
+                                              psFlight->fHeightSet, numFromFloat(heightPct(psFlight)),
+                                              NUM_CONST(HEIGHT_FF_HOVER)
+                                              + feedForward(&psFlight->sHeightProfile, HEIGHT_FF_RATE,
+                                                            HEIGHT_FF_ACCEL, HEIGHT_FF_JERK), "height"));
+    psFlight->fTailDuty = numToFloat(stepLoop(psFlight, &psFlight->sYaw, &psFlight->sYawProfile,
+                                              psFlight->fYawSet, numFromFloat(yawDeg(psFlight)),
+                                              feedForward(&psFlight->sYawProfile, YAW_FF_RATE, YAW_FF_ACCEL,
+                                                          YAW_FF_JERK), "yaw"));
+    for (i = 0; i < CONTROL_DIVIDER; i++) {
+        heliPlantStep(&psFlight->sPlant, PLANT_DT_S, psFlight->fMainDuty, psFlight->fTailDuty);
+    }
+    psFlight->ui32Cycle++;
+}
+
+
+/*******************************************************
+ * Function: flySettle
+ *
+ * Flies for MANOEUVRE_S after a set point change
+ *
+ * pfnMeasure: the axis
+ *
+ * returns: the 5% settling time, MANOEUVRE_S if it never
+ *          settles
+ *******************************************************/
+static float
+flySettle (flight_t *psFlight, float (*pfnMeasure)(flight_t *psFlight), float fFrom, float fTo)
+{
+    float fSettle = 0.0f;
+    uint32_t k;
+
+    for (k = 0; k < (uint32_t) (MANOEUVRE_S / CONTROL_DT_S + 0.5f); k++) {
+        controlStep(psFlight);
+        if (fabsf(pfnMeasure(psFlight) - fTo) > SETTLE_BAND * fabsf(fTo - fFrom)) {
+            fSettle = (k + 1) * CONTROL_DT_S;
+        }
+    }
+    return fSettle;
+}
+
+
+/*******************************************************
+ * Function: modelG
+ *
+ * returns: the plant K / (s (s + D) (tau s + 1)), with the
+ *          output held over the control period, at s = jw
+ *******************************************************/
+static float complex
+modelG (float fK, float fD, float fTau, float fW)
+{
+    float complex cS = I * fW;
+
+    return fK * cexpf(-cS * MODEL_DELAY_S) / (cS * (cS + fD) * (fTau * cS + 1.0f));
+}
+
+
+/*******************************************************
+ * Function: modelRelay
+ *
+ * Works out where a relay of amplitude d and hysteresis
+ * eps makes the model oscillate: where G(jw) meets
+ * -pi (sqrt(a^2 - eps^2) + j eps) / 4 d, the describing
+ * function. The imaginary part fixes w, found by bisection
+ * below the 180 degree point, and the real part the Ku
+ * stepRelayTune() reports, -1 / Re G. With no hysteresis
+ * this is the ultimate gain and period.
+ *
+ * pfKu: set to the Ku the relay should find
+ * pfTu: set to the period, s
+ *******************************************************/
+static void
+modelRelay (float fK, float fD, float fTau, float fStep, float fBand, float *pfKu, float *pfTu)
+{
+    float fLow = 0.1f, fHigh = 1000.0f, fW = 1.0f, fTarget = -(float) M_PI * fBand / (4.0f * fStep);
+    uint32_t i;
+
+    for (i = 0; i < 60; i++) {
+        fW = 0.5f * (fLow + fHigh);
+        if (cargf(modelG(fK, fD, fTau, fW)) > 0.0f) {
+            fHigh = fW;  // Past 180 degrees, the angle has wrapped
+        } else {
+            fLow = fW;
+        }
+    }
+
+    fLow = 0.1f;
+    for (i = 0; i < 60; i++) {
+        fW = 0.5f * (fLow + fHigh);
+        if (cimagf(modelG(fK, fD, fTau, fW)) > fTarget) {
+            fHigh = fW;
+        } else {
+            fLow = fW;
+        }
+    }
+    *pfKu = -1.0f / crealf(modelG(fK, fD, fTau, fW));
+    *pfTu = 2.0f * (float) M_PI / fW;
+}
+
+
+/*******************************************************
+ * Function: tuneLoop
+ *
+ * Hands a loop to the relay, as control_task.c does, and
+ * flies until it hands back
+ *
+ * returns: true if it finished, within MODEL_TOL of the
+ *          model, the duty within its limits throughout,
+ *          and the hand back without a bump
+ *******************************************************/
+static bool
+tuneLoop (flight_t *psFlight, PIDController *psPID, float fSet, float fStep, float fBand, float fModelKu,
+          float fModelTu, const char *pcName)
+{
+    float fDuty, fMin = 1.0f, fMax = 0.0f, fBump = 0.0f, fKu, fTu;
+    bool bDuring = true;
+
+    initRelayTune(&psFlight->sTune, NUM_CONST(CONTROL_DT_S), numFromFloat(fSet), psPID->output,
+                  numFromFloat(fStep), numFromFloat(fBand), NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN),
+                  (uint32_t) (TUNE_TIMEOUT_S / CONTROL_DT_S));
+    psFlight->psTuning = psPID;
+
+    while (psFlight->psTuning != NULL || bDuring) {
+        bDuring = (psFlight->psTuning != NULL);  // One more step, the first with the new gains
+        controlStep(psFlight);
+        fDuty = numToFloat(psPID->output);
+        if (bDuring) {
+            fMin = fminf(fMin, fDuty);
+            fMax = fmaxf(fMax, fDuty);
+        } else {
+            fBump = fabsf(fDuty - numToFloat(psFlight->sTune.bias));  // Back where the relay switched about
+        }
+    }
+
+    fKu = numToFloat(psFlight->sTune.result.ku);
+    fTu = numToFloat(psFlight->sTune.result.tu);
+    printf("  %-6s Ku %.4f (model %.4f), Tu %.3f s (model %.3f s), kp %.4f ki %.4f, duty %.2f to %.2f, "
+           "hand back moved it %.4f\n", pcName, fKu, fModelKu, fTu, fModelTu, numToFloat(psFlight->sTune.result.kp),
+           numToFloat(psFlight->sTune.result.ki), fMin, fMax, fBump);
+
+    return psFlight->sTune.result.state == RELAY_TUNE_DONE && fabsf(fKu - fModelKu) <= MODEL_TOL * fModelKu
+           && fabsf(fTu - fModelTu) <= MODEL_TOL * fModelTu && fMin >= DUTY_MIN && fMax <= DUTY_MAX
+           && fBump <= BUMP_TOL;
+}
+
+
+/*******************************************************
+ * Function: checkTimeout
+ *
+ * returns: true if a present value that never moves makes
+ *          the relay give up at the timeout, at the bias
+ *******************************************************/
+static bool
+checkTimeout (void)
+{
+    RelayTune sTune;
+    uint32_t k, ui32Steps = 0;
+    num_t xOutput = 0;
+
+    initRelayTune(&sTune, NUM_CONST(CONTROL_DT_S), numFromInt(50), NUM_CONST(0.45), NUM_CONST(0.3), NUM_CONST(1.0),
+                  NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN), 100);
+    for (k = 0; k < 200; k++) {
+        xOutput = stepRelayTune(&sTune, numFromInt(40));  // Stuck under, the relay stays high
+        if (sTune.result.state == RELAY_TUNE_RUNNING) {
+            ui32Steps = k + 1;
+        }
+    }
+
+    return sTune.result.state == RELAY_TUNE_FAILED && ui32Steps == 99 && xOutput == NUM_CONST(0.45);
+}
+
+
+int
+main (void)
+{
+    flight_t sFlight;
+    float fHeightKu, fHeightTu, fYawKu, fYawTu, pfSettle[4];
+    bool bTuned, bSettled = true;
+    uint32_t i;
+
+    printf("num_t is %s\n", NUM_NAME);
+    modelRelay(MODEL_LIFT, MODEL_HEIGHT_DAMP, MODEL_MAIN_TAU, HEIGHT_TUNE_STEP, HEIGHT_TUNE_BAND, &fHeightKu, &fHeightTu);
+    modelRelay(MODEL_TAIL, MODEL_YAW_DAMP, MODEL_TAIL_TAU, YAW_TUNE_STEP, YAW_TUNE_BAND, &fYawKu, &fYawTu);
+
+    // Hover, then tune height and yaw in turn
+    initFlight(&sFlight);
+    sFlight.fHeightSet = 50.0f;
+    (void) flySettle(&sFlight, heightPct, 0.0f, 50.0f);
+    bTuned = tuneLoop(&sFlight, &sFlight.sHeight, 50.0f, HEIGHT_TUNE_STEP, HEIGHT_TUNE_BAND, fHeightKu, fHeightTu,
+                      "height");
+    (void) flySettle(&sFlight, heightPct, 50.0f, 50.0f);
+    bTuned &= tuneLoop(&sFlight, &sFlight.sYaw, sFlight.fYawSet, YAW_TUNE_STEP, YAW_TUNE_BAND, fYawKu, fYawTu,
+                       "yaw");
+    (void) flySettle(&sFlight, yawDeg, sFlight.fYawSet, sFlight.fYawSet);
+    check(bTuned, "both loops tuned, near the model, bumpless hand back");
+
+    // Button presses and a half turn on the tuned gains
+    sFlight.fHeightSet = 55.0f;
+    pfSettle[0] = flySettle(&sFlight, heightPct, 50.0f, 55.0f);
+    sFlight.fHeightSet = 45.0f;
+    pfSettle[1] = flySettle(&sFlight, heightPct, 55.0f, 45.0f);
+    sFlight.fYawSet += 10.0f;
+    pfSettle[2] = flySettle(&sFlight, yawDeg, sFlight.fYawSet - 10.0f, sFlight.fYawSet);
+    sFlight.fYawSet += 180.0f;
+    pfSettle[3] = flySettle(&sFlight, yawDeg, sFlight.fYawSet - 180.0f, sFlight.fYawSet);
+    printf("  tuned gains settle: height +5%% %.2fs, -10%% %.2fs, yaw +10 deg %.2fs, +180 deg %.2fs\n",
+           pfSettle[0], pfSettle[1], pfSettle[2], pfSettle[3]);
+    for (i = 0; i < 4; i++) {
+        bSettled &= (pfSettle[i] < SETTLE_LIMIT_S);
+    }
+    check(bSettled, "tuned gains settle within the 5 s requirement");
+
+    check(checkTimeout(), "a loop that does not oscillate gives up at the timeout");
+
+    printf("%u failures\n", g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
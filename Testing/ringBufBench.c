@@ -0,0 +1,191 @@
+/*******************************************************
+ * ringBufBench.c
+ *
+ * Host benchmark of the height sample buffer. Compares the
+ * original circBufT (modulo wrap branch, calloc storage)
+ * with spscBuf (free running indices masked into static
+ * storage), writing and reading the same stream of samples
+ * through each, and checks both return what was written.
+ *
+ * spscBuf does more work per read (it checks windex so it
+ * never reads ahead of the writer, and detects overwrites),
+ * so it is not expected to win on the PC. The numbers show
+ * what that safety costs relative to the unchecked reads.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -IDrivers -o ring_buf_bench Testing/ringBufBench.c
+ *         Drivers/circBufT.c Drivers/spscBuf.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "circBufT.h"
+#include "spscBuf.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define BENCH_BUF_SIZE      64  // Power of two so both buffers can use it
+#define BENCH_SAMPLES       10000000
+#define BENCH_BURST         4  // Samples written per read pass, as getHeightTask sees them
+
+
+static volatile uint32_t g_pui32SpscData[BENCH_BUF_SIZE];
+
+
+/*******************************************************
+ * Function: nextSample
+ *
+ * returns: a 12 bit pseudo-random ADC sample (xorshift32)
+ *******************************************************/
+static uint32_t
+nextSample (uint32_t *pui32Seed)
+{
+    *pui32Seed ^= *pui32Seed << 13;
+    *pui32Seed ^= *pui32Seed >> 17;
+    *pui32Seed ^= *pui32Seed << 5;
+    return *pui32Seed & 0x0FFF;
+}
+
+
+/*******************************************************
+ * Function: secondsSince
+ *******************************************************/
+static double
+secondsSince (clock_t sStart)
+{
+    return (double) (clock() - sStart) / CLOCKS_PER_SEC;
+}
+
+
+/*******************************************************
+ * Function: benchCircBuf
+ *
+ * returns: true if every sample read matched the one
+ *          written
+ *******************************************************/
+static bool
+benchCircBuf (double *pdSeconds)
+{
+    circBuf_t sBuffer;
+    uint32_t ui32Seed = 1, ui32Check = 1;
+    uint32_t ui32Sample, i, j;
+    bool bOk = true;
+    clock_t sStart;
+
+    if (initCircBuf(&sBuffer, BENCH_BUF_SIZE) == NULL) {
+        return false;
+    }
+
+    sStart = clock();
+    for (i = 0; i < BENCH_SAMPLES; i += BENCH_BURST) {
+        for (j = 0; j < BENCH_BURST; j++) {
+            writeCircBuf(&sBuffer, nextSample(&ui32Seed));
+        }
+        for (j = 0; j < BENCH_BURST; j++) {
+            ui32Sample = readCircBuf(&sBuffer);
+            bOk &= (ui32Sample == nextSample(&ui32Check));
+        }
+    }
+    *pdSeconds = secondsSince(sStart);
+
+    freeCircBuf(&sBuffer);
+    return bOk;
+}
+
+
+/*******************************************************
+ * Function: benchSpscBuf
+ *
+ * returns: true if every sample read matched the one
+ *          written
+ *******************************************************/
+static bool
+benchSpscBuf (double *pdSeconds)
+{
+    spscBuf_t sBuffer;
+    uint32_t ui32Seed = 1, ui32Check = 1;
+    uint32_t ui32Sample, i, j;
+    bool bOk = true;
+    clock_t sStart;
+
+    if (!initSpscBuf(&sBuffer, g_pui32SpscData, BENCH_BUF_SIZE)) {
+        return false;
+    }
+
+    sStart = clock();
+    for (i = 0; i < BENCH_SAMPLES; i += BENCH_BURST) {
+        for (j = 0; j < BENCH_BURST; j++) {
+            writeSpscBuf(&sBuffer, nextSample(&ui32Seed));
+        }
+        for (j = 0; j < BENCH_BURST; j++) {
+            bOk &= readSpscBuf(&sBuffer, &ui32Sample);
+            bOk &= (ui32Sample == nextSample(&ui32Check));
+        }
+    }
+    *pdSeconds = secondsSince(sStart);
+
+    return bOk && (sBuffer.overruns == 0);
+}
+
+
+/*******************************************************
+ * Function: checkSpscOverrun
+ *
+ * Writes past a full buffer and checks the reader skips
+ * the overwritten entries and the snapshot returns the
+ * newest ones
+ *******************************************************/
+static bool
+checkSpscOverrun (void)
+{
+    spscBuf_t sBuffer;
+    uint32_t pui32Snapshot[BENCH_BUF_SIZE];
+    uint32_t ui32Entry, i;
+    bool bOk = true;
+
+    initSpscBuf(&sBuffer, g_pui32SpscData, BENCH_BUF_SIZE);
+    bOk &= !readSpscBuf(&sBuffer, &ui32Entry);
+    bOk &= (snapshotSpscBuf(&sBuffer, pui32Snapshot, 4) == 0);
+
+    for (i = 0; i < BENCH_BUF_SIZE + 10; i++) {
+        writeSpscBuf(&sBuffer, i);
+    }
+
+    bOk &= (snapshotSpscBuf(&sBuffer, pui32Snapshot, 4) == 4);
+    for (i = 0; i < 4; i++) {
+        bOk &= (pui32Snapshot[i] == BENCH_BUF_SIZE + 6 + i);
+    }
+
+    bOk &= readSpscBuf(&sBuffer, &ui32Entry);
+    bOk &= (ui32Entry == 10) && (sBuffer.overruns == 10);
+
+    return bOk && !initSpscBuf(&sBuffer, g_pui32SpscData, 48);
+}
+
+
+int
+main (void)
+{
+    double dCirc = 0.0, dSpsc = 0.0;
+    bool bCircOk, bSpscOk, bOverrunOk;
+
+    bCircOk = benchCircBuf(&dCirc);
+    bSpscOk = benchSpscBuf(&dSpsc);
+    bOverrunOk = checkSpscOverrun();
+
+    printf("%u samples through a %u entry buffer, %u per read pass\n",
+           BENCH_SAMPLES, BENCH_BUF_SIZE, BENCH_BURST);
+    printf("circBufT: %6.2f ns/sample  %s\n", dCirc * 1e9 / BENCH_SAMPLES, bCircOk ? "ok" : "FAIL");
+    printf("spscBuf:  %6.2f ns/sample  %s\n", dSpsc * 1e9 / BENCH_SAMPLES, bSpscOk ? "ok" : "FAIL");
+    printf("spscBuf overrun and snapshot: %s\n", bOverrunOk ? "ok" : "FAIL");
+
+    return (bCircOk && bSpscOk && bOverrunOk) ? 0 : 1;
+}
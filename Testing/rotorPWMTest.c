@@ -0,0 +1,244 @@
+/*******************************************************
+ * rotorPWMTest.c
+ *
+ * Host test of the rotor PWM driver (Drivers/rotorPWM.c)
+ * against the simulated PWM generators, which keep their
+ * load and compare values in their registers.
+ *
+ * Checks that
+ *   - initRotorPWM() sets the PWM clock to / 4 and both
+ *     generators' load to half of 80 MHz / 4 / 250 Hz,
+ *     counting up and down, with the outputs off and
+ *     disarmed, so a duty set does not turn them on
+ *   - every duty, 1 to ROTOR_DUTY_ONE, gives the compare
+ *     worked out in 64 bits, held to the limits, on the
+ *     output's own generator only
+ *   - the compare is the one driverlib's PWMPulseWidthSet()
+ *     gives for the same pulse, and the simulated output
+ *     runs at the duty set
+ *   - a duty of 0 turns the output off, the next duty
+ *     turns it back on
+ *   - setRotorLimits() moves the limits
+ *   - killRotors() turns both off and keeps them off
+ *     through new duties, armRotors() brings back only
+ *     those with a duty set, at the last one
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -ISimulation -IDrivers -o rotor_pwm_test Testing/rotorPWMTest.c
+ *         Drivers/rotorPWM.c Simulation/sim_peripherals.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_pwm.h"
+#include "driverlib/pwm.h"
+#include "driverlib/sysctl.h"
+
+#include "sim_peripherals.h"
+#include "rotorPWM.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define CLOCK_HZ            80000000
+#define LOAD                (CLOCK_HZ / ROTOR_PWM_DIVIDER / ROTOR_PWM_HZ / 2)  // 40000, counting up and down
+
+#define MAIN_GEN            (ROTOR_MAIN_PWM_BASE + ROTOR_MAIN_PWM_GEN)
+#define TAIL_GEN            (ROTOR_TAIL_PWM_BASE + ROTOR_TAIL_PWM_GEN)
+#define MAIN_CMP            HWREG(MAIN_GEN + PWM_O_X_CMPB)  // Both are odd outputs
+#define TAIL_CMP            HWREG(TAIL_GEN + PWM_O_X_CMPB)
+
+
+static uint32_t g_ui32Failures;
+
+static const struct {
+    uint32_t ui32Base;
+    uint32_t ui32Gen;
+    uint32_t ui32Out;
+} g_psRotors[NUM_ROTORS] = {
+    { ROTOR_MAIN_PWM_BASE, MAIN_GEN, ROTOR_MAIN_PWM_OUTNUM },
+    { ROTOR_TAIL_PWM_BASE, TAIL_GEN, ROTOR_TAIL_PWM_OUTNUM },
+};
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: expectedCompare
+ *
+ * The compare for a duty, worked out in 64 bits
+ *******************************************************/
+static uint32_t
+expectedCompare (uint32_t ui32Duty, uint32_t ui32Min, uint32_t ui32Max)
+{
+    uint64_t ui64Duty = (ui32Duty < ui32Min) ? ui32Min : (ui32Duty > ui32Max) ? ui32Max : ui32Duty;
+
+    return LOAD - (uint32_t) ((LOAD * ui64Duty + ROTOR_DUTY_ONE / 2) / ROTOR_DUTY_ONE);
+}
+
+
+/*******************************************************
+ * Function: checkInit
+ *******************************************************/
+static void
+checkInit (void)
+{
+    check(SysCtlPWMClockGet() == ROTOR_PWM_DIVIDER_CODE, "PWM clock divided by 4");
+    check(HWREG(MAIN_GEN + PWM_O_X_LOAD) == LOAD && HWREG(TAIL_GEN + PWM_O_X_LOAD) == LOAD
+          && PWMGenPeriodGet(ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_GEN) == 2 * LOAD,
+          "load 40000 on both, a 250 Hz period");
+    check((HWREG(MAIN_GEN + PWM_O_X_CTL) & (PWM_X_CTL_ENABLE | PWM_X_CTL_MODE)) == (PWM_X_CTL_ENABLE | PWM_X_CTL_MODE)
+          && (HWREG(TAIL_GEN + PWM_O_X_CTL) & (PWM_X_CTL_ENABLE | PWM_X_CTL_MODE))
+             == (PWM_X_CTL_ENABLE | PWM_X_CTL_MODE),
+          "both running, counting up and down");
+    check(simPWMDutyGet(ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_OUTNUM) == 0.0f
+          && simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM) == 0.0f && getRotorsKilled(),
+          "outputs off, disarmed");
+
+    setRotorDuty(ROTOR_MAIN, ROTOR_DUTY(0.5));
+    check(simPWMDutyGet(ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_OUTNUM) == 0.0f, "a duty does not turn one on until armed");
+    setRotorDuty(ROTOR_MAIN, 0);
+    armRotors();  // For the rest
+}
+
+
+/*******************************************************
+ * Function: checkDuties
+ *
+ * Every duty on each rotor
+ *******************************************************/
+static void
+checkDuties (void)
+{
+    bool bExact = true, bOwn = true, bDriverlib = true, bSim = true;
+    uint32_t ui32Duty, ui32Other, ui32Compare;
+    uint8_t ui8Rotor;
+    float fDuty;
+
+    for (ui8Rotor = 0; ui8Rotor < NUM_ROTORS; ui8Rotor++) {
+        ui32Other = HWREG(g_psRotors[!ui8Rotor].ui32Gen + PWM_O_X_CMPB);
+        for (ui32Duty = 1; ui32Duty <= ROTOR_DUTY_ONE; ui32Duty++) {
+            setRotorDuty(ui8Rotor, ui32Duty);
+            ui32Compare = HWREG(g_psRotors[ui8Rotor].ui32Gen + PWM_O_X_CMPB);
+            bExact = bExact && ui32Compare == expectedCompare(ui32Duty, ROTOR_DUTY_MIN, ROTOR_DUTY_MAX);
+            bOwn = bOwn && HWREG(g_psRotors[!ui8Rotor].ui32Gen + PWM_O_X_CMPB) == ui32Other;
+
+            // The pulse it is, through driverlib
+            fDuty = simPWMDutyGet(g_psRotors[ui8Rotor].ui32Base, g_psRotors[ui8Rotor].ui32Out);
+            bSim = bSim && fabsf(fDuty - (float) (LOAD - ui32Compare) / LOAD) < 1e-6f;
+            PWMPulseWidthSet(g_psRotors[ui8Rotor].ui32Base, g_psRotors[ui8Rotor].ui32Out,
+                             PWMPulseWidthGet(g_psRotors[ui8Rotor].ui32Base, g_psRotors[ui8Rotor].ui32Out));
+            bDriverlib = bDriverlib && HWREG(g_psRotors[ui8Rotor].ui32Gen + PWM_O_X_CMPB) == ui32Compare;
+        }
+    }
+    check(bExact, "compare for every duty, held to 2 to 98%");
+    check(bOwn, "each rotor sets only its own compare");
+    check(bDriverlib, "the compare driverlib gives for the same pulse");
+    check(bSim, "output runs at the duty set");
+
+    setRotorDuty(ROTOR_MAIN, ROTOR_DUTY(0.5));
+    setRotorDuty(ROTOR_TAIL, ROTOR_DUTY(0.25));
+    printf("  50%%: compare %u, 25%%: compare %u, of load %u\n", (unsigned) MAIN_CMP, (unsigned) TAIL_CMP, LOAD);
+    check(MAIN_CMP == LOAD / 2 && TAIL_CMP == LOAD * 3 / 4
+          && fabsf(simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM) - 0.25f) < 1e-6f,
+          "50% and 25% exact");
+}
+
+
+/*******************************************************
+ * Function: checkOffAndLimits
+ *******************************************************/
+static void
+checkOffAndLimits (void)
+{
+    uint32_t ui32Compare;
+
+    setRotorDuty(ROTOR_TAIL, ROTOR_DUTY(0.3));
+    ui32Compare = TAIL_CMP;
+    setRotorDuty(ROTOR_TAIL, 0);
+    check(simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM) == 0.0f && TAIL_CMP == ui32Compare
+          && simPWMDutyGet(ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_OUTNUM) > 0.0f,
+          "0 turns only that output off");
+    setRotorDuty(ROTOR_TAIL, ROTOR_DUTY(0.3));
+    check(fabsf(simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM) - 0.3f) < 1e-4f, "and a duty back on");
+
+    setRotorLimits(ROTOR_TAIL, ROTOR_DUTY(0.1), ROTOR_DUTY(0.5));
+    setRotorDuty(ROTOR_TAIL, ROTOR_DUTY(0.05));
+    ui32Compare = TAIL_CMP;
+    setRotorDuty(ROTOR_TAIL, ROTOR_DUTY(0.9));
+    check(ui32Compare == expectedCompare(ROTOR_DUTY(0.1), 0, ROTOR_DUTY_ONE)
+          && TAIL_CMP == expectedCompare(ROTOR_DUTY(0.5), 0, ROTOR_DUTY_ONE),
+          "setRotorLimits moves the limits");
+    setRotorLimits(ROTOR_TAIL, 0, 2 * ROTOR_DUTY_ONE);
+    setRotorDuty(ROTOR_TAIL, ROTOR_DUTY_ONE);
+    check(TAIL_CMP == 0, "and only as far as 100%");
+    setRotorLimits(ROTOR_TAIL, ROTOR_DUTY_MIN, ROTOR_DUTY_MAX);
+}
+
+
+/*******************************************************
+ * Function: checkKill
+ *******************************************************/
+static void
+checkKill (void)
+{
+    setRotorDuty(ROTOR_MAIN, ROTOR_DUTY(0.5));
+    setRotorDuty(ROTOR_TAIL, ROTOR_DUTY(0.5));
+    killRotors();
+    check(getRotorsKilled() && simPWMDutyGet(ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_OUTNUM) == 0.0f
+          && simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM) == 0.0f,
+          "killRotors turns both off");
+
+    setRotorDuty(ROTOR_MAIN, ROTOR_DUTY(0.6));
+    setRotorDuty(ROTOR_TAIL, 0);
+    setRotorDuty(ROTOR_TAIL, ROTOR_DUTY(0.4));  // Turned off and on again while killed
+    setRotorDuty(ROTOR_TAIL, 0);
+    check(simPWMDutyGet(ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_OUTNUM) == 0.0f
+          && simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM) == 0.0f
+          && MAIN_CMP == expectedCompare(ROTOR_DUTY(0.6), 0, ROTOR_DUTY_ONE),
+          "kept off through new duties");
+
+    armRotors();
+    check(!getRotorsKilled()
+          && fabsf(simPWMDutyGet(ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_OUTNUM) - 0.6f) < 1e-4f
+          && simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM) == 0.0f,
+          "armRotors brings back only those with a duty set");
+    setRotorDuty(ROTOR_TAIL, ROTOR_DUTY(0.4));
+    check(fabsf(simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM) - 0.4f) < 1e-4f, "then the rest");
+}
+
+
+int
+main (void)
+{
+    printf("Rotor PWM\n");
+    simReset();
+    SysCtlClockSet(SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    initRotorPWM();
+
+    checkInit();
+    checkDuties();
+    checkOffAndLimits();
+    checkKill();
+
+    printf("%u failures\n", g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
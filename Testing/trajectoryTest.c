@@ -0,0 +1,434 @@
+/*******************************************************
+ * trajectoryTest.c
+ *
+ * Host test of the set point profiles in trajectory.c.
+ *
+ * First the profiles alone, with the height and yaw limits
+ * from control_task.h: moves of a button press (5%, 10
+ * degrees) up to take off and a half turn, a move too
+ * small to reach any limit, and targets changed part way
+ * through a move, back the other way. Checks that the
+ * rate, acceleration and jerk never go over their limits,
+ * that every move stops on its target without overshoot,
+ * and that it takes no longer than an S-curve that spends
+ * the full time ramping to every limit (d / vmax +
+ * vmax / amax + amax / jmax).
+ *
+ * Then flown against the simulated HeliRig plant
+ * (Simulation/heli_plant.c), with both loops run at
+ * CONTROL_RATE_HZ with the control_task.h gains and
+ * feed-forward as control_task.c runs them: the same
+ * manoeuvres stepped straight into the loops, and through
+ * the profiles. The overshoot, 5% settling time and time
+ * the motors spend saturated are reported for each.
+ * Checks that with the profiles every manoeuvre settles
+ * within the 5 second requirement and overshoots no more
+ * than the raw step (to within a couple of counts of the
+ * measurement).
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -ISimulation -I"HeliRig Project" -o trajectory_test Testing/trajectoryTest.c
+ *         "HeliRig Project"/trajectory.c "HeliRig Project"/PI_controller.c Simulation/heli_plant.c
+ *         Simulation/sim_peripherals.c -lm
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "heli_plant.h"
+#include "heli_math.h"
+#include "PI_controller.h"
+#include "trajectory.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define PLANT_DT_S          0.001f  // Plant integration step
+#define CONTROL_DIVIDER     5  // Control runs every 5 plant steps (CONTROL_RATE_HZ, 200 Hz)
+#define CONTROL_DT_S        (PLANT_DT_S * CONTROL_DIVIDER)
+#define SETTLE_LIMIT_S      5.0f  // README hard requirement 5
+#define SETTLE_BAND         0.05f  // Settled within 5% of the step size
+#define MANOEUVRE_S         10.0f  // Flown for, from the set point change
+#define PROFILE_MAX_S       20.0f  // Longest a profile alone is stepped for
+#define HEIGHT_PCT_PER_COUNT 0.081f  // Height resolution, one ADC count
+#define YAW_DEG_PER_COUNT   (360.0f / PLANT_YAW_COUNTS_PER_REV)  // Yaw resolution, one quadrature count
+#define PROFILE_SLACK_S     0.25f  // Allowed over the time bound, for the last creep onto the target (longer in fixed point)
+
+// control_task.h
+#define HEIGHT_KP           0.04f
+#define HEIGHT_KI           0.01f
+#define YAW_KP              0.008f
+#define YAW_KI              0.002f
+#define HEIGHT_TT           0.0f
+#define YAW_TT              1.0f
+#define DUTY_MIN            0.02f
+#define DUTY_MAX            0.98f
+#define HEIGHT_RATE         20.0f
+#define HEIGHT_ACCEL        40.0f
+#define HEIGHT_JERK         200.0f
+#define YAW_RATE            60.0f
+#define YAW_ACCEL           120.0f
+#define YAW_JERK            600.0f
+#define HEIGHT_FF_HOVER     0.45f
+#define HEIGHT_FF_RATE      0.0135f
+#define HEIGHT_FF_ACCEL     0.0036f
+#define HEIGHT_FF_JERK      0.000225f
+#define YAW_FF_RATE         0.0067f
+#define YAW_FF_ACCEL        0.00144f
+#define YAW_FF_JERK         0.0000556f
+
+
+static uint32_t g_ui32Failures;
+
+
+// A profile move, from fFrom to fTo, or to fRetarget fRetargetS in if that is > 0
+typedef struct
+{
+    const char *pcName;
+    bool bYaw;  // Yaw limits, else height
+    float fFrom;
+    float fTo;
+    float fRetargetS;
+    float fRetarget;
+} move_t;
+
+// The plant and both loops
+typedef struct
+{
+    heliPlant_t sPlant;
+    PIDController sHeight;
+    PIDController sYaw;
+    Trajectory sHeightProfile;
+    Trajectory sYawProfile;
+    bool bProfiled;  // Set points go through the profiles
+    float fHeightSet;  // %
+    float fYawSet;  // deg
+    float fMainDuty;
+    float fTailDuty;
+} flight_t;
+
+// Response to one set point change
+typedef struct
+{
+    float fOvershoot;  // % of the step
+    float fSettle;  // s, MANOEUVRE_S if it never settles
+    float fSaturated;  // s either motor spent at a duty limit
+} response_t;
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: initProfile
+ *
+ * Sets up a profile with the height or yaw limits
+ *******************************************************/
+static void
+initProfile (Trajectory *psProfile, bool bYaw, float fFrom)
+{
+    if (bYaw) {
+        initTrajectory(psProfile, NUM_CONST(CONTROL_DT_S), NUM_CONST(YAW_RATE), NUM_CONST(YAW_ACCEL),
+                       NUM_CONST(YAW_JERK), numFromFloat(fFrom));
+    } else {
+        initTrajectory(psProfile, NUM_CONST(CONTROL_DT_S), NUM_CONST(HEIGHT_RATE), NUM_CONST(HEIGHT_ACCEL),
+                       NUM_CONST(HEIGHT_JERK), numFromFloat(fFrom));
+    }
+}
+
+
+/*******************************************************
+ * Function: checkMove
+ *
+ * Steps a profile through one move, checking it against
+ * its limits
+ *
+ * returns: true if every check passes
+ *******************************************************/
+static bool
+checkMove (const move_t *psMove)
+{
+    Trajectory sProfile;
+    float fVmax = psMove->bYaw ? YAW_RATE : HEIGHT_RATE;
+    float fAmax = psMove->bYaw ? YAW_ACCEL : HEIGHT_ACCEL;
+    float fJmax = psMove->bYaw ? YAW_JERK : HEIGHT_JERK;
+    float fTarget = psMove->fTo, fStart = psMove->fFrom;
+    float fPeakV = 0.0f, fPeakA = 0.0f, fPeakJ = 0.0f, fOvershoot = 0.0f;
+    float fLastA = 0.0f, fPosition, fTime = 0.0f, fDone = -1.0f, fBound;
+    uint32_t k;
+    bool bPass;
+
+    initProfile(&sProfile, psMove->bYaw, psMove->fFrom);
+    for (k = 0; k < (uint32_t) (PROFILE_MAX_S / CONTROL_DT_S); k++) {
+        fTime = (k + 1) * CONTROL_DT_S;
+        if (psMove->fRetargetS > 0.0f && k * CONTROL_DT_S >= psMove->fRetargetS && fTarget != psMove->fRetarget) {
+            fTarget = psMove->fRetarget;
+            fStart = numToFloat(sProfile.position);
+        }
+        if (fabsf(numToFloat(sProfile.position) - fTarget) > fabsf(fStart - fTarget)) {
+            fStart = numToFloat(sProfile.position);  // Still carrying on the other way, the move starts from where it stops
+        }
+
+        fPosition = numToFloat(stepTrajectory(&sProfile, numFromFloat(fTarget)));
+
+        fPeakV = fmaxf(fPeakV, fabsf(numToFloat(sProfile.velocity)));
+        fPeakA = fmaxf(fPeakA, fabsf(numToFloat(sProfile.accel)));
+        fPeakJ = fmaxf(fPeakJ, fabsf(numToFloat(sProfile.accel) - fLastA) / CONTROL_DT_S);
+        fLastA = numToFloat(sProfile.accel);
+        fOvershoot = fmaxf(fOvershoot, (fTarget >= fStart) ? fPosition - fTarget : fTarget - fPosition);
+
+        if (isTrajectoryDone(&sProfile)) {
+            fDone = (fDone < 0.0f) ? fTime : fDone;
+        } else {
+            fDone = -1.0f;
+        }
+    }
+
+    // An S-curve ramping all the way to every limit, as long as any move of this size takes, after
+    // stopping from a retarget
+    fBound = fabsf(fTarget - fStart) / fVmax + fVmax / fAmax + fAmax / fJmax
+             + ((psMove->fRetargetS > 0.0f) ? psMove->fRetargetS + fVmax / fAmax + 2.0f * fAmax / fJmax : 0.0f);
+
+    // Fixed point rounds the limits to the nearest step
+    bPass = fPeakV <= fVmax * 1.001f && fPeakA <= fAmax * 1.001f && fPeakJ <= fJmax * 1.01f
+            && fOvershoot <= numToFloat(sProfile.settle) && fDone > 0.0f && fDone <= fBound + PROFILE_SLACK_S
+            && sProfile.position == numFromFloat(fTarget);
+
+    printf("  %-22s %8.2f -> %8.2f | %5.2fs (bound %5.2fs) | v %6.2f a %6.2f j %6.1f | over %.4f  %s\n",
+           psMove->pcName, psMove->fFrom, fTarget, fDone, fBound, fPeakV, fPeakA, fPeakJ, fOvershoot,
+           bPass ? "ok" : "FAIL");
+    return bPass;
+}
+
+
+/*******************************************************
+ * Function: heightPct
+ *
+ * returns: the height the firmware would map from the
+ *          plant's ADC reading, %
+ *******************************************************/
+static float
+heightPct (flight_t *psFlight)
+{
+    return 242.0f - 0.081f * (float) heliPlantADCCounts(&psFlight->sPlant);
+}
+
+
+/*******************************************************
+ * Function: yawDeg
+ *******************************************************/
+static float
+yawDeg (flight_t *psFlight)
+{
+    return heliPlantQuadCount(&psFlight->sPlant) * 360.0f / PLANT_YAW_COUNTS_PER_REV;
+}
+
+
+/*******************************************************
+ * Function: initFlight
+ *
+ * Lands the plant and sets up both loops and profiles
+ *******************************************************/
+static void
+initFlight (flight_t *psFlight, bool bProfiled)
+{
+    initHeliPlant(&psFlight->sPlant);
+    initPID(&psFlight->sHeight, NUM_CONST(CONTROL_DT_S), NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN),
+            NUM_CONST(HEIGHT_KP), NUM_CONST(HEIGHT_KI), 0);
+    initPID(&psFlight->sYaw, NUM_CONST(CONTROL_DT_S), NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN),
+            NUM_CONST(YAW_KP), NUM_CONST(YAW_KI), 0);
+    setPIDWindup(&psFlight->sHeight, PID_WINDUP_BACK_CALC, NUM_CONST(HEIGHT_TT));
+    setPIDWindup(&psFlight->sYaw, PID_WINDUP_BACK_CALC, NUM_CONST(YAW_TT));
+    initProfile(&psFlight->sHeightProfile, false, 0.0f);
+    initProfile(&psFlight->sYawProfile, true, 0.0f);
+    psFlight->bProfiled = bProfiled;
+    psFlight->fHeightSet = 0.0f;
+    psFlight->fYawSet = 0.0f;
+    psFlight->fMainDuty = 0.0f;
+    psFlight->fTailDuty = 0.0f;
+}
+
+
+/*******************************************************
+ * Function: feedForward
+ *
+ * returns: the duty a profile's present rate,
+ *          acceleration and jerk need, as control_task.c
+ *******************************************************/
+static num_t
+feedForward (const Trajectory *psProfile, float fRateGain, float fAccelGain, float fJerkGain)
+{
+    return numMul(numFromFloat(fRateGain), psProfile->velocity) + numMul(numFromFloat(fAccelGain), psProfile->accel)
+           + numMul(numFromFloat(fJerkGain), psProfile->jerk);
+}
+
+
+/*******************************************************
+ * Function: controlStep
+ *
+ * Steps both loops once, through the profiles if the
+ * flight has them, then the plant for one control period
+ *******************************************************/
+static void
+controlStep (flight_t *psFlight)
+{
+    num_t xHeightSet = numFromFloat(psFlight->fHeightSet);
+    num_t xYawSet = numFromFloat(psFlight->fYawSet);
+    uint32_t i;
+
+    if (psFlight->bProfiled) {
+        xHeightSet = stepTrajectory(&psFlight->sHeightProfile, xHeightSet);
+        xYawSet = stepTrajectory(&psFlight->sYawProfile, xYawSet);
+        setPIDFeedForward(&psFlight->sHeight, NUM_CONST(HEIGHT_FF_HOVER)
+                          + feedForward(&psFlight->sHeightProfile, HEIGHT_FF_RATE, HEIGHT_FF_ACCEL, HEIGHT_FF_JERK));
+        setPIDFeedForward(&psFlight->sYaw, feedForward(&psFlight->sYawProfile, YAW_FF_RATE, YAW_FF_ACCEL, YAW_FF_JERK));
+    }
+    psFlight->fMainDuty = numToFloat(stepPID(&psFlight->sHeight, xHeightSet, numFromFloat(heightPct(psFlight))));
+    psFlight->fTailDuty = numToFloat(stepPID(&psFlight->sYaw, xYawSet, numFromFloat(yawDeg(psFlight))));
+    for (i = 0; i < CONTROL_DIVIDER; i++) {
+        heliPlantStep(&psFlight->sPlant, PLANT_DT_S, psFlight->fMainDuty, psFlight->fTailDuty);
+    }
+}
+
+
+/*******************************************************
+ * Function: fly
+ *
+ * Flies for MANOEUVRE_S, measuring the response of one
+ * axis to a step from fFrom to its present set point
+ *
+ * pfnMeasure: the axis
+ *******************************************************/
+static void
+fly (flight_t *psFlight, float (*pfnMeasure)(flight_t *psFlight), float fFrom, float fTo, response_t *psResponse)
+{
+    float fStep = fabsf(fTo - fFrom);
+    float fValue, fPast;
+    uint32_t k, ui32Steps = (uint32_t) (MANOEUVRE_S / CONTROL_DT_S + 0.5f);
+
+    psResponse->fOvershoot = 0.0f;
+    psResponse->fSettle = 0.0f;
+    psResponse->fSaturated = 0.0f;
+    for (k = 0; k < ui32Steps; k++) {
+        controlStep(psFlight);
+        fValue = pfnMeasure(psFlight);
+        fPast = (fTo > fFrom) ? fValue - fTo : fTo - fValue;
+        if (fPast > psResponse->fOvershoot) {
+            psResponse->fOvershoot = fPast;
+        }
+        if (fabsf(fValue - fTo) > SETTLE_BAND * fStep) {
+            psResponse->fSettle = (k + 1) * CONTROL_DT_S;
+        }
+        if (psFlight->fMainDuty <= DUTY_MIN || psFlight->fMainDuty >= DUTY_MAX
+            || psFlight->fTailDuty <= DUTY_MIN || psFlight->fTailDuty >= DUTY_MAX) {
+            psResponse->fSaturated += CONTROL_DT_S;
+        }
+    }
+    psResponse->fOvershoot = 100.0f * psResponse->fOvershoot / fStep;
+}
+
+
+/*******************************************************
+ * Function: flyManoeuvres
+ *
+ * Takes off, then flies button presses and a half turn,
+ * printing and returning the responses (take off, height
+ * up 5%, height down 10%, yaw 10 degrees, yaw 180)
+ *******************************************************/
+static void
+flyManoeuvres (bool bProfiled, response_t psResponses[5])
+{
+    flight_t sFlight;
+    float fYaw;
+
+    initFlight(&sFlight, bProfiled);
+
+    sFlight.fHeightSet = 50.0f;
+    fly(&sFlight, heightPct, 0.0f, 50.0f, &psResponses[0]);
+    sFlight.fHeightSet = 55.0f;
+    fly(&sFlight, heightPct, 50.0f, 55.0f, &psResponses[1]);
+    sFlight.fHeightSet = 45.0f;
+    fly(&sFlight, heightPct, 55.0f, 45.0f, &psResponses[2]);
+
+    fYaw = sFlight.fYawSet;
+    sFlight.fYawSet = fYaw + 10.0f;
+    fly(&sFlight, yawDeg, fYaw, sFlight.fYawSet, &psResponses[3]);
+    sFlight.fYawSet += 180.0f;
+    fly(&sFlight, yawDeg, fYaw + 10.0f, sFlight.fYawSet, &psResponses[4]);
+
+    printf("%-9s|", bProfiled ? "profiled" : "step");
+    for (uint32_t i = 0; i < 5; i++) {
+        printf(" %5.1f%% %4.2fs %4.2fs |", psResponses[i].fOvershoot, psResponses[i].fSettle, psResponses[i].fSaturated);
+    }
+    printf("\n");
+}
+
+
+int
+main (void)
+{
+    static const move_t psMoves[] = {
+        { "height button",      false,    0.0f,    5.0f, 0.0f, 0.0f },
+        { "height two presses", false,   50.0f,   40.0f, 0.0f, 0.0f },
+        { "take off",           false,    0.0f,   50.0f, 0.0f, 0.0f },
+        { "height full range",  false,  100.0f,    0.0f, 0.0f, 0.0f },
+        { "height nudge",       false,   50.0f,   50.01f, 0.0f, 0.0f },
+        { "height turned back", false,    0.0f,   50.0f, 0.5f,  0.0f },
+        { "yaw button",         true,     0.0f,   10.0f, 0.0f, 0.0f },
+        { "yaw quarter",        true,     0.0f,  -90.0f, 0.0f, 0.0f },
+        { "yaw turn, far out",  true,  1000.0f, 1360.0f, 0.0f, 0.0f },
+        { "yaw turned back",    true,     0.0f,   90.0f, 0.7f, -20.0f },
+    };
+    static const char * const ppcManoeuvres[5] = { "take off", "height +5%", "height -10%", "yaw +10 deg",
+                                                   "yaw +180 deg" };
+    static const float pfSteps[5] = { 50.0f, 5.0f, 10.0f, 10.0f, 180.0f };
+    static const float pfCounts[5] = { HEIGHT_PCT_PER_COUNT, HEIGHT_PCT_PER_COUNT, HEIGHT_PCT_PER_COUNT,
+                                       YAW_DEG_PER_COUNT, YAW_DEG_PER_COUNT };
+    response_t psStep[5], psProfiled[5];
+    bool bPass = true, bSettled = true, bLessOver = true;
+    uint32_t i;
+
+    printf("Profiles (" NUM_NAME ")\n");
+    for (i = 0; i < sizeof(psMoves) / sizeof(psMoves[0]); i++) {
+        bPass &= checkMove(&psMoves[i]);
+    }
+    check(bPass, "within limits, on target without overshoot, in time");
+
+    printf("\n         | take off            | height +5%%          | height -10%%         | yaw +10 deg         "
+           "| yaw +180 deg        |\n");
+    printf("         |  over settle satur  |  over settle satur  |  over settle satur  |  over settle satur  "
+           "|  over settle satur  |\n");
+    flyManoeuvres(false, psStep);
+    flyManoeuvres(true, psProfiled);
+
+    for (i = 0; i < 5; i++) {
+        if (psProfiled[i].fSettle >= SETTLE_LIMIT_S) {
+            printf("  %s takes %.2fs with the profile\n", ppcManoeuvres[i], psProfiled[i].fSettle);
+            bSettled = false;
+        }
+        // In % of the step, allowing a couple of counts for where the measurement happens to round
+        if (psProfiled[i].fOvershoot > psStep[i].fOvershoot + 200.0f * pfCounts[i] / pfSteps[i]) {
+            printf("  %s overshoots more with the profile\n", ppcManoeuvres[i]);
+            bLessOver = false;
+        }
+    }
+    check(bSettled, "profiled manoeuvres settle within the 5 s requirement");
+    check(bLessOver, "profiled manoeuvres overshoot no more than a step");
+
+    printf("%u failures\n", g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
@@ -0,0 +1,376 @@
+/*******************************************************
+ * windupTest.c
+ *
+ * Host test of the anti-windup strategies and bumpless
+ * transfer in PI_controller.c, flown against the simulated
+ * HeliRig plant (Simulation/heli_plant.c).
+ *
+ * Each anti-windup strategy (none, conditional integration
+ * and back calculation) flies the same manoeuvres, with
+ * the gains from gainSweep.c and the duty limited to 2% to
+ * 98%:
+ *   - take off from landed to 50% height
+ *   - a height jump from 10% to 90%, and back down
+ *   - a yaw jump of 180 degrees while hovering
+ * and the overshoot and 5% settling time of each is
+ * reported. Checks that both strategies overshoot less
+ * than integrating through saturation, and that back
+ * calculation (the default) settles within the 5 second
+ * requirement. Conditional integration holds the integral
+ * at 0 for the whole climb at take off, so it then has to
+ * build up the hover duty slowly, and misses it there.
+ *
+ * Then, while hovering:
+ *   - the height gains are doubled with setPIDGains(), and
+ *     by writing them straight into the controller
+ *   - the main duty is held by hand with setPIDManual()
+ *     and handed back with setPIDAuto(), and by resetting
+ *     the controller when handing it back
+ * and checks the bumpless ways move the output no more
+ * than a normal step does.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -ISimulation -I"HeliRig Project" -o windup_test Testing/windupTest.c
+ *         "HeliRig Project"/PI_controller.c Simulation/heli_plant.c Simulation/sim_peripherals.c -lm
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "heli_plant.h"
+#include "heli_math.h"
+#include "PI_controller.h"
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define PLANT_DT_S          0.001f  // Plant integration step
+#define CONTROL_DIVIDER     10  // Control runs every 10 plant steps (100 Hz)
+#define CONTROL_DT_S        (PLANT_DT_S * CONTROL_DIVIDER)
+#define SETTLE_LIMIT_S      5.0f  // README hard requirement 5
+#define SETTLE_BAND         0.05f  // Settled within 5% of the step size
+#define MANOEUVRE_S         10.0f  // Flown for, from the set point change
+
+#define HEIGHT_KP           0.04f  // gainSweep.c nominal gains
+#define HEIGHT_KI           0.01f
+#define YAW_KP              0.008f
+#define YAW_KI              0.002f
+#define HEIGHT_TT           0.0f  // Back calculation tracking time, the integral time kp / ki (4 s)
+#define YAW_TT              1.0f  // ... shorter for yaw, whose tail saturates for longer on a big jump
+#define DUTY_MIN            0.02f
+#define DUTY_MAX            0.98f
+#define HOVER_DUTY          0.45f  // Main duty the plant hovers at
+
+#define BUMP_TOL            0.01f  // Output change allowed at a transfer
+
+
+static const char * const g_ppcWindup[] = { "none", "conditional", "back calculation" };
+
+static uint32_t g_ui32Failures;
+
+// The plant and both loops
+typedef struct
+{
+    heliPlant_t sPlant;
+    PIDController sHeight;
+    PIDController sYaw;
+    float fHeightSet;  // %
+    float fYawSet;  // deg
+    float fMainDuty;
+    float fTailDuty;
+} flight_t;
+
+// Response to one set point change
+typedef struct
+{
+    float fOvershoot;  // % of the step
+    float fSettle;  // s, MANOEUVRE_S if it never settles
+} response_t;
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: heightPct
+ *
+ * returns: the height the firmware would map from the
+ *          plant's ADC reading, %
+ *******************************************************/
+static float
+heightPct (flight_t *psFlight)
+{
+    return 242.0f - 0.081f * (float) heliPlantADCCounts(&psFlight->sPlant);
+}
+
+
+/*******************************************************
+ * Function: yawDeg
+ *******************************************************/
+static float
+yawDeg (flight_t *psFlight)
+{
+    return heliPlantQuadCount(&psFlight->sPlant) * 360.0f / PLANT_YAW_COUNTS_PER_REV;
+}
+
+
+/*******************************************************
+ * Function: initFlight
+ *
+ * Lands the plant and sets up both loops with ui8Windup
+ *******************************************************/
+static void
+initFlight (flight_t *psFlight, uint8_t ui8Windup)
+{
+    initHeliPlant(&psFlight->sPlant);
+    initPID(&psFlight->sHeight, NUM_CONST(CONTROL_DT_S), NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN),
+            NUM_CONST(HEIGHT_KP), NUM_CONST(HEIGHT_KI), 0);
+    initPID(&psFlight->sYaw, NUM_CONST(CONTROL_DT_S), NUM_CONST(DUTY_MAX), NUM_CONST(DUTY_MIN),
+            NUM_CONST(YAW_KP), NUM_CONST(YAW_KI), 0);
+    setPIDWindup(&psFlight->sHeight, ui8Windup, NUM_CONST(HEIGHT_TT));
+    setPIDWindup(&psFlight->sYaw, ui8Windup, NUM_CONST(YAW_TT));
+    psFlight->fHeightSet = 0.0f;
+    psFlight->fYawSet = 0.0f;
+    psFlight->fMainDuty = 0.0f;
+    psFlight->fTailDuty = 0.0f;
+}
+
+
+/*******************************************************
+ * Function: controlStep
+ *
+ * Steps both loops once, then the plant for one control
+ * period
+ *******************************************************/
+static void
+controlStep (flight_t *psFlight)
+{
+    uint32_t i;
+
+    psFlight->fMainDuty = numToFloat(stepPID(&psFlight->sHeight, numFromFloat(psFlight->fHeightSet),
+                                             numFromFloat(heightPct(psFlight))));
+    psFlight->fTailDuty = numToFloat(stepPID(&psFlight->sYaw, numFromFloat(psFlight->fYawSet),
+                                             numFromFloat(yawDeg(psFlight))));
+    for (i = 0; i < CONTROL_DIVIDER; i++) {
+        heliPlantStep(&psFlight->sPlant, PLANT_DT_S, psFlight->fMainDuty, psFlight->fTailDuty);
+    }
+}
+
+
+/*******************************************************
+ * Function: fly
+ *
+ * Flies for fSeconds, measuring the response of one axis
+ * to a step from fFrom to its present set point
+ *
+ * pfnMeasure: the axis
+ *******************************************************/
+static void
+fly (flight_t *psFlight, float fSeconds, float (*pfnMeasure)(flight_t *psFlight), float fFrom, float fTo,
+     response_t *psResponse)
+{
+    float fStep = fabsf(fTo - fFrom);
+    float fValue, fPast;
+    uint32_t k, ui32Steps = (uint32_t) (fSeconds / CONTROL_DT_S + 0.5f);
+
+    psResponse->fOvershoot = 0.0f;
+    psResponse->fSettle = 0.0f;
+    for (k = 0; k < ui32Steps; k++) {
+        controlStep(psFlight);
+        fValue = pfnMeasure(psFlight);
+        fPast = (fTo > fFrom) ? fValue - fTo : fTo - fValue;
+        if (fPast > psResponse->fOvershoot) {
+            psResponse->fOvershoot = fPast;
+        }
+        if (fabsf(fValue - fTo) > SETTLE_BAND * fStep) {
+            psResponse->fSettle = (k + 1) * CONTROL_DT_S;
+        }
+    }
+    psResponse->fOvershoot = 100.0f * psResponse->fOvershoot / fStep;
+}
+
+
+/*******************************************************
+ * Function: flyManoeuvres
+ *
+ * Flies every manoeuvre with one strategy, printing and
+ * returning the responses (take off, up, down, yaw)
+ *******************************************************/
+static void
+flyManoeuvres (uint8_t ui8Windup, response_t psResponses[4])
+{
+    flight_t sFlight;
+
+    initFlight(&sFlight, ui8Windup);
+
+    sFlight.fHeightSet = 50.0f;
+    fly(&sFlight, MANOEUVRE_S, heightPct, 0.0f, 50.0f, &psResponses[0]);
+
+    sFlight.fHeightSet = 10.0f;
+    fly(&sFlight, MANOEUVRE_S, heightPct, 50.0f, 10.0f, &psResponses[3]);  // Into position, not reported
+    sFlight.fHeightSet = 90.0f;
+    fly(&sFlight, MANOEUVRE_S, heightPct, 10.0f, 90.0f, &psResponses[1]);
+    sFlight.fHeightSet = 10.0f;
+    fly(&sFlight, MANOEUVRE_S, heightPct, 90.0f, 10.0f, &psResponses[2]);
+
+    sFlight.fHeightSet = 50.0f;
+    sFlight.fYawSet = yawDeg(&sFlight);
+    fly(&sFlight, MANOEUVRE_S, heightPct, 10.0f, 50.0f, &psResponses[3]);  // Into position, not reported
+    sFlight.fYawSet += 180.0f;
+    fly(&sFlight, MANOEUVRE_S, yawDeg, sFlight.fYawSet - 180.0f, sFlight.fYawSet, &psResponses[3]);
+
+    printf("%-17s | %6.1f%% %5.2fs | %6.1f%% %5.2fs | %6.1f%% %5.2fs | %6.1f%% %5.2fs\n", g_ppcWindup[ui8Windup],
+           psResponses[0].fOvershoot, psResponses[0].fSettle, psResponses[1].fOvershoot, psResponses[1].fSettle,
+           psResponses[2].fOvershoot, psResponses[2].fSettle, psResponses[3].fOvershoot, psResponses[3].fSettle);
+}
+
+
+/*******************************************************
+ * Function: hover
+ *
+ * returns: a flight hovering at 50% with the default
+ *          strategy, settled
+ *******************************************************/
+static void
+hover (flight_t *psFlight)
+{
+    response_t sResponse;
+
+    initFlight(psFlight, PID_WINDUP_DEFAULT);
+    psFlight->fHeightSet = 50.0f;
+    fly(psFlight, MANOEUVRE_S, heightPct, 0.0f, 50.0f, &sResponse);
+    psFlight->fHeightSet = 60.0f;  // Then on the way to 60%, so the error is not 0 at the transfer
+    fly(psFlight, 0.3f, heightPct, 50.0f, 60.0f, &sResponse);
+}
+
+
+/*******************************************************
+ * Function: transferBump
+ *
+ * returns: how far the main duty moves over the step
+ *          after a transfer, less how far it moved over
+ *          the step before
+ *******************************************************/
+static float
+transferBump (flight_t *psFlight, float fBefore, float fLast)
+{
+    controlStep(psFlight);
+    return fabsf(psFlight->fMainDuty - fLast) - fabsf(fLast - fBefore);
+}
+
+
+/*******************************************************
+ * Function: checkGainChange
+ *
+ * returns: true if setPIDGains() moves the output no more
+ *          than BUMP_TOL beyond a normal step
+ *******************************************************/
+static bool
+checkGainChange (void)
+{
+    flight_t sFlight;
+    float fBefore, fLast, fBumpless, fBump;
+
+    hover(&sFlight);
+    fBefore = sFlight.fMainDuty;
+    controlStep(&sFlight);
+    fLast = sFlight.fMainDuty;
+    setPIDGains(&sFlight.sHeight, NUM_CONST(2 * HEIGHT_KP), NUM_CONST(2 * HEIGHT_KI), 0);
+    fBumpless = transferBump(&sFlight, fBefore, fLast);
+
+    hover(&sFlight);
+    fBefore = sFlight.fMainDuty;
+    controlStep(&sFlight);
+    fLast = sFlight.fMainDuty;
+    sFlight.sHeight.kp = NUM_CONST(2 * HEIGHT_KP);  // Written straight in
+    sFlight.sHeight.ki = NUM_CONST(2 * HEIGHT_KI);
+    fBump = transferBump(&sFlight, fBefore, fLast);
+
+    printf("  gains doubled: main duty bump %.4f with setPIDGains, %.4f written straight in\n", fBumpless, fBump);
+    return fBumpless <= BUMP_TOL && fBump > fBumpless;
+}
+
+
+/*******************************************************
+ * Function: checkManual
+ *
+ * returns: true if handing the main duty back from manual
+ *          with setPIDAuto() moves it no more than
+ *          BUMP_TOL beyond a normal step
+ *******************************************************/
+static bool
+checkManual (void)
+{
+    flight_t sFlight;
+    float fBefore, fLast, fBumpless, fBump;
+    uint32_t k;
+
+    hover(&sFlight);
+    setPIDManual(&sFlight.sHeight, NUM_CONST(HOVER_DUTY + 0.05f));  // Climb by hand for a second
+    for (k = 0; k < (uint32_t) (1.0f / CONTROL_DT_S); k++) {
+        fBefore = sFlight.fMainDuty;
+        controlStep(&sFlight);
+    }
+    fLast = sFlight.fMainDuty;
+    setPIDAuto(&sFlight.sHeight);
+    fBumpless = transferBump(&sFlight, fBefore, fLast);
+
+    hover(&sFlight);
+    setPIDManual(&sFlight.sHeight, NUM_CONST(HOVER_DUTY + 0.05f));
+    for (k = 0; k < (uint32_t) (1.0f / CONTROL_DT_S); k++) {
+        fBefore = sFlight.fMainDuty;
+        controlStep(&sFlight);
+    }
+    fLast = sFlight.fMainDuty;
+    setPIDAuto(&sFlight.sHeight);
+    resetPID(&sFlight.sHeight);  // Handed back from scratch
+    fBump = transferBump(&sFlight, fBefore, fLast);
+
+    printf("  manual to auto: main duty bump %.4f with setPIDAuto, %.4f reset\n", fBumpless, fBump);
+    return fBumpless <= BUMP_TOL && fBump > fBumpless;
+}
+
+
+int
+main (void)
+{
+    response_t psNone[4], psConditional[4], psBack[4];
+    bool bLess = true, bSettled = true;
+    uint32_t i;
+
+    printf("num_t is %s, default anti-windup %s\n", NUM_NAME, g_ppcWindup[PID_WINDUP_DEFAULT]);
+    printf("anti-windup       |   take off 50%%  |  height 10->90%% |  height 90->10%% |   yaw +180 deg\n");
+    printf("                  | overshoot settle | overshoot settle | overshoot settle | overshoot settle\n");
+    flyManoeuvres(PID_WINDUP_NONE, psNone);
+    flyManoeuvres(PID_WINDUP_CONDITIONAL, psConditional);
+    flyManoeuvres(PID_WINDUP_BACK_CALC, psBack);
+
+    for (i = 0; i < 4; i++) {
+        bLess = bLess && psConditional[i].fOvershoot <= psNone[i].fOvershoot && psBack[i].fOvershoot <= psNone[i].fOvershoot;
+        bSettled = bSettled && psBack[i].fSettle <= SETTLE_LIMIT_S;
+    }
+    check(bLess, "anti-windup overshoots less in every manoeuvre");
+    check(psConditional[0].fOvershoot < psNone[0].fOvershoot && psBack[0].fOvershoot < psNone[0].fOvershoot,
+          "anti-windup overshoots less at take off");
+    check(bSettled, "back calculation settles within 5 s in every manoeuvre");
+
+    check(checkGainChange(), "gain change is bumpless");
+    check(checkManual(), "manual to auto is bumpless");
+
+    printf("%u failures\n", (unsigned) g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
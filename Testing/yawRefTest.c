@@ -0,0 +1,442 @@
+/*******************************************************
+ * yawRefTest.c
+ *
+ * Host test of the yaw reference in get_yaw_task.c: the
+ * PC4 interrupt that latches the count at the reference,
+ * and the find reference start up of getYawTask.
+ *
+ * Checks:
+ *   - a pass over the reference turning backwards is not
+ *     latched, the next pass forwards is, on the exact
+ *     count, and a YawPosition started before then moves
+ *     over to count from it
+ *   - getYawTask, run against the plant (heli_plant.c) with
+ *     its reference slot, from a range of start headings,
+ *     with the tail held at YAW_FIND_REF_DUTY as the
+ *     control loop holds it, finds the reference in under
+ *     a revolution, and reports the heading from the
+ *     reference, without ever writing the rotor PWMs
+ *   - started over the reference, it is found at once
+ *   - with the rig stuck, it waits for the loop to give up,
+ *     YAW_FIND_REF_TIMEOUT_MS after it was armed, and
+ *     carries on from the power on heading
+ *
+ * The FreeRTOS calls made by get_yaw_task.c are stubbed
+ * below, only the headers from the POSIX port are needed.
+ * Delays step the simulation, and the plant with it. A
+ * stand-in for the control loop arms the rotors and
+ * reports when the yaw loop takes over (getControlOutput).
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -DYAW_FIND_REF=1 -ISimulation -I. -I"HeliRig Project" -IDrivers -Iutils -IFreeRTOS/include
+ *         -I$POSIX_PORT -o yaw_ref_test Testing/yawRefTest.c "HeliRig Project"/get_yaw_task.c
+ *         Drivers/rotorPWM.c utils/ustdlib.c Simulation/sim_peripherals.c Simulation/heli_plant.c -lm
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <setjmp.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pwm.h"
+#include "driverlib/sysctl.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "sim_peripherals.h"
+#include "heli_plant.h"
+#include "heli_math.h"
+#include "rotorPWM.h"
+#include "get_yaw_task.h"
+#include "relay_tune.h"
+#include "control_task.h"
+#include "helirig_structs.c"
+
+#if YAW_USE_QEI || !YAW_FIND_REF
+#error yawRefTest.c tests the GPIO backend with YAW_FIND_REF
+#endif
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_REF_COUNT      40  // Reference slot for the edge by edge check
+#define TEST_REF_WIDTH      4
+#define TEST_COAST_MS       2000  // Followed after the reference is found
+#define TEST_ARM_MS         5000  // When the stuck rig is armed
+
+
+// Pin states in Gray code order, counting up (B leads A)
+static const uint8_t g_pui8Phase[4] = { 0, GPIO_PIN_1, GPIO_PIN_0 | GPIO_PIN_1, GPIO_PIN_0 };
+
+static TaskFunction_t g_pfnTask;
+static void *g_pvTaskParameters;
+static jmp_buf g_sTaskExit;
+static uint32_t g_ui32Failures;
+
+static int32_t g_i32Position;  // Encoder position driven by driveTo()
+static bool g_bFinding;  // getYawTask said it was finding the reference
+static int32_t g_i32Angle;  // First angle getYawTask reported
+static float g_fTailDuty;  // Tail duty the test set, standing in for the control loop
+static bool g_bRotorsChanged;  // The rotor duties were seen other than the test set them
+static uint32_t g_ui32ArmMs;  // When the control loop stand-in arms the rotors
+
+
+/*******************************************************
+ * FreeRTOS stubs
+ *******************************************************/
+BaseType_t
+xTaskCreate (TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth,
+             void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    (void) pcName;
+    (void) usStackDepth;
+    (void) uxPriority;
+    (void) pxCreatedTask;
+    g_pfnTask = pxTaskCode;
+    g_pvTaskParameters = pvParameters;
+    return pdPASS;
+}
+
+BaseType_t
+xQueueGenericSend (QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait,
+                   const BaseType_t xCopyPosition)
+{
+    const OLEDMessage *psMessage = (const OLEDMessage *) pvItemToQueue;
+
+    (void) xQueue;
+    (void) xTicksToWait;
+    (void) xCopyPosition;
+
+    if (strncmp(psMessage->strBuf, "Finding ref", 11) == 0) {
+        g_bFinding = true;
+    } else if (sscanf(psMessage->strBuf, "Angle (deg): %d", &g_i32Angle) == 1) {
+        longjmp(g_sTaskExit, 1);  // Start up is over, end the task
+    }
+    return pdPASS;
+}
+
+void
+vTaskDelay (const TickType_t xTicksToDelay)
+{
+    float fDuty;
+    TickType_t i;
+
+    // One tick is 1 ms (configTICK_RATE_HZ)
+    for (i = 0; i < xTicksToDelay; i++) {
+        if (getRotorsKilled() && simTimeGet() / 1000 >= g_ui32ArmMs) {
+            armRotors();  // As the loop does on armControl()
+            g_fTailDuty = simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM);
+        }
+        fDuty = simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM);
+        g_bRotorsChanged = g_bRotorsChanged || fDuty != g_fTailDuty
+                           || simPWMDutyGet(ROTOR_MAIN_PWM_BASE, ROTOR_MAIN_PWM_OUTNUM) != 0.0f;
+        simStep(1000);
+    }
+}
+
+BaseType_t
+xTaskNotifyWait (uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue,
+                 TickType_t xTicksToWait)
+{
+    (void) ulBitsToClearOnEntry;
+    (void) ulBitsToClearOnExit;
+    (void) pulNotificationValue;
+    vTaskDelay(xTicksToWait);  // Never notified, there is no task handle
+    return pdFALSE;
+}
+
+BaseType_t
+xTaskGenericNotifyFromISR (TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                           uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void) xTaskToNotify;
+    (void) ulValue;
+    (void) eAction;
+    (void) pulPreviousNotificationValue;
+    (void) pxHigherPriorityTaskWoken;
+    return pdPASS;
+}
+
+/*******************************************************
+ * Control loop stand-in
+ *
+ * The yaw loop takes over once the reference is found, or
+ * once it has turned for YAW_FIND_REF_TIMEOUT_MS since
+ * being armed, as controlStep() decides yawAuto
+ *******************************************************/
+void
+getControlOutput (ControlOutput *output)
+{
+    uint32_t ui32Ms = (uint32_t) (simTimeGet() / 1000);
+
+    memset(output, 0, sizeof(*output));
+    output->armed = !getRotorsKilled();
+    output->yawAuto = getYawRefFound() || (output->armed && ui32Ms - g_ui32ArmMs >= YAW_FIND_REF_TIMEOUT_MS);
+}
+
+TickType_t
+xTaskGetTickCount (void)
+{
+    return (TickType_t) (simTimeGet() / 1000);
+}
+
+void
+vPortYield (void)
+{
+}
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Function: driveTo
+ *
+ * Drives edges onto PB0/PB1 one at a time up to
+ * i32Position, with the reference signal on PC4 low over
+ * TEST_REF_COUNT to TEST_REF_COUNT + TEST_REF_WIDTH - 1
+ *******************************************************/
+static void
+driveTo (int32_t i32Position)
+{
+    bool bOverRef;
+
+    while (g_i32Position != i32Position) {
+        g_i32Position += (i32Position > g_i32Position) ? 1 : -1;
+        bOverRef = g_i32Position >= TEST_REF_COUNT && g_i32Position < TEST_REF_COUNT + TEST_REF_WIDTH;
+        simGPIOInputSet(GPIO_PORTB_BASE, QUAD_PINS, g_pui8Phase[g_i32Position & 3]);
+        simGPIOInputSet(YAW_REF_BASE, YAW_REF_PIN, bOverRef ? 0 : YAW_REF_PIN);
+    }
+}
+
+
+/*******************************************************
+ * Function: checkLatch
+ *
+ * Starts above the reference, passes it backwards, then
+ * forwards, edge by edge
+ *******************************************************/
+static void
+checkLatch (void)
+{
+    xQueueHandle xQueue = NULL;
+    YawPosition sPosition;
+
+    simReset();
+    SysCtlClockSet(SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    g_i32Position = 60;  // Power on here, count 0
+    simGPIOInputSet(GPIO_PORTB_BASE, QUAD_PINS, g_pui8Phase[g_i32Position & 3]);
+    simGPIOInputSet(YAW_REF_BASE, YAW_REF_PIN, YAW_REF_PIN);
+    initGetYawTask(&xQueue);
+    IntMasterEnable();
+
+    initYawPosition(&sPosition);
+    check(!getYawRefFound() && !sPosition.referenced, "not over the reference at power on, not found");
+
+    driveTo(20);
+    updateYawPosition(&sPosition);
+    check(!getYawRefFound(), "a pass backwards is not latched");
+    check(sPosition.count == -40 && !sPosition.referenced, "position still from power on");
+
+    driveTo(60);
+    check(getYawRefFound(), "the next pass forwards is");
+    updateYawPosition(&sPosition);
+    check(sPosition.referenced && sPosition.count == 60 - TEST_REF_COUNT,
+          "position moves over to count from the reference");
+    check(sPosition.rebase == 60 - TEST_REF_COUNT, "the jump from the power on count is in rebase");
+
+    driveTo(-1000);
+    driveTo(30);
+    updateYawPosition(&sPosition);
+    check(sPosition.count == 30 - TEST_REF_COUNT, "later passes either way leave it alone");
+    check(sPosition.rebase == 0, "rebase only for the update that moved it");
+    check(getQuadIllegal() == 0, "no illegal transitions");
+}
+
+
+/*******************************************************
+ * Function: runStartUp
+ *
+ * Runs getYawTask with the plant from a start heading
+ * until it reports its first angle, with the tail held at
+ * YAW_FIND_REF_DUTY from ui32ArmMs meanwhile as the control
+ * loop holds it, then stops the tail as the loop would
+ * steer it by then
+ *
+ * returns: the simulated time it took, in ms
+ *******************************************************/
+static uint32_t
+runStartUp (heliPlant_t *psPlant, int32_t i32StartCount, uint32_t ui32ArmMs)
+{
+    xQueueHandle xQueue = NULL;
+
+    simReset();
+    SysCtlClockSet(SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    initRotorPWM();  // As main() does, before the tasks
+    setRotorDuty(ROTOR_TAIL, ROTOR_DUTY(YAW_FIND_REF_DUTY / 100.0));  // Still killed, until the stand-in arms them
+    psPlant->fYaw = (i32StartCount + 0.5f) * 360.0f / PLANT_YAW_COUNTS_PER_REV;
+    heliPlantAttach(psPlant);
+
+    g_pfnTask = NULL;
+    g_bFinding = false;
+    g_i32Angle = -1;
+    g_fTailDuty = simPWMDutyGet(ROTOR_TAIL_PWM_BASE, ROTOR_TAIL_PWM_OUTNUM);
+    g_ui32ArmMs = ui32ArmMs;
+    g_bRotorsChanged = false;
+
+    if (initGetYawTask(&xQueue) != 0 || g_pfnTask == NULL) {
+        return 0;
+    }
+    IntMasterEnable();
+    if (setjmp(g_sTaskExit) == 0) {
+        g_pfnTask(g_pvTaskParameters);
+    }
+    setRotorDuty(ROTOR_TAIL, 0);
+    g_fTailDuty = 0.0f;
+
+    return (uint32_t) (simTimeGet() / 1000);
+}
+
+
+/*******************************************************
+ * Function: expectedAngle
+ *
+ * returns: the angle getYawTask should report for a count
+ *          from the reference, worked out as it does
+ *******************************************************/
+static int32_t
+expectedAngle (int32_t i32Count)
+{
+    int32_t i32InRev = ((i32Count % YAW_COUNTS_PER_REV) + YAW_COUNTS_PER_REV) % YAW_COUNTS_PER_REV;
+
+    return numToInt(numMul(numFromInt(i32InRev), YAW_DEG_PER_COUNT));
+}
+
+
+/*******************************************************
+ * Function: fromReference
+ *
+ * returns: the plant's counts past the reference it last
+ *          passed forwards, the one getYawTask latched
+ *          (it turns less than a revolution after)
+ *******************************************************/
+static int32_t
+fromReference (const heliPlant_t *psPlant)
+{
+    int32_t i32Count = (heliPlantQuadCount(psPlant) - PLANT_YAW_REF_COUNT) % PLANT_YAW_COUNTS_PER_REV;
+
+    return (i32Count < 0) ? i32Count + PLANT_YAW_COUNTS_PER_REV : i32Count;
+}
+
+
+/*******************************************************
+ * Function: checkFindReference
+ *
+ * Finds the reference from a range of start headings
+ *******************************************************/
+static void
+checkFindReference (void)
+{
+    static const int32_t pi32Starts[] = { 0, 100, 149, 160, 300, 447, -120 };
+    heliPlant_t sPlant;
+    YawPosition sPosition;
+    uint32_t ui32Ms, ui32MaxMs = 0;
+    uint32_t i;
+    int32_t i32FromRef;
+    bool bFound = true, bRotors = true, bAngle = true, bFollows = true;
+
+    printf("start (counts)  time (ms)  angle  from the reference (counts)\n");
+    for (i = 0; i < sizeof(pi32Starts) / sizeof(pi32Starts[0]); i++) {
+        initHeliPlant(&sPlant);
+        ui32Ms = runStartUp(&sPlant, pi32Starts[i], 0);
+        i32FromRef = fromReference(&sPlant);
+        printf("%14d %10u %6d %8d\n", pi32Starts[i], (unsigned) ui32Ms, g_i32Angle, i32FromRef);
+
+        bFound = bFound && getYawRefFound() && g_bFinding;
+        bRotors = bRotors && !g_bRotorsChanged;
+        bAngle = bAngle && g_i32Angle == expectedAngle(i32FromRef);
+        ui32MaxMs = (ui32Ms > ui32MaxMs) ? ui32Ms : ui32MaxMs;
+
+        // Coast to a stop, still counting from the reference
+        initYawPosition(&sPosition);
+        vTaskDelay(TEST_COAST_MS);
+        updateYawPosition(&sPosition);
+        bFollows = bFollows && sPosition.referenced
+                   && sPosition.count == fromReference(&sPlant);
+    }
+
+    check(bFound, "found from every start heading");
+    check(bRotors, "the rotor PWMs are left to the control loop");
+    check(bAngle, "first angle is from the reference");
+    check(bFollows, "and it is still followed after the tail stops");
+    check(ui32MaxMs < YAW_FIND_REF_TIMEOUT_MS / 2, "within half the timeout");
+}
+
+
+/*******************************************************
+ * Function: checkStartOverReference
+ *******************************************************/
+static void
+checkStartOverReference (void)
+{
+    heliPlant_t sPlant;
+    YawPosition sPosition;
+    uint32_t ui32Ms;
+
+    initHeliPlant(&sPlant);
+    ui32Ms = runStartUp(&sPlant, PLANT_YAW_REF_COUNT + 1, 0);
+    initYawPosition(&sPosition);
+    check(getYawRefFound() && !g_bFinding && ui32Ms == 0, "started over the reference, found at once");
+    check(sPosition.count >= 0 && sPosition.count < PLANT_YAW_REF_WIDTH, "to within the slot width");
+}
+
+
+/*******************************************************
+ * Function: checkTimeout
+ *******************************************************/
+static void
+checkTimeout (void)
+{
+    heliPlant_t sPlant;
+    uint32_t ui32Ms;
+
+    initHeliPlant(&sPlant);
+    sPlant.sParams.fTailGain = 0.0f;  // Stuck
+    ui32Ms = runStartUp(&sPlant, 0, TEST_ARM_MS);
+    printf("stuck: armed at %u ms, gave up after %u ms\n", (unsigned) TEST_ARM_MS, (unsigned) ui32Ms);
+    check(!getYawRefFound() && ui32Ms >= TEST_ARM_MS + YAW_FIND_REF_TIMEOUT_MS
+          && ui32Ms < TEST_ARM_MS + YAW_FIND_REF_TIMEOUT_MS + 100, "stuck, gives up with the loop, timed from arming");
+    check(!g_bRotorsChanged && g_i32Angle == 0, "rotors left alone, heading from power on");
+}
+
+
+int
+main (void)
+{
+    checkLatch();
+    checkFindReference();
+    checkStartOverReference();
+    checkTimeout();
+
+    printf("%u failures\n", (unsigned) g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
@@ -0,0 +1,338 @@
+/*******************************************************
+ * yawVelocityTest.c
+ *
+ * Host unit test of the edge timed yaw velocity estimate
+ * in get_yaw_task.c (getQuadVelocity(), period based, and
+ * updateYawVelocity(), count based at speed), run against
+ * the simulated Port B and the free running edge timer.
+ *
+ * Simulated time advances 1 us at a time. A velocity
+ * profile is integrated to a position, and an edge is
+ * driven onto PB0/PB1 whenever it crosses a count. The
+ * estimates are sampled at YAW_TEST_RATE_HZ, the rate a
+ * controller would call updateYawVelocity() at, and
+ * compared with the true velocity at the same moment. A
+ * plain difference of counts per sample, as getYawTask
+ * worked it out before, is shown alongside.
+ *
+ * Profiles:
+ *   - constant rates from 20 to 20000 counts per second,
+ *     in both directions
+ *   - an acceleration from rest to 20000 counts/s, back
+ *     through zero and out the other way
+ *   - a stop, after which the estimate must fall away and
+ *     read 0 within 1 / YAW_VEL_MIN seconds
+ *
+ * The FreeRTOS calls made by get_yaw_task.c are stubbed
+ * below, only the headers from the POSIX port are needed.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -ISimulation -I. -I"HeliRig Project" -Iutils -IFreeRTOS/include
+ *         -I$POSIX_PORT -o yaw_velocity_test Testing/yawVelocityTest.c "HeliRig Project"/get_yaw_task.c
+ *         utils/ustdlib.c Simulation/sim_peripherals.c -lm
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "sim_peripherals.h"
+#include "get_yaw_task.h"
+
+#if YAW_USE_QEI
+#error yawVelocityTest.c tests the GPIO backend
+#endif
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define YAW_TEST_RATE_HZ    200  // Estimates per second
+#define TEST_SAMPLE_US      (1000000 / YAW_TEST_RATE_HZ)
+#define TEST_SETTLE_US      50000  // Left out of the error figures at the start of a profile,
+#define TEST_SETTLE_EDGES   (YAW_PERIOD_EDGES + 1)  // ... along with the time to the first full period
+#define TEST_RAMP           20000.0  // Counts per second per second
+#define TEST_CONST_TOL      0.01  // Allowed error at a constant rate, of the rate
+#define TEST_RAMP_TOL       0.03  // Allowed error while accelerating, of the peak rate
+
+
+// Pin states in Gray code order, counting up (B leads A)
+static const uint8_t g_pui8Phase[4] = { 0, GPIO_PIN_1, GPIO_PIN_0 | GPIO_PIN_1, GPIO_PIN_0 };
+
+static int64_t g_i64Edges;  // Every edge driven so far
+static uint32_t g_ui32Failures;
+
+// Error figures for one profile, in counts per second
+typedef struct
+{
+    double dMaxError;  // updateYawVelocity()
+    double dMaxPeriodError;  // getQuadVelocity()
+    double dMaxNaiveError;  // Counts per sample
+    double dSumSquares;
+    double dNaiveSumSquares;
+    uint32_t ui32Samples;
+} errors_t;
+
+
+/*******************************************************
+ * FreeRTOS stubs
+ *******************************************************/
+BaseType_t
+xTaskCreate (TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth,
+             void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    (void) pxTaskCode;
+    (void) pcName;
+    (void) usStackDepth;
+    (void) pvParameters;
+    (void) uxPriority;
+    (void) pxCreatedTask;
+    return pdPASS;  // The task itself is not run
+}
+
+BaseType_t
+xQueueGenericSend (QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait,
+                   const BaseType_t xCopyPosition)
+{
+    (void) xQueue;
+    (void) pvItemToQueue;
+    (void) xTicksToWait;
+    (void) xCopyPosition;
+    return pdPASS;
+}
+
+void
+vTaskDelay (const TickType_t xTicksToDelay)
+{
+    (void) xTicksToDelay;
+}
+
+BaseType_t
+xTaskNotifyWait (uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue,
+                 TickType_t xTicksToWait)
+{
+    (void) ulBitsToClearOnEntry;
+    (void) ulBitsToClearOnExit;
+    (void) pulNotificationValue;
+    (void) xTicksToWait;
+    return pdFALSE;
+}
+
+BaseType_t
+xTaskGenericNotifyFromISR (TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                           uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void) xTaskToNotify;
+    (void) ulValue;
+    (void) eAction;
+    (void) pulPreviousNotificationValue;
+    (void) pxHigherPriorityTaskWoken;
+    return pdPASS;  // Not reached, the task is never created so there is no handle
+}
+
+TickType_t
+xTaskGetTickCount (void)
+{
+    return (TickType_t) (simTimeGet() / 1000);  // One tick is 1 ms (configTICK_RATE_HZ)
+}
+
+void
+vPortYield (void)
+{
+}
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+/*******************************************************
+ * Velocity profiles, counts per second at dT seconds
+ *******************************************************/
+static double g_dRate;
+
+static double
+constantRate (double dT)
+{
+    (void) dT;
+    return g_dRate;
+}
+
+static double
+rampThroughZero (double dT)
+{
+    // Up to +peak over the first second, then down through 0 to -peak over the next two
+    return (dT < 1.0) ? TEST_RAMP * dT : TEST_RAMP * (2.0 - dT);
+}
+
+
+/*******************************************************
+ * Function: runProfile
+ *
+ * Drives the edges for a velocity profile for ui32Us
+ * microseconds, sampling the estimates every
+ * TEST_SAMPLE_US
+ *******************************************************/
+static void
+runProfile (double (*pfnVelocity)(double dT), uint32_t ui32Us, errors_t *psErrors)
+{
+    YawVelocity sVelocity;
+    double dPosition = (double) g_i64Edges;
+    double dTrue, dError;
+    int64_t i64Target, i64LastSample = g_i64Edges, i64Start = g_i64Edges;
+    int32_t i32Estimate, i32Period, i32Naive;
+    uint32_t ui32T;
+
+    psErrors->dMaxError = psErrors->dMaxPeriodError = psErrors->dMaxNaiveError = 0.0;
+    psErrors->dSumSquares = psErrors->dNaiveSumSquares = 0.0;
+    psErrors->ui32Samples = 0;
+
+    initYawVelocity(&sVelocity);
+
+    for (ui32T = 1; ui32T <= ui32Us; ui32T++) {
+        simStep(1);
+        dPosition += pfnVelocity(ui32T * 1e-6) * 1e-6;
+
+        // One edge per count crossed
+        i64Target = (int64_t) floor(dPosition);
+        while (g_i64Edges != i64Target) {
+            g_i64Edges += (i64Target > g_i64Edges) ? 1 : -1;
+            simGPIOInputSet(GPIO_PORTB_BASE, QUAD_PINS, g_pui8Phase[g_i64Edges & 3]);
+        }
+
+        if (ui32T % TEST_SAMPLE_US == 0) {
+            i32Estimate = updateYawVelocity(&sVelocity);
+            i32Period = getQuadVelocity();
+            i32Naive = (int32_t) (g_i64Edges - i64LastSample) * YAW_TEST_RATE_HZ;
+            i64LastSample = g_i64Edges;
+
+            if (ui32T > TEST_SETTLE_US && llabs(g_i64Edges - i64Start) >= TEST_SETTLE_EDGES) {
+                dTrue = pfnVelocity(ui32T * 1e-6);
+                dError = fabs(i32Estimate - dTrue);
+                psErrors->dMaxError = fmax(psErrors->dMaxError, dError);
+                psErrors->dMaxPeriodError = fmax(psErrors->dMaxPeriodError, fabs(i32Period - dTrue));
+                psErrors->dMaxNaiveError = fmax(psErrors->dMaxNaiveError, fabs(i32Naive - dTrue));
+                psErrors->dSumSquares += dError * dError;
+                psErrors->dNaiveSumSquares += (i32Naive - dTrue) * (i32Naive - dTrue);
+                psErrors->ui32Samples++;
+            }
+        }
+    }
+}
+
+
+/*******************************************************
+ * Function: checkConstantRates
+ *
+ * returns: true if every constant rate is estimated
+ *          within TEST_CONST_TOL
+ *******************************************************/
+static bool
+checkConstantRates (void)
+{
+    static const double pdRates[] = { 20.0, 200.0, 2000.0, 20000.0, -20.0, -2000.0, -20000.0 };
+    errors_t sErrors;
+    uint32_t i;
+    bool bPass = true;
+
+    printf("rate (c/s)   estimate  period only  counts per sample  (max error, c/s)\n");
+    for (i = 0; i < sizeof(pdRates) / sizeof(pdRates[0]); i++) {
+        g_dRate = pdRates[i];
+        runProfile(constantRate, 1000000, &sErrors);
+        printf("%10.0f %10.2f %12.2f %18.2f\n", g_dRate, sErrors.dMaxError, sErrors.dMaxPeriodError,
+               sErrors.dMaxNaiveError);
+        bPass = bPass && sErrors.dMaxError <= TEST_CONST_TOL * fabs(g_dRate);
+    }
+
+    return bPass;
+}
+
+
+/*******************************************************
+ * Function: checkStop
+ *
+ * Runs at 1000 counts/s, stops, and follows the estimate
+ * until it reads 0
+ *
+ * returns: true if it only ever falls, and reads 0 within
+ *          1 / YAW_VEL_MIN seconds
+ *******************************************************/
+static bool
+checkStop (void)
+{
+    YawVelocity sVelocity;
+    errors_t sErrors;
+    int32_t i32Estimate, i32Last;
+    uint32_t ui32Ms;
+    bool bFalling = true;
+
+    g_dRate = 1000.0;
+    runProfile(constantRate, 200000, &sErrors);
+    initYawVelocity(&sVelocity);
+    i32Last = getQuadVelocity();
+
+    for (ui32Ms = 1; ui32Ms <= 1000 / YAW_VEL_MIN + 5; ui32Ms++) {
+        simStep(1000);
+        i32Estimate = updateYawVelocity(&sVelocity);
+        bFalling = bFalling && i32Estimate <= i32Last;
+        i32Last = i32Estimate;
+        if (ui32Ms == 10 || ui32Ms == 50 || ui32Ms == 200) {
+            printf("  %3u ms after stopping: %d c/s\n", (unsigned) ui32Ms, i32Estimate);
+        }
+    }
+
+    return bFalling && i32Last == 0;
+}
+
+
+int
+main (void)
+{
+    xQueueHandle xQueue = NULL;
+    const simStats_t *psStats = simStatsGet();
+    errors_t sErrors;
+
+    simReset();
+    SysCtlClockSet(SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_16MHZ);
+    check(initGetYawTask(&xQueue) == 0, "initGetYawTask");
+    IntMasterEnable();
+    check(getQuadVelocity() == 0, "no edges, no velocity");
+
+    check(checkConstantRates(), "constant rates within 1%");
+
+    runProfile(rampThroughZero, 3000000, &sErrors);
+    printf("ramp at %.0f c/s^2 through 0: max error %.1f c/s (rms %.1f), period only %.1f, "
+           "counts per sample %.1f (rms %.1f)\n", TEST_RAMP, sErrors.dMaxError,
+           sqrt(sErrors.dSumSquares / sErrors.ui32Samples), sErrors.dMaxPeriodError, sErrors.dMaxNaiveError,
+           sqrt(sErrors.dNaiveSumSquares / sErrors.ui32Samples));
+    check(sErrors.dMaxError <= TEST_RAMP_TOL * TEST_RAMP, "accelerating, within 3% of the peak rate");
+    check(sErrors.dSumSquares < sErrors.dNaiveSumSquares, "accelerating, lower rms error than counts per sample");
+
+    check(checkStop(), "after a stop, falls to 0 within 1 / YAW_VEL_MIN");
+    check(getQuadIllegal() == 0 && psStats->ui32StuckInts == 0, "no illegal transitions or stuck interrupts");
+
+    printf("%u failures\n", (unsigned) g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}
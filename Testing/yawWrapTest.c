@@ -0,0 +1,317 @@
+/*******************************************************
+ * yawWrapTest.c
+ *
+ * Host stress test of the yaw count ownership in
+ * get_yaw_task.c: only quadIntHandler writes the count,
+ * and getYawTask follows it with a YawPosition.
+ *
+ * Runs getYawTask against the simulated Port B, with a
+ * random burst of encoder edges driven onto PB0/PB1 inside
+ * every FreeRTOS call the task makes (while sending to the
+ * OLED queue, while holding off after a send and while
+ * waiting for a notification). The edges run
+ * quadIntHandler as they arrive, just as the interrupt
+ * would preempt the task. The bursts drift in one
+ * direction, so the yaw goes round many times both ways.
+ * Checks that
+ *   - every angle the task reports is the one for the
+ *     reference count at its snapshot
+ *   - a YawPosition started before the task ends on the
+ *     reference count exactly, with the right number of
+ *     revolutions, so no edge was lost
+ *
+ * For comparison the old wrap (the task writing -1 or 449
+ * back to the count) is run under the same bursts, and the
+ * edges it overwrote are counted.
+ *
+ * The FreeRTOS calls made by get_yaw_task.c are stubbed
+ * below, only the headers from the POSIX port are needed.
+ *
+ * Build on the host:
+ *     gcc -std=gnu99 -O2 -ISimulation -I. -I"HeliRig Project" -Iutils -IFreeRTOS/include
+ *         -I$POSIX_PORT -o yaw_wrap_test Testing/yawWrapTest.c "HeliRig Project"/get_yaw_task.c
+ *         utils/ustdlib.c Simulation/sim_peripherals.c
+ *
+ *  Created on: 17/10/2026
+ *      Author: Group 1
+ *******************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <setjmp.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "sim_peripherals.h"
+#include "heli_math.h"
+#include "get_yaw_task.h"
+#include "helirig_structs.c"
+
+#if YAW_USE_QEI
+#error yawWrapTest.c tests the GPIO backend, see qeiBackendTest.c for the QEI
+#endif
+
+
+/*******************************************************
+ * Constants
+ *******************************************************/
+#define TEST_PASSES         20000  // Passes of getYawTask
+#define TEST_MAX_BURST      120  // Most edges in one burst, either way
+#define TEST_DRIFT          9  // Added to every burst, so the yaw goes round
+
+
+// Pin states in Gray code order, counting up (B leads A)
+static const uint8_t g_pui8Phase[4] = { 0, GPIO_PIN_1, GPIO_PIN_0 | GPIO_PIN_1, GPIO_PIN_0 };
+
+static TaskFunction_t g_pfnTask;
+static void *g_pvTaskParameters;
+static jmp_buf g_sTaskExit;
+static uint32_t g_ui32Failures;
+
+static uint32_t g_ui32Seed = 0x2468ACE;
+static int64_t g_i64Reference;  // Every edge driven so far
+static int64_t g_i64Snapshot;  // g_i64Reference when the task last took its snapshot
+static int32_t g_i32Drift = TEST_DRIFT;
+static uint32_t g_ui32Passes;
+static uint32_t g_ui32Messages;
+static uint32_t g_ui32AngleErrors;
+
+
+/*******************************************************
+ * Function: burstSize
+ *
+ * returns: a random number of edges, signed, for the next
+ *          burst
+ *******************************************************/
+static int32_t
+burstSize (void)
+{
+    g_ui32Seed = g_ui32Seed * 1664525u + 1013904223u;
+    return (int32_t) ((g_ui32Seed >> 16) % (2 * TEST_MAX_BURST + 1)) - TEST_MAX_BURST + g_i32Drift;
+}
+
+
+/*******************************************************
+ * Function: driveEdges
+ *
+ * Drives i32Edges edges onto PB0/PB1 one at a time, each
+ * running quadIntHandler as it arrives
+ *******************************************************/
+static void
+driveEdges (int32_t i32Edges)
+{
+    for (; i32Edges != 0; i32Edges += (i32Edges > 0) ? -1 : 1) {
+        g_i64Reference += (i32Edges > 0) ? 1 : -1;
+        simGPIOInputSet(GPIO_PORTB_BASE, QUAD_PINS, g_pui8Phase[g_i64Reference & 3]);
+    }
+}
+
+
+/*******************************************************
+ * Function: expectedAngle
+ *
+ * returns: the angle getYawTask should report for an
+ *          absolute count, worked out as it does
+ *******************************************************/
+static int32_t
+expectedAngle (int64_t i64Count)
+{
+    int32_t i32InRev = (int32_t) (((i64Count % YAW_COUNTS_PER_REV) + YAW_COUNTS_PER_REV) % YAW_COUNTS_PER_REV);
+
+    return numToInt(numMul(numFromInt(i32InRev), YAW_DEG_PER_COUNT));
+}
+
+
+/*******************************************************
+ * FreeRTOS stubs
+ *
+ * Each one drives a burst of edges, as if the interrupt
+ * had preempted the task there
+ *******************************************************/
+BaseType_t
+xTaskCreate (TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth,
+             void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+    (void) pcName;
+    (void) usStackDepth;
+    (void) uxPriority;
+    (void) pxCreatedTask;
+    g_pfnTask = pxTaskCode;
+    g_pvTaskParameters = pvParameters;
+    return pdPASS;
+}
+
+BaseType_t
+xQueueGenericSend (QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait,
+                   const BaseType_t xCopyPosition)
+{
+    const OLEDMessage *psMessage = (const OLEDMessage *) pvItemToQueue;
+    int32_t i32Angle = -1;
+
+    (void) xQueue;
+    (void) xTicksToWait;
+    (void) xCopyPosition;
+
+    if (sscanf(psMessage->strBuf, "Angle (deg): %d", &i32Angle) != 1 || i32Angle != expectedAngle(g_i64Snapshot)) {
+        if (g_ui32AngleErrors++ < 5) {
+            printf("  pass %u: \"%s\", expected %d\n", (unsigned) g_ui32Passes, psMessage->strBuf,
+                   expectedAngle(g_i64Snapshot));
+        }
+    }
+
+    g_ui32Messages++;
+    driveEdges(burstSize());
+    return pdPASS;
+}
+
+void
+vTaskDelay (const TickType_t xTicksToDelay)
+{
+    (void) xTicksToDelay;
+    driveEdges(burstSize());
+}
+
+BaseType_t
+xTaskNotifyWait (uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue,
+                 TickType_t xTicksToWait)
+{
+    (void) ulBitsToClearOnEntry;
+    (void) ulBitsToClearOnExit;
+    (void) pulNotificationValue;
+    (void) xTicksToWait;
+
+    if (++g_ui32Passes >= TEST_PASSES) {
+        longjmp(g_sTaskExit, 1);  // End the task
+    }
+
+    // Change direction every so often, so the yaw goes round both ways
+    if (g_ui32Passes % 5000 == 4999) {
+        g_i32Drift = -g_i32Drift;
+    }
+    driveEdges(burstSize());
+    g_i64Snapshot = g_i64Reference;  // getYawTask takes its snapshot straight after the wait
+    return pdTRUE;
+}
+
+BaseType_t
+xTaskGenericNotifyFromISR (TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                           uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    (void) xTaskToNotify;
+    (void) ulValue;
+    (void) eAction;
+    (void) pulPreviousNotificationValue;
+    (void) pxHigherPriorityTaskWoken;
+    return pdPASS;
+}
+
+TickType_t
+xTaskGetTickCount (void)
+{
+    return 0;  // Time stands still, only changes are sent
+}
+
+void
+vPortYield (void)
+{
+}
+
+
+/*******************************************************
+ * Function: legacyWrap
+ *
+ * The old getYawTask wrap, under the same bursts. The
+ * count is written by both sides, edges that arrive
+ * between the task's read and its write back are lost.
+ *
+ * returns: the number of edges overwritten
+ *******************************************************/
+static uint32_t
+legacyWrap (uint32_t ui32Passes, uint32_t *pui32Wraps)
+{
+    volatile int32_t i32Count = 0;
+    int32_t i32Angle, i32Burst;
+    uint32_t ui32Lost = 0;
+    uint32_t i;
+
+    *pui32Wraps = 0;
+    for (i = 0; i < ui32Passes; i++) {
+        if (i % 5000 == 4999) {
+            g_i32Drift = -g_i32Drift;
+        }
+
+        i32Angle = numToInt(numMul(numFromInt(i32Count), YAW_DEG_PER_COUNT));
+        i32Burst = burstSize();
+        i32Count += i32Burst;  // The interrupt, between the read and the write back
+        if (i32Angle > 359 || i32Angle < 0) {
+            i32Count = (i32Angle > 359) ? -1 : 449;
+            ui32Lost += (uint32_t) ((i32Burst < 0) ? -i32Burst : i32Burst);
+            (*pui32Wraps)++;
+        }
+        i32Count += burstSize();  // The rest of the pass
+    }
+
+    return ui32Lost;
+}
+
+
+/*******************************************************
+ * Function: check
+ *******************************************************/
+static void
+check (bool bPass, const char *pcWhat)
+{
+    printf("%-56s %s\n", pcWhat, bPass ? "ok" : "FAIL");
+    g_ui32Failures += !bPass;
+}
+
+
+int
+main (void)
+{
+    QueueHandle_t xQueue = (QueueHandle_t) &g_ui32Passes;  // Never dereferenced by the stubs
+    const simStats_t *psStats = simStatsGet();
+    YawPosition sPosition;
+    uint32_t ui32Lost, ui32Wraps;
+    int32_t i32Rev;
+
+    simReset();
+    simGPIOInputSet(YAW_REF_BASE, YAW_REF_PIN, 0);  // Over the reference at count 0, so the task starts straight away
+    check(initGetYawTask(&xQueue) == 0 && g_pfnTask != NULL, "initGetYawTask creates the task");
+    IntMasterEnable();
+    initYawPosition(&sPosition);
+
+    if (setjmp(g_sTaskExit) == 0) {
+        g_pfnTask(g_pvTaskParameters);
+    }
+
+    updateYawPosition(&sPosition);
+    i32Rev = (int32_t) ((g_i64Reference >= 0) ? g_i64Reference / YAW_COUNTS_PER_REV
+                                              : -((-g_i64Reference + YAW_COUNTS_PER_REV - 1) / YAW_COUNTS_PER_REV));
+    printf("%u passes, %u messages, %u edge interrupts, ended %lld counts (%d revolutions) from the start\n",
+           (unsigned) g_ui32Passes, (unsigned) g_ui32Messages, (unsigned) psStats->ui32GPIOInts, (long long) g_i64Reference,
+           yawRevolutions(&sPosition));
+
+    check(g_ui32Passes == TEST_PASSES, "getYawTask ran every pass");
+    check(g_ui32AngleErrors == 0, "every angle matches the count at its snapshot");
+    check(sPosition.count == g_i64Reference, "absolute position ends on the reference, no edge lost");
+    check(yawRevolutions(&sPosition) == i32Rev
+          && yawCountInRev(&sPosition) == (int32_t) (g_i64Reference - (int64_t) i32Rev * YAW_COUNTS_PER_REV),
+          "revolutions and position in the revolution");
+    check(getQuadIllegal() == 0 && psStats->ui32StuckInts == 0, "no illegal transitions or stuck interrupts");
+
+    g_i32Drift = TEST_DRIFT;
+    ui32Lost = legacyWrap(TEST_PASSES, &ui32Wraps);
+    printf("old wrap, same load: %u wraps overwrote %u edges\n", (unsigned) ui32Wraps, (unsigned) ui32Lost);
+
+    printf("%u failures\n", (unsigned) g_ui32Failures);
+    return g_ui32Failures ? 1 : 0;
+}